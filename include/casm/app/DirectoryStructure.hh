@@ -102,6 +102,12 @@ class DirectoryStructure {
   /// \brief Return SymrepBuilder plugin dir
   fs::path symrep_builder_plugins() const;
 
+  /// \brief Return directory containing cached supercell symmetry data
+  fs::path supercell_cache_dir() const;
+
+  /// \brief Return cached correlations file path for a basis set
+  fs::path correlation_cache(std::string bset) const;
+
   template <typename DataObject>
   fs::path master_selection() const;
 
@@ -161,6 +167,10 @@ class DirectoryStructure {
   /// \brief Returns path to clexulator so file
   fs::path clexulator_so(std::string project_name, std::string bset) const;
 
+  /// \brief Returns path to directory containing precompiled headers used to
+  /// compile clexulators
+  fs::path clexulator_pch_dir() const;
+
   /// \brief Returns path to directory containing equivalent clexulator files
   fs::path equivalent_clexulator_dir(std::string bset,
                                      int equivalent_index) const;
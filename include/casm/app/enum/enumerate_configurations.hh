@@ -58,6 +58,14 @@ struct ConfigEnumOptions {
 
   /// If true, include output for configurations that were filtered out
   bool output_filtered_configurations = false;
+
+  /// Maximum number of threads used to make enumerated configurations
+  /// canonical. Values < 1 use `default_n_threads()`.
+  Index n_threads = 0;
+
+  /// Number of enumerated configurations made canonical and inserted
+  /// together. Batches are not used if `output_configurations` is true.
+  Index batch_size = 1000;
 };
 
 /// Collect information during `enumerate_configurations` function for optional
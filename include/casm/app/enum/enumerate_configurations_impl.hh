@@ -74,6 +74,12 @@ namespace CASM {
 ///
 /// Note:
 /// - Uses CASM::log() for logging progress
+/// - If enumerated configurations are not output, configurations are made
+///   canonical and inserted in batches of `options.batch_size`, using up to
+///   `options.n_threads` threads (see the batch version of
+///   `DB::make_canonical_and_insert`). Otherwise, each configuration is
+///   inserted as it is enumerated, so that formatted data can use the
+///   enumerator state.
 ///
 template <typename MakeEnumeratorFunction, typename InputNameValuePairIterator,
           typename ConfigEnumDataType>
@@ -103,11 +109,18 @@ void enumerate_configurations(
         notstd::make_unique<FormattedDataFileType>(options.output_options);
   }
 
+  bool use_batches = !data_out_ptr && options.batch_size > 1;
+  std::vector<Configuration> batch;
+
   Index initial_state_index{0};
   auto it = name_value_pairs_begin;
   for (; it != name_value_pairs_end; ++it) {
     auto const &input_name_value_pair = *it;
 
+    // the previous enumerator is destroyed, so this is a safe point to
+    // release supercells (if `supercell_db.max_resident()` is limited)
+    supercell_db.shrink_resident();
+
     Index count = 0;
     Index count_filtered = 0;
     Index num_before = configuration_db.size();
@@ -120,6 +133,28 @@ void enumerate_configurations(
                           input_name_value_pair.second);
 
     for (Configuration const &configuration : enumerator) {
+      if (use_batches) {
+        /// Use while transitioning Supercell to no longer need a `PrimClex
+        /// const *`
+        if (!configuration.supercell().has_primclex()) {
+          configuration.supercell().set_primclex(options.primclex_ptr);
+        }
+
+        ++count;
+        if (options.filter && !options.filter(configuration)) {
+          ++count_filtered;
+        } else {
+          batch.push_back(configuration);
+        }
+        if (batch.size() >= options.batch_size) {
+          make_canonical_and_insert(enumerator, batch, supercell_db,
+                                    configuration_db, options.primitive_only,
+                                    options.n_threads);
+          batch.clear();
+        }
+        continue;
+      }
+
       ConfigEnumDataType data{primclex,
                               initial_state_index,
                               input_name_value_pair.first,
@@ -151,6 +186,12 @@ void enumerate_configurations(
         (*data_out_ptr)(formatter, data);
       }
     }
+    if (batch.size()) {
+      make_canonical_and_insert(enumerator, batch, supercell_db,
+                                configuration_db, options.primitive_only,
+                                options.n_threads);
+      batch.clear();
+    }
 
     Index num_after = configuration_db.size();
     log << dry_run_msg << count << " configurations"
@@ -3,6 +3,8 @@
 
 #include <iostream>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace CASM {
 
@@ -24,6 +26,14 @@ void print_initial_states(Log &log,
                           NamedInitialStatesType const &named_initial_states);
 
 void print_options(Log &log, ConfigEnumOptions const &options);
+
+/// Print distinct configuration counts and estimated enumeration cost for
+/// enumerating all occupations
+void print_occupation_enumeration_estimates(
+    Log &log,
+    std::vector<std::pair<std::string, ConfigEnumInput>> const
+        &named_initial_states,
+    bool primitive_only);
 }  // namespace CASM
 
 #endif
@@ -0,0 +1,22 @@
+#ifndef CASM_enum_ConfigEnumCanonicalOccupationsInterface
+#define CASM_enum_ConfigEnumCanonicalOccupationsInterface
+
+#include "casm/app/enum/EnumInterface.hh"
+
+namespace CASM {
+
+/// Interface for ConfigEnumCanonicalOccupations
+class ConfigEnumCanonicalOccupationsInterface : public EnumInterfaceBase {
+  CLONEABLE(ConfigEnumCanonicalOccupationsInterface)
+ public:
+  std::string desc() const override;
+
+  std::string name() const override;
+
+  void run(PrimClex &primclex, jsonParser const &json_options,
+           jsonParser const &cli_options_as_json) const override;
+};
+
+}  // namespace CASM
+
+#endif
@@ -83,6 +83,13 @@ class Clexulator {
   /// \brief Obtain reference to abstract ClexParamPack object
   clexulator::ClexParamPack &param_pack() { return m_clex->param_pack(); }
 
+  /// \brief Obtain const reference to the underlying BaseClexulator
+  ///
+  /// Notes:
+  /// - The BaseClexulator keeps mutable evaluation state, see
+  ///   ClexulatorContext for thread-safe evaluation
+  clexulator::BaseClexulator const &base() const { return *m_clex; }
+
   /// \brief Obtain ClexParamKey for a particular parameter
   clexulator::ClexParamKey const &param_key(
       std::string const &_param_name) const;
@@ -0,0 +1,151 @@
+#ifndef CASM_ClexulatorContext
+#define CASM_ClexulatorContext
+
+#include <vector>
+
+#include "casm/clex/Clexulator.hh"
+#include "casm/clexulator/ConfigDoFValues.hh"
+#include "casm/crystallography/DoFDecl.hh"
+#include "casm/global/eigen.hh"
+
+namespace CASM {
+
+class ConfigDoF;
+
+namespace clexulator {
+class SuperNeighborList;
+}
+using clexulator::SuperNeighborList;
+
+/// \brief Per-thread state used to evaluate a shared Clexulator
+///
+/// A Clexulator keeps mutable evaluation state: pointers to the DoF values and
+/// neighbor list currently being evaluated, and the ClexParamPack that the
+/// generated basis functions write into. One Clexulator therefore must not be
+/// used by more than one thread at a time.
+///
+/// ClexulatorContext gathers all of that state in one object that is owned by
+/// a single thread, so that the Clexulator it was constructed from can be
+/// shared read-only by any number of threads:
+/// - a private evaluator (a copy of the shared Clexulator, sharing the loaded
+///   runtime library, with its own ClexParamPack),
+/// - the ConfigDoF values and neighbor list currently bound for evaluation,
+/// - scratch correlation vectors used by the correlation functions in
+///   "casm/clex/ConfigCorrelations.hh".
+///
+/// The ConfigDoF values are bound once per configuration (`set_configdof`),
+/// rather than once per unit cell, which avoids repeated DoF type lookups.
+///
+/// Usage:
+/// \code
+/// Clexulator const &clexulator = ...;  // shared, read-only
+///
+/// // in each thread:
+/// ClexulatorContext context(clexulator);
+/// Eigen::VectorXd corr;
+/// correlations(corr, configdof, supercell_neighbor_list, context);
+/// \endcode
+///
+/// \ingroup Clexulator
+///
+class ClexulatorContext {
+ public:
+  typedef Clexulator::size_type size_type;
+
+  /// \brief Construct a context for evaluating `shared_clexulator`
+  explicit ClexulatorContext(Clexulator const &shared_clexulator);
+
+  /// \brief The private evaluator owned by this context
+  Clexulator const &clexulator() const { return m_clexulator; }
+
+  /// \brief Number of correlations
+  size_type corr_size() const { return m_clexulator.corr_size(); }
+
+  /// \brief Bind ConfigDoF values for evaluation
+  void set_configdof(ConfigDoF const &configdof);
+
+  /// \brief Bind the neighbor list of a particular unit cell for evaluation
+  void set_nlist(SuperNeighborList const &supercell_neighbor_list,
+                 Index linear_unitcell_index);
+
+  /// \brief Bind a private copy of the DoF values in the neighborhood of one
+  /// unit cell, so that trial values can be evaluated without modifying
+  /// `configdof`
+  void set_trial_nlist(ConfigDoF const &configdof,
+                       SuperNeighborList const &supercell_neighbor_list,
+                       Index linear_unitcell_index);
+
+  /// \brief Set a trial occupation in the neighborhood bound by
+  /// `set_trial_nlist`
+  void set_trial_occ(Index linear_site_index, int occ);
+
+  /// \brief Set a trial local continuous DoF value in the neighborhood bound
+  /// by `set_trial_nlist`
+  void set_trial_local_dof_value(DoFKey const &key, Index linear_site_index,
+                                 Eigen::VectorXd const &value);
+
+  /// \brief Calculate select correlation contribution of the bound unit cell
+  void calc_restricted_global_corr_contribution(
+      double *corr_begin, size_type const *corr_ind_begin,
+      size_type const *corr_ind_end) const {
+    m_base->calc_restricted_global_corr_contribution(corr_begin, corr_ind_begin,
+                                                     corr_ind_end);
+  }
+
+  /// \brief Calculate select point correlations of the bound unit cell
+  void calc_restricted_point_corr(int neighbor_ind, double *corr_begin,
+                                  size_type const *corr_ind_begin,
+                                  size_type const *corr_ind_end) const {
+    m_base->calc_restricted_point_corr(neighbor_ind, corr_begin,
+                                       corr_ind_begin, corr_ind_end);
+  }
+
+  /// \brief Calculate the change in select point correlations of the bound
+  /// unit cell due to changing an occupant
+  void calc_restricted_delta_point_corr(int neighbor_ind, int occ_i, int occ_f,
+                                        double *corr_begin,
+                                        size_type const *corr_ind_begin,
+                                        size_type const *corr_ind_end) const {
+    m_base->calc_restricted_delta_point_corr(
+        neighbor_ind, occ_i, occ_f, corr_begin, corr_ind_begin, corr_ind_end);
+  }
+
+  /// \brief Sequential correlation indices [0, corr_size())
+  std::vector<unsigned int> const &all_correlation_indices() const {
+    return m_all_correlation_indices;
+  }
+
+  /// \brief Scratch vector, of size corr_size(), for unit cell contributions
+  Eigen::VectorXd &tcorr() { return m_tcorr; }
+
+  /// \brief Scratch vector, of size corr_size(), for "before" values of
+  /// delta correlation calculations
+  Eigen::VectorXd &before() { return m_before; }
+
+ private:
+  /// Private copy of the shared Clexulator
+  Clexulator m_clexulator;
+
+  /// Points at the BaseClexulator owned by m_clexulator
+  clexulator::BaseClexulator const *m_base;
+
+  std::vector<unsigned int> m_all_correlation_indices;
+
+  Eigen::VectorXd m_tcorr;
+
+  Eigen::VectorXd m_before;
+
+  /// DoF values of the neighborhood bound by set_trial_nlist, with one site
+  /// per neighbor list index
+  clexulator::ConfigDoFValues m_trial_values;
+
+  /// Neighbor list for m_trial_values: m_trial_nlist[i] == i
+  std::vector<long int> m_trial_nlist;
+
+  /// Supercell site indices of the neighborhood bound by set_trial_nlist
+  std::vector<Index> const *m_trial_sites;
+};
+
+}  // namespace CASM
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef CASM_ConfigCorrelations
 #define CASM_ConfigCorrelations
 
+#include <vector>
+
 #include "casm/crystallography/DoFDecl.hh"
 #include "casm/global/definitions.hh"
 #include "casm/global/eigen.hh"
@@ -19,6 +21,7 @@ class SuperNeighborList;
 using clexulator::SuperNeighborList;
 
 class Clexulator;
+class ClexulatorContext;
 class ConfigDoF;
 class Configuration;
 class GlobalContinuousConfigDoFValues;
@@ -151,6 +154,97 @@ void restricted_delta_corr(
     Clexulator const &clexulator, unsigned int const *corr_indices_begin,
     unsigned int const *corr_indices_end);
 
+// --- Evaluation using a ClexulatorContext ---
+//
+// These overloads take a per-thread ClexulatorContext instead of a Clexulator.
+// They do not use any static or shared scratch data, so the Clexulator used to
+// construct the contexts may be shared by many threads.
+
+/// \brief Sets correlations using a per-thread ClexulatorContext. Mean of the
+/// contribution from every unit cell.
+void correlations(Eigen::VectorXd &corr, ConfigDoF const &configdof,
+                  SuperNeighborList const &supercell_neighbor_list,
+                  ClexulatorContext &context);
+
+/// \brief Sets correlations using a per-thread ClexulatorContext, restricted
+/// to specified correlation indices. Mean of the contribution from every unit
+/// cell.
+void restricted_correlations(Eigen::VectorXd &corr, ConfigDoF const &configdof,
+                             SuperNeighborList const &supercell_neighbor_list,
+                             ClexulatorContext &context,
+                             unsigned int const *corr_indices_begin,
+                             unsigned int const *corr_indices_end);
+
+/// \brief Sets correlations using a per-thread ClexulatorContext. Sum of the
+/// contribution from every unit cell.
+void extensive_correlations(Eigen::VectorXd &corr, ConfigDoF const &configdof,
+                            SuperNeighborList const &supercell_neighbor_list,
+                            ClexulatorContext &context);
+
+/// \brief Sets correlations using a per-thread ClexulatorContext, restricted
+/// to specified correlation indices. Sum of the contribution from every unit
+/// cell.
+void restricted_extensive_correlations(
+    Eigen::VectorXd &corr, ConfigDoF const &configdof,
+    SuperNeighborList const &supercell_neighbor_list,
+    ClexulatorContext &context, unsigned int const *corr_indices_begin,
+    unsigned int const *corr_indices_end);
+
+/// \brief Sets change in (extensive) correlations due to an occupation
+/// change, using a per-thread ClexulatorContext, restricted to specified
+/// correlations
+void restricted_delta_corr(Eigen::VectorXd &dcorr, Index linear_site_index,
+                           int new_occ, ConfigDoF const &configdof,
+                           SuperNeighborList const &supercell_neighbor_list,
+                           ClexulatorContext &context,
+                           unsigned int const *corr_indices_begin,
+                           unsigned int const *corr_indices_end);
+
+/// \brief Sets change in (extensive) correlations due to a local continuous
+/// DoF change, using a per-thread ClexulatorContext, restricted to specified
+/// correlations
+void restricted_delta_corr(Eigen::VectorXd &dcorr, Index linear_site_index,
+                           Eigen::VectorXd const &new_value,
+                           ConfigDoF const &configdof,
+                           SuperNeighborList const &supercell_neighbor_list,
+                           LocalContinuousConfigDoFValues const &dof_values,
+                           ClexulatorContext &context,
+                           unsigned int const *corr_indices_begin,
+                           unsigned int const *corr_indices_end);
+
+// --- Batched correlations ---
+
+/// \brief Sets correlations for many ConfigDoF in one supercell, one row per
+/// ConfigDoF, evaluated in parallel
+void correlations(Eigen::MatrixXdRowMajor &corr,
+                  std::vector<ConfigDoF const *> const &configdof,
+                  SuperNeighborList const &supercell_neighbor_list,
+                  Clexulator const &clexulator, Index n_threads = 0);
+
+/// \brief Sets restricted correlations for many ConfigDoF in one supercell,
+/// one row per ConfigDoF, evaluated in parallel
+void restricted_correlations(Eigen::MatrixXdRowMajor &corr,
+                             std::vector<ConfigDoF const *> const &configdof,
+                             SuperNeighborList const &supercell_neighbor_list,
+                             Clexulator const &clexulator,
+                             unsigned int const *corr_indices_begin,
+                             unsigned int const *corr_indices_end,
+                             Index n_threads = 0);
+
+/// \brief Returns correlations for many configurations, in any supercells,
+/// one row per configuration, evaluated in parallel
+Eigen::MatrixXdRowMajor correlations(
+    std::vector<Configuration const *> const &configurations,
+    Clexulator const &clexulator, Index n_threads = 0);
+
+/// \brief Sets restricted correlations for many configurations, in any
+/// supercells, one row per configuration, evaluated in parallel
+void restricted_correlations(
+    Eigen::MatrixXdRowMajor &corr,
+    std::vector<Configuration const *> const &configurations,
+    Clexulator const &clexulator, unsigned int const *corr_indices_begin,
+    unsigned int const *corr_indices_end, Index n_threads = 0);
+
 // --- Coordinates for sites in `all_point_corr` ---
 
 /// Return xtal::UnitCellCoord for each row in `all_point_corr`
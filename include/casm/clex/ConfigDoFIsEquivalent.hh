@@ -31,31 +31,37 @@ class Occupation {
 
   /// \brief Return config == A*config, store config < A*config
   bool operator()(PermuteIterator const &A) const {
+    PermuteIndices permute_A(A);
     return _for_each(
         [&](Index i) { return (*m_occupation_ptr)[i]; },
-        [&](Index i) { return (*m_occupation_ptr)[A.permute_ind(i)]; });
+        [&](Index i) { return (*m_occupation_ptr)[permute_A[i]]; });
   }
 
   /// \brief Return A*config == B*config, store A*config < B*config
   bool operator()(PermuteIterator const &A, PermuteIterator const &B) const {
+    PermuteIndices permute_A(A);
+    PermuteIndices permute_B(B);
     return _for_each(
-        [&](Index i) { return (*m_occupation_ptr)[A.permute_ind(i)]; },
-        [&](Index i) { return (*m_occupation_ptr)[B.permute_ind(i)]; });
+        [&](Index i) { return (*m_occupation_ptr)[permute_A[i]]; },
+        [&](Index i) { return (*m_occupation_ptr)[permute_B[i]]; });
   }
 
   /// \brief Return config == A*other, store config < A*other
   bool operator()(PermuteIterator const &A,
                   Eigen::VectorXi const &other) const {
+    PermuteIndices permute_A(A);
     return _for_each([&](Index i) { return (*m_occupation_ptr)[i]; },
-                     [&](Index i) { return other[A.permute_ind(i)]; });
+                     [&](Index i) { return other[permute_A[i]]; });
   }
 
   /// \brief Return A*config == B*other, store A*config < B*other
   bool operator()(PermuteIterator const &A, PermuteIterator const &B,
                   Eigen::VectorXi const &other) const {
+    PermuteIndices permute_A(A);
+    PermuteIndices permute_B(B);
     return _for_each(
-        [&](Index i) { return (*m_occupation_ptr)[A.permute_ind(i)]; },
-        [&](Index i) { return other[B.permute_ind(i)]; });
+        [&](Index i) { return (*m_occupation_ptr)[permute_A[i]]; },
+        [&](Index i) { return other[permute_B[i]]; });
   }
 
   /// \brief Returns less than comparison
@@ -129,9 +135,10 @@ class AnisoOccupation {
     _update_B(B, *m_occupation_ptr);
     m_tmp_valid = true;
 
+    PermuteIndices permute_B(B);
     return _for_each(
         [&](Index i) { return (*m_occupation_ptr)[i]; },
-        [&](Index i) { return this->m_new_occ_B[B.permute_ind(i)]; });
+        [&](Index i) { return this->m_new_occ_B[permute_B[i]]; });
   }
 
   /// \brief Return A*config == B*config, store A*config < B*config
@@ -140,9 +147,11 @@ class AnisoOccupation {
     _update_B(B, *m_occupation_ptr);
     m_tmp_valid = true;
 
+    PermuteIndices permute_A(A);
+    PermuteIndices permute_B(B);
     return _for_each(
-        [&](Index i) { return this->m_new_occ_A[A.permute_ind(i)]; },
-        [&](Index i) { return this->m_new_occ_B[B.permute_ind(i)]; });
+        [&](Index i) { return this->m_new_occ_A[permute_A[i]]; },
+        [&](Index i) { return this->m_new_occ_B[permute_B[i]]; });
   }
 
   /// \brief Return config == B*other, store config < B*other
@@ -151,9 +160,10 @@ class AnisoOccupation {
     _update_B(B, other);
     m_tmp_valid = false;
 
+    PermuteIndices permute_B(B);
     return _for_each(
         [&](Index i) { return (*m_occupation_ptr)[i]; },
-        [&](Index i) { return this->m_new_occ_B[B.permute_ind(i)]; });
+        [&](Index i) { return this->m_new_occ_B[permute_B[i]]; });
   }
 
   /// \brief Return A*config == B*other, store A*config < B*other
@@ -163,9 +173,11 @@ class AnisoOccupation {
     _update_B(B, other);
     m_tmp_valid = false;
 
+    PermuteIndices permute_A(A);
+    PermuteIndices permute_B(B);
     return _for_each(
-        [&](Index i) { return this->m_new_occ_A[A.permute_ind(i)]; },
-        [&](Index i) { return this->m_new_occ_B[B.permute_ind(i)]; });
+        [&](Index i) { return this->m_new_occ_A[permute_A[i]]; },
+        [&](Index i) { return this->m_new_occ_B[permute_B[i]]; });
   }
 
   /// \brief Returns less than comparison
@@ -282,9 +294,10 @@ class Local {
     _update_B(B, _values());
     m_tmp_valid = true;
 
+    PermuteIndices permute_B(B);
     return _for_each(
         [&](Index i, Index j) { return this->_values()(i, j); },
-        [&](Index i, Index j) { return this->new_dof_B(i, B.permute_ind(j)); });
+        [&](Index i, Index j) { return this->new_dof_B(i, permute_B[j]); });
   }
 
   /// \brief Return A*config == B*config, store A*config < B*config
@@ -292,9 +305,11 @@ class Local {
     _update_A(A, _values());
     _update_B(B, _values());
     m_tmp_valid = true;
+    PermuteIndices permute_A(A);
+    PermuteIndices permute_B(B);
     return _for_each(
-        [&](Index i, Index j) { return this->new_dof_A(i, A.permute_ind(j)); },
-        [&](Index i, Index j) { return this->new_dof_B(i, B.permute_ind(j)); });
+        [&](Index i, Index j) { return this->new_dof_A(i, permute_A[j]); },
+        [&](Index i, Index j) { return this->new_dof_B(i, permute_B[j]); });
   }
 
   /// \brief Return config == B*other, store config < B*other
@@ -303,9 +318,10 @@ class Local {
     _update_B(B, other);
     m_tmp_valid = false;
 
+    PermuteIndices permute_B(B);
     return _for_each(
         [&](Index i, Index j) { return this->_values()(i, j); },
-        [&](Index i, Index j) { return this->new_dof_B(i, B.permute_ind(j)); });
+        [&](Index i, Index j) { return this->new_dof_B(i, permute_B[j]); });
   }
 
   /// \brief Return A*config == B*other, store A*config < B*other
@@ -315,9 +331,11 @@ class Local {
     _update_B(B, other);
     m_tmp_valid = false;
 
+    PermuteIndices permute_A(A);
+    PermuteIndices permute_B(B);
     return _for_each(
-        [&](Index i, Index j) { return this->new_dof_A(i, A.permute_ind(j)); },
-        [&](Index i, Index j) { return this->new_dof_B(i, B.permute_ind(j)); });
+        [&](Index i, Index j) { return this->new_dof_A(i, permute_A[j]); },
+        [&](Index i, Index j) { return this->new_dof_B(i, permute_B[j]); });
   }
 
   /// \brief Returns less than comparison
@@ -0,0 +1,100 @@
+#ifndef CASM_ConfigEnumCanonicalOccupations
+#define CASM_ConfigEnumCanonicalOccupations
+
+#include "casm/clex/Configuration.hh"
+#include "casm/enumerator/InputEnumerator.hh"
+#include "casm/misc/cloneable_ptr.hh"
+
+namespace CASM {
+
+class ConfigEnumCanonicalOccupations;
+class ConfigEnumInput;
+
+/** \defgroup ConfigEnumGroup Configuration Enumerators
+ *  \ingroup Configuration
+ *  \ingroup Enumerator
+ *  \brief Enumerates Configuration
+ *  @{
+ */
+
+/// \brief Conditionally true for ConfigEnumCanonicalOccupations
+template <>
+bool is_guaranteed_for_database_insert(
+    ConfigEnumCanonicalOccupations const &enumerator);
+
+/// Enumerate canonical occupations of all sites in a supercell, by orderly
+/// generation
+///
+/// Produces the same configurations as ConfigEnumAllOccupations enumerating
+/// on all sites (one canonical configuration per orbit), but without visiting
+/// every occupation. Sites are assigned one at a time, in site index order,
+/// and partial occupations are abandoned as soon as a supercell symmetry
+/// operation is found that makes every completion of the partial occupation
+/// lexicographically greater, and therefore non-canonical.
+///
+/// Requires enumerating on all sites, no anisotropic occupants, and that any
+/// continuous DoF in the initial configuration are zero, so that canonical
+/// form is determined by the occupation alone.
+class ConfigEnumCanonicalOccupations
+    : public InputEnumeratorBase<Configuration> {
+  // -- Required members -------------------
+
+ public:
+  /// \brief Construct with a ConfigEnumInput, which must include all sites
+  ConfigEnumCanonicalOccupations(ConfigEnumInput const &config_enum_input,
+                                 bool primitive_only = true);
+
+  std::string name() const override;
+
+  /// \brief Returns true if enumerator is guaranteed to output
+  ///     primitive & canonical configurations only
+  bool primitive_canonical_guarantee() const;
+
+  static const std::string enumerator_name;
+
+ private:
+  /// Implements increment
+  void increment() override;
+
+  // -- Unique -------------------
+
+  /// Find the next occupation, including the current one if `check_current`,
+  /// that is canonical and, optionally, primitive
+  bool _find_next(bool check_current);
+
+  /// Returns false if no occupation beginning with the first `n_assigned`
+  /// values of m_occupation can be canonical
+  bool _prefix_may_be_canonical(Index n_assigned) const;
+
+  /// Move to the next value of the last assigned site, backtracking as
+  /// necessary. Returns false if there are no more.
+  bool _next_prefix();
+
+  /// Site permutations, for all operations except the identity, stored
+  /// contiguously: m_permutations[g * m_n_sites + i]
+  std::vector<Index> m_permutations;
+
+  /// Number of sites
+  Index m_n_sites;
+
+  /// Maximum allowed occupation index, by site
+  Eigen::VectorXi m_max_occupation;
+
+  /// Current occupation (only the first m_n_assigned are meaningful during
+  /// search)
+  Eigen::VectorXi m_occupation;
+
+  /// Number of assigned sites
+  Index m_n_assigned;
+
+  /// The current configuration
+  notstd::cloneable_ptr<Configuration> m_current;
+
+  /// True if only enumerating primitive configurations
+  bool m_primitive_only;
+};
+
+/** @}*/
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,111 @@
+#ifndef CASM_ConfigFingerprint
+#define CASM_ConfigFingerprint
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "casm/crystallography/UnitCellCoord.hh"
+#include "casm/global/definitions.hh"
+
+namespace CASM {
+
+class ConfigDoF;
+class Configuration;
+class Supercell;
+
+/** \ingroup Configuration
+ *  @{
+ */
+
+/// \brief Calculates a symmetry-invariant fingerprint of Configuration
+/// occupation in a particular Supercell
+///
+/// The fingerprint is a hash of:
+/// - the number of each species on each orbit of sublattices, where the
+///   sublattice orbits are generated by the supercell factor group, and
+/// - the number of each pair of species, (species on site i, species on site
+///   j), at each of the first `n_shells` neighbor distances, also classified
+///   by the sublattice orbits of sites i and j.
+///
+/// All of these counts are unchanged by any PermuteIterator of the supercell,
+/// so Configurations that are equivalent by supercell symmetry always have the
+/// same fingerprint. Configurations with different fingerprints are therefore
+/// known to be distinct without a canonical form calculation; only
+/// Configurations with the same fingerprint need a full comparison.
+///
+/// Species are identified by occupant name. If the prim has anisotropic
+/// occupants, species are identified by their (sorted) atom names instead, so
+/// that symmetrically equivalent orientations are not distinguished.
+/// Continuous DoF values are not included, so Configurations that differ only
+/// in continuous DoF values have the same fingerprint.
+///
+/// Construction, which finds sublattice orbits and neighbor shells, scales
+/// with the size of the prim. Each evaluation is O(N_sites). Each Supercell
+/// constructs one on first use, see `Supercell::fingerprint_calculator`.
+///
+/// The fingerprint is used by Configuration `is_sym_equivalent` and
+/// `find_sym_equivalent`. It is not used by the configuration database or the
+/// MonteCarloEnum hall of fame: they store canonical Configuration, which are
+/// compared directly, and a new Configuration must be made canonical to be
+/// stored whether or not its fingerprint is new.
+class ConfigFingerprintCalculator {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param supercell Supercell of the Configurations to be evaluated. Must
+  ///     outlive the calculator.
+  /// \param n_shells Number of neighbor distances to include in pair counts
+  explicit ConfigFingerprintCalculator(Supercell const &supercell,
+                                       Index n_shells = 2);
+
+  /// \brief Supercell of the Configurations to be evaluated
+  Supercell const &supercell() const { return *m_supercell; }
+
+  /// \brief Number of neighbor distances included in pair counts
+  Index n_shells() const { return m_n_shells; }
+
+  /// \brief Return the fingerprint of occupation values in `configdof`
+  std::uint64_t operator()(ConfigDoF const &configdof) const;
+
+ private:
+  /// Neighbor of a site on a particular sublattice
+  struct Neighbor {
+    Neighbor(Index _shell, xtal::UnitCellCoord const &_offset)
+        : shell(_shell), offset(_offset) {}
+
+    /// Neighbor distance index
+    Index shell;
+
+    /// Neighbor sublattice and unit cell offset from the site's unit cell
+    xtal::UnitCellCoord offset;
+  };
+
+  Supercell const *m_supercell;
+
+  Index m_n_shells;
+
+  /// Sublattice orbit index, for each sublattice
+  std::vector<Index> m_sublat_orbit;
+
+  Index m_n_sublat_orbits;
+
+  /// Species index, as m_species[sublattice][occupation value]
+  std::vector<std::vector<Index>> m_species;
+
+  Index m_n_species;
+
+  /// Neighbors, as m_neighbors[sublattice][neighbor index]
+  std::vector<std::vector<Neighbor>> m_neighbors;
+};
+
+/// \brief Return the symmetry-invariant fingerprint of a Configuration
+std::uint64_t symmetry_fingerprint(Configuration const &config);
+
+/// \brief Return a fingerprint as a fixed width (16 character) hex string
+std::string fingerprint_string(std::uint64_t fingerprint);
+
+/** @} */
+}  // namespace CASM
+
+#endif
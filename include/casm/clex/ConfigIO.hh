@@ -16,7 +16,9 @@ namespace CASM {
 ///
 /// \ingroup DataFormatter
 
+class ClexulatorContext;
 class Configuration;
+class CorrelationCache;
 struct NeighborhoodInfo;
 template <typename DataObject>
 class Norm;
@@ -233,8 +235,15 @@ class Corr : public VectorXdAttribute<Configuration> {
   mutable Clexulator m_clexulator;
   mutable std::string m_clex_name;
 
+  /// Evaluation state for m_clexulator, constructed by `init`
+  mutable std::shared_ptr<ClexulatorContext> m_context;
+
   /// Which correlations to calculate
   mutable std::vector<Clexulator::size_type> m_correlation_indices;
+
+  /// Cache of correlations, if m_clexulator is from the PrimClex. Shared, so
+  /// that it remains valid if the PrimClex is refreshed.
+  mutable std::shared_ptr<CorrelationCache> m_cache;
 };
 
 /// \brief Returns correlation values
@@ -590,6 +599,10 @@ class Clex : public ScalarAttribute<Configuration> {
   mutable Clexulator m_clexulator;
   mutable ECIContainer m_eci;
   mutable notstd::cloneable_ptr<Norm<Configuration> > m_norm;
+
+  /// Cache of correlations, if m_clexulator is from the PrimClex. Shared, so
+  /// that it remains valid if the PrimClex is refreshed.
+  mutable std::shared_ptr<CorrelationCache> m_cache;
 };
 }  // namespace ConfigIO
 
@@ -604,6 +617,8 @@ ConfigIO::GenericConfigFormatter<std::string> configname();
 
 ConfigIO::GenericConfigFormatter<std::string> scelname();
 
+ConfigIO::GenericConfigFormatter<std::string> fingerprint();
+
 ConfigIO::GenericConfigFormatter<std::string> calc_status();
 
 ConfigIO::GenericConfigFormatter<std::string> failure_type();
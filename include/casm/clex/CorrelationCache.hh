@@ -0,0 +1,163 @@
+#ifndef CASM_CorrelationCache
+#define CASM_CorrelationCache
+
+#include <boost/filesystem/path.hpp>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "casm/global/definitions.hh"
+#include "casm/global/eigen.hh"
+
+namespace CASM {
+
+class Clexulator;
+class ConfigDoF;
+class Configuration;
+class DirectoryStructure;
+
+/** \ingroup Clex
+ *  @{
+ */
+
+/// \brief On-disk cache of the correlations of database configurations for
+/// one basis set
+///
+/// Correlations, normalized per primitive cell as by `correlations`, are
+/// stored as a dense row-major matrix with one row per configuration. Rows
+/// are found by configuration name, and each row also stores a hash of the
+/// configuration DoF values (see `configdof_hash`), which is checked on
+/// lookup, so that a configuration that was removed and replaced by another
+/// with the same name does not use stale correlations.
+///
+/// The cache file has a header with a key identifying the basis set (see
+/// `correlation_cache_key`) and the number of correlations. If the key does
+/// not match on load, the file is ignored and replaced on the next commit.
+///
+/// Rows are inserted as correlations are calculated, and written by `commit`
+/// or on destruction. On commit, rows committed by other processes since
+/// load are kept. Files are written to a temporary file and renamed into
+/// place, so concurrent readers never see partial files.
+///
+/// The cache is an optimization only: failure to read or write the cache file
+/// is not an error, correlations are re-calculated instead.
+class CorrelationCache {
+ public:
+  /// \brief Constructor, reads the cache file if it exists and is valid
+  ///
+  /// \param location Cache file path. May be empty to use in memory only.
+  /// \param key Hash identifying the basis set
+  /// \param corr_size Number of correlations
+  CorrelationCache(fs::path location, std::uint64_t key, Index corr_size);
+
+  CorrelationCache(CorrelationCache const &) = delete;
+  CorrelationCache &operator=(CorrelationCache const &) = delete;
+
+  /// \brief Destructor, commits any inserted rows
+  ~CorrelationCache();
+
+  fs::path const &location() const { return m_location; }
+
+  std::uint64_t key() const { return m_key; }
+
+  /// \brief Number of correlations per row
+  Index corr_size() const { return m_corr_size; }
+
+  /// \brief Number of rows
+  Index size() const { return m_names.size(); }
+
+  /// \brief Correlations of a configuration, or nullptr if not cached
+  ///
+  /// \param configname Configuration name
+  /// \param dof_hash Hash of the configuration DoF values. Rows with a
+  ///     different hash are not returned.
+  ///
+  /// Returns a pointer to `corr_size()` values, valid until the next insert.
+  double const *find(std::string const &configname,
+                     std::uint64_t dof_hash) const;
+
+  /// \brief Insert or replace the correlations of a configuration
+  void insert(std::string const &configname, std::uint64_t dof_hash,
+              Eigen::VectorXd const &corr);
+
+  /// \brief Write the cache file, if rows were inserted since load
+  void commit();
+
+ private:
+  /// Read rows from the cache file, if it exists and is valid. Returns false
+  /// otherwise.
+  bool _read(fs::path const &path, std::vector<std::string> &names,
+             std::vector<std::uint64_t> &dof_hash,
+             std::vector<double> &data) const;
+
+  /// Append a row, or replace the existing row with the same name
+  void _set_row(std::string const &configname, std::uint64_t dof_hash,
+                double const *corr);
+
+  fs::path m_location;
+
+  std::uint64_t m_key;
+
+  Index m_corr_size;
+
+  // configuration name, by row
+  std::vector<std::string> m_names;
+
+  // configuration DoF hash, by row
+  std::vector<std::uint64_t> m_dof_hash;
+
+  // correlations, row-major, size() x corr_size()
+  std::vector<double> m_data;
+
+  // configuration name -> row
+  std::unordered_map<std::string, Index> m_row;
+
+  // if true, rows were inserted since load or the last commit
+  bool m_modified;
+};
+
+/// \brief Hash of the DoF values of a configuration
+std::uint64_t configdof_hash(ConfigDoF const &configdof);
+
+/// \brief Hash of the basis set specs and clexulator source of a basis set,
+/// identifying a CorrelationCache
+std::uint64_t correlation_cache_key(DirectoryStructure const &dir,
+                                    std::string const &project_name,
+                                    std::string const &basis_set_name);
+
+/// \brief Return true if correlation caches should be used
+bool correlation_cache_enabled();
+
+/// \brief Correlations of a configuration, from a cache if possible
+///
+/// \param config Configuration. The cache is used only for configurations
+///     with an id, as in the configuration database.
+/// \param clexulator Clexulator for the basis set of the cache
+/// \param cache Cache, or nullptr to calculate without a cache
+///
+/// Correlations that are calculated are inserted in the cache.
+Eigen::VectorXd correlations(Configuration const &config,
+                             Clexulator const &clexulator,
+                             CorrelationCache *cache);
+
+/// \brief Calculate and insert the correlations of many configurations that
+/// are not yet in a cache, evaluated in parallel
+///
+/// \param cache Cache to insert correlations in
+/// \param configurations Configurations. Only configurations with an id, as
+///     in the configuration database, are inserted.
+/// \param clexulator Clexulator for the basis set of the cache
+/// \param n_threads Maximum number of threads to use. Values < 1 use
+///     `default_n_threads()`.
+///
+/// \returns Number of configurations inserted
+Index insert_correlations(
+    CorrelationCache &cache,
+    std::vector<Configuration const *> const &configurations,
+    Clexulator const &clexulator, Index n_threads = 0);
+
+/** @} */
+}  // namespace CASM
+
+#endif
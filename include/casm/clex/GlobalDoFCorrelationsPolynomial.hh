@@ -0,0 +1,113 @@
+#ifndef CASM_GlobalDoFCorrelationsPolynomial
+#define CASM_GlobalDoFCorrelationsPolynomial
+
+#include <vector>
+
+#include "casm/crystallography/DoFDecl.hh"
+#include "casm/global/definitions.hh"
+#include "casm/global/eigen.hh"
+
+namespace CASM {
+
+namespace clexulator {
+class SuperNeighborList;
+}
+using clexulator::SuperNeighborList;
+
+class Clexulator;
+class ConfigDoF;
+
+/// \brief Extensive correlations of a configuration as an explicit polynomial
+/// of one global continuous DoF (i.e. strain)
+///
+/// For fixed values of all other DoF, every cluster function is a polynomial
+/// in the global DoF values, e = (e_0, ..., e_{d-1}), of total order at most
+/// `max_poly_order`. This class determines, once per configuration, the
+/// coefficients of that polynomial for the extensive correlations:
+///
+///     corr_j(e) = sum_k coefficients(j, k) * prod_i e_i^exponents[k](i)
+///
+/// Afterwards, correlations or changes in correlations for trial values of the
+/// global DoF can be evaluated with a dense contraction whose cost depends on
+/// the number of correlations and monomials, but not on the supercell size.
+///
+/// Notes:
+/// - The coefficients are determined by evaluating the correlations on a
+///   fixed grid of global DoF values and interpolating with forward
+///   differences, which is deterministic and exact (up to floating point
+///   error) if `max_poly_order` is not less than the maximum polynomial order
+///   of the global DoF in the basis set. The result is checked against a
+///   direct evaluation at an additional value, and an exception is thrown if
+///   the results do not agree.
+/// - The polynomial is only valid while all other DoF of the configuration are
+///   unchanged. After occupation or local DoF changes it must be
+///   reconstructed.
+/// - Global DoF values are in the prim DoF basis, the same as
+///   `GlobalContinuousConfigDoFValues::values()`.
+class GlobalDoFCorrelationsPolynomial {
+ public:
+  /// \brief Constructor, determines the polynomial coefficients
+  GlobalDoFCorrelationsPolynomial(
+      ConfigDoF const &configdof,
+      SuperNeighborList const &supercell_neighbor_list,
+      Clexulator const &clexulator, DoFKey const &dof_key,
+      Index max_poly_order, unsigned int const *corr_indices_begin,
+      unsigned int const *corr_indices_end, double sample_scale = 1.0,
+      double tol = 1e-8);
+
+  /// \brief Global DoF type
+  DoFKey const &dof_key() const { return m_dof_key; }
+
+  /// \brief Global DoF dimension
+  Index dim() const { return m_dim; }
+
+  /// \brief Maximum total polynomial order
+  Index max_poly_order() const { return m_max_poly_order; }
+
+  /// \brief Exponents of each monomial, as a vector of size dim()
+  std::vector<Eigen::VectorXi> const &exponents() const { return m_exponents; }
+
+  /// \brief Polynomial coefficients, shape=(corr_size, n_monomials)
+  Eigen::MatrixXd const &coefficients() const { return m_coefficients; }
+
+  /// \brief Correlation indices included in the polynomial
+  std::vector<unsigned int> const &correlation_indices() const {
+    return m_correlation_indices;
+  }
+
+  /// \brief Evaluate all monomials at a global DoF value
+  void monomials(Eigen::VectorXd &result, Eigen::VectorXd const &value) const;
+
+  /// \brief Extensive correlations at a global DoF value
+  void extensive_correlations(Eigen::VectorXd &corr,
+                              Eigen::VectorXd const &value) const;
+
+  /// \brief Change in extensive correlations, from one global DoF value to
+  /// another
+  void delta_corr(Eigen::VectorXd &dcorr, Eigen::VectorXd const &curr_value,
+                  Eigen::VectorXd const &new_value) const;
+
+ private:
+  DoFKey m_dof_key;
+
+  Index m_dim;
+
+  Index m_max_poly_order;
+
+  std::vector<unsigned int> m_correlation_indices;
+
+  std::vector<Eigen::VectorXi> m_exponents;
+
+  Eigen::MatrixXd m_coefficients;
+};
+
+/// \brief Sets change in (extensive) correlations due to a global continuous
+/// DoF change, using a GlobalDoFCorrelationsPolynomial
+void restricted_delta_corr(Eigen::VectorXd &dcorr,
+                           Eigen::VectorXd const &current_value,
+                           Eigen::VectorXd const &new_value,
+                           GlobalDoFCorrelationsPolynomial const &polynomial);
+
+}  // namespace CASM
+
+#endif
@@ -3,6 +3,8 @@
 
 #include <vector>
 
+#include "casm/global/definitions.hh"
+
 namespace CASM {
 namespace xtal {
 class Lattice;
@@ -120,6 +122,9 @@ class CanonicalForm : public Base {
                                                   PermuteIteratorIt end) const;
 };
 
+/// \brief Number of threads used by ConfigCanonicalForm if not specified
+Index default_canonical_form_n_threads();
+
 /// \brief Implements canonical form finding for Configuration and
 /// DiffTransConfiguration
 ///
@@ -132,6 +137,15 @@ class CanonicalForm : public Base {
 ///   - where SuperGroupPermuteIteratorType may be PermuteIterator or
 ///     std::vector<PermuteIterator>::const_iterator
 ///
+/// Parallel evaluation:
+/// - `to_canonical`, `from_canonical`, and `invariant_subgroup` may split the
+///   range of permutations into contiguous blocks evaluated by separate
+///   threads. The `n_threads` argument sets the maximum number of threads;
+///   values < 1 use `default_canonical_form_n_threads()`, which is 1 (serial)
+///   unless set by the environment variable CASM_CANONICAL_FORM_NUM_THREADS.
+/// - Results are identical to serial evaluation: ties are broken in favor of
+///   the lowest-index permutation, and invariant_subgroup is in range order.
+///
 template <typename Base>
 class ConfigCanonicalForm : public Base {
  public:
@@ -177,16 +191,18 @@ class ConfigCanonicalForm : public Base {
                              PermuteIteratorIt end) const;
 
   template <typename PermuteIteratorIt>
-  PermuteIterator to_canonical(PermuteIteratorIt begin,
-                               PermuteIteratorIt end) const;
+  PermuteIterator to_canonical(PermuteIteratorIt begin, PermuteIteratorIt end,
+                               Index n_threads = -1) const;
 
   template <typename PermuteIteratorIt>
   PermuteIterator from_canonical(PermuteIteratorIt begin,
-                                 PermuteIteratorIt end) const;
+                                 PermuteIteratorIt end,
+                                 Index n_threads = -1) const;
 
   template <typename PermuteIteratorIt>
   std::vector<PermuteIterator> invariant_subgroup(PermuteIteratorIt begin,
-                                                  PermuteIteratorIt end) const;
+                                                  PermuteIteratorIt end,
+                                                  Index n_threads = -1) const;
 
   // --- Required in MostDerived:
 
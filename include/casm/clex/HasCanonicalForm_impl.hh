@@ -1,11 +1,18 @@
 #ifndef CASM_HasCanonicalForm_impl
 #define CASM_HasCanonicalForm_impl
 
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+#include "casm/clex/ConfigFingerprint.hh"
 #include "casm/clex/HasCanonicalForm.hh"
+#include "casm/clex/OccupationCanonicalForm.hh"
 #include "casm/clex/ScelOrbitGeneration.hh"
 #include "casm/clex/Supercell.hh"
 #include "casm/crystallography/CanonicalForm.hh"
 #include "casm/crystallography/SymTools.hh"
+#include "casm/misc/parallel.hh"
 #include "casm/symmetry/InvariantSubgroup_impl.hh"
 #include "casm/symmetry/OrbitGeneration.hh"
 #include "casm/symmetry/PermuteIterator.hh"
@@ -191,7 +198,8 @@ std::vector<PermuteIterator> CanonicalForm<_Base>::invariant_subgroup(
 
 template <typename Base>
 bool ConfigCanonicalForm<Base>::is_sym_equivalent(const MostDerived &B) const {
-  return this->canonical_form() == B.canonical_form();
+  return is_sym_equivalent(B, derived().supercell().sym_info().permute_begin(),
+                           derived().supercell().sym_info().permute_end());
 }
 
 template <typename Base>
@@ -199,11 +207,9 @@ template <typename ConfigIterator>
 ConfigIterator ConfigCanonicalForm<Base>::find_sym_equivalent(
     const MostDerived &B, ConfigIterator obj_begin,
     ConfigIterator obj_end) const {
-  auto canon = this->canonical_form();
-  auto is_sym_equiv = [&](const MostDerived &test) {
-    return canon == test.canonical_form();
-  };
-  return std::find_if(obj_begin, obj_end, is_sym_equiv);
+  return find_sym_equivalent(obj_begin, obj_end,
+                             derived().supercell().sym_info().permute_begin(),
+                             derived().supercell().sym_info().permute_end());
 }
 
 template <typename Base>
@@ -238,30 +244,141 @@ std::vector<PermuteIterator> ConfigCanonicalForm<Base>::invariant_subgroup()
                             derived().supercell().sym_info().permute_end());
 }
 
+namespace ConfigCanonicalForm_impl {
+
+/// \brief True if [begin, end) is the full range of supercell permutations and
+/// the pruned occupation-only canonical form search may be used
+template <typename ConfigType, typename PermuteIteratorIt>
+bool use_occupation_search(ConfigType const &config, PermuteIteratorIt begin,
+                           PermuteIteratorIt end) {
+  if constexpr (std::is_same<PermuteIteratorIt, PermuteIterator>::value) {
+    auto const &sym_info = config.supercell().sym_info();
+    return begin == sym_info.permute_begin() &&
+           end == sym_info.permute_end() &&
+           is_occupation_only(config.configdof(), sym_info);
+  } else {
+    return false;
+  }
+}
+
+/// \brief Minimum number of permutations evaluated per thread
+///
+/// Smaller ranges are not split, because thread start-up would cost more than
+/// the comparisons saved.
+const Index min_permutations_per_thread = 256;
+
+/// \brief Split [begin, end) into contiguous blocks if it should be evaluated
+/// by more than one thread
+///
+/// \param n_threads Maximum number of threads, values < 1 use
+///     `default_canonical_form_n_threads()`. Set to the number of blocks.
+///
+/// \returns Block boundaries, `{begin, ..., end}`, or an empty vector if the
+///     range should be evaluated serially
+template <typename ConfigType, typename PermuteIteratorIt>
+std::vector<PermuteIteratorIt> make_permutation_blocks(
+    ConfigType const &config, PermuteIteratorIt begin, PermuteIteratorIt end,
+    Index &n_threads) {
+  std::vector<PermuteIteratorIt> boundaries;
+  if (n_threads < 1) {
+    n_threads = default_canonical_form_n_threads();
+  }
+  if (n_threads <= 1) {
+    return boundaries;
+  }
+  Index size = std::distance(begin, end);
+  n_threads = std::min(n_threads, size / min_permutations_per_thread);
+  if (n_threads <= 1) {
+    return boundaries;
+  }
+
+  boundaries.push_back(begin);
+  auto it = begin;
+  Index pos = 0;
+  for (Index b = 1; b < n_threads; ++b) {
+    Index next = (size * b) / n_threads;
+    for (; pos < next; ++pos) {
+      ++it;
+    }
+    boundaries.push_back(it);
+  }
+  boundaries.push_back(end);
+
+  // lazily constructed symmetry data must exist before sharing between threads
+  auto const &sym_info = config.supercell().sym_info();
+  sym_info.site_permutation_symrep();
+  sym_info.factor_group().get_multi_table();
+  sym_info.factor_group().get_alt_multi_table();
+  return boundaries;
+}
+
+/// \brief Call `f(block_index, block_begin, block_end)` for each block, each
+/// in a separate thread
+template <typename PermuteIteratorIt, typename F>
+void for_each_block(std::vector<PermuteIteratorIt> const &boundaries, F f) {
+  Index n_blocks = boundaries.size() - 1;
+  parallel_for(0, n_blocks, n_blocks, [&](Index thread_index, Index b) {
+    f(b, boundaries[b], boundaries[b + 1]);
+  });
+}
+
+}  // namespace ConfigCanonicalForm_impl
+
 template <typename Base>
 template <typename PermuteIteratorIt>
 bool ConfigCanonicalForm<Base>::is_canonical(PermuteIteratorIt begin,
                                              PermuteIteratorIt end) const {
+  if (ConfigCanonicalForm_impl::use_occupation_search(derived(), begin, end)) {
+    return occupation_is_canonical(derived().configdof().occupation(),
+                                   derived().supercell().sym_info());
+  }
   return std::none_of(begin, end, derived().less());
 }
 
 /// True if this and B have same canonical form
+///
+/// Configurations in different supercells, or with different symmetry
+/// fingerprints, are rejected before calculating canonical forms. The
+/// fingerprint is invariant under all supercell permutations, and therefore
+/// under any subgroup [begin, end).
 template <typename Base>
 template <typename PermuteIteratorIt>
 bool ConfigCanonicalForm<Base>::is_sym_equivalent(const MostDerived &B,
                                                   PermuteIteratorIt begin,
                                                   PermuteIteratorIt end) const {
+  if (derived().supercell() != B.supercell()) {
+    return false;
+  }
+  ConfigFingerprintCalculator const &fingerprint =
+      derived().supercell().fingerprint_calculator();
+  if (fingerprint(derived().configdof()) != fingerprint(B.configdof())) {
+    return false;
+  }
   return this->canonical_form(begin, end) == B.canonical_form(begin, end);
 }
 
+/// Find element that has the same canonical form
+///
+/// Elements in different supercells, or with different symmetry fingerprints,
+/// are rejected before calculating canonical forms.
 template <typename Base>
 template <typename ConfigIterator, typename PermuteIteratorIt>
 ConfigIterator ConfigCanonicalForm<Base>::find_sym_equivalent(
     ConfigIterator obj_begin, ConfigIterator obj_end, PermuteIteratorIt begin,
     PermuteIteratorIt end) const {
-  auto canon = this->canonical_form(begin, end);
+  ConfigFingerprintCalculator const &fingerprint =
+      derived().supercell().fingerprint_calculator();
+  std::uint64_t this_fingerprint = fingerprint(derived().configdof());
+  std::unique_ptr<MostDerived> canon;
   auto is_sym_equiv = [&](const MostDerived &test) {
-    return canon == test.canonical_form(begin, end);
+    if (derived().supercell() != test.supercell() ||
+        this_fingerprint != fingerprint(test.configdof())) {
+      return false;
+    }
+    if (!canon) {
+      canon.reset(new MostDerived(this->canonical_form(begin, end)));
+    }
+    return *canon == test.canonical_form(begin, end);
   };
   return std::find_if(obj_begin, obj_end, is_sym_equiv);
 }
@@ -274,51 +391,130 @@ ConfigCanonicalForm<Base>::canonical_form(PermuteIteratorIt begin,
   return copy_apply(to_canonical(begin, end), derived());
 }
 
+/// The first (lowest-index) permutation in [begin, end) that results in the
+/// canonical form
+///
+/// With more than one thread, each block finds its first maximal
+/// permutation, and blocks are reduced in order, keeping the earlier
+/// permutation on ties.
 template <typename Base>
 template <typename PermuteIteratorIt>
 PermuteIterator ConfigCanonicalForm<Base>::to_canonical(
-    PermuteIteratorIt begin, PermuteIteratorIt end) const {
-  return *std::max_element(begin, end, derived().less());
+    PermuteIteratorIt begin, PermuteIteratorIt end, Index n_threads) const {
+  if (ConfigCanonicalForm_impl::use_occupation_search(derived(), begin, end)) {
+    return occupation_to_canonical(derived().configdof().occupation(),
+                                   derived().supercell().sym_info());
+  }
+  auto blocks = ConfigCanonicalForm_impl::make_permutation_blocks(
+      derived(), begin, end, n_threads);
+  if (blocks.empty()) {
+    return *std::max_element(begin, end, derived().less());
+  }
+
+  std::vector<PermuteIterator> block_max(n_threads);
+  ConfigCanonicalForm_impl::for_each_block(
+      blocks, [&](Index b, PermuteIteratorIt block_begin,
+                  PermuteIteratorIt block_end) {
+        block_max[b] = *std::max_element(block_begin, block_end,
+                                         derived().less());
+      });
+
+  auto less = derived().less();
+  PermuteIterator result = block_max[0];
+  for (Index b = 1; b < n_threads; ++b) {
+    if (less(result, block_max[b])) {
+      result = block_max[b];
+    }
+  }
+  return result;
 }
 
+/// The lowest-index permutation that transforms the canonical form to this
+///
+/// With more than one thread, each block finds its maximal permutations and
+/// the lowest-index inverse among them; block results are then reduced the
+/// same way.
 template <typename Base>
 template <typename PermuteIteratorIt>
 PermuteIterator ConfigCanonicalForm<Base>::from_canonical(
-    PermuteIteratorIt begin, PermuteIteratorIt end) const {
+    PermuteIteratorIt begin, PermuteIteratorIt end, Index n_threads) const {
   // simplest version: use the inverse of the first element that results in the
   // canonical form return to_canonical(begin, end).inverse();
 
   // alternate version: the lowest index element that transforms canonical form
   // to this
-  auto less = derived().less();
-  auto _to_canonical = begin;
-  auto _from_canonical = _to_canonical.inverse();
-  for (auto it = begin; it < end; ++it) {
-    if (less(_to_canonical, it)) {
-      _to_canonical = it;
-      _from_canonical = _to_canonical.inverse();
-    }
-    // other permutations that result in canonical config may have a lower index
-    // inverse
-    else if (!less(it, _to_canonical)) {
-      auto it_inv = it.inverse();
-      if (it_inv < _from_canonical) {
-        _from_canonical = it_inv;
+  auto search = [&](auto const &less, auto search_begin, auto search_end) {
+    PermuteIterator _to_canonical = *search_begin;
+    PermuteIterator _from_canonical = _to_canonical.inverse();
+    for (auto it = search_begin; it != search_end; ++it) {
+      if (less(_to_canonical, *it)) {
+        _to_canonical = *it;
+        _from_canonical = _to_canonical.inverse();
+      }
+      // other permutations that result in canonical config may have a lower
+      // index inverse
+      else if (!less(*it, _to_canonical)) {
+        auto it_inv = it->inverse();
+        if (it_inv < _from_canonical) {
+          _from_canonical = it_inv;
+        }
       }
     }
+    return std::make_pair(_to_canonical, _from_canonical);
+  };
+
+  auto blocks = ConfigCanonicalForm_impl::make_permutation_blocks(
+      derived(), begin, end, n_threads);
+  if (blocks.empty()) {
+    return search(derived().less(), begin, end).second;
   }
-  return _from_canonical;
+
+  std::vector<std::pair<PermuteIterator, PermuteIterator>> block_result(
+      n_threads);
+  ConfigCanonicalForm_impl::for_each_block(
+      blocks, [&](Index b, PermuteIteratorIt block_begin,
+                  PermuteIteratorIt block_end) {
+        block_result[b] = search(derived().less(), block_begin, block_end);
+      });
+
+  auto less = derived().less();
+  auto result = block_result[0];
+  for (Index b = 1; b < n_threads; ++b) {
+    if (less(result.first, block_result[b].first)) {
+      result = block_result[b];
+    } else if (!less(block_result[b].first, result.first) &&
+               block_result[b].second < result.second) {
+      result.second = block_result[b].second;
+    }
+  }
+  return result.second;
 }
 
+/// The permutations in [begin, end) that leave this unchanged, in range order
 template <typename Base>
 template <typename PermuteIteratorIt>
 std::vector<PermuteIterator> ConfigCanonicalForm<Base>::invariant_subgroup(
-    PermuteIteratorIt begin, PermuteIteratorIt end) const {
-  // std::cout << "INSIDE invariant_subgroup()" << std::endl;
+    PermuteIteratorIt begin, PermuteIteratorIt end, Index n_threads) const {
   std::vector<PermuteIterator> sub_grp;
-  // std::cout << "begin: " << begin->factor_group_index() << std::endl;
-  std::copy_if(begin, end, std::back_inserter(sub_grp), derived().equal_to());
-  // std::cout << "Complete!\n";
+  auto blocks = ConfigCanonicalForm_impl::make_permutation_blocks(
+      derived(), begin, end, n_threads);
+  if (blocks.empty()) {
+    std::copy_if(begin, end, std::back_inserter(sub_grp),
+                 derived().equal_to());
+    return sub_grp;
+  }
+
+  std::vector<std::vector<PermuteIterator>> block_sub_grp(n_threads);
+  ConfigCanonicalForm_impl::for_each_block(
+      blocks, [&](Index b, PermuteIteratorIt block_begin,
+                  PermuteIteratorIt block_end) {
+        std::copy_if(block_begin, block_end,
+                     std::back_inserter(block_sub_grp[b]),
+                     derived().equal_to());
+      });
+  for (auto const &block : block_sub_grp) {
+    sub_grp.insert(sub_grp.end(), block.begin(), block.end());
+  }
   return sub_grp;
 }
 
@@ -0,0 +1,36 @@
+#ifndef CASM_OccupationCanonicalForm
+#define CASM_OccupationCanonicalForm
+
+#include "casm/global/definitions.hh"
+#include "casm/global/eigen.hh"
+
+namespace CASM {
+
+class ConfigDoF;
+class PermuteIterator;
+class SupercellSymInfo;
+
+/** \ingroup Configuration
+ *  @{
+ */
+
+/// \brief True if Configuration comparison reduces to lexicographic
+/// comparison of isotropic occupation values
+bool is_occupation_only(ConfigDoF const &configdof,
+                        SupercellSymInfo const &sym_info);
+
+/// \brief Return the first PermuteIterator, in the order
+/// [permute_begin(), permute_end()), that transforms an occupation vector to
+/// its canonical (lexicographically maximal) form
+PermuteIterator occupation_to_canonical(Eigen::VectorXi const &occupation,
+                                        SupercellSymInfo const &sym_info);
+
+/// \brief True if no PermuteIterator in [permute_begin(), permute_end())
+/// transforms an occupation vector to a lexicographically greater vector
+bool occupation_is_canonical(Eigen::VectorXi const &occupation,
+                             SupercellSymInfo const &sym_info);
+
+/** @} */
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef CASM_OccupationOrbitCount
+#define CASM_OccupationOrbitCount
+
+#include <boost/multiprecision/cpp_int.hpp>
+
+#include "casm/global/definitions.hh"
+#include "casm/global/eigen.hh"
+
+namespace CASM {
+
+class SupercellSymInfo;
+
+/** \ingroup Configuration
+ *  @{
+ */
+
+/// \brief Number of occupation vectors, the product of the number of
+/// allowed occupants on each site
+boost::multiprecision::cpp_int count_occupations(
+    Eigen::VectorXi const &max_allowed_occupation);
+
+/// \brief Number of distinct occupations, under the supercell symmetry
+/// group, counted with Burnside's lemma
+boost::multiprecision::cpp_int count_occupation_orbits(
+    SupercellSymInfo const &sym_info,
+    Eigen::VectorXi const &max_allowed_occupation);
+
+/// \brief Number of distinct primitive occupations, under the supercell
+/// symmetry group
+boost::multiprecision::cpp_int count_primitive_occupation_orbits(
+    SupercellSymInfo const &sym_info,
+    Eigen::VectorXi const &max_allowed_occupation);
+
+/** @} */
+}  // namespace CASM
+
+#endif
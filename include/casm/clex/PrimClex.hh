@@ -21,6 +21,8 @@ class Clexulator;
 class ECIContainer;
 struct NeighborhoodInfo;
 class Structure;
+class SupercellSymCache;
+class CorrelationCache;
 
 namespace DB {
 template <typename T>
@@ -130,6 +132,10 @@ class PrimClex {
   /// Access to the primitive neighbor list
   PrimNeighborList &nlist() const;
 
+  /// Access the on-disk cache of supercell symmetry data, or nullptr if not
+  /// used
+  SupercellSymCache const *supercell_sym_cache() const;
+
   /// returns true if vacancy are an allowed species
   bool vacancy_allowed() const;
 
@@ -171,6 +177,14 @@ class PrimClex {
   std::vector<Clexulator> local_clexulator(
       std::string const &basis_set_name) const;
 
+  /// Access the on-disk cache of correlations for a basis set, or nullptr if
+  /// not used
+  std::shared_ptr<CorrelationCache> correlation_cache(
+      std::string const &basis_set_name) const;
+
+  /// Names of the basis sets with a correlation cache that has been accessed
+  std::vector<std::string> correlation_cache_basis_sets() const;
+
   bool has_eci(const ClexDescription &key) const;
   ECIContainer const &eci(const ClexDescription &key) const;
 
@@ -1,6 +1,10 @@
 #ifndef CASM_Supercell
 #define CASM_Supercell
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+
 #include "casm/clex/HasCanonicalForm.hh"
 #include "casm/clex/HasPrimClex.hh"
 #include "casm/clex/SupercellTraits.hh"
@@ -34,9 +38,11 @@ using clexulator::SuperNeighborList;
 template <typename T, typename U>
 class ConfigIterator;
 class PermuteIterator;
+class ConfigFingerprintCalculator;
 class PrimClex;
 class Clexulator;
 class Structure;
+class SupercellLRU;
 
 namespace DB {
 template <typename T>
@@ -51,6 +57,17 @@ class DatabaseIterator;
 
 /// \brief Represents a supercell of the primitive parent crystal structure
 ///
+/// The SupercellSymInfo and SuperNeighborList are constructed on first use,
+/// so that a Supercell that is only named, compared, or used for its lattice
+/// is inexpensive. Lazy construction is thread-safe.
+///
+/// If the Supercell is registered with a SupercellLRU (see `set_lru`), they
+/// may be released when not recently used, and are then re-constructed on
+/// next use. They are only released by explicit calls to
+/// `SupercellLRU::shrink` (for the supercell database,
+/// `Database<Supercell>::shrink_resident`), never by the accessors, and never
+/// while pinned by a SupercellPin.
+///
 class Supercell
     : public DB::Named<
           Comparisons<SupercellCanonicalForm<CRTPBase<Supercell>>>> {
@@ -61,6 +78,8 @@ class Supercell
 
   Supercell(const Supercell &RHS);
 
+  Supercell &operator=(const Supercell &RHS);
+
   Supercell(std::shared_ptr<Structure const> const &_shared_prim,
             const Lattice &superlattice);
   Supercell(std::shared_ptr<Structure const> const &_shared_prim,
@@ -144,6 +163,24 @@ class Supercell
   // SymInfo object of this supercell
   const SupercellSymInfo &sym_info() const;
 
+  /// \brief Shared ownership of the SupercellSymInfo, which keeps it from
+  /// being released
+  std::shared_ptr<SupercellSymInfo const> shared_sym_info() const;
+
+  /// \brief Shared ownership of the SuperNeighborList, which keeps it from
+  /// being released
+  std::shared_ptr<SuperNeighborList const> shared_nlist() const;
+
+  /// \brief True if the SupercellSymInfo is currently constructed
+  bool has_sym_info() const;
+
+  /// \brief Calculates symmetry fingerprints of Configuration in this
+  /// Supercell, constructed on first use
+  ConfigFingerprintCalculator const &fingerprint_calculator() const;
+
+  /// \brief Register with a SupercellLRU, or nullptr to unregister
+  void set_lru(SupercellLRU *lru) const;
+
   bool operator<(const Supercell &B) const;
 
   /// \brief Insert the canonical form of this into the database
@@ -152,6 +189,7 @@ class Supercell
  private:
   friend Comparisons<SupercellCanonicalForm<CRTPBase<Supercell>>>;
   friend DB::Named<Comparisons<SupercellCanonicalForm<CRTPBase<Supercell>>>>;
+  friend SupercellLRU;
 
   bool eq_impl(const Supercell &B) const;
 
@@ -159,6 +197,16 @@ class Supercell
 
   std::string generate_name_impl() const;
 
+  /// Release the SupercellSymInfo and SuperNeighborList, to be
+  /// re-constructed on next use
+  void _release() const;
+
+  /// True if the SupercellSymInfo or SuperNeighborList are shared
+  bool _is_pinned() const;
+
+  /// Notify m_lru of use
+  void _mark_used() const;
+
   // Note:
   // - Prefer not to access PrimClex via Supercell. In future, PrimClex access
   // via Supercell will
@@ -172,15 +220,44 @@ class Supercell
 
   std::shared_ptr<Structure const> m_shared_prim;
 
-  SupercellSymInfo m_sym_info;
+  /// Couples the prim lattice to the supercell lattice
+  xtal::Superlattice m_superlattice;
+
+  /// Guards lazy construction and release of m_sym_info, m_nlist, and
+  /// m_fingerprint_calculator
+  mutable std::mutex m_lazy_mutex;
+
+  /// SupercellSymInfo, mutable for lazy construction
+  mutable std::shared_ptr<SupercellSymInfo> m_sym_info;
+
+  /// Equal to m_sym_info.get(), for access without locking
+  mutable std::atomic<SupercellSymInfo const *> m_sym_info_ptr;
 
   /// SuperNeighborList, mutable for lazy construction
-  mutable notstd::cloneable_ptr<SuperNeighborList> m_nlist;
+  mutable std::shared_ptr<SuperNeighborList> m_nlist;
+
+  /// Equal to m_nlist.get(), for access without locking
+  mutable std::atomic<SuperNeighborList const *> m_nlist_ptr;
 
   /// Store size of PrimNeighborList at time of construction of
   /// SuperNeighborList to enable checking if SuperNeighborList should be
   /// re-constructed
-  mutable Index m_nlist_size_at_construction;
+  mutable std::atomic<Index> m_nlist_size_at_construction;
+
+  /// If not nullptr, notified when the SupercellSymInfo or SuperNeighborList
+  /// are used
+  mutable SupercellLRU *m_lru;
+
+  /// Value of `m_lru->tick()` at last use
+  mutable std::atomic<Index> m_last_use;
+
+  /// ConfigFingerprintCalculator, mutable for lazy construction
+  mutable std::unique_ptr<ConfigFingerprintCalculator const>
+      m_fingerprint_calculator;
+
+  /// Equal to m_fingerprint_calculator.get(), for access without locking
+  mutable std::atomic<ConfigFingerprintCalculator const *>
+      m_fingerprint_calculator_ptr;
 };
 
 /// Make the supercell name from a Superlattice
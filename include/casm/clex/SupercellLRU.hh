@@ -0,0 +1,117 @@
+#ifndef CASM_SupercellLRU
+#define CASM_SupercellLRU
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+
+#include "casm/global/definitions.hh"
+
+namespace CASM {
+
+class Supercell;
+class SupercellSymInfo;
+namespace clexulator {
+class SuperNeighborList;
+}
+using clexulator::SuperNeighborList;
+
+/** \ingroup Supercell
+ *  @{
+ */
+
+/// \brief Limits how many Supercell keep their symmetry information and
+/// neighbor list constructed
+///
+/// Supercell construct their SupercellSymInfo and SuperNeighborList lazily,
+/// on first use. A Supercell that is registered with a SupercellLRU (see
+/// `Supercell::set_lru`) is "resident" while these are constructed. When
+/// `shrink()` is called and more than `capacity()` registered Supercell are
+/// resident, the least recently used that are not pinned have their
+/// SupercellSymInfo and SuperNeighborList released, to be re-constructed on
+/// next use.
+///
+/// Notes:
+/// - The supercell database registers its Supercell with its SupercellLRU,
+///   so that for projects with many supercells only those in use are
+///   resident. The capacity is unlimited by default, see
+///   `default_supercell_lru_capacity`.
+/// - Supercell are only released by `shrink()` and `set_capacity()`, which
+///   must be called at points where no other thread is using registered
+///   Supercell. Accessing a Supercell never releases another.
+/// - A Supercell is pinned, and not released, while its SupercellSymInfo or
+///   SuperNeighborList is shared, i.e. by a SupercellPin. References obtained
+///   from `Supercell::sym_info()`, `Supercell::factor_group()` or
+///   `Supercell::nlist()`, and PermuteIterator, that are held across calls to
+///   `shrink()` must be protected by a SupercellPin.
+class SupercellLRU {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param capacity Maximum number of resident Supercell. Values < 1 are
+  ///     unlimited.
+  explicit SupercellLRU(Index capacity = 0);
+
+  SupercellLRU(SupercellLRU const &) = delete;
+  SupercellLRU &operator=(SupercellLRU const &) = delete;
+
+  /// \brief Maximum number of resident Supercell, values < 1 are unlimited
+  Index capacity() const { return m_capacity; }
+
+  /// \brief Set maximum number of resident Supercell, and `shrink()`
+  void set_capacity(Index capacity);
+
+  /// \brief Number of resident Supercell
+  Index size() const;
+
+  /// \brief Release the least recently used, not pinned, Supercell until
+  /// within capacity
+  Index shrink();
+
+  /// \brief Add a Supercell, which has just constructed its
+  /// SupercellSymInfo or SuperNeighborList, to the resident Supercell
+  void insert(Supercell const &scel);
+
+  /// \brief Remove a Supercell, without releasing it
+  void erase(Supercell const &scel);
+
+  /// \brief Increment and return the use counter
+  Index tick() { return m_clock.fetch_add(1, std::memory_order_relaxed) + 1; }
+
+ private:
+  mutable std::mutex m_mutex;
+
+  std::atomic<Index> m_capacity;
+
+  /// Use counter, Supercell store its value when used
+  std::atomic<Index> m_clock;
+
+  // resident Supercell
+  std::unordered_set<Supercell const *> m_resident;
+};
+
+/// \brief Keeps the SupercellSymInfo (and optionally the SuperNeighborList)
+/// of a Supercell from being released while in scope
+///
+/// Use when holding references obtained from `Supercell::sym_info()`,
+/// `Supercell::factor_group()` or `Supercell::nlist()`, or PermuteIterator,
+/// across points where `SupercellLRU::shrink` may be called. Pin once per
+/// loop or batch, rather than per object, to avoid contention on the shared
+/// reference count.
+class SupercellPin {
+ public:
+  explicit SupercellPin(Supercell const &scel, bool include_nlist = false);
+
+ private:
+  std::shared_ptr<SupercellSymInfo const> m_sym_info;
+  std::shared_ptr<SuperNeighborList const> m_nlist;
+};
+
+/// \brief Default SupercellLRU capacity for the supercell database
+Index default_supercell_lru_capacity();
+
+/** @} */
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef CASM_SupercellSymCache
+#define CASM_SupercellSymCache
+
+#include <boost/filesystem/path.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "casm/global/definitions.hh"
+#include "casm/global/eigen.hh"
+
+namespace CASM {
+
+class SupercellSymInfo;
+
+namespace clexulator {
+class PrimNeighborList;
+class SuperNeighborList;
+}  // namespace clexulator
+
+/** \ingroup Supercell
+ *  @{
+ */
+
+/// \brief On-disk cache of supercell symmetry data that is expensive to
+/// re-generate each run
+///
+/// For each supercell, identified by its transformation matrix, T, the cache
+/// stores:
+/// - the site permutations of the supercell factor group operations and
+///   translations (a Layout::factored SupercellPermutationTable), in
+///   "<dir>/T_<T00>_<T01>_..._<T22>.sym", and
+/// - the supercell neighbor list, in "<dir>/T_<T00>_<T01>_..._<T22>.nlist".
+///
+/// Files are stored in a sub-directory of `cache_dir` named by the hash of
+/// the prim, so changing the prim invalidates all entries. Each file also has
+/// a header that is checked on load (T, table sizes, the prim factor group
+/// indices of the supercell factor group operations, and for neighbor lists,
+/// a hash of the PrimNeighborList), so that stale or incomplete files are
+/// ignored and re-generated rather than used. Files are written to a
+/// temporary file and renamed into place, so concurrent readers never see
+/// partial files.
+///
+/// Permutation files are memory-mapped read-only on load and used directly
+/// by SupercellSymInfo without copying. Data is stored in native byte order,
+/// so cache directories should not be shared between machines with different
+/// architectures.
+///
+/// The cache is an optimization only: failure to read or write cache files
+/// is not an error, the data is re-calculated instead.
+class SupercellSymCache {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param cache_dir Cache root directory. Need not exist.
+  /// \param prim_hash Hash identifying the prim, see `prim_file_hash`
+  SupercellSymCache(fs::path cache_dir, std::uint64_t prim_hash);
+
+  /// \brief Cache root directory
+  fs::path const &cache_dir() const { return m_cache_dir; }
+
+  /// \brief Prim hash
+  std::uint64_t prim_hash() const { return m_prim_hash; }
+
+  /// \brief Directory containing files for this prim
+  fs::path dir() const;
+
+  /// \brief Path to the site permutations file for a supercell
+  fs::path sym_path(Eigen::Matrix3l const &T) const;
+
+  /// \brief Path to the neighbor list file for a supercell
+  fs::path nlist_path(Eigen::Matrix3l const &T) const;
+
+  /// \brief Set SupercellSymInfo permutations from the cache, if present and
+  /// valid
+  bool load(SupercellSymInfo const &sym_info) const;
+
+  /// \brief Save SupercellSymInfo permutations to the cache, if not already
+  /// present
+  bool save(SupercellSymInfo const &sym_info) const;
+
+  /// \brief Read a SuperNeighborList from the cache, if present and valid
+  std::unique_ptr<clexulator::SuperNeighborList> load_nlist(
+      Eigen::Matrix3l const &T,
+      clexulator::PrimNeighborList const &prim_nlist) const;
+
+  /// \brief Save a SuperNeighborList to the cache
+  bool save_nlist(Eigen::Matrix3l const &T,
+                  clexulator::PrimNeighborList const &prim_nlist,
+                  clexulator::SuperNeighborList const &nlist) const;
+
+  /// \brief Remove cache files for other prim
+  void remove_stale() const;
+
+ private:
+  fs::path m_cache_dir;
+
+  std::uint64_t m_prim_hash;
+};
+
+/// \brief Hash of the contents of a prim file, for use as a SupercellSymCache
+/// key
+std::uint64_t prim_file_hash(fs::path const &prim_path);
+
+/// \brief Hash of the PrimNeighborList parameters and current neighborhood
+std::uint64_t neighbor_list_hash(
+    clexulator::PrimNeighborList const &prim_nlist);
+
+/// \brief Return true if the supercell symmetry cache should be used
+bool supercell_sym_cache_enabled();
+
+/** @} */
+}  // namespace CASM
+
+#endif
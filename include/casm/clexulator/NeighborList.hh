@@ -189,6 +189,13 @@ class SuperNeighborList {
   SuperNeighborList(Eigen::Matrix3l const &transformation_matrix_to_super,
                     PrimNeighborList const &prim_nlist);
 
+  /// Construct from previously calculated data (i.e. read from a cache)
+  SuperNeighborList(size_type prim_grid_size,
+                    std::vector<std::vector<size_type> > site,
+                    std::vector<std::vector<size_type> > unitcell,
+                    std::vector<int> site_index_to_neighbor_index,
+                    bool overlaps);
+
   // --- Keep inlined functions inline for most efficient use  ---
 
   size_type n_unitcells() const { return m_prim_grid_size; }
@@ -0,0 +1,69 @@
+#ifndef CASM_xtal_SiteLookup
+#define CASM_xtal_SiteLookup
+
+#include <unordered_map>
+#include <vector>
+
+#include "casm/global/definitions.hh"
+#include "casm/global/eigen.hh"
+
+namespace CASM {
+namespace xtal {
+class Lattice;
+class Site;
+
+/// \brief Fast repeated `find_index(basis, test_site, tol)` lookups
+///
+/// Sites are binned by fractional coordinates on a periodic grid whose cells
+/// are at least as wide as the largest fractional displacement allowed by
+/// `tol`, so all sites that could be within `tol` of a test site are in the
+/// 27 cells around it. Each lookup checks only those candidates, with the
+/// same comparison (`compare_type` and `min_dist < tol`) as `find_index`, and
+/// returns the lowest passing index, so results are identical to
+/// `find_index`.
+///
+/// The `basis` vector is held by reference and must outlive the SiteLookup.
+/// Sites added to it after construction are only found if added with
+/// `insert`.
+class SiteLookup {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param basis Sites to look up. All must have `lattice` as their home
+  ///     lattice.
+  /// \param lattice Lattice used for periodic distances
+  /// \param tol Distance tolerance (in Angstr.), as for `find_index`
+  SiteLookup(std::vector<Site> const &basis, Lattice const &lattice,
+             double tol);
+
+  /// \brief Add `basis[basis_index]` to the lookup
+  void insert(Index basis_index);
+
+  /// \brief Equivalent to `find_index(basis, test_site, tol)`
+  Index find_index(Site const &test_site) const;
+
+ private:
+  typedef long key_type;
+
+  /// Grid cell of a Cartesian position
+  Eigen::Vector3l _cell(Eigen::Vector3d const &cart) const;
+
+  key_type _key(Eigen::Vector3l const &cell) const;
+
+  std::vector<Site> const *m_basis;
+
+  Lattice const *m_lattice;
+
+  double m_tol;
+
+  /// Number of grid cells along each lattice vector
+  Eigen::Vector3l m_n_cells;
+
+  /// Basis indices, in increasing order, by grid cell
+  std::unordered_map<key_type, std::vector<Index>> m_bins;
+};
+
+}  // namespace xtal
+}  // namespace CASM
+
+#endif
@@ -141,6 +141,11 @@ class SupercellSymInfo;
 SupercellSymInfo make_supercell_sym_info(Structure const &prim,
                                          Lattice const &super_lattice);
 
+/// Construct SupercellSymInfo on the heap (SupercellSymInfo holds handles to
+/// its own members, so it should not be copied or moved after construction)
+std::unique_ptr<SupercellSymInfo> make_unique_supercell_sym_info(
+    Structure const &prim, Lattice const &super_lattice);
+
 /** @} */
 }  // namespace CASM
 
@@ -1,6 +1,9 @@
 #ifndef CASM_ConfigDatabase
 #define CASM_ConfigDatabase
 
+#include <map>
+#include <string>
+
 #include "casm/clex/Configuration.hh"
 #include "casm/database/Database.hh"
 
@@ -52,6 +55,20 @@ class Database<Configuration> : public ValDatabase<Configuration> {
 
   /// Number of Configuration in a particular supercell
   Index scel_range_size(const std::string &scelname) const;
+
+  /// Configuration renamed by the last commit, old name -> new name
+  ///
+  /// When a commit is merged with changes committed by another process, a
+  /// Configuration inserted by this process that is equivalent to one
+  /// inserted by the other process is not inserted again, and takes the name
+  /// of the other. Properties and selections using the old name should be
+  /// updated (see `PropertiesDatabase::rename_to`).
+  std::map<std::string, std::string> const &renamed_on_commit() const {
+    return m_renamed_on_commit;
+  }
+
+ protected:
+  std::map<std::string, std::string> m_renamed_on_commit;
 };
 
 }  // namespace DB
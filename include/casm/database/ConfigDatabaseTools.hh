@@ -1,6 +1,8 @@
 #ifndef CASM_ConfigDatabaseTools
 #define CASM_ConfigDatabaseTools
 
+#include <vector>
+
 #include "casm/database/ConfigDatabase.hh"
 #include "casm/database/ScelDatabase.hh"
 
@@ -40,6 +42,14 @@ ConfigInsertResult make_canonical_and_insert(
     Configuration const &configuration, Database<Supercell> &supercell_db,
     Database<Configuration> &configuration_db, bool primitive_only);
 
+/// Insert a batch of configurations (in primitive & canonical form) in the
+/// database
+std::vector<ConfigInsertResult> make_canonical_and_insert(
+    std::vector<Configuration> const &configurations,
+    Database<Supercell> &supercell_db,
+    Database<Configuration> &configuration_db, bool primitive_only,
+    Index n_threads = 0);
+
 /// Insert this configuration (in primitive & canonical form) in the database
 ///
 /// - This version checks `is_guaranteed_for_database_insert(enumerator)` and
@@ -50,6 +60,31 @@ ConfigInsertResult make_canonical_and_insert(
     EnumeratorType const &enumerator, Configuration const &configuration,
     Database<Supercell> &supercell_db,
     Database<Configuration> &configuration_db, bool primitive_only);
+
+/// Insert a batch of configurations (in primitive & canonical form) in the
+/// database
+///
+/// - This version checks `is_guaranteed_for_database_insert(enumerator)` and
+/// either inserts
+///   directly or makes canonical and then inserts
+template <typename EnumeratorType>
+std::vector<ConfigInsertResult> make_canonical_and_insert(
+    EnumeratorType const &enumerator,
+    std::vector<Configuration> const &configurations,
+    Database<Supercell> &supercell_db,
+    Database<Configuration> &configuration_db, bool primitive_only,
+    Index n_threads = 0);
+
+/// Hash of supercell name and occupation
+std::size_t config_hash(Configuration const &config);
+
+/// Maximum number of Configuration with equal `config_hash` that are compared
+/// one by one
+///
+/// Configuration that differ only in continuous DoF values have equal
+/// `config_hash`, so beyond this number they should be found by ordered
+/// comparison instead.
+Index const config_hash_max_compare = 8;
 }  // namespace DB
 }  // namespace CASM
 
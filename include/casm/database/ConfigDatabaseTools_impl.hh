@@ -31,6 +31,30 @@ ConfigInsertResult make_canonical_and_insert(
                                      configuration_db, primitive_only);
   }
 }
+
+/// Insert a batch of configurations (in primitive & canonical form) in the
+/// database
+template <typename EnumeratorType>
+std::vector<ConfigInsertResult> make_canonical_and_insert(
+    EnumeratorType const &enumerator,
+    std::vector<Configuration> const &configurations,
+    Database<Supercell> &supercell_db,
+    Database<Configuration> &configuration_db, bool primitive_only,
+    Index n_threads) {
+  if (is_guaranteed_for_database_insert(enumerator)) {
+    std::vector<ConfigInsertResult> results;
+    for (Configuration const &configuration : configurations) {
+      results.push_back(make_canonical_and_insert(
+          enumerator, configuration, supercell_db, configuration_db,
+          primitive_only));
+    }
+    return results;
+  } else {
+    return make_canonical_and_insert(configurations, supercell_db,
+                                     configuration_db, primitive_only,
+                                     n_threads);
+  }
+}
 }  // namespace DB
 }  // namespace CASM
 
@@ -0,0 +1,65 @@
+#ifndef CASM_ConfigIdReservation
+#define CASM_ConfigIdReservation
+
+#include <map>
+#include <string>
+
+#include "casm/global/definitions.hh"
+
+namespace CASM {
+class PrimClex;
+
+namespace DB {
+
+/// Reserves Configuration ids, shared between processes
+///
+/// A Configuration database gives each new Configuration the next id from a
+/// block of ids reserved by this process in the file
+/// ".casm/config_id_reserved.json". Processes writing to the same project
+/// concurrently reserve disjoint blocks, so a Configuration keeps the name it
+/// is given on insert when the database is committed and merged with changes
+/// by other processes. Files copied to its training data directory, and
+/// properties inserted for it, can therefore use its name before commit.
+///
+/// - Reserving takes an exclusive lock on the project databases (see
+///   DatabaseHandler::lock), so ids are reserved in blocks of `block_size`
+/// - Ids reserved but not used are released on `release()` if no other
+///   process has reserved ids since, so that a single process assigns
+///   consecutive ids
+/// - Without a project root directory, ids are not reserved
+class ConfigIdReservation {
+ public:
+  /// Number of ids reserved at once
+  static const Index block_size;
+
+  explicit ConfigIdReservation(PrimClex const &_primclex);
+
+  ConfigIdReservation(ConfigIdReservation const &) = delete;
+  ConfigIdReservation &operator=(ConfigIdReservation const &) = delete;
+
+  /// Releases reserved ids that were not used
+  ~ConfigIdReservation();
+
+  /// \brief Return an id for a new Configuration in a supercell
+  Index next(std::string const &scelname, Index next_id);
+
+  /// \brief Release reserved ids that were not used
+  void release();
+
+ private:
+  /// Read the reservation file
+  std::map<std::string, Index> _read() const;
+
+  /// Write the reservation file
+  void _write(std::map<std::string, Index> const &reserved) const;
+
+  PrimClex const *m_primclex;
+
+  // scelname -> [next id to use, end of reserved block)
+  std::map<std::string, std::pair<Index, Index> > m_blocks;
+};
+
+}  // namespace DB
+}  // namespace CASM
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef CASM_DB_ConfigImport
 #define CASM_DB_ConfigImport
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -37,6 +38,12 @@ class StructureMap<Configuration> {
   StructureMap<Configuration>(ConfigMapping::Settings const &_set,
                               const PrimClex &_primclex);
 
+  /// Construct with the same settings, but a separate ConfigMapper, so that
+  /// the copy may map structures in another thread
+  StructureMap<Configuration>(StructureMap<Configuration> const &other);
+
+  ~StructureMap<Configuration>();
+
   typedef std::back_insert_iterator<std::vector<ConfigIO::Result> >
       map_result_inserter;
 
@@ -61,13 +68,46 @@ class StructureMap<Configuration> {
                           std::unique_ptr<Configuration> const &hint_config,
                           map_result_inserter result) const;
 
+  /// \brief Map many structures, using multiple threads
+  ///
+  /// \param paths Paths to structure or properties.calc.json files
+  /// \param hints 'from' configs, one per path (may be nullptr), or empty if
+  /// unknown as with 'casm import'
+  /// \param req_properties As for `map`
+  /// \param n_threads Maximum number of threads mapping structures. Values < 1
+  /// use `default_n_threads()`.
+  /// \param f Called as `f(i, results)`, with the results of mapping
+  /// `paths[i]`, in order of i, in the calling thread
+  ///
+  /// Each thread maps structures with its own ConfigMapper. Database insertion
+  /// is done in the calling thread, in order of i, so results do not depend on
+  /// the number of threads.
+  void map_all(std::vector<fs::path> const &paths,
+               std::vector<std::unique_ptr<Configuration> > const &hints,
+               std::vector<std::string> const &req_properties, Index n_threads,
+               std::function<void(Index, std::vector<ConfigIO::Result> &)> f)
+      const;
+
   /// Returns settings used for mapping
   const ConfigMapping::Settings &settings() const;
 
  private:
+  /// Result of mapping one structure, before database insertion
+  struct Mapped;
+
   /// \brief Read SimpleStructure to be imported
   SimpleStructure _make_structure(const fs::path &p) const;
 
+  /// \brief Read and map a structure, without modifying the database
+  void _map_structure(fs::path const &p, Configuration const *hint_config,
+                      Mapped &mapped) const;
+
+  /// \brief Insert mapped configurations in the database and output results
+  map_result_inserter _insert(Mapped const &mapped,
+                              std::vector<std::string> const &req_properties,
+                              Configuration const *hint_config,
+                              map_result_inserter result) const;
+
   PrimClex const *m_primclex_ptr;
   std::unique_ptr<ConfigMapper> m_configmapper;
 };
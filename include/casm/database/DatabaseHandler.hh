@@ -6,6 +6,8 @@
 #include <string>
 #include <utility>
 
+#include "casm/database/DatabaseLock.hh"
+
 namespace CASM {
 
 class PrimClex;
@@ -25,6 +27,8 @@ class PropertiesDatabase;
 /// - Lazy initialization
 /// - Does not do any checks on the operations of the databases, just
 ///   provides access
+/// - Provides a reader/writer lock, shared between processes, that database
+///   implementations hold while reading from and writing to the project
 class DatabaseHandler {
  public:
   /// Constructor
@@ -76,6 +80,9 @@ class DatabaseHandler {
   /// Close all databases
   void close();
 
+  /// Lock the project databases, shared for reading or exclusive for writing
+  DatabaseLock lock(DatabaseLock::Mode mode) const;
+
   /// Insert a Database
   template <typename T>
   void insert(std::string db_name, std::unique_ptr<DatabaseBase> &&value);
@@ -183,6 +190,10 @@ class DatabaseHandler {
   // PropDBKey -> db_props
   // mutable for lazy initialization
   mutable props_map_type m_db_props;
+
+  // lock file shared by all databases, or nullptr if no project directory
+  // mutable for lazy initialization
+  mutable std::unique_ptr<DatabaseLockFile> m_lock_file;
 };
 
 }  // namespace DB
@@ -0,0 +1,91 @@
+#ifndef CASM_DatabaseLock
+#define CASM_DatabaseLock
+
+#include <boost/filesystem/path.hpp>
+#include <string>
+#include <vector>
+
+#include "casm/global/definitions.hh"
+
+namespace CASM {
+namespace DB {
+
+/// Reader/writer lock on a file, shared between processes
+///
+/// - Uses flock(2), so that locks are released if a process exits
+/// - Locks are nested within one DatabaseLockFile: a shared lock requested
+///   while an exclusive lock is held does not change the lock, and an
+///   exclusive lock requested while only a shared lock is held upgrades it
+///   until released. Upgrading is not atomic, so data read under the shared
+///   lock must be checked again under the exclusive lock.
+class DatabaseLockFile {
+ public:
+  explicit DatabaseLockFile(fs::path const &_path);
+
+  DatabaseLockFile(DatabaseLockFile const &) = delete;
+  DatabaseLockFile &operator=(DatabaseLockFile const &) = delete;
+
+  ~DatabaseLockFile();
+
+  /// \brief Acquire a lock, blocking until it is available
+  void lock(bool exclusive);
+
+  /// \brief Release the most recently acquired lock
+  void unlock();
+
+  fs::path const &path() const { return m_path; }
+
+ private:
+  void _flock(int operation);
+
+  fs::path m_path;
+  int m_fd;
+
+  // held locks, true if exclusive
+  std::vector<bool> m_held;
+
+  // number of exclusive locks in m_held
+  Index m_n_exclusive;
+};
+
+/// Holds a lock on a DatabaseLockFile for its lifetime
+///
+/// - A DatabaseLock constructed with a null DatabaseLockFile does nothing,
+///   for projects without a root directory
+class DatabaseLock {
+ public:
+  enum class Mode { shared, exclusive };
+
+  DatabaseLock(DatabaseLockFile *_file, Mode mode) : m_file(_file) {
+    if (m_file) {
+      m_file->lock(mode == Mode::exclusive);
+    }
+  }
+
+  DatabaseLock(DatabaseLock &&other) : m_file(other.m_file) {
+    other.m_file = nullptr;
+  }
+
+  DatabaseLock(DatabaseLock const &) = delete;
+  DatabaseLock &operator=(DatabaseLock const &) = delete;
+
+  ~DatabaseLock() {
+    if (m_file) {
+      m_file->unlock();
+    }
+  }
+
+ private:
+  DatabaseLockFile *m_file;
+};
+
+/// \brief Identifies a version of a database file that is replaced, never
+/// modified, on commit, or is empty if the file does not exist
+///
+/// - Read under a DatabaseLock, to detect commits by other processes
+std::string file_version(fs::path const &path);
+
+}  // namespace DB
+}  // namespace CASM
+
+#endif
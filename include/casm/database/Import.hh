@@ -57,6 +57,9 @@ struct ImportSettings {
 
   /// Output reports as JSON instead of columns
   bool output_as_json = true;
+
+  /// Number of threads used to map structures, < 1 uses default_n_threads()
+  Index n_threads = 0;
 };
 
 jsonParser &to_json(ImportSettings const &_set, jsonParser &_json);
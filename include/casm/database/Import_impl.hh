@@ -7,6 +7,7 @@
 #include "casm/app/import.hh"
 #include "casm/clex/PrimClex_impl.hh"
 #include "casm/database/ConfigData_impl.hh"
+#include "casm/database/DatabaseHandler.hh"
 #include "casm/database/Import.hh"
 #include "casm/database/PropertiesDatabase.hh"
 #include "casm/database/Selection_impl.hh"
@@ -109,18 +110,19 @@ void ImportT<_ConfigType>::import(PathIterator begin, PathIterator end) {
   auto required_properties =
       project_settings.required_properties(traits<ConfigType>::name, calctype);
 
-  Log &log = CASM::log();
-  auto it = begin;
-  for (; it != end; ++it) {
-    log << "Importing " << it->string() << std::endl;
+  // properties to insert, in bulk, after mapping all structures
+  std::vector<MappedProperties> import_properties;
 
-    std::vector<ConfigIO::Result> tvec;
+  std::vector<fs::path> paths;
+  for (auto it = begin; it != end; ++it) {
+    paths.push_back(*it);
+  }
 
-    // Outputs one or more mapping results from the structure located at specied
-    // path
-    //   See _import documentation for more.
-    m_structure_mapper.map(it->string(), required_properties, nullptr,
-                           std::back_inserter(tvec));
+  // Structures are mapped in parallel, and results are checked and inserted
+  // here, in order, by the calling thread
+  Log &log = CASM::log();
+  auto f = [&](Index i, std::vector<ConfigIO::Result> &tvec) {
+    log << "Importing " << paths[i].string() << std::endl;
 
     // if successfully mapped:
     // - check for preexisting properties and files
@@ -162,7 +164,7 @@ void ImportT<_ConfigType>::import(PathIterator begin, PathIterator end) {
         // - first erase in case properties from structure already inserted
         // - assume no "force" necessary
         db_props().erase_via_origin(res.properties.origin);
-        db_props().insert(res.properties);
+        import_properties.push_back(res.properties);
       }
     }
 
@@ -170,7 +172,10 @@ void ImportT<_ConfigType>::import(PathIterator begin, PathIterator end) {
     for (auto &res : tvec) {
       results.push_back(res);
     }
-  }
+  };
+  m_structure_mapper.map_all(paths, {}, required_properties,
+                             settings().n_threads, f);
+  db_props().insert(import_properties);
 
   // Check if result is the new best conflict scoring mapping
   double tol = this->primclex().settings().lin_alg_tol();
@@ -220,8 +225,13 @@ void ImportT<_ConfigType>::import(PathIterator begin, PathIterator end) {
 
   this->_import_report(results);
 
+  // commit under one lock, so that Configuration renamed when merged with
+  // commits by another process are also renamed in the properties
+  auto lock =
+      this->primclex().db_handler().lock(DatabaseLock::Mode::exclusive);
   db_supercell().commit();
   db_config<ConfigType>().commit();
+  db_props().rename_to(db_config<ConfigType>().renamed_on_commit());
   db_props().commit();
 }
 
@@ -2,6 +2,7 @@
 #define CASM_PropertiesDatabase
 
 #include <boost/iterator/iterator_facade.hpp>
+#include <map>
 #include <set>
 #include <string>
 
@@ -268,6 +269,9 @@ class PropertiesDatabase : public DatabaseBase {
   /// \brief Insert data
   std::pair<iterator, bool> insert(const MappedProperties &value);
 
+  /// \brief Insert data in bulk
+  size_type insert(const std::vector<MappedProperties> &values);
+
   /// \brief Erase data
   iterator erase(iterator pos);
 
@@ -281,7 +285,20 @@ class PropertiesDatabase : public DatabaseBase {
     return 1;
   }
 
+  /// \brief Change the 'to' Configuration of all data mapped to renamed
+  /// Configuration
+  ///
+  /// - `renamed`: old Configuration name -> new Configuration name, i.e.
+  ///   `Database<Configuration>::renamed_on_commit()`
+  ///
+  /// \returns Number of data entries changed
+  size_type rename_to(std::map<std::string, std::string> const &renamed);
+
  private:
+  /// \brief Reserve space for a total of 'n' data entries, before a bulk
+  /// insert
+  virtual void _reserve(size_type n) {}
+
   /// \brief Private _insert MappedProperties, without modifying 'relaxed_from'
   virtual std::pair<iterator, bool> _insert(const MappedProperties &value) = 0;
 
@@ -5,6 +5,7 @@
 #include <set>
 
 #include "casm/clex/Supercell.hh"
+#include "casm/clex/SupercellLRU.hh"
 #include "casm/database/Database.hh"
 #include "casm/database/DatabaseSetIterator.hh"
 
@@ -23,6 +24,11 @@ namespace DB {
 /// where it is known that a Supercell is generated in canonical form, the
 /// Database insert and emplace methods may be used directly.
 ///
+/// Supercell in the database construct their symmetry information and
+/// neighbor list on first use. The number that keep them constructed may be
+/// limited with `set_max_resident`, and is enforced when `shrink_resident` is
+/// called, see SupercellLRU.
+///
 /// Derived ScelDatabase must implement public methods:
 /// - void DatabaseBase& open()
 /// - void commit()
@@ -31,7 +37,9 @@ namespace DB {
 template <>
 class Database<Supercell> : public ValDatabase<Supercell> {
  public:
-  Database(const PrimClex &_primclex) : ValDatabase<Supercell>(_primclex) {}
+  Database(const PrimClex &_primclex)
+      : ValDatabase<Supercell>(_primclex),
+        m_lru(default_supercell_lru_capacity()) {}
 
   virtual ~Database() {}
 
@@ -56,6 +64,30 @@ class Database<Supercell> : public ValDatabase<Supercell> {
   iterator find(const std::string &name_or_alias) const override;
   using ValDatabase<Supercell>::find;
 
+  /// \brief Maximum number of Supercell with constructed symmetry information
+  /// and neighbor list, values < 1 are unlimited
+  Index max_resident() const { return m_lru.capacity(); }
+
+  /// \brief Set maximum number of Supercell with constructed symmetry
+  /// information and neighbor list, values < 1 are unlimited
+  void set_max_resident(Index max_resident) {
+    m_lru.set_capacity(max_resident);
+  }
+
+  /// \brief Number of Supercell with constructed symmetry information or
+  /// neighbor list
+  Index size_resident() const { return m_lru.size(); }
+
+  /// \brief Release the symmetry information and neighbor list of the least
+  /// recently used Supercell, until at most `max_resident()` are resident
+  ///
+  /// - Other than `set_max_resident`, this is the only point at which
+  ///   Supercell in the database are released. Call it between units of
+  ///   work (i.e. after enumerating configurations in one supercell), when no
+  ///   other thread is using Supercell from the database.
+  /// - Supercell pinned by a SupercellPin are not released
+  Index shrink_resident() { return m_lru.shrink(); }
+
  protected:
   typedef std::set<Supercell>::iterator base_iterator;
 
@@ -66,6 +98,9 @@ class Database<Supercell> : public ValDatabase<Supercell> {
 
   iterator _iterator(base_iterator base_it) const;
 
+  // declared before m_scel_list, so that it outlives the Supercell
+  SupercellLRU m_lru;
+
   std::map<std::string, base_iterator> m_name_to_scel;
   std::set<Supercell> m_scel_list;
 };
@@ -179,6 +179,12 @@ class Selection {
   jsonParser &to_json(const DataFormatterDictionary<ObjType> &_dict,
                       jsonParser &_json, bool only_selected = false) const;
 
+  /// \brief Write selection to file
+  ///
+  /// - Written as JSON if `write_json` or the extension is ".json"
+  /// - Written in compact binary form, without properties, if the extension
+  ///   is ".bin" (see SelectionBitset)
+  /// - Otherwise written as a CSV-like table
   void write(const DataFormatterDictionary<ObjType> &dict,
              const fs::path &out_path, bool write_json,
              bool only_selected) const;
@@ -0,0 +1,133 @@
+#ifndef CASM_SelectionBitset
+#define CASM_SelectionBitset
+
+#include <boost/filesystem.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "casm/global/definitions.hh"
+
+namespace CASM {
+namespace DB {
+
+template <typename ValueType>
+class Database;
+
+template <typename ObjType>
+class Selection;
+
+/// Ordinal index of the objects in a database, shared by SelectionBitset
+///
+/// - Ordinals are the positions of the objects in database iteration order
+/// - Constructed from names only, so that database objects are not
+///   constructed
+template <typename ObjType>
+class SelectionIndex {
+ public:
+  /// \brief Index the objects currently in a database
+  explicit SelectionIndex(Database<ObjType> const &db);
+
+  /// \brief Number of objects
+  Index size() const { return m_names.size(); }
+
+  /// \brief Name of the object with a given ordinal
+  std::string const &name(Index ordinal) const { return m_names[ordinal]; }
+
+  /// \brief Ordinal of the object with a given name, or -1 if not found
+  Index ordinal(std::string const &name) const;
+
+  /// \brief Hash of the names, in order, identifying the index
+  std::uint64_t fingerprint() const { return m_fingerprint; }
+
+ private:
+  std::vector<std::string> m_names;
+  std::unordered_map<std::string, Index> m_ordinal;
+  std::uint64_t m_fingerprint;
+};
+
+/// Selection stored as dense bitsets over database ordinals
+///
+/// Stores two bitsets, for the objects included in the selection and for the
+/// objects selected. Set operations act on 64 objects per word. Conversion
+/// to and from Selection reproduces the behavior of 'casm select --and',
+/// '--or', '--xor', and '--not' on Selection::data(). Constructing a
+/// SelectionIndex visits every object in the database, so the set operations
+/// only pay off when one index is shared by many operations.
+///
+/// Selections may be written in a compact binary form, which is valid only
+/// for a database with the same names in the same order, and which is
+/// checked when read.
+template <typename ObjType>
+class SelectionBitset {
+ public:
+  typedef std::shared_ptr<SelectionIndex<ObjType> const> index_ptr;
+
+  /// \brief Construct with all objects included and not selected
+  explicit SelectionBitset(index_ptr _index);
+
+  /// \brief Construct from a Selection
+  SelectionBitset(index_ptr _index, Selection<ObjType> const &selection);
+
+  SelectionIndex<ObjType> const &index() const { return *m_index; }
+
+  /// \brief Number of objects in the index
+  Index size() const { return m_index->size(); }
+
+  /// \brief Number of objects included
+  Index included_size() const;
+
+  /// \brief Number of objects selected
+  Index selected_size() const;
+
+  bool is_included(Index ordinal) const { return _test(m_included, ordinal); }
+
+  bool is_selected(Index ordinal) const { return _test(m_selected, ordinal); }
+
+  /// \brief Include an object and set whether it is selected
+  void set(Index ordinal, bool selected);
+
+  /// \brief Set selected objects: included and selected in either
+  SelectionBitset &operator|=(SelectionBitset const &other);
+
+  /// \brief Set selected objects: selected in both, or selected and not
+  /// included in other; include objects in either
+  SelectionBitset &operator&=(SelectionBitset const &other);
+
+  /// \brief Set selected objects: selected in only one; include selected
+  /// objects in other
+  SelectionBitset &operator^=(SelectionBitset const &other);
+
+  /// \brief Invert selected value of included objects
+  void flip();
+
+  /// \brief Only include selected objects
+  void subset();
+
+  /// \brief Replace the contents of a Selection
+  void to_selection(Selection<ObjType> &selection) const;
+
+  /// \brief Write in binary form
+  void write(fs::path const &path) const;
+
+  /// \brief Read from binary form
+  void read(fs::path const &path);
+
+ private:
+  static bool _test(std::vector<std::uint64_t> const &bits, Index ordinal) {
+    return (bits[ordinal >> 6] >> (ordinal & 63)) & 1;
+  }
+
+  void _check_index(SelectionBitset const &other) const;
+
+  index_ptr m_index;
+  std::vector<std::uint64_t> m_included;
+  std::vector<std::uint64_t> m_selected;
+};
+
+}  // namespace DB
+}  // namespace CASM
+
+#endif
@@ -27,12 +27,15 @@ class Selection;
 
 struct UpdateSettings {
   UpdateSettings(bool _output_as_json = true)
-      : output_as_json(_output_as_json) {}
+      : output_as_json(_output_as_json), n_threads(0) {}
 
   void set_default() { *this = UpdateSettings(); }
 
   // Output reports as JSON instead of columns
   bool output_as_json;
+
+  // Number of threads used to map structures, < 1 uses default_n_threads()
+  Index n_threads;
 };
 
 /// Generic ConfigType-dependent part of Import
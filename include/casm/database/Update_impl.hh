@@ -5,6 +5,7 @@
 
 #include "casm/clex/PrimClex_impl.hh"
 #include "casm/database/ConfigData_impl.hh"
+#include "casm/database/DatabaseHandler.hh"
 #include "casm/database/Selection_impl.hh"
 #include "casm/database/Update.hh"
 
@@ -36,6 +37,11 @@ void UpdateT<_ConfigType>::update(const DB::Selection<ConfigType> &selection,
 
   // vector of Mapping results
   std::vector<ConfigIO::Result> results;
+
+  // structures to map, and 'from' configs, if in the database
+  std::vector<std::string> names;
+  std::vector<fs::path> paths;
+  std::vector<std::unique_ptr<ConfigType> > hints;
   for (const auto &val : selection.data()) {
     // if not selected, skip
     if (!val.second) {
@@ -70,31 +76,44 @@ void UpdateT<_ConfigType>::update(const DB::Selection<ConfigType> &selection,
 
     if (!fs::exists(pos)) continue;
 
-    log << "Updating data records for " << name << std::endl;
-    std::vector<ConfigIO::Result> tvec;
+    names.push_back(name);
+    paths.push_back(resolve_struc_path(pos, primclex()));
     auto config_it = db_config<ConfigType>().find(name);
-    if (config_it == db_config<ConfigType>().end())
-      m_structure_mapper.map(resolve_struc_path(pos, primclex()),
-                             required_properties, nullptr,
-                             std::back_inserter(tvec));
-    else
-      m_structure_mapper.map(resolve_struc_path(pos, primclex()),
-                             required_properties,
-                             notstd::make_unique<ConfigType>(*config_it),
-                             std::back_inserter(tvec));
+    if (config_it == db_config<ConfigType>().end()) {
+      hints.emplace_back();
+    } else {
+      hints.push_back(notstd::make_unique<ConfigType>(*config_it));
+    }
+  }
+
+  // properties to insert, in bulk, after mapping all structures
+  std::vector<MappedProperties> update_properties;
+
+  // Structures are mapped in parallel, and results are inserted here, in
+  // order, by the calling thread
+  auto f = [&](Index i, std::vector<ConfigIO::Result> &tvec) {
+    log << "Updating data records for " << names[i] << std::endl;
     for (auto &res : tvec) {
       results.push_back(res);
       // if mapped && has data, insert
       if (!res.properties.to.empty() && res.has_data) {
-        // insert data:
-        db_props().insert(res.properties);
+        // insert data, in bulk after mapping all structures:
+        update_properties.push_back(res.properties);
       }
     }
-  }
+  };
+  m_structure_mapper.map_all(paths, hints, required_properties,
+                             settings().n_threads, f);
+  db_props().insert(update_properties);
   _update_report(results, selection);
 
+  // commit under one lock, so that Configuration renamed when merged with
+  // commits by another process are also renamed in the properties
+  auto lock =
+      this->primclex().db_handler().lock(DatabaseLock::Mode::exclusive);
   db_supercell().commit();
   db_config<ConfigType>().commit();
+  db_props().rename_to(db_config<ConfigType>().renamed_on_commit());
   db_props().commit();
 }
 
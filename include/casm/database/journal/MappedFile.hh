@@ -0,0 +1,39 @@
+#ifndef CASM_MappedFile
+#define CASM_MappedFile
+
+#include <boost/filesystem/path.hpp>
+#include <cstddef>
+
+#include "casm/global/definitions.hh"
+
+namespace CASM {
+namespace DB {
+
+/// Read-only memory map of a file
+///
+/// - The mapping remains valid if the file is replaced by renaming another
+///   file into its place
+/// - An empty file is not mapped, and has data() == nullptr
+class MappedFile {
+ public:
+  /// \throws std::runtime_error if the file can not be opened or mapped
+  explicit MappedFile(fs::path const &path);
+
+  MappedFile(MappedFile const &) = delete;
+  MappedFile &operator=(MappedFile const &) = delete;
+
+  ~MappedFile();
+
+  char const *data() const { return m_data; }
+
+  std::size_t size() const { return m_size; }
+
+ private:
+  char const *m_data;
+  std::size_t m_size;
+};
+
+}  // namespace DB
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,273 @@
+#ifndef CASM_columnarPropertiesDatabase
+#define CASM_columnarPropertiesDatabase
+
+#include <boost/filesystem/path.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "casm/database/PropertiesDatabase.hh"
+
+namespace CASM {
+namespace DB {
+
+class MappedFile;
+class columnarPropertiesDatabase;
+
+class columnarPropertiesDatabaseIterator
+    : public PropertiesDatabaseIteratorBase {
+ public:
+  columnarPropertiesDatabaseIterator() : m_db(nullptr) {}
+
+  std::unique_ptr<columnarPropertiesDatabaseIterator> clone() const {
+    return std::unique_ptr<columnarPropertiesDatabaseIterator>(this->_clone());
+  }
+
+ private:
+  // origin -> row ordinal
+  typedef typename std::map<std::string, Index>::const_iterator base_iterator;
+  friend columnarPropertiesDatabase;
+
+  columnarPropertiesDatabaseIterator(columnarPropertiesDatabase const *_db,
+                                     base_iterator _it)
+      : m_db(_db), m_it(_it) {}
+
+  base_iterator base() const { return m_it; }
+
+  bool equal(const PropertiesDatabaseIteratorBase &other) const override {
+    return m_it ==
+           static_cast<const columnarPropertiesDatabaseIterator &>(other).m_it;
+  }
+
+  void increment() override { ++m_it; }
+
+  const MappedProperties &dereference() const override;
+
+  long distance_to(const PropertiesDatabaseIteratorBase &other) const override {
+    return std::distance(
+        m_it,
+        static_cast<const columnarPropertiesDatabaseIterator &>(other).m_it);
+  }
+
+  columnarPropertiesDatabaseIterator *_clone() const override {
+    return new columnarPropertiesDatabaseIterator(*this);
+  }
+
+  columnarPropertiesDatabase const *m_db;
+  base_iterator m_it;
+};
+
+/// An implementation of PropertiesDatabase storing properties in columns
+///
+/// Each global and each site property is stored as one column, indexed by the
+/// ordinal of the MappedProperties (a row). A column holds the shape and
+/// offset of the value for each row and the values of all rows, contiguously,
+/// as doubles. Global scalar properties are 1x1 values, and site properties
+/// are the column-major matrix of each row, so that a column of site
+/// properties is one flat matrix.
+///
+/// On open, the file is memory-mapped and only the 'origin', 'to',
+/// 'init_config', and 'file_data' of each row are read. MappedProperties are
+/// constructed the first time they are dereferenced, by copying from the
+/// columns, and the values of a single property can be read directly from its
+/// column without constructing MappedProperties.
+///
+/// Inserted rows are appended to columns in memory. Commit writes all rows,
+/// except erased rows, to a new file that replaces the old one.
+///
+/// If the file does not exist, but a jsonDB properties file does, it is read
+/// on open and the columnar file is written on the next commit.
+///
+/// Open holds a shared lock, and commit an exclusive lock, on the project
+/// databases (see DatabaseHandler::lock). If another process has committed
+/// since open, its changes are merged with the changes made by this process
+/// before writing.
+class columnarPropertiesDatabase : public PropertiesDatabase {
+ public:
+  /// Read-only view of the values of one property
+  class Column {
+   public:
+    Column();
+
+    /// \brief True if the row has a value for this property
+    bool has(Index ordinal) const;
+
+    /// \brief Value of the property for a row, which must have one
+    Eigen::Map<Eigen::MatrixXd const> value(Index ordinal) const;
+
+   private:
+    friend columnarPropertiesDatabase;
+
+    // shape is stored as (rows, cols); absent values have rows == absent
+    static const std::uint32_t absent = 0xFFFFFFFF;
+
+    // number of rows in the mapped file
+    Index m_n_mapped;
+
+    // values for rows in the mapped file, or nullptr
+    std::uint32_t const *m_mapped_shape;
+    std::uint64_t const *m_mapped_offset;
+    double const *m_mapped_data;
+
+    // values for rows appended since open
+    std::vector<std::uint32_t> m_shape;
+    std::vector<std::uint64_t> m_offset;
+    std::vector<double> m_data;
+  };
+
+  /// Constructor
+  ///
+  /// \param location Where the columns are read from on "open", written to on
+  /// "commit". Can be used all in memory with empty location.
+  /// \param json_location A jsonDB properties file, read on "open" if
+  /// "location" does not exist
+  ///
+  /// Note: "_primclex" and "calc_type" are unused, as for
+  /// jsonPropertiesDatabase
+  columnarPropertiesDatabase(const PrimClex &_primclex, std::string calc_type,
+                             fs::path location,
+                             fs::path json_location = fs::path());
+
+  ~columnarPropertiesDatabase();
+
+  DatabaseBase &open() override;
+
+  void commit() override;
+
+  void close() override;
+
+  /// \brief Begin iterator
+  iterator begin() const override;
+
+  /// \brief End iterator
+  iterator end() const override;
+
+  size_type size() const override;
+
+  /// \brief Return iterator to MappedProperties that is the best mapping to
+  /// specified config
+  ///
+  /// - Prefers self-mapped, else best scoring
+  iterator find_via_to(std::string to_configname) const override;
+
+  /// \brief Return iterator to MappedProperties that is from the specified
+  /// config
+  iterator find_via_origin(std::string origin) const override;
+
+  /// \brief Names of all configurations that relaxed 'origin'->'to'
+  std::set<std::string, Compare> all_origins(
+      std::string to_configname) const override;
+
+  /// \brief Change the score method for a single configuration
+  void set_score_method(std::string to_configname,
+                        const ScoreMappedProperties &score) override;
+
+  /// \brief Row ordinal of the MappedProperties at an iterator
+  Index ordinal(iterator const &it) const;
+
+  /// \brief Column of a global property, or nullptr if no row has it
+  Column const *global_column(std::string const &name) const;
+
+  /// \brief Column of a site property, or nullptr if no row has it
+  Column const *site_column(std::string const &name) const;
+
+  /// \brief Number of MappedProperties currently constructed
+  size_type size_materialized() const { return m_n_materialized; }
+
+ private:
+  friend columnarPropertiesDatabaseIterator;
+
+  enum class ColumnKind : std::uint32_t { global = 0, site = 1 };
+
+  typedef std::pair<ColumnKind, std::string> column_key;
+
+  /// Fields of one MappedProperties that are not stored in columns
+  struct Row {
+    std::string origin;
+    std::string to;
+    std::string init_config;
+    FileData file_data;
+    mutable std::unique_ptr<MappedProperties> value;
+  };
+
+  iterator _iterator(
+      columnarPropertiesDatabaseIterator::base_iterator _it) const;
+
+  /// Construct the MappedProperties for a row, if not yet constructed
+  MappedProperties const &_materialize(Index ordinal) const;
+
+  /// Read rows and columns from the mapped file
+  void _read_mapped();
+
+  /// Clear all and read from a jsonDB properties file
+  void _read_json(fs::path const &path);
+
+  /// Apply the changes committed by another process since open
+  void _merge();
+
+  /// Append one row to the columns
+  void _append(const MappedProperties &value);
+
+  /// \brief Reserve space for rows
+  void _reserve(size_type n) override;
+
+  /// \brief Private _insert MappedProperties, without modifying 'relaxed_from'
+  std::pair<iterator, bool> _insert(const MappedProperties &value) override;
+
+  /// \brief Private _erase MappedProperties, without modifying 'relaxed_from'
+  iterator _erase(iterator pos) override;
+
+  /// \brief Names of all configurations that relaxed 'from'->'to'
+  void _set_all_origins(std::string to_configname,
+                        const std::set<std::string, Compare> &_set) override;
+
+  std::set<std::string, Compare> _make_set(
+      std::string to_configname, const ScoreMappedProperties &score) const;
+
+  bool m_is_open;
+
+  // if true, there are changes to write on commit
+  bool m_is_modified;
+
+  std::string m_calc_type;
+  fs::path m_location;
+  fs::path m_json_location;
+
+  ScoreMappedProperties m_default_score;
+
+  // the mapped file, which columns of mapped rows point into
+  std::unique_ptr<MappedFile> m_mapped;
+
+  // version of the file on open or the last commit, to detect commits by
+  // another process
+  std::string m_file_version;
+
+  // origins inserted since open or the last commit
+  std::set<std::string> m_inserted;
+
+  // origins erased since open or the last commit
+  std::set<std::string> m_erased;
+
+  // all rows, by ordinal, including rows erased since the last commit
+  std::vector<Row> m_rows;
+
+  // number of rows read from the mapped file
+  Index m_n_mapped;
+
+  // number of constructed MappedProperties
+  mutable size_type m_n_materialized;
+
+  // (kind, property name) -> values
+  std::map<column_key, Column> m_columns;
+
+  // origin -> row ordinal, for rows that are not erased
+  std::map<std::string, Index> m_data;
+
+  // to -> {from, from, ...}, used to find best mapping
+  std::map<std::string, std::set<std::string, Compare> > m_origins;
+};
+
+}  // namespace DB
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,275 @@
+#ifndef CASM_journalDatabase
+#define CASM_journalDatabase
+
+#include <memory>
+
+#include "casm/app/DirectoryStructure.hh"
+#include "casm/database/ConfigDatabase.hh"
+#include "casm/database/ConfigIdReservation.hh"
+#include "casm/database/Database.hh"
+#include "casm/database/ScelDatabase.hh"
+
+namespace CASM {
+
+template <typename T>
+struct traits;
+
+namespace DB {
+template <typename DataObject>
+class journalDatabase;
+class DatabaseHandler;
+class MappedFile;
+
+struct journalDB;
+}  // namespace DB
+
+template <>
+struct traits<DB::journalDB> {
+  static const std::string name;
+
+  /// Database format version, incremented separately from casm --version
+  static const std::string version;
+};
+
+namespace DB {
+
+/// The journalDB uses the jsonDB for Supercell, stores Configuration as a
+/// snapshot plus an append-only journal of changes, and stores properties in
+/// columnarPropertiesDatabase
+///
+/// Select it for a project with `"database": "journalDB"` in the project
+/// settings file.
+struct journalDB {
+  static void insert(DatabaseHandler &);
+
+  class DirectoryStructure {
+   public:
+    DirectoryStructure(const fs::path _root);
+
+    /// Location of the journalDB snapshot, containing a compacted record of
+    /// each DataObject
+    template <typename DataObject>
+    fs::path snapshot() const;
+
+    /// Location of the journalDB journal, containing records of changes
+    /// since the snapshot was written
+    template <typename DataObject>
+    fs::path journal() const;
+
+    /// Location of the columnar properties database for a calculation type
+    template <typename DataObject>
+    fs::path props_list(std::string calctype) const;
+
+   private:
+    CASM::DirectoryStructure m_dir;
+  };
+};
+
+/// Configuration database stored as a snapshot plus an append-only journal
+///
+/// Commit appends one binary record per insert, erase, and update since the
+/// last commit, plus one record per Configuration whose cache was updated, to
+/// the journal. The cost of a commit is proportional to the size of the
+/// change, not the size of the database.
+///
+/// Files:
+/// - Both files begin with a header containing a magic string, the format
+///   version, and a generation number. The journal is only applied to a
+///   snapshot with the same generation.
+/// - Each record is written with its size and checksum. On open, journal
+///   records are applied in order until the end of the file or the first
+///   incomplete or corrupt record, which can only result from an
+///   interrupted commit, and is discarded on the next commit.
+/// - When the journal grows larger than the snapshot, it is compacted: a new
+///   snapshot with the next generation is written to a temporary file and
+///   renamed into place, then the journal is reset. A reader never sees a
+///   partially written snapshot, and a crash between the two steps leaves a
+///   stale journal that is ignored because of its generation.
+/// - Appended records, and snapshots and their directory entries, are synced
+///   to disk before commit returns.
+/// - Only Configuration records are journaled. The master selection and the
+///   aliases are text files, with one line per Configuration or alias, that
+///   are still rewritten in full by each commit, as for the jsonDB.
+///
+/// If neither file exists, but a jsonDB configuration list does, it is read
+/// on open and a snapshot is written on the first commit.
+///
+/// Open holds a shared lock, and commit and compact hold an exclusive lock, on
+/// the project databases (see DatabaseHandler::lock). If another process has
+/// committed since this database was opened, commit first re-opens from the
+/// files and applies the changes made since open to the current state, so
+/// that no changes by either process are lost. New Configuration are given
+/// ids reserved by this process (see ConfigIdReservation), so they keep their
+/// names. Equivalent Configuration inserted by both processes are only
+/// inserted once, see `renamed_on_commit`.
+///
+/// Open is index-only: the files are memory-mapped, and only the supercell
+/// name, id, and the location of the DoF, source, and cache data of each
+/// Configuration are read. A Configuration is constructed the first time it
+/// is dereferenced. Operations that only use names, such as reading a
+/// selection, never construct a Configuration. Search and insert construct
+/// the Configuration in one supercell only, to compare DoF.
+///
+/// Configuration are iterated in order of supercell name, then id.
+template <>
+class journalDatabase<Configuration> : public Database<Configuration> {
+ public:
+  journalDatabase<Configuration>(const PrimClex &_primclex);
+
+  ~journalDatabase<Configuration>();
+
+  journalDatabase<Configuration> &open() override;
+
+  void commit() override;
+
+  void close() override;
+
+  iterator begin() const override;
+
+  iterator end() const override;
+
+  size_type size() const override;
+
+  std::pair<iterator, bool> insert(const Configuration &config) override;
+
+  iterator update(const Configuration &config) override;
+
+  iterator erase(iterator pos) override;
+
+  iterator find(const std::string &name_or_alias) const override;
+
+  /// Range of Configuration in a particular supecell
+  ///
+  /// - Should return range {end(), end()} if no Configuration in specified
+  /// Supercell
+  /// - Note: boost::iterator_range<iterator>::size is not valid for
+  ///   DatabaseIterator.  Use boost::distance instead.
+  boost::iterator_range<iterator> scel_range(
+      const std::string &scelname) const override;
+
+  /// Find canonical Configuration in database by comparing DoF
+  iterator search(const Configuration &config) const override;
+
+  /// Write a new snapshot of all Configuration and reset the journal
+  void compact();
+
+  /// Number of Configuration currently constructed
+  size_type size_materialized() const;
+
+ private:
+  class Iterator;
+
+  /// A string stored in a record, in a mapped file
+  struct Field {
+    Field() : data(nullptr), size(0) {}
+    Field(char const *_data, std::size_t _size) : data(_data), size(_size) {}
+
+    std::string str() const { return std::string(data, size); }
+
+    char const *data;
+    std::size_t size;
+  };
+
+  /// Index entry for one Configuration
+  ///
+  /// Until `config` is constructed, the Configuration is read from the
+  /// fields.
+  struct Entry {
+    Field dof;
+    Field source;
+    Field cache;
+    mutable std::unique_ptr<Configuration> config;
+  };
+
+  // (scelname, id) -> Entry
+  typedef std::pair<std::string, Index> key_type;
+  typedef std::map<key_type, Entry> index_type;
+  typedef index_type::const_iterator base_iterator;
+
+  struct ConfigPtrLess {
+    bool operator()(Configuration const *A, Configuration const *B) const {
+      return *A < *B;
+    }
+  };
+
+  // Configuration -> id, for one supercell
+  typedef std::map<Configuration const *, Index, ConfigPtrLess> search_type;
+
+  iterator _iterator(base_iterator it) const;
+
+  /// Construct the Configuration for an index entry, if not yet constructed
+  Configuration const &_materialize(base_iterator it) const;
+
+  /// Construct a Configuration from the fields of a record
+  std::unique_ptr<Configuration> _make_config(key_type const &key,
+                                              Entry const &fields) const;
+
+  /// Construct all Configuration in a supercell and index them by DoF
+  search_type &_search_index(std::string const &scelname) const;
+
+  /// Insert with a particular key, recording the change
+  base_iterator _insert(key_type const &key, Configuration const &config);
+
+  /// Erase from the containers, without recording the change
+  base_iterator _erase(base_iterator it);
+
+  /// True if another process has committed since this database was opened
+  bool _is_changed_on_disk() const;
+
+  /// Re-open from the current files and apply the changes made since this
+  /// database was opened
+  void _merge();
+
+  /// Read records from a mapped file, or the migrated jsonDB data
+  ///
+  /// \returns Size, in bytes, of the valid part of the data
+  ///
+  /// If `match_generation`, no records are read unless the data generation
+  /// equals `generation`. Otherwise, `generation` is set from the data.
+  std::size_t _replay(char const *data, std::size_t size,
+                      unsigned long long &generation, bool match_generation);
+
+  bool m_is_open;
+
+  // index of Configuration
+  index_type m_index;
+
+  // scelname -> DoF index, for supercells in which search has been used
+  mutable std::map<std::string, search_type> m_search_index;
+
+  // number of constructed Configuration
+  mutable size_type m_n_materialized;
+
+  // map of scelname -> next id to assign to a new Configuration
+  std::map<std::string, Index> m_config_id;
+
+  // ids reserved for new Configuration
+  ConfigIdReservation m_id_reservation;
+
+  // mapped snapshot and journal files, which index fields point into
+  std::vector<std::unique_ptr<MappedFile> > m_mapped;
+
+  // records converted from a jsonDB configuration list
+  std::string m_migrated;
+
+  // records of changes since the last commit
+  std::string m_pending;
+
+  // generation of the snapshot, which the journal must match
+  unsigned long long m_generation;
+
+  // size, in bytes, of the snapshot
+  unsigned long long m_snapshot_size;
+
+  // size, in bytes, of the valid part of the journal (0 if it must be
+  // re-created)
+  unsigned long long m_journal_size;
+
+  // if true, write a snapshot on the next commit
+  bool m_needs_compaction;
+};
+
+}  // namespace DB
+}  // namespace CASM
+
+#endif
@@ -1,8 +1,13 @@
 #ifndef CASM_jsonDatabase
 #define CASM_jsonDatabase
 
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+
 #include "casm/app/DirectoryStructure.hh"
 #include "casm/database/ConfigDatabase.hh"
+#include "casm/database/ConfigIdReservation.hh"
 #include "casm/database/Database.hh"
 #include "casm/database/ScelDatabase.hh"
 
@@ -68,6 +73,9 @@ struct jsonDB {
 /// json["supercells"] is a JSON object that corresponds to a map in which the
 /// supercell name is the key and the value is the information of that
 /// supercell.
+///
+/// On commit, Supercell committed by another process since open are inserted
+/// before writing, so that concurrent commits do not lose Supercell.
 template <>
 class jsonDatabase<Supercell> : public Database<Supercell> {
  public:
@@ -84,7 +92,14 @@ class jsonDatabase<Supercell> : public Database<Supercell> {
 
   void _read_SCEL();
 
+  /// Insert Supercell that were committed by another process since open
+  void _merge();
+
   bool m_is_open;
+
+  // names of Supercell on open, used to distinguish Supercell erased by this
+  // process from Supercell inserted by another process
+  std::set<std::string> m_opened_names;
 };
 
 /// ValueType must have:
@@ -115,6 +130,20 @@ class jsonDatabase<Supercell> : public Database<Supercell> {
 /// json["config_id"] is a map of supercell name (key) to the next index
 /// (value)to be assigned to the newly enumerated configuration within the given
 /// supercell
+///
+/// Open and commit hold the project database lock, so that a commit is never
+/// read partially written. On commit, changes committed by another process
+/// since open are merged before writing:
+/// - New Configuration are given ids reserved with ConfigIdReservation, so
+///   that they keep their names when merged
+/// - Inserted Configuration that are equivalent to a Configuration inserted
+///   by another process are not inserted again, and are recorded in
+///   `renamed_on_commit()`
+/// - Erasures and updates by this process are applied to the merged list
+/// - Selected values in the master selection are kept, by name
+///
+/// The whole list is read and written on each commit, so the journalDB is
+/// preferred for frequent concurrent writers.
 template <>
 class jsonDatabase<Configuration> : public Database<Configuration> {
  public:
@@ -166,11 +195,24 @@ class jsonDatabase<Configuration> : public Database<Configuration> {
     return iterator(db_set_iterator(name_it));
   }
 
+  /// Find an equivalent Configuration using m_hash_index
+  base_iterator _hash_find(const Configuration &config) const;
+
+  /// Re-open from the current file and apply the changes made since open
+  void _merge();
+
   bool m_is_open;
 
   // map name -> Configuration
   std::map<std::string, base_iterator> m_name_to_config;
 
+  // map hash of supercell name and occupation -> Configuration, for at most
+  // config_hash_max_compare Configuration per hash
+  std::unordered_multimap<std::size_t, base_iterator> m_hash_index;
+
+  // hashes shared by more than config_hash_max_compare Configuration
+  std::unordered_set<std::size_t> m_hash_overflow;
+
   // container of Configuration
   std::set<Configuration> m_config_list;
 
@@ -179,6 +221,19 @@ class jsonDatabase<Configuration> : public Database<Configuration> {
 
   // map of scelname -> next id to assign to a new Configuration
   std::map<std::string, Index> m_config_id;
+
+  // ids of new Configuration, reserved so they are unique between processes
+  ConfigIdReservation m_id_reservation;
+
+  // version of the file on open or the last commit, to detect commits by
+  // another process
+  std::string m_file_version;
+
+  // names of Configuration inserted, updated, and erased since open or the
+  // last commit
+  std::set<std::string> m_inserted;
+  std::set<std::string> m_updated;
+  std::set<std::string> m_erased;
 };
 
 }  // namespace DB
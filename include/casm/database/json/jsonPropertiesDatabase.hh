@@ -49,6 +49,9 @@ class jsonPropertiesDatabaseIterator : public PropertiesDatabaseIteratorBase {
 };
 
 /// An implementation of PropertiesDatabase for reading/writing JSON
+///
+/// - On commit, changes committed by another process since open are merged,
+///   as for columnarPropertiesDatabase
 class jsonPropertiesDatabase : public PropertiesDatabase {
  public:
   /// Constructor
@@ -115,6 +118,9 @@ class jsonPropertiesDatabase : public PropertiesDatabase {
   std::set<std::string, Compare> _make_set(
       std::string to_configname, const ScoreMappedProperties &score) const;
 
+  /// \brief Apply the changes committed by another process since open
+  void _merge();
+
   bool m_is_open;
 
   std::string m_calc_type;
@@ -130,6 +136,16 @@ class jsonPropertiesDatabase : public PropertiesDatabase {
 
   // to -> {from, from, ...}, used to find best mapping
   std::map<std::string, std::set<std::string, Compare> > m_origins;
+
+  // version of the file on open or the last commit, to detect commits by
+  // another process
+  std::string m_file_version;
+
+  // origins inserted since open or the last commit
+  std::set<std::string> m_inserted;
+
+  // origins erased since open or the last commit
+  std::set<std::string> m_erased;
 };
 
 }  // namespace DB
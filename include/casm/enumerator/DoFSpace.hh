@@ -294,7 +294,8 @@ VectorSpaceSymReport vector_space_sym_report(
 /// Make VectorSpaceSymReport
 SymRepTools_v2::VectorSpaceSymReport vector_space_sym_report_v2(
     DoFSpace const &dof_space, SupercellSymInfo const &sym_info,
-    std::vector<PermuteIterator> const &group, bool calc_wedges = false);
+    std::vector<PermuteIterator> const &group, bool calc_wedges = false,
+    bool blocked_decomposition = false);
 
 /// Make DoFSpace with symmetry adapated basis
 DoFSpace make_symmetry_adapted_dof_space(
@@ -306,7 +307,8 @@ DoFSpace make_symmetry_adapted_dof_space(
 DoFSpace make_symmetry_adapted_dof_space_v2(
     DoFSpace const &dof_space, SupercellSymInfo const &sym_info,
     std::vector<PermuteIterator> const &group, bool calc_wedges,
-    std::optional<SymRepTools_v2::VectorSpaceSymReport> &symmetry_report);
+    std::optional<SymRepTools_v2::VectorSpaceSymReport> &symmetry_report,
+    bool blocked_decomposition = false);
 
 class make_symmetry_adapted_dof_space_error : public std::runtime_error {
  public:
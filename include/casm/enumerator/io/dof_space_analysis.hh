@@ -228,6 +228,10 @@ struct DoFSpaceAnalysisOptions {
 
   // specify a subspace for the DoFSpace explicitly
   std::optional<Eigen::MatrixXd> basis;
+
+  // find irreps of local DoF spaces block by block, using sparse symmetry
+  // representations
+  bool blocked_decomposition = false;
 };
 
 void output_dof_space(Index state_index, std::string const &identifier,
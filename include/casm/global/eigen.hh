@@ -13,6 +13,7 @@ typedef Matrix<long int, 3, 3> Matrix3l;
 typedef Matrix<long int, 3, 1> Vector3l;
 typedef Matrix<long int, Dynamic, Dynamic> MatrixXl;
 typedef Matrix<long int, Dynamic, 1> VectorXl;
+typedef Matrix<double, Dynamic, Dynamic, RowMajor> MatrixXdRowMajor;
 
 template <typename Derived>
 std::istream &operator>>(std::istream &s, MatrixBase<Derived> &m) {
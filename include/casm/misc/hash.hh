@@ -0,0 +1,64 @@
+#ifndef CASM_misc_hash
+#define CASM_misc_hash
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace CASM {
+
+/// \brief Mix `value` into `seed` (64-bit finalizer from splitmix64)
+inline void hash_combine(std::uint64_t &seed, std::uint64_t value) {
+  std::uint64_t z = seed + 0x9e3779b97f4a7c15ULL + value;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  seed = z ^ (z >> 31);
+}
+
+/// \brief Initial value of a 64-bit FNV-1a hash
+std::uint64_t const fnv1a_offset_basis = 14695981039346656037ULL;
+
+/// \brief 64-bit FNV-1a hash, continuing from `hash`
+///
+/// FNV-1a does not depend on the standard library implementation, so it may
+/// be used for values that are saved to file.
+inline void fnv1a(std::uint64_t &hash, void const *data, std::size_t n_bytes) {
+  auto bytes = static_cast<unsigned char const *>(data);
+  for (std::size_t i = 0; i < n_bytes; ++i) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ULL;
+  }
+}
+
+/// \brief 64-bit FNV-1a hash of the bytes of `value`, continuing from `hash`
+inline void fnv1a(std::uint64_t &hash, std::int64_t value) {
+  fnv1a(hash, &value, sizeof(value));
+}
+
+/// \brief 64-bit FNV-1a hash of the size and characters of `value`,
+/// continuing from `hash`
+inline void fnv1a(std::uint64_t &hash, std::string const &value) {
+  fnv1a(hash, std::int64_t(value.size()));
+  fnv1a(hash, value.data(), value.size());
+}
+
+/// \brief 32-bit FNV-1a hash
+inline std::uint32_t fnv1a_32(void const *data, std::size_t n_bytes) {
+  auto bytes = static_cast<unsigned char const *>(data);
+  std::uint32_t hash = 2166136261u;
+  for (std::size_t i = 0; i < n_bytes; ++i) {
+    hash ^= bytes[i];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+/// \brief Index of the lowest set bit of a non-zero `word`
+inline int lowest_set_bit(std::uint64_t word) {
+  return std::bitset<64>((word & (~word + 1)) - 1).count();
+}
+
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,220 @@
+#ifndef CASM_misc_parallel
+#define CASM_misc_parallel
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "casm/global/definitions.hh"
+
+namespace CASM {
+
+/// \brief Number of threads used by parallel algorithms if not specified
+Index default_n_threads();
+
+/// \brief Call `f(thread_index, i)` for each i in [begin, end), using up to
+/// `n_threads` threads
+///
+/// \param begin,end Range of indices
+/// \param n_threads Maximum number of threads. Values < 1 use
+///     `default_n_threads()`.
+/// \param f Function with signature `void f(Index thread_index, Index i)`.
+///
+/// Notes:
+/// - The range is split into contiguous blocks, one per thread, so that
+///   the thread evaluating a given index depends only on `begin`, `end`, and
+///   the number of threads used. `thread_index` is in [0, n_threads) and may be
+///   used to select per-thread state (i.e. a ClexulatorContext).
+/// - If only one thread is used, `f` is called in the calling thread.
+/// - If `f` throws, the first exception (by thread index) is rethrown after all
+///   threads have finished.
+template <typename F>
+void parallel_for(Index begin, Index end, Index n_threads, F f) {
+  Index size = end - begin;
+  if (size <= 0) {
+    return;
+  }
+  if (n_threads < 1) {
+    n_threads = default_n_threads();
+  }
+  n_threads = std::min(n_threads, size);
+
+  if (n_threads == 1) {
+    for (Index i = begin; i < end; ++i) {
+      f(0, i);
+    }
+    return;
+  }
+
+  std::vector<std::exception_ptr> errors(n_threads);
+  std::vector<std::thread> threads;
+  threads.reserve(n_threads);
+  Index block = size / n_threads;
+  Index remainder = size % n_threads;
+  Index block_begin = begin;
+  for (Index t = 0; t < n_threads; ++t) {
+    Index block_end = block_begin + block + (t < remainder ? 1 : 0);
+    threads.emplace_back([&, t, block_begin, block_end]() {
+      try {
+        for (Index i = block_begin; i < block_end; ++i) {
+          f(t, i);
+        }
+      } catch (...) {
+        errors[t] = std::current_exception();
+      }
+    });
+    block_begin = block_end;
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (auto const &error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+/// \brief Call `map(thread_index, i)` for each i in [0, size), using up to
+/// `n_threads` threads, and `consume(i, value)` with each result, in order of
+/// i, in the calling thread
+///
+/// \param size Number of items
+/// \param n_threads Maximum number of threads calling `map`. Values < 1 use
+///     `default_n_threads()`.
+/// \param capacity Maximum number of items that may be mapped ahead of
+///     `consume`, which bounds the number of results held in memory. Values
+///     < 1 use `4 * n_threads`.
+/// \param map Function with signature `T map(Index thread_index, Index i)`.
+/// \param consume Function with signature `void consume(Index i, T &&value)`.
+///
+/// Notes:
+/// - Items are assigned to threads as threads become free, so that items that
+///   take longer to map do not hold up other threads. `thread_index` is in
+///   [0, n_threads) and may be used to select per-thread state.
+/// - Because `consume` is called in order, in one thread, the results of a
+///   pipeline do not depend on the number of threads if `map` does not.
+/// - If only one thread is used, `map` and `consume` are called alternately
+///   in the calling thread.
+/// - If `map` throws, the exception is rethrown in the calling thread in place
+///   of calling `consume` for that item. If `consume` throws, no further items
+///   are mapped and the exception is rethrown after all threads have finished.
+template <typename MapF, typename ConsumeF>
+void parallel_pipeline(Index size, Index n_threads, Index capacity, MapF map,
+                       ConsumeF consume) {
+  typedef typename std::decay<decltype(map(Index(0), Index(0)))>::type
+      value_type;
+  if (size <= 0) {
+    return;
+  }
+  if (n_threads < 1) {
+    n_threads = default_n_threads();
+  }
+  n_threads = std::min(n_threads, size);
+
+  if (n_threads == 1) {
+    for (Index i = 0; i < size; ++i) {
+      consume(i, map(0, i));
+    }
+    return;
+  }
+
+  if (capacity < 1) {
+    capacity = 4 * n_threads;
+  }
+  capacity = std::max(capacity, n_threads);
+
+  // results of item i are held in slots[i % capacity] until consumed
+  struct Slot {
+    std::unique_ptr<value_type> value;
+    std::exception_ptr error;
+    bool ready = false;
+  };
+  std::vector<Slot> slots(capacity);
+  std::mutex mutex;
+  std::condition_variable slot_free;
+  std::condition_variable slot_ready;
+  Index next = 0;
+  Index n_consumed = 0;
+  bool stop = false;
+
+  auto worker = [&](Index t) {
+    while (true) {
+      Index i;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        slot_free.wait(lock, [&]() {
+          return stop || next == size || next < n_consumed + capacity;
+        });
+        if (stop || next == size) {
+          return;
+        }
+        i = next++;
+      }
+      Slot result;
+      try {
+        result.value.reset(new value_type(map(t, i)));
+      } catch (...) {
+        result.error = std::current_exception();
+      }
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        Slot &slot = slots[i % capacity];
+        slot.value = std::move(result.value);
+        slot.error = result.error;
+        slot.ready = true;
+      }
+      slot_ready.notify_all();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(n_threads);
+  for (Index t = 0; t < n_threads; ++t) {
+    threads.emplace_back(worker, t);
+  }
+
+  std::exception_ptr error;
+  try {
+    for (Index i = 0; i < size; ++i) {
+      Slot result;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        Slot &slot = slots[i % capacity];
+        slot_ready.wait(lock, [&]() { return slot.ready; });
+        result.value = std::move(slot.value);
+        result.error = slot.error;
+        slot.error = nullptr;
+        slot.ready = false;
+        ++n_consumed;
+      }
+      slot_free.notify_all();
+      if (result.error) {
+        std::rethrow_exception(result.error);
+      }
+      consume(i, std::move(*result.value));
+    }
+  } catch (...) {
+    error = std::current_exception();
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stop = true;
+    }
+    slot_free.notify_all();
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+}  // namespace CASM
+
+#endif
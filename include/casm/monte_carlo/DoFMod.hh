@@ -1,6 +1,9 @@
 #ifndef CASM_DoFMod_HH
 #define CASM_DoFMod_HH
 
+#include "casm/global/definitions.hh"
+#include "casm/global/eigen.hh"
+
 namespace CASM {
 namespace Monte {
 
@@ -63,6 +66,10 @@ class SiteMod {
 /// \brief An OccMod describes the change in occupation variable on a site
 typedef SiteMod<int> OccMod;
 
+/// \brief A LocalContinuousMod describes the change in a local continuous DoF
+/// value (prim DoF basis) on a site
+typedef SiteMod<Eigen::VectorXd> LocalContinuousMod;
+
 }  // namespace Monte
 }  // namespace CASM
 
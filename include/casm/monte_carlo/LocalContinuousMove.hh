@@ -0,0 +1,102 @@
+#ifndef CASM_Monte_LocalContinuousMove
+#define CASM_Monte_LocalContinuousMove
+
+#include <vector>
+
+#include "casm/crystallography/DoFDecl.hh"
+#include "casm/global/definitions.hh"
+#include "casm/global/eigen.hh"
+#include "casm/monte_carlo/DoFMod.hh"
+
+class MTRand;
+
+namespace CASM {
+
+class ConfigDoF;
+
+namespace Monte {
+
+/// \brief Settings for proposing local continuous DoF moves
+struct LocalContinuousMoveSettings {
+  /// Local continuous DoF type
+  DoFKey dof;
+
+  /// Probability of proposing a local continuous move, rather than an
+  /// occupation move, if both are possible
+  double probability = 0.5;
+
+  /// Maximum step length, in the prim DoF basis
+  double max_step = 0.1;
+
+  /// If true, keep site values at unit length (i.e. for spins)
+  bool normalize = false;
+
+  /// Fraction of local continuous moves that are over-relaxation moves
+  double over_relaxation = 0.0;
+};
+
+/// \brief Proposes changes to a local continuous DoF at randomly chosen sites
+///
+/// Two types of moves are proposed:
+/// - Random step: the value on a random site is displaced by a vector drawn
+///   uniformly from the ball of radius `max_step` (and renormalized if
+///   `normalize` is true). These moves are symmetric.
+/// - Over-relaxation: the value on a random site is reflected about the local
+///   field, `h`, which is the part of the energy linear in the site value.
+///   Reflection preserves `h.dot(value)`, so for bilinear (Heisenberg-like)
+///   interactions these moves do not change the energy and decorrelate spin
+///   configurations quickly. The reflection is an involution as long as `h`
+///   does not depend on the current site value, so these moves are also
+///   symmetric and may be accepted with the usual Metropolis criterion.
+class LocalContinuousMoveProposer {
+ public:
+  /// \brief Constructor
+  LocalContinuousMoveProposer(ConfigDoF const &configdof,
+                              LocalContinuousMoveSettings const &settings);
+
+  /// \brief Settings
+  LocalContinuousMoveSettings const &settings() const { return m_settings; }
+
+  /// \brief Number of sites with the local continuous DoF
+  Index size() const { return m_site_index.size(); }
+
+  /// \brief Linear index of sites with the local continuous DoF
+  std::vector<Index> const &site_index() const { return m_site_index; }
+
+  /// \brief DoF dimension on a site, by linear site index
+  Index site_dim(Index linear_site_index) const;
+
+  /// \brief Choose whether the next move is an over-relaxation move
+  bool choose_over_relaxation(MTRand &mtrand) const;
+
+  /// \brief Propose a random step on a randomly chosen site
+  LocalContinuousMod &propose(LocalContinuousMod &mod,
+                              ConfigDoF const &configdof,
+                              MTRand &mtrand) const;
+
+  /// \brief Choose a random site for an over-relaxation move
+  Index propose_site(MTRand &mtrand) const;
+
+  /// \brief Propose an over-relaxation move, reflecting the current value on
+  /// a site about the local field
+  LocalContinuousMod &propose_over_relaxation(
+      LocalContinuousMod &mod, Index linear_site_index,
+      Eigen::VectorXd const &local_field, ConfigDoF const &configdof) const;
+
+ private:
+  LocalContinuousMoveSettings m_settings;
+
+  /// Linear index of sites with the DoF
+  std::vector<Index> m_site_index;
+
+  /// DoF dimension by sublattice
+  std::vector<Index> m_sublat_dim;
+
+  /// Number of unit cells in the supercell
+  Index m_volume;
+};
+
+}  // namespace Monte
+}  // namespace CASM
+
+#endif
@@ -1,14 +1,18 @@
 #ifndef CASM_MonteCorrlations
 #define CASM_MonteCorrlations
 
+#include "casm/crystallography/DoFDecl.hh"
 #include "casm/global/definitions.hh"
 #include "casm/global/eigen.hh"
+#include "casm/monte_carlo/DoFMod.hh"
 
 namespace CASM {
 
 class Clexulator;
+class ClexulatorContext;
 class ConfigDoF;
 class Conversions;
+class ECIContainer;
 
 namespace clexulator {
 class SuperNeighborList;
@@ -29,6 +33,22 @@ void restricted_delta_corr(Eigen::VectorXd &dcorr, OccEvent const &occ_event,
                            unsigned int const *corr_indices_begin,
                            unsigned int const *corr_indices_end);
 
+/// \brief Sets change in (extensive) correlations due to a local continuous
+/// DoF change, restricted to specified correlations
+void restricted_delta_corr(Eigen::VectorXd &dcorr,
+                           LocalContinuousMod const &local_continuous_mod,
+                           DoFKey const &dof_key, ConfigDoF const &configdof,
+                           SuperNeighborList const &supercell_neighbor_list,
+                           ClexulatorContext &context,
+                           unsigned int const *corr_indices_begin,
+                           unsigned int const *corr_indices_end);
+
+/// \brief Sets the local field acting on a local continuous DoF site
+void local_field(Eigen::VectorXd &field, Index linear_site_index,
+                 DoFKey const &dof_key, ConfigDoF const &configdof,
+                 SuperNeighborList const &supercell_neighbor_list,
+                 ClexulatorContext &context, ECIContainer const &eci);
+
 }  // namespace Monte
 }  // namespace CASM
 
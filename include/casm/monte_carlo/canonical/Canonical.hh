@@ -2,8 +2,10 @@
 #define CASM_Canonical_HH
 
 #include "casm/clex/Clex.hh"
+#include "casm/clex/ClexulatorContext.hh"
 #include "casm/enumerator/OrderParameter.hh"
 #include "casm/monte_carlo/Conversions.hh"
+#include "casm/monte_carlo/LocalContinuousMove.hh"
 #include "casm/monte_carlo/MonteCarlo.hh"
 #include "casm/monte_carlo/MonteDefinitions.hh"
 #include "casm/monte_carlo/OccCandidate.hh"
@@ -42,7 +44,8 @@ class Canonical : public MonteCarlo {
   Canonical(const PrimClex &primclex, const SettingsType &settings, Log &_log);
 
   /// \brief Return number of steps per pass. Equals number of sites with
-  /// variable occupation.
+  /// variable occupation, plus the number of sites with the local continuous
+  /// DoF if local continuous moves are enabled.
   size_type steps_per_pass() const;
 
   /// \brief Return current conditions
@@ -153,6 +156,9 @@ class Canonical : public MonteCarlo {
   /// \brief Calculate delta correlations for an event
   void _set_dCorr(CanonicalEvent &event) const;
 
+  /// \brief Propose a local continuous DoF change
+  void _propose_local_continuous(CanonicalEvent &event);
+
   /// \brief Print correlations to _log()
   void _print_correlations(const Eigen::VectorXd &corr, std::string title,
                            std::string colheader) const;
@@ -218,6 +224,12 @@ class Canonical : public MonteCarlo {
   /// Event to propose, check, accept/reject:
   CanonicalEvent m_event;
 
+  /// Proposes local continuous DoF changes, if enabled
+  std::unique_ptr<LocalContinuousMoveProposer> m_local_continuous;
+
+  /// Used to evaluate delta correlations for local continuous DoF changes
+  std::unique_ptr<ClexulatorContext> m_context;
+
   // ---- Pointers to properties for faster access
 
   /// \brief Formation energy, normalized per primitive cell
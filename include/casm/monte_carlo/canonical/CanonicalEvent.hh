@@ -3,6 +3,7 @@
 
 #include "casm/external/Eigen/Dense"
 #include "casm/global/definitions.hh"
+#include "casm/monte_carlo/DoFMod.hh"
 #include "casm/monte_carlo/MonteDefinitions.hh"
 #include "casm/monte_carlo/OccLocation.hh"
 
@@ -67,6 +68,21 @@ class CanonicalEvent {
   /// \brief const Access the data describing this event
   const OccEvent &occ_event() const;
 
+  /// \brief True if this event is a local continuous DoF change, false if it
+  /// is an occupation change
+  bool is_local_continuous() const;
+
+  /// \brief Set whether this event is a local continuous DoF change
+  void set_is_local_continuous(bool _is_local_continuous);
+
+  /// \brief Access the local continuous DoF change (valid if
+  /// `is_local_continuous()`)
+  LocalContinuousMod &local_continuous_mod();
+
+  /// \brief const Access the local continuous DoF change (valid if
+  /// `is_local_continuous()`)
+  const LocalContinuousMod &local_continuous_mod() const;
+
  private:
   /// \brief Change in (extensive) correlations due to this event
   Eigen::VectorXd m_dCorr;
@@ -86,6 +102,12 @@ class CanonicalEvent {
 
   /// \brief The modifications performed by this event
   OccEvent m_occ_event;
+
+  /// \brief True if this event is a local continuous DoF change
+  bool m_is_local_continuous = false;
+
+  /// \brief The local continuous DoF change performed by this event
+  LocalContinuousMod m_local_continuous_mod;
 };
 
 }  // namespace Monte
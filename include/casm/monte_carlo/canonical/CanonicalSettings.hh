@@ -1,7 +1,10 @@
 #ifndef CASM_CanonicalSettings
 #define CASM_CanonicalSettings
 
+#include <optional>
+
 #include "casm/enumerator/OrderParameter.hh"
+#include "casm/monte_carlo/LocalContinuousMove.hh"
 #include "casm/monte_carlo/MonteSettings.hh"
 
 namespace CASM {
@@ -46,6 +49,10 @@ class CanonicalSettings : public EquilibriumMonteSettings {
   std::shared_ptr<std::vector<std::vector<int>>>
   make_order_parameter_subspaces() const;
 
+  /// \brief Make local continuous DoF move settings, if any
+  std::optional<LocalContinuousMoveSettings>
+  make_local_continuous_move_settings() const;
+
   // --- Sampler settings ---------------------
 
   /// \brief Construct MonteSamplers as specified in the MonteSettings
@@ -0,0 +1,19 @@
+#ifndef CASM_Monte_LocalContinuousMove_json_io
+#define CASM_Monte_LocalContinuousMove_json_io
+
+namespace CASM {
+class jsonParser;
+
+namespace Monte {
+
+struct LocalContinuousMoveSettings;
+
+jsonParser &to_json(LocalContinuousMoveSettings const &settings,
+                    jsonParser &json);
+
+void from_json(LocalContinuousMoveSettings &settings, jsonParser const &json);
+
+}  // namespace Monte
+}  // namespace CASM
+
+#endif
@@ -5,6 +5,7 @@
 
 #include "casm/container/multivector.hh"
 #include "casm/external/Eigen/Core"
+#include "casm/external/Eigen/SparseCore"
 #include "casm/global/definitions.hh"
 
 namespace CASM {
@@ -12,6 +13,7 @@ namespace CASM {
 namespace SymRepTools_v2 {
 
 typedef std::vector<Eigen::MatrixXd> MatrixRep;
+typedef std::vector<Eigen::SparseMatrix<double>> SparseMatrixRep;
 typedef std::set<Index> GroupIndices;
 typedef std::set<GroupIndices> GroupIndicesOrbit;
 typedef std::vector<GroupIndicesOrbit> GroupIndicesOrbitVector;
@@ -74,12 +76,36 @@ struct IrrepDecomposition {
                      GroupIndicesOrbitVector const &_all_subgroups,
                      bool allow_complex);
 
+  /// IrrepDecomposition constructor, using a sparse representation
+  IrrepDecomposition(SparseMatrixRep const &_fullspace_rep,
+                     GroupIndices const &_head_group,
+                     GroupIndices const &_translation_group,
+                     Eigen::MatrixXd const &_init_subspace,
+                     GroupIndicesOrbitVector const &_cyclic_subgroups,
+                     GroupIndicesOrbitVector const &_all_subgroups,
+                     bool allow_complex);
+
   /// Full space matrix representation of head_group
   ///
   /// fullspace_rep[i].rows() == full space dimension
   /// fullspace_rep[i].cols() == full space dimension
+  ///
+  /// Empty if constructed from a sparse representation, use
+  /// `fullspace_matrix` or `apply` to access either representation.
   MatrixRep fullspace_rep;
 
+  /// Full space sparse matrix representation of head_group, if constructed
+  /// from a sparse representation, else empty
+  SparseMatrixRep sparse_fullspace_rep;
+
+  /// Dense full space matrix representation of element `element_index`
+  Eigen::MatrixXd fullspace_matrix(Index element_index) const;
+
+  /// Apply the full space matrix representation of element `element_index`
+  /// to the columns of `vectors`
+  Eigen::MatrixXd apply(Index element_index,
+                        Eigen::MatrixXd const &vectors) const;
+
   /// Group (as indices into fullspace_rep) used to find irreps
   GroupIndices head_group;
 
@@ -122,6 +148,11 @@ SymRepTools_v2::IrrepDecomposition make_irrep_decomposition(
     SymGroupRep const &rep, SymGroup const &head_group,
     Eigen::MatrixXd const &_init_subspace, bool allow_complex);
 
+/// Make an IrrepDecompotion using a sparse representation of CASM::SymGroup
+SymRepTools_v2::IrrepDecomposition make_irrep_decomposition(
+    SymRepTools_v2::SparseMatrixRep const &rep, SymGroup const &head_group,
+    Eigen::MatrixXd const &_init_subspace, bool allow_complex);
+
 }  // namespace CASM
 
 #endif
@@ -203,6 +203,38 @@ std::vector<IrrepInfo> symmetrize_irreps(
     GroupIndicesOrbitVector const &cyclic_subgroups,
     GroupIndicesOrbitVector const &all_subgroups);
 
+/// \brief Find symmetrized irreps that span an invariant subspace
+std::vector<IrrepInfo> make_symmetrized_irreps(
+    MatrixRep const &rep, GroupIndices const &head_group,
+    Eigen::MatrixXd const &subspace,
+    GroupIndicesOrbitVector const &cyclic_subgroups,
+    GroupIndicesOrbitVector const &all_subgroups, bool allow_complex);
+
+/// Orthonormal basis for the null space of `matrix`
+Eigen::MatrixXd make_null_space(Eigen::MatrixXd const &matrix);
+
+/// Expand subspace by application of group, and orthogonalize
+Eigen::MatrixXd make_invariant_space(SparseMatrixRep const &rep,
+                                     GroupIndices const &head_group,
+                                     Eigen::MatrixXd const &subspace);
+
+// Create `subspace_rep`, a transformed copy of `fullspace_rep` that acts
+// on coordinates with `subspace` columns as a basis. Matrices in
+// `subspace_rep` are shape (subspace.cols() x subspace.cols())
+MatrixRep make_subspace_rep(SparseMatrixRep const &fullspace_rep,
+                            Eigen::MatrixXd const &subspace);
+
+/// \brief Find sets of full space coordinates that are not mixed by any
+/// element of head_group
+std::vector<std::vector<Index>> make_invariant_blocks(
+    SparseMatrixRep const &rep, GroupIndices const &head_group);
+
+/// \brief Split an invariant subspace into smaller orthogonal invariant
+/// subspaces, using invariant blocks and translations
+std::vector<Eigen::MatrixXd> make_blocked_subspaces(
+    SparseMatrixRep const &rep, GroupIndices const &head_group,
+    GroupIndices const &translation_group, Eigen::MatrixXd const &subspace);
+
 }  // namespace IrrepDecompositionImpl
 
 }  // namespace SymRepTools_v2
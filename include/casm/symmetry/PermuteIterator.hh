@@ -14,6 +14,56 @@ namespace CASM {
  *  @{
  */
 
+class PermuteIterator;
+
+/// \brief Site permutation of the operation a PermuteIterator points at
+///
+/// `operator[](i)` is equivalent to `permute_it.permute_ind(i)`, but the
+/// permutation rows are looked up once, at construction, from the
+/// SupercellPermutationTable or, if the table stores nothing, from the factor
+/// group and translation permutations. Loops over sites then only index
+/// arrays.
+///
+/// Usage:
+/// \code
+/// PermuteIndices permute_ind(permute_it);
+/// for (Index i = 0; i < n_sites; ++i) {
+///   after[i] = before[permute_ind[i]];
+/// }
+/// \endcode
+///
+/// - Only valid while `permute_it` exists and is unchanged
+class PermuteIndices {
+ public:
+  typedef SupercellPermutationTable::value_type value_type;
+
+  /// \brief Construct empty, not valid for `operator[]`
+  PermuteIndices();
+
+  explicit PermuteIndices(PermuteIterator const &permute_it);
+
+  Index operator[](Index i) const {
+    if (m_row) {
+      return m_factor_group ? m_factor_group[m_row[i]] : m_row[i];
+    }
+    return m_factor_group_permute[m_translation_permute[i]];
+  }
+
+ private:
+  /// Combined permutation row (Layout::combined), or translation row
+  /// (Layout::factored)
+  value_type const *m_row;
+
+  /// Factor group permutation row (Layout::factored)
+  value_type const *m_factor_group;
+
+  /// Factor group permutation (Layout::none)
+  Index const *m_factor_group_permute;
+
+  /// Translation permutation (Layout::none)
+  Index const *m_translation_permute;
+};
+
 /// Iterate over all combined factor group and translation permutations for a
 /// Supercell
 ///
@@ -39,6 +89,10 @@ namespace CASM {
 /// Bidirectional iterators are supposed to be input/output iterators, but this
 /// is actually only an input iterator (meaning operator* returns by value).
 ///
+/// PermuteIterator only points to its SupercellSymInfo, it does not share
+/// ownership. If a Supercell is registered with a SupercellLRU, protect loops
+/// over its PermuteIterator that span calls to `SupercellLRU::shrink` with a
+/// SupercellPin.
 ///
 class PermuteIterator
     : public std::iterator<std::bidirectional_iterator_tag, PermuteIterator>,
@@ -161,6 +215,16 @@ class PermuteIterator
   /// Translation currently stored in m_tmp_translation_permute
   mutable Index m_tmp_translation_index;
 
+  /// Site permutation used by permute_ind, looked up when the operation
+  /// changes
+  mutable PermuteIndices m_tmp_indices;
+
+  /// Factor group index of the operation stored in m_tmp_indices
+  mutable Index m_tmp_indices_factor_group_index;
+
+  /// Translation index of the operation stored in m_tmp_indices
+  mutable Index m_tmp_indices_translation_index;
+
   bool eq_impl(const PermuteIterator &iter) const;
 };
 
@@ -0,0 +1,26 @@
+#ifndef CASM_symmetry_SparseCollectiveDoFSymRep
+#define CASM_symmetry_SparseCollectiveDoFSymRep
+
+#include <set>
+#include <vector>
+
+#include "casm/crystallography/DoFDecl.hh"
+#include "casm/symmetry/IrrepDecomposition.hh"
+#include "casm/symmetry/SymGroup.hh"
+
+namespace CASM {
+
+class PermuteIterator;
+class SupercellSymInfo;
+
+/// \brief Make the sparse matrix representation for group '_group'
+/// describing the transformation of DoF '_key' among a subset of sites
+std::pair<MasterSymGroup, SymRepTools_v2::SparseMatrixRep>
+make_sparse_collective_dof_symrep(std::set<Index> const &site_indices,
+                                  SupercellSymInfo const &_syminfo,
+                                  DoFKey const &_key,
+                                  std::vector<PermuteIterator> const &_group);
+
+}  // namespace CASM
+
+#endif
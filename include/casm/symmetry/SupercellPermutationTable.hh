@@ -0,0 +1,150 @@
+#ifndef CASM_SupercellPermutationTable
+#define CASM_SupercellPermutationTable
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "casm/global/definitions.hh"
+
+namespace CASM {
+
+class SupercellSymInfo;
+
+/** \ingroup SymOp
+ *  @{
+ */
+
+/// \brief Materialized site permutations of the symmetry operations of a
+/// supercell
+///
+/// `PermuteIterator::permute_ind(i)` composes a factor group permutation and a
+/// translation permutation, which are stored separately (and, for supercells
+/// with more than 100 unit cells, the translation permutation is re-generated
+/// whenever the translation changes). SupercellPermutationTable stores the
+/// same permutations as contiguous arrays of 32-bit indices so that loops over
+/// sites in equivalence and canonical form checks read contiguous memory.
+///
+/// There are three layouts, chosen by available memory:
+/// - Layout::combined: One row of `n_sites()` values for every
+///   (factor_group_index, translation_index) pair, in PermuteIterator order:
+///   `combined(f, t)[i] == permute_it(f, t).permute_ind(i)`. Requires
+///   `n_factor_group() * n_translations() * n_sites()` values.
+/// - Layout::factored: One row per factor group operation and one row per
+///   translation, so that `permute_ind(i) == factor_group(f)[translation(t)[i]]`.
+///   Requires `(n_factor_group() + n_translations()) * n_sites()` values.
+/// - Layout::none: Nothing is stored.
+///
+/// The rows may be owned by the table or, for tables read from a
+/// SupercellSymCache, by a read-only memory-mapped file.
+///
+/// Usage:
+/// \code
+/// // materialize, using at most 256 MB
+/// sym_info.materialize_permutations(256 * 1024 * 1024);
+///
+/// // PermuteIterator::permute_ind and PermuteIndices use the table
+/// // automatically, or:
+/// SupercellPermutationTable const &table = sym_info.permutation_table();
+/// if (table.layout() == SupercellPermutationTable::Layout::combined) {
+///   SupercellPermutationTable::value_type const *row = table.combined(f, t);
+///   for (Index i = 0; i < table.n_sites(); ++i) {
+///     after[i] = before[row[i]];
+///   }
+/// }
+/// \endcode
+class SupercellPermutationTable {
+ public:
+  typedef std::uint32_t value_type;
+
+  enum class Layout { none, factored, combined };
+
+  /// \brief Construct an empty table, with Layout::none
+  SupercellPermutationTable();
+
+  /// \brief Construct the largest layout that requires at most `max_bytes`
+  SupercellPermutationTable(SupercellSymInfo const &sym_info,
+                            std::size_t max_bytes);
+
+  /// \brief Construct with a particular layout
+  SupercellPermutationTable(SupercellSymInfo const &sym_info, Layout layout);
+
+  /// \brief Construct a table that uses existing data (i.e. a memory-mapped
+  /// file)
+  SupercellPermutationTable(Layout layout, Index n_factor_group,
+                            Index n_translations, Index n_sites,
+                            std::shared_ptr<void const> storage,
+                            value_type const *data);
+
+  /// \brief Bytes required to store a particular layout
+  static std::size_t required_bytes(Layout layout, Index n_factor_group,
+                                    Index n_translations, Index n_sites);
+
+  Layout layout() const { return m_layout; }
+
+  Index n_factor_group() const { return m_n_factor_group; }
+
+  Index n_translations() const { return m_n_translations; }
+
+  Index n_sites() const { return m_n_sites; }
+
+  /// \brief Bytes used by the stored permutations
+  std::size_t memory_size() const {
+    return required_bytes(m_layout, m_n_factor_group, m_n_translations,
+                          m_n_sites);
+  }
+
+  /// \brief Stored permutations, all rows in layout order
+  value_type const *data() const { return m_data; }
+
+  /// \brief Combined permutation row (Layout::combined only)
+  value_type const *combined(Index factor_group_index,
+                             Index translation_index) const {
+    return m_data +
+           (factor_group_index * m_n_translations + translation_index) *
+               m_n_sites;
+  }
+
+  /// \brief Factor group permutation row (Layout::factored only)
+  value_type const *factor_group(Index factor_group_index) const {
+    return m_data + factor_group_index * m_n_sites;
+  }
+
+  /// \brief Translation permutation row (Layout::factored only)
+  value_type const *translation(Index translation_index) const {
+    return m_data + (m_n_factor_group + translation_index) * m_n_sites;
+  }
+
+  /// \brief Equivalent to `permute_it(f, t).permute_ind(i)` (requires layout()
+  /// != Layout::none)
+  Index permute_ind(Index factor_group_index, Index translation_index,
+                    Index i) const {
+    if (m_layout == Layout::combined) {
+      return combined(factor_group_index, translation_index)[i];
+    }
+    return factor_group(factor_group_index)[translation(translation_index)[i]];
+  }
+
+ private:
+  Layout m_layout;
+
+  Index m_n_factor_group;
+
+  Index m_n_translations;
+
+  Index m_n_sites;
+
+  /// Owns the memory pointed to by m_data. Rows are never modified, so copies
+  /// of a table share storage.
+  std::shared_ptr<void const> m_storage;
+
+  /// Rows, in layout order. For Layout::factored, factor group rows are
+  /// followed by translation rows.
+  value_type const *m_data;
+};
+
+/** @} */
+}  // namespace CASM
+
+#endif
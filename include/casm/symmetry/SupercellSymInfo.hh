@@ -8,6 +8,7 @@
 #include "casm/crystallography/LinearIndexConverter.hh"
 #include "casm/crystallography/Superlattice.hh"
 #include "casm/global/eigen.hh"
+#include "casm/symmetry/SupercellPermutationTable.hh"
 #include "casm/symmetry/SymGroup.hh"
 #include "casm/symmetry/SymGroupRep.hh"
 #include "casm/symmetry/SymGroupRepID.hh"
@@ -34,6 +35,10 @@ Permutation make_translation_permutation(
 std::vector<Permutation> make_translation_permutations(
     const Eigen::Matrix3l &transformation_matrix, int basis_sites_in_prim);
 
+/// \brief Default memory budget, in bytes, for materializing SupercellSymInfo
+/// site permutations
+std::size_t default_permutation_table_max_bytes();
+
 /// \brief A class that collects all symmetry information for for performing
 /// symmetry transformations on the site indices, site DoFs, and global DoFs of
 /// a Supercell or Configuration
@@ -123,6 +128,19 @@ class SupercellSymInfo {
     return m_translation_permutations;
   }
 
+  /// \brief Materialize site permutations of all supercell operations, using
+  /// at most `max_bytes`
+  SupercellPermutationTable::Layout materialize_permutations(
+      std::size_t max_bytes) const;
+
+  /// \brief Use previously materialized site permutations
+  void set_permutation_table(SupercellPermutationTable table) const;
+
+  /// \brief Materialized site permutations (Layout::none if not materialized)
+  SupercellPermutationTable const &permutation_table() const {
+    return m_permutation_table;
+  }
+
   /// \brief Subgroup of primitive-cell factor group operations that leave
   /// supercell lattice invariant
   SymGroup const &factor_group() const { return m_factor_group; }
@@ -240,6 +258,9 @@ class SupercellSymInfo {
   //       encounter the gaps OR, see note for Supercell::permutation_symrep()
   //       below.
   mutable SymGroupRep::RemoteHandle m_site_perm_symrep;
+
+  /// Materialized site permutations, see materialize_permutations
+  mutable SupercellPermutationTable m_permutation_table;
 };
 
 std::string hermite_normal_form_name(const Eigen::Matrix3l &matrix);
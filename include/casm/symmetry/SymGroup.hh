@@ -1,9 +1,13 @@
 #ifndef SYMGROUP_HH
 #define SYMGROUP_HH
 
+#include <array>
+#include <atomic>
 #include <iomanip>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 
@@ -280,6 +284,46 @@ SymGroup molecular_point_group(
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
+/// \brief Array of SymGroupRep pointers, used by MasterSymGroup
+///
+/// Entries are stored in blocks of doubling size that are never moved, so
+/// existing entries may be read by one thread while another thread appends.
+/// Appending and clearing require external synchronization. Does not own the
+/// SymGroupRep.
+class SymGroupRepArray {
+ public:
+  SymGroupRepArray() : m_size(0) {}
+
+  SymGroupRepArray(SymGroupRepArray const &) = delete;
+  SymGroupRepArray &operator=(SymGroupRepArray const &) = delete;
+
+  Index size() const { return m_size.load(std::memory_order_acquire); }
+
+  SymGroupRep *operator[](Index i) const {
+    Index b = _block(i);
+    return m_blocks[b][i + 1 - (Index(1) << b)];
+  }
+
+  SymGroupRep *back() const { return (*this)[size() - 1]; }
+
+  void push_back(SymGroupRep *rep);
+
+  void clear();
+
+ private:
+  /// Block b holds entries [2^b - 1, 2^(b+1) - 1)
+  static Index _block(Index i) {
+    Index b = 0;
+    for (Index n = (i + 1) >> 1; n; n >>= 1) {
+      ++b;
+    }
+    return b;
+  }
+
+  std::array<std::unique_ptr<SymGroupRep *[]>, 64> m_blocks;
+  std::atomic<Index> m_size;
+};
+
 class MasterSymGroup : public SymGroup {
   // NOTE: It may be useful to store a user-specified set of "favored
   // directions" in MasterSymGroup
@@ -368,7 +412,12 @@ class MasterSymGroup : public SymGroup {
 
   /// Collection of alternate representations of this symmetry group
   /// Stored as pointers to avoid weird behavior with resizing
-  mutable std::vector<SymGroupRep *> m_rep_array;
+  mutable SymGroupRepArray m_rep_array;
+
+  /// Serializes adding representations and the lazily constructed
+  /// representations and point group, so that Supercell may be constructed
+  /// by multiple threads sharing one prim
+  mutable std::recursive_mutex m_rep_mutex;
 
   /// ID of Cartesian representation
   mutable SymGroupRepID m_coord_rep_ID;
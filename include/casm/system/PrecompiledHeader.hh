@@ -0,0 +1,71 @@
+#ifndef CASM_PrecompiledHeader_HH
+#define CASM_PrecompiledHeader_HH
+
+#include <boost/filesystem/path.hpp>
+#include <string>
+#include <vector>
+
+#include "casm/global/definitions.hh"
+
+namespace CASM {
+
+/// \brief Build and maintain a precompiled header for runtime compilation
+///
+/// A PrecompiledHeader manages four files in a directory:
+/// - `<name>.hh`: the header, containing the `#include` lines given at
+///   construction
+/// - `<name>.hh.gch`: the precompiled header
+/// - `<name>.hh.d`: the dependency file written by the compiler when the
+///   precompiled header was built, used to detect header changes
+/// - `<name>.hh.cmd`: the command used to build the precompiled header
+///
+/// The precompiled header is rebuilt if the header contents or the compile
+/// options change, or if any header it depends on is newer than the
+/// precompiled header. Using a precompiled header requires that it is built
+/// with the same compile options as the source files that use it, so the
+/// directory should be specific to one set of compile options.
+///
+/// Usage:
+/// \code
+/// PrecompiledHeader pch(dir, "clexulator_pch", includes, compile_options);
+/// pch.update();  // throws if the precompiled header can not be built
+/// std::string cmd = compile_options + " " + pch.include_option() + ...;
+/// \endcode
+///
+class PrecompiledHeader {
+ public:
+  /// \brief Constructor
+  PrecompiledHeader(fs::path dir, std::string name,
+                    std::vector<std::string> includes,
+                    std::string compile_options);
+
+  /// \brief Path to the header
+  fs::path header() const;
+
+  /// \brief Path to the precompiled header
+  fs::path precompiled_header() const;
+
+  /// \brief True if the precompiled header exists and is up-to-date
+  bool is_current() const;
+
+  /// \brief Build the precompiled header, if it is not up-to-date
+  void update();
+
+  /// \brief Compiler option that includes the header, and so uses the
+  /// precompiled header if it is valid
+  std::string include_option() const;
+
+ private:
+  std::string _header_contents() const;
+
+  std::string _build_command() const;
+
+  fs::path m_dir;
+  std::string m_name;
+  std::vector<std::string> m_includes;
+  std::string m_compile_options;
+};
+
+}  // namespace CASM
+
+#endif
@@ -80,6 +80,13 @@ class RuntimeLibrary {
   /// \brief Return default compiler
   static std::pair<std::string, std::string> default_cxx();
 
+  /// \brief Return default precompiled header mode ("on" or "off")
+  static std::pair<std::string, std::string> default_pch_mode();
+
+  /// \brief Return default profile-guided optimization mode ("off",
+  /// "generate", or "use")
+  static std::pair<std::string, std::string> default_pgo_mode();
+
   /// \brief Return default includedir for CASM
   static std::pair<fs::path, std::string> default_casm_includedir();
 
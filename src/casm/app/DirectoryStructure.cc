@@ -164,6 +164,20 @@ fs::path DirectoryStructure::scel_list() const {
   return m_root / m_casm_dir / "scel_list.json";
 }
 
+/// \brief Return directory containing cached supercell symmetry data
+///
+/// See SupercellSymCache. Contents may be deleted at any time.
+fs::path DirectoryStructure::supercell_cache_dir() const {
+  return m_root / m_casm_dir / "cache" / "supercell";
+}
+
+/// \brief Return cached correlations file path for a basis set
+///
+/// See CorrelationCache. Contents may be deleted at any time.
+fs::path DirectoryStructure::correlation_cache(std::string bset) const {
+  return m_root / m_casm_dir / "cache" / "correlations" / (bset + ".bin");
+}
+
 /// \brief Return master config_list.json file path
 fs::path DirectoryStructure::config_list() const {
   return m_root / m_casm_dir / "config_list.json";
@@ -285,6 +299,15 @@ fs::path DirectoryStructure::clexulator_so(std::string project_name,
   return bset_dir(bset) / (project_name + "_Clexulator_" + bset + ".so");
 }
 
+/// \brief Returns path to directory containing precompiled headers used to
+/// compile clexulators
+///
+/// Precompiled headers depend on the compile options, so each set of compile
+/// options uses a separate subdirectory.
+fs::path DirectoryStructure::clexulator_pch_dir() const {
+  return casm_dir() / "pch";
+}
+
 /// \brief Returns path to directory containing equivalent clexulator files
 fs::path DirectoryStructure::equivalent_clexulator_dir(
     std::string bset, int equivalent_index) const {
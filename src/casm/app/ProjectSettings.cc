@@ -542,6 +542,11 @@ jsonParser &to_json(const ProjectSettings &set, jsonParser &json) {
   json["lin_alg_tol"].set_scientific();
   json["query_alias"] = set.query_alias();
 
+  // only write database type if not the default
+  if (set.default_database_name() != "jsonDB") {
+    json["database"] = set.default_database_name();
+  }
+
   return json;
 }
 
@@ -627,6 +632,9 @@ ProjectSettings jsonConstructor<ProjectSettings>::from_json(
     if (json.get_if(tmp_str, "view_command_video")) {
       settings.set_view_command_video(tmp_str);
     }
+    if (json.get_if(tmp_str, "database")) {
+      settings.set_default_database_name(tmp_str);
+    }
 
     // precision options -- always set
     double tmp_double = TOL;
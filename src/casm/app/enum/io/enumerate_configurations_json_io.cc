@@ -81,6 +81,10 @@ void parse(InputParser<ConfigEnumOptions> &parser, std::string method_name,
 
   parser.optional_else(options.dry_run, "dry_run", false);
 
+  parser.optional_else(options.n_threads, "n_threads", Index(0));
+
+  parser.optional_else(options.batch_size, "batch_size", Index(1000));
+
   options.verbosity = parse_verbosity(parser);
 
   parser.optional(options.filter_expression, "filter");
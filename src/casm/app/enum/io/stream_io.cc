@@ -1,8 +1,64 @@
+#include <chrono>
+#include <sstream>
+
 #include "casm/app/enum/enumerate_configurations.hh"
+#include "casm/app/enum/io/stream_io.hh"
 #include "casm/casm_io/Log.hh"
+#include "casm/casm_io/json/jsonParser.hh"
+#include "casm/clex/OccupationCanonicalForm.hh"
+#include "casm/clex/OccupationOrbitCount.hh"
+#include "casm/clex/Supercell.hh"
+#include "casm/clex/io/json/ConfigDoF_json_io.hh"
+#include "casm/enumerator/ConfigEnumInput.hh"
+#include "casm/external/MersenneTwister/MersenneTwister.h"
 
 namespace CASM {
 
+namespace {
+
+/// Estimate the time (ms) ConfigEnumAllOccupations spends per occupation
+///
+/// Times the primitive and canonical checks on random occupations of
+/// `configuration`, for up to `max_samples` samples or about `max_ms`.
+double time_per_occupation_ms(Configuration configuration,
+                              Eigen::VectorXi const &max_allowed_occupation,
+                              Index max_samples = 100, double max_ms = 100.) {
+  typedef std::chrono::steady_clock clock;
+  MTRand mtrand(MTRand::uint32(0));
+  Eigen::VectorXi occupation(max_allowed_occupation.size());
+  double total_ms = 0.;
+  Index n_samples = 0;
+  while (n_samples < max_samples && total_ms < max_ms) {
+    for (Index i = 0; i < occupation.size(); ++i) {
+      occupation(i) = mtrand.randInt(max_allowed_occupation(i));
+    }
+    auto start = clock::now();
+    configuration.set_occupation(occupation);
+    if (configuration.is_primitive()) {
+      configuration.is_canonical();
+    }
+    total_ms += std::chrono::duration<double, std::milli>(clock::now() - start)
+                    .count();
+    ++n_samples;
+  }
+  return total_ms / n_samples;
+}
+
+/// Estimate the size (bytes) of one configuration in the configuration
+/// database, as written by jsonDatabase<Configuration>::commit
+double bytes_per_configuration(Configuration const &configuration) {
+  jsonParser json;
+  jsonParser &configjson = json[configuration.supercell().name()]["0"];
+  to_json(configuration.configdof(), configjson["dof"]);
+  configjson["source"].put_array();
+  configjson["cache"].put_obj();
+  std::stringstream ss;
+  json.print(ss, 0);
+  return ss.str().size();
+}
+
+}  // namespace
+
 void print_options(Log &log, ConfigEnumOptions const &options) {
   log << std::boolalpha;
   log.indent() << "primitive_only: " << options.primitive_only << std::endl;
@@ -13,6 +69,7 @@ void print_options(Log &log, ConfigEnumOptions const &options) {
   }
   log.indent() << "verbosity: " << options.verbosity << std::endl;
   log.indent() << "dry_run: " << options.dry_run << std::endl;
+  log.indent() << "n_threads: " << options.n_threads << std::endl;
   log.indent() << "output_configurations: " << options.output_configurations
                << std::endl;
   if (options.output_configurations) {
@@ -29,4 +86,77 @@ void print_options(Log &log, ConfigEnumOptions const &options) {
   log << std::noboolalpha;
 }
 
+/// Print distinct configuration counts and estimated enumeration cost for
+/// enumerating all occupations
+///
+/// For each initial state where all sites are selected, prints:
+/// - the number of occupations that would be visited,
+/// - the exact number of distinct configurations (orbits under supercell
+///   symmetry), from Burnside's lemma, only counting primitive
+///   configurations if `primitive_only`,
+/// - the estimated enumeration time, in milliseconds, from timing canonical
+///   form checks on a sample of random occupations, and
+/// - the estimated configuration database size, in bytes.
+///
+/// Initial states with a subset of sites selected, anisotropic occupants, or
+/// non-zero continuous DoF are reported as not counted.
+void print_occupation_enumeration_estimates(
+    Log &log,
+    std::vector<std::pair<std::string, ConfigEnumInput>> const
+        &named_initial_states,
+    bool primitive_only) {
+  using boost::multiprecision::cpp_int;
+
+  cpp_int total_orbits = 0;
+  double total_ms = 0.;
+  double total_bytes = 0.;
+  bool all_counted = true;
+
+  log.indent() << "Estimated enumeration results"
+               << (primitive_only ? " (primitive only)" : "") << ":"
+               << std::endl;
+  log.increase_indent();
+  for (auto const &named_initial_state : named_initial_states) {
+    ConfigEnumInput const &initial_state = named_initial_state.second;
+    Configuration const &configuration = initial_state.configuration();
+    SupercellSymInfo const &sym_info = configuration.supercell().sym_info();
+
+    log.indent() << named_initial_state.first << ": ";
+    if (initial_state.sites().size() != configuration.size() ||
+        !is_occupation_only(configuration.configdof(), sym_info)) {
+      log << "not counted (requires all sites selected, isotropic "
+          << "occupants, and zero continuous DoF)" << std::endl;
+      all_counted = false;
+      continue;
+    }
+
+    Eigen::VectorXi max_allowed_occupation =
+        configuration.supercell().max_allowed_occupation();
+    cpp_int n_occupations = count_occupations(max_allowed_occupation);
+    cpp_int n_orbits =
+        primitive_only
+            ? count_primitive_occupation_orbits(sym_info,
+                                                max_allowed_occupation)
+            : count_occupation_orbits(sym_info, max_allowed_occupation);
+    double ms = n_occupations.convert_to<double>() *
+                time_per_occupation_ms(configuration, max_allowed_occupation);
+    double bytes =
+        n_orbits.convert_to<double>() * bytes_per_configuration(configuration);
+
+    log << "occupations: " << n_occupations << ", distinct: " << n_orbits
+        << ", est. time (ms): " << ms << ", est. database size (bytes): "
+        << bytes << std::endl;
+
+    total_orbits += n_orbits;
+    total_ms += ms;
+    total_bytes += bytes;
+  }
+  log.decrease_indent();
+  log.indent() << "Total" << (all_counted ? "" : " (counted states only)")
+               << ": distinct: " << total_orbits
+               << ", est. time (ms): " << total_ms
+               << ", est. database size (bytes): " << total_bytes << std::endl
+               << std::endl;
+}
+
 }  // namespace CASM
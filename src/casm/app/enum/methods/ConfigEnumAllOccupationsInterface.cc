@@ -40,7 +40,13 @@ std::string ConfigEnumAllOccupationsInterface::desc() const {
       "    allows including non-canonical configurations in the  \n"
       "    output generated when \"output_configurations\"==true.\n"
       "    The default value is true if enumeration is occuring  \n"
-      "    on all sites in the configuration, and false otherwise.\n\n";
+      "    on all sites in the configuration, and false otherwise.\n\n"
+
+      "  With --dry-run, instead of enumerating, the exact number of      \n"
+      "  distinct configurations for each initial state with all sites   \n"
+      "  selected is printed, along with the estimated enumeration time   \n"
+      "  and configuration database size. Only primitive configurations  \n"
+      "  are counted unless \"skip_non_primitive\"==false.\n\n";
 
   std::string examples =
       "  Examples:\n"
@@ -124,6 +130,14 @@ void ConfigEnumAllOccupationsInterface::run(
   report_and_throw_if_invalid(parser, log, error_if_invalid);
   auto const &named_initial_states = *input_parser_ptr->value;
   print_initial_states(log, named_initial_states);
+  if (options.dry_run) {
+    // primitive_only defaults to true when all sites are selected
+    log << std::endl;
+    print_occupation_enumeration_estimates(log, named_initial_states,
+                                           skip_non_primitive.value_or(true));
+    log.end_section();
+    return;
+  }
 
   // 3) Enumerate configurations ------------------
 
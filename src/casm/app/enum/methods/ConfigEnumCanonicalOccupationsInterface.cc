@@ -0,0 +1,142 @@
+#include "casm/app/enum/methods/ConfigEnumCanonicalOccupationsInterface.hh"
+
+#include "casm/app/APICommand.hh"
+#include "casm/app/ProjectSettings.hh"
+#include "casm/app/QueryHandler_impl.hh"
+#include "casm/app/enum/dataformatter/ConfigEnumIO_impl.hh"
+#include "casm/app/enum/enumerate_configurations_impl.hh"
+#include "casm/app/enum/io/enumerate_configurations_json_io.hh"
+#include "casm/app/enum/io/stream_io_impl.hh"
+#include "casm/app/enum/standard_ConfigEnumInput_help.hh"
+#include "casm/casm_io/dataformatter/DatumFormatterAdapter.hh"
+#include "casm/casm_io/json/InputParser_impl.hh"
+#include "casm/casm_io/json/optional.hh"
+#include "casm/clex/ConfigEnumCanonicalOccupations.hh"
+#include "casm/clex/PrimClex.hh"
+#include "casm/clusterography/ClusterSpecs_impl.hh"
+#include "casm/clusterography/io/json/ClusterSpecs_json_io.hh"
+#include "casm/enumerator/ConfigEnumInput.hh"
+#include "casm/enumerator/io/json/ConfigEnumInput_json_io.hh"
+
+namespace CASM {
+
+std::string ConfigEnumCanonicalOccupationsInterface::desc() const {
+  std::string description =
+      "  Enumerates the same configurations as ConfigEnumAllOccupations   \n"
+      "  enumerating on all sites, but generates only canonical           \n"
+      "  occupations directly, by assigning sites in order and abandoning \n"
+      "  partial occupations that cannot be completed to a canonical      \n"
+      "  occupation. This is much faster for large supercells.            \n"
+      "                                                                   \n"
+      "  Requirements: all sites must be selected, occupants must be      \n"
+      "  isotropic, and any continuous DoF of the initial configuration   \n"
+      "  must be zero.\n\n";
+
+  std::string custom_options =
+      "  skip_non_primitive: bool (optional, default=true)\n"
+      "    If true, non-primitive configurations are skipped in  \n"
+      "    the enumeration. If false, they are included. Whether \n"
+      "    they are included in the database or not is specified \n"
+      "    separately by the \"primitive_only\" option. This     \n"
+      "    option allows including non-primitive configurations  \n"
+      "    in the output generated when \"output_configurations\"==true.\n\n";
+
+  std::string examples =
+      "  Examples:\n"
+      "    To enumerate all occupations in supercells up to and including size "
+      "8:\n"
+      "      casm enum --method ConfigEnumCanonicalOccupations -i "
+      "'{\"supercells\": {\"max\": 8}}' \n"
+      "\n"
+      "    To enumerate all occupations in all existing supercells:\n"
+      "      casm enum --method ConfigEnumCanonicalOccupations --all\n\n";
+
+  return name() + ": \n\n" + description + standard_ConfigEnumInput_help() +
+         custom_options + examples;
+}
+
+std::string ConfigEnumCanonicalOccupationsInterface::name() const {
+  return ConfigEnumCanonicalOccupations::enumerator_name;
+}
+
+void ConfigEnumCanonicalOccupationsInterface::run(
+    PrimClex &primclex, jsonParser const &json_options,
+    jsonParser const &cli_options_as_json) const {
+  Log &log = CASM::log();
+
+  log.subsection().begin("ConfigEnumCanonicalOccupations");
+  ParentInputParser parser =
+      make_enum_parent_parser(log, json_options, cli_options_as_json);
+  std::runtime_error error_if_invalid{
+      "Error reading ConfigEnumCanonicalOccupations JSON input"};
+
+  log.custom("Checking input");
+
+  // 1a) Parse ConfigEnumOptions ------------------
+
+  auto options_parser_ptr = parser.parse_as<ConfigEnumOptions>(
+      ConfigEnumCanonicalOccupations::enumerator_name, primclex,
+      primclex.settings().query_handler<Configuration>().dict());
+  report_and_throw_if_invalid(parser, log, error_if_invalid);
+  ConfigEnumOptions const &options = *options_parser_ptr->value;
+  print_options(log, options);
+  log.set_verbosity(options.verbosity);
+
+  // 1b) Parse custom options ---------------------
+  bool skip_non_primitive = true;
+  parser.optional(skip_non_primitive, "skip_non_primitive");
+
+  log << std::boolalpha;
+  log.indent() << "skip_non_primitive: " << skip_non_primitive << std::endl;
+  log << std::noboolalpha;
+
+  // 2) Parse initial enumeration states ------------------
+
+  auto input_parser_ptr =
+      parser.parse_as<std::vector<std::pair<std::string, ConfigEnumInput>>>(
+          primclex.shared_prim(), &primclex, primclex.db<Supercell>(),
+          primclex.db<Configuration>());
+  report_and_throw_if_invalid(parser, log, error_if_invalid);
+  auto const &named_initial_states = *input_parser_ptr->value;
+  print_initial_states(log, named_initial_states);
+
+  // 3) Enumerate configurations ------------------
+
+  auto make_enumerator_f = [&](Index index, std::string name,
+                               ConfigEnumInput const &initial_state) {
+    return ConfigEnumCanonicalOccupations{initial_state, skip_non_primitive};
+  };
+
+  typedef ConfigEnumData<ConfigEnumCanonicalOccupations, ConfigEnumInput>
+      ConfigEnumDataType;
+  DataFormatter<ConfigEnumDataType> formatter;
+  formatter.push_back(ConfigEnumIO::canonical_configname<ConfigEnumDataType>(),
+                      ConfigEnumIO::selected<ConfigEnumDataType>(),
+                      ConfigEnumIO::is_new<ConfigEnumDataType>(),
+                      ConfigEnumIO::is_existing<ConfigEnumDataType>());
+  if (options.filter) {
+    formatter.push_back(
+        ConfigEnumIO::is_excluded_by_filter<ConfigEnumDataType>());
+  }
+  formatter.push_back(
+      ConfigEnumIO::initial_state_index<ConfigEnumDataType>(),
+      ConfigEnumIO::initial_state_name<ConfigEnumDataType>(),
+      ConfigEnumIO::initial_state_configname<ConfigEnumDataType>(),
+      ConfigEnumIO::n_selected_sites<ConfigEnumDataType>());
+  for (const auto &formatter_ptr : options.output_formatter.formatters()) {
+    formatter.push_back(
+        make_datum_formatter_adapter<ConfigEnumDataType, Configuration>(
+            *formatter_ptr));
+  }
+
+  log << std::endl;
+  log.begin("ConfigEnumCanonicalOccupations enumeration");
+
+  enumerate_configurations(primclex, options, make_enumerator_f,
+                           named_initial_states.begin(),
+                           named_initial_states.end(), formatter);
+
+  log.end_section();
+}
+
+}  // namespace CASM
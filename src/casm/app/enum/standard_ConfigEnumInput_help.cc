@@ -22,6 +22,19 @@ std::string standard_ConfigEnumInput_help() {
          "        \n"
          "    configurations are saved. \n\n"
 
+         "  n_threads: int (optional, default=0)\n"
+         "    Maximum number of threads used to make enumerated "
+         "configurations\n"
+         "    canonical. If < 1, use the value of the environment variable\n"
+         "    CASM_NUM_THREADS, else the number of available cores. Not used\n"
+         "    if `output_configurations==true`. \n\n"
+
+         "  batch_size: int (optional, default=1000)\n"
+         "    Number of enumerated configurations made canonical and inserted\n"
+         "    together, using up to `n_threads` threads. If <= 1, each\n"
+         "    configuration is made canonical and inserted as it is\n"
+         "    enumerated. Not used if `output_configurations==true`. \n\n"
+
          "  output_configurations: bool (optional, default=false)\n"
          "    If true, write formatted data for each enumerated configuration. "
          "Formatting options are \n"
@@ -4,6 +4,7 @@
 
 #include "casm/app/enum/EnumInterface.hh"
 #include "casm/app/enum/methods/ConfigEnumAllOccupationsInterface.hh"
+#include "casm/app/enum/methods/ConfigEnumCanonicalOccupationsInterface.hh"
 //#include "casm/app/enum/methods/ConfigEnumInterfaceTemplate.hh"
 #include "casm/app/enum/methods/ConfigEnumRandomLocalInterface.hh"
 #include "casm/app/enum/methods/ConfigEnumRandomOccupationsInterface.hh"
@@ -20,6 +21,8 @@ namespace CASM {
 EnumInterfaceVector make_standard_enumerator_interfaces() {
   EnumInterfaceVector vec;
   vec.emplace_back(notstd::make_cloneable<ConfigEnumAllOccupationsInterface>());
+  vec.emplace_back(
+      notstd::make_cloneable<ConfigEnumCanonicalOccupationsInterface>());
   vec.emplace_back(notstd::make_cloneable<ConfigEnumRandomLocalInterface>());
   vec.emplace_back(
       notstd::make_cloneable<ConfigEnumRandomOccupationsInterface>());
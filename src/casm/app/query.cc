@@ -7,7 +7,9 @@
 #include "casm/app/query/QueryIO_impl.hh"
 #include "casm/casm_io/FormatFlag.hh"
 #include "casm/casm_io/Log.hh"
+#include "casm/clex/Clexulator.hh"
 #include "casm/clex/ConfigEnumByPermutation.hh"
+#include "casm/clex/CorrelationCache.hh"
 #include "casm/clex/PrimClex.hh"
 #include "casm/clex/io/json/ConfigDoF_json_io.hh"
 #include "casm/database/DatabaseTypes_impl.hh"
@@ -500,6 +502,29 @@ void _query_equivalents(DataFormatter<QueryData<Configuration>> &formatter,
   }
 }
 
+/// Evaluate data used by the query for a batch of objects at once
+///
+/// - Does nothing, except for Configuration
+template <typename DataObject>
+void _prefetch(PrimClex const &primclex,
+               std::vector<DataObject const *> const &objects) {}
+
+/// Evaluate the correlations of a batch of configurations in parallel, for
+/// each correlation cache used by the query, so that query properties using
+/// correlations (i.e. "corr", "clex") read them from the cache
+template <>
+void _prefetch(PrimClex const &primclex,
+               std::vector<Configuration const *> const &configurations) {
+  for (auto const &basis_set_name : primclex.correlation_cache_basis_sets()) {
+    std::shared_ptr<CorrelationCache> cache =
+        primclex.correlation_cache(basis_set_name);
+    if (cache != nullptr) {
+      insert_correlations(*cache, configurations,
+                          primclex.clexulator(basis_set_name));
+    }
+  }
+}
+
 template <typename DataObject>
 int QueryCommandImpl<DataObject>::_query() const {
   // WARNING: Valgrind has found some initialization/read errors in this block,
@@ -547,12 +572,32 @@ int QueryCommandImpl<DataObject>::_query() const {
   auto begin = _count("all") ? _sel().all().begin() : _sel().selected().begin();
   auto end = _count("all") ? _sel().all().end() : _sel().selected().end();
 
+  // After the first object initializes the formatter, data it uses is
+  // evaluated for batches of objects at once (see `_prefetch`)
+  Index batch_size = 1000;
+  auto batch_end = begin;
+  auto prefetch = [&](decltype(begin) const &it) {
+    if (it == begin) {
+      ++batch_end;
+      return;
+    }
+    if (it == batch_end) {
+      std::vector<DataObject const *> batch;
+      for (; batch_end != end && Index(batch.size()) < batch_size;
+           ++batch_end) {
+        batch.push_back(&*batch_end);
+      }
+      _prefetch(m_cmd.primclex(), batch);
+    }
+  };
+
   if (_write_json()) {
     jsonParser json = jsonParser::array();
     for (auto it = begin; it != end; ++it) {
       if (include_equivalents) {
         _query_equivalents(formatter, json, m_cmd.primclex(), *it);
       } else {
+        prefetch(it);
         QueryData<DataObject> data{m_cmd.primclex(), *it};
         json.push_back(formatter(data));
       }
@@ -563,6 +608,7 @@ int QueryCommandImpl<DataObject>::_query() const {
       if (include_equivalents) {
         _query_equivalents(formatter, output_stream, m_cmd.primclex(), *it);
       } else {
+        prefetch(it);
         QueryData<DataObject> data{m_cmd.primclex(), *it};
         output_stream << formatter(data);
       }
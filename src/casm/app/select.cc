@@ -26,7 +26,8 @@ void SelectOption::initialize() {
 
   m_desc.add_options()("json",
                        "Write JSON output (otherwise CSV, unless output "
-                       "extension is '.json' or '.JSON')")(
+                       "extension is '.json' or '.JSON', or compact binary "
+                       "if output extension is '.bin')")(
       "subset",
       "Only write selected configurations to output. Can be used by itself or "
       "in conjunction with other options")(
@@ -138,6 +138,14 @@ std::string dof_space_analysis_desc() {
       "      is only checked if DoF is \"occ\" and \"axes\" are not       \n"
       "      included explicitly.  \n\n"
 
+      "    blocked_decomposition: bool (optional, default=false)         \n"
+      "      If true, find irreducible representations of local DoF spaces\n"
+      "      separately in blocks that are not mixed by symmetry (orbits  \n"
+      "      of sites, and translationally invariant modes), using sparse \n"
+      "      symmetry representations. This is much faster for large      \n"
+      "      supercells. Repeated irreps may be given a different, but    \n"
+      "      equivalent, symmetry adapted basis.                          \n\n"
+
       "    axes: matrix or JSON object (optional)                           \n"
       "      Coordinate axes of the DoF grid. This parameter is only checked\n"
       "      when there is a single input state and single \"dof\". The     \n"
@@ -302,6 +310,10 @@ void dof_space_analysis(PrimClex &primclex, jsonParser const &json_options,
   parser.optional_else(options.include_default_occ_modes,
                        "include_default_occ_modes", false);
 
+  // parse "blocked_decomposition" (optional, default = false)
+  parser.optional_else(options.blocked_decomposition, "blocked_decomposition",
+                       false);
+
   // 2) parse input states
 
   typedef std::vector<std::pair<std::string, ConfigEnumInput>>
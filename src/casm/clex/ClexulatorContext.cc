@@ -0,0 +1,114 @@
+#include "casm/clex/ClexulatorContext.hh"
+
+#include <numeric>
+
+#include "casm/clex/ConfigDoF.hh"
+#include "casm/clexulator/NeighborList.hh"
+
+namespace CASM {
+
+/// \brief Construct a context for evaluating `shared_clexulator`
+///
+/// Notes:
+/// - The context holds a copy of `shared_clexulator`, so constructing it has
+///   the cost of one Clexulator copy. Construct one context per thread and
+///   reuse it, rather than constructing one per evaluation.
+ClexulatorContext::ClexulatorContext(Clexulator const &shared_clexulator)
+    : m_clexulator(shared_clexulator),
+      m_base(&m_clexulator.base()),
+      m_tcorr(Eigen::VectorXd::Zero(m_clexulator.corr_size())),
+      m_before(Eigen::VectorXd::Zero(m_clexulator.corr_size())),
+      m_trial_sites(nullptr) {
+  m_all_correlation_indices.reserve(m_clexulator.corr_size());
+  for (unsigned int i = 0; i < m_clexulator.corr_size(); ++i) {
+    m_all_correlation_indices.push_back(i);
+  }
+}
+
+/// \brief Bind ConfigDoF values for evaluation
+///
+/// Notes:
+/// - `configdof` must outlive its use by this context, and must be re-bound
+///   if DoF types are added or removed
+void ClexulatorContext::set_configdof(ConfigDoF const &configdof) {
+  m_base->set_configdofvalues(configdof.values());
+}
+
+/// \brief Bind the neighbor list of a particular unit cell for evaluation
+void ClexulatorContext::set_nlist(
+    SuperNeighborList const &supercell_neighbor_list,
+    Index linear_unitcell_index) {
+  m_base->set_nlist(supercell_neighbor_list.sites(linear_unitcell_index).data());
+}
+
+/// \brief Bind a private copy of the DoF values in the neighborhood of one
+/// unit cell, so that trial values can be evaluated without modifying
+/// `configdof`
+///
+/// Notes:
+/// - Copies the DoF values of `supercell_neighbor_list.sites(
+///   linear_unitcell_index)` and binds them, with a matching neighbor list,
+///   for evaluation. Cost scales with the neighborhood size, not the
+///   supercell size.
+/// - Use `set_trial_occ` or `set_trial_local_dof_value` to change values,
+///   then `calc_restricted_point_corr` to evaluate. Call `set_configdof`
+///   to bind `configdof` again.
+/// - If the neighborhood overlaps its periodic images, a supercell site may
+///   appear more than once in the neighbor list. Trial values are set at
+///   every appearance.
+void ClexulatorContext::set_trial_nlist(
+    ConfigDoF const &configdof,
+    SuperNeighborList const &supercell_neighbor_list,
+    Index linear_unitcell_index) {
+  m_trial_sites = &supercell_neighbor_list.sites(linear_unitcell_index);
+  std::vector<Index> const &sites = *m_trial_sites;
+  Index n = sites.size();
+  clexulator::ConfigDoFValues const &values = configdof.values();
+
+  m_trial_values.occupation.resize(n);
+  for (Index i = 0; i < n; ++i) {
+    m_trial_values.occupation(i) = values.occupation(sites[i]);
+  }
+  for (auto const &local : values.local_dof_values) {
+    Eigen::MatrixXd &trial = m_trial_values.local_dof_values[local.first];
+    trial.resize(local.second.rows(), n);
+    for (Index i = 0; i < n; ++i) {
+      trial.col(i) = local.second.col(sites[i]);
+    }
+  }
+  m_trial_values.global_dof_values = values.global_dof_values;
+
+  if (m_trial_nlist.size() != n) {
+    m_trial_nlist.resize(n);
+    std::iota(m_trial_nlist.begin(), m_trial_nlist.end(), 0);
+  }
+
+  m_base->set_configdofvalues(m_trial_values);
+  m_base->set_nlist(m_trial_nlist.data());
+}
+
+/// \brief Set a trial occupation in the neighborhood bound by
+/// `set_trial_nlist`
+void ClexulatorContext::set_trial_occ(Index linear_site_index, int occ) {
+  std::vector<Index> const &sites = *m_trial_sites;
+  for (Index i = 0; i < sites.size(); ++i) {
+    if (sites[i] == linear_site_index) {
+      m_trial_values.occupation(i) = occ;
+    }
+  }
+}
+
+/// \brief Set a trial local continuous DoF value in the neighborhood bound
+/// by `set_trial_nlist`
+void ClexulatorContext::set_trial_local_dof_value(
+    DoFKey const &key, Index linear_site_index, Eigen::VectorXd const &value) {
+  std::vector<Index> const &sites = *m_trial_sites;
+  Eigen::MatrixXd &trial = m_trial_values.local_dof_values.at(key);
+  for (Index i = 0; i < sites.size(); ++i) {
+    if (sites[i] == linear_site_index) {
+      trial.col(i) = value;
+    }
+  }
+}
+
+}  // namespace CASM
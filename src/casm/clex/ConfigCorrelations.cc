@@ -1,20 +1,28 @@
 #include "casm/clex/ConfigCorrelations.hh"
 
+#include <numeric>
+
 #include "casm/clex/Clexulator.hh"
+#include "casm/clex/ClexulatorContext.hh"
 #include "casm/clex/Configuration.hh"
 #include "casm/clex/NeighborhoodInfo.hh"
 #include "casm/clex/Supercell.hh"
 #include "casm/clexulator/ClexParamPack.hh"
 #include "casm/crystallography/Coordinate.hh"
 #include "casm/crystallography/Structure.hh"
+#include "casm/misc/parallel.hh"
 
 namespace CASM {
 
 namespace {
 
 /// Return const reference to vector of sequential indices of size >= n
+///
+/// Notes:
+/// - The cache is thread_local so that concurrent callers never resize a
+///   vector another thread is reading from
 std::vector<unsigned int> const &all_correlation_indices(Index n) {
-  static std::vector<unsigned int> all_correlation_indices;
+  thread_local std::vector<unsigned int> all_correlation_indices;
   if (all_correlation_indices.size() < n) {
     all_correlation_indices.reserve(n);
     unsigned int i = all_correlation_indices.size();
@@ -121,7 +129,7 @@ void restricted_extensive_correlations(
   int n_unitcells = supercell_neighbor_list.n_unitcells();
 
   // Holds contribution to global correlations from a particular Neighborhood
-  static Eigen::VectorXd tcorr;
+  thread_local Eigen::VectorXd tcorr;
   corr.resize(n_corr);
   tcorr.resize(n_corr);
 
@@ -354,7 +362,7 @@ void restricted_delta_corr(Eigen::VectorXd &dcorr, Index linear_site_index,
         configdof, nlist_begin, nlist_end, neighbor_index, curr_occ, new_occ,
         corr_begin, corr_end, corr_indices_begin, corr_indices_end);
   } else {
-    static Eigen::VectorXd before;
+    thread_local Eigen::VectorXd before;
     before.resize(n_corr);
     Eigen::VectorXd &after = dcorr;
 
@@ -416,7 +424,7 @@ void restricted_delta_corr(Eigen::VectorXd &dcorr, Index linear_site_index,
   long int const *nlist_begin = nlist_sites.data();
   long int const *nlist_end = end_ptr(nlist_sites);
 
-  static Eigen::VectorXd before;
+  thread_local Eigen::VectorXd before;
   before.resize(n_corr);
   Eigen::VectorXd &after = dcorr;
 
@@ -489,6 +497,318 @@ void restricted_delta_corr(
   }
 }
 
+// --- Evaluation using a ClexulatorContext ---
+
+/// \brief Sets correlations using a per-thread ClexulatorContext. Mean of the
+/// contribution from every unit cell.
+void correlations(Eigen::VectorXd &corr, ConfigDoF const &configdof,
+                  SuperNeighborList const &supercell_neighbor_list,
+                  ClexulatorContext &context) {
+  auto const &correlation_indices = context.all_correlation_indices();
+  restricted_correlations(corr, configdof, supercell_neighbor_list, context,
+                          correlation_indices.data(),
+                          end_ptr(correlation_indices));
+}
+
+/// \brief Sets correlations using a per-thread ClexulatorContext, restricted
+/// to specified correlation indices. Mean of the contribution from every unit
+/// cell.
+void restricted_correlations(Eigen::VectorXd &corr, ConfigDoF const &configdof,
+                             SuperNeighborList const &supercell_neighbor_list,
+                             ClexulatorContext &context,
+                             unsigned int const *corr_indices_begin,
+                             unsigned int const *corr_indices_end) {
+  restricted_extensive_correlations(corr, configdof, supercell_neighbor_list,
+                                    context, corr_indices_begin,
+                                    corr_indices_end);
+  corr /= (double)supercell_neighbor_list.n_unitcells();
+}
+
+/// \brief Sets correlations using a per-thread ClexulatorContext. Sum of the
+/// contribution from every unit cell.
+void extensive_correlations(Eigen::VectorXd &corr, ConfigDoF const &configdof,
+                            SuperNeighborList const &supercell_neighbor_list,
+                            ClexulatorContext &context) {
+  auto const &correlation_indices = context.all_correlation_indices();
+  restricted_extensive_correlations(corr, configdof, supercell_neighbor_list,
+                                    context, correlation_indices.data(),
+                                    end_ptr(correlation_indices));
+}
+
+/// \brief Sets correlations using a per-thread ClexulatorContext, restricted
+/// to specified correlation indices. Sum of the contribution from every unit
+/// cell.
+///
+/// Notes:
+/// - The ConfigDoF values are bound once, rather than once per unit cell
+/// - Safe to call concurrently from multiple threads, each with its own
+///   `context`, sharing the same `configdof` and `supercell_neighbor_list`
+void restricted_extensive_correlations(
+    Eigen::VectorXd &corr, ConfigDoF const &configdof,
+    SuperNeighborList const &supercell_neighbor_list,
+    ClexulatorContext &context, unsigned int const *corr_indices_begin,
+    unsigned int const *corr_indices_end) {
+  int n_corr = context.corr_size();
+  int n_unitcells = supercell_neighbor_list.n_unitcells();
+
+  Eigen::VectorXd &tcorr = context.tcorr();
+  corr.resize(n_corr);
+  tcorr.resize(n_corr);
+
+  for (auto it = corr_indices_begin; it != corr_indices_end; ++it) {
+    *(corr.data() + *it) = 0.0;
+  }
+
+  context.set_configdof(configdof);
+  for (int unitcell_index = 0; unitcell_index < n_unitcells; unitcell_index++) {
+    context.set_nlist(supercell_neighbor_list, unitcell_index);
+    context.calc_restricted_global_corr_contribution(
+        tcorr.data(), corr_indices_begin, corr_indices_end);
+
+    for (auto it = corr_indices_begin; it != corr_indices_end; ++it) {
+      *(corr.data() + *it) += *(tcorr.data() + *it);
+    }
+  }
+}
+
+/// \brief Sets change in (extensive) correlations due to an occupation
+/// change, using a per-thread ClexulatorContext, restricted to specified
+/// correlations
+///
+/// Notes:
+/// - `configdof` is not modified. If the neighborhood of a site overlaps its
+///   periodic images, the trial occupation is evaluated in the context's copy
+///   of the neighborhood DoF values (see `ClexulatorContext::set_trial_nlist`)
+void restricted_delta_corr(Eigen::VectorXd &dcorr, Index linear_site_index,
+                           int new_occ, ConfigDoF const &configdof,
+                           SuperNeighborList const &supercell_neighbor_list,
+                           ClexulatorContext &context,
+                           unsigned int const *corr_indices_begin,
+                           unsigned int const *corr_indices_end) {
+  int n_corr = context.corr_size();
+  dcorr.resize(n_corr);
+
+  Index unitcell_index =
+      supercell_neighbor_list.unitcell_index(linear_site_index);
+  int neighbor_index =
+      supercell_neighbor_list.neighbor_index(linear_site_index);
+
+  int curr_occ = configdof.occ(linear_site_index);
+  if (!supercell_neighbor_list.overlaps()) {
+    context.set_configdof(configdof);
+    context.set_nlist(supercell_neighbor_list, unitcell_index);
+    context.calc_restricted_delta_point_corr(
+        neighbor_index, curr_occ, new_occ, dcorr.data(), corr_indices_begin,
+        corr_indices_end);
+  } else {
+    Eigen::VectorXd &before = context.before();
+    before.resize(n_corr);
+    Eigen::VectorXd &after = dcorr;
+
+    context.set_trial_nlist(configdof, supercell_neighbor_list,
+                            unitcell_index);
+    context.calc_restricted_point_corr(neighbor_index, before.data(),
+                                       corr_indices_begin, corr_indices_end);
+    context.set_trial_occ(linear_site_index, new_occ);
+    context.calc_restricted_point_corr(neighbor_index, after.data(),
+                                       corr_indices_begin, corr_indices_end);
+
+    for (auto it = corr_indices_begin; it != corr_indices_end; ++it) {
+      *(dcorr.data() + *it) -= *(before.data() + *it);
+    }
+  }
+}
+
+/// \brief Sets change in (extensive) correlations due to a local continuous
+/// DoF change, using a per-thread ClexulatorContext, restricted to specified
+/// correlations
+///
+/// Notes:
+/// - Neither `configdof` nor `dof_values` is modified. The trial value is
+///   evaluated in the context's copy of the neighborhood DoF values (see
+///   `ClexulatorContext::set_trial_nlist`)
+void restricted_delta_corr(Eigen::VectorXd &dcorr, Index linear_site_index,
+                           Eigen::VectorXd const &new_value,
+                           ConfigDoF const &configdof,
+                           SuperNeighborList const &supercell_neighbor_list,
+                           LocalContinuousConfigDoFValues const &dof_values,
+                           ClexulatorContext &context,
+                           unsigned int const *corr_indices_begin,
+                           unsigned int const *corr_indices_end) {
+  int n_corr = context.corr_size();
+  dcorr.resize(n_corr);
+
+  Index unitcell_index =
+      supercell_neighbor_list.unitcell_index(linear_site_index);
+  int neighbor_index =
+      supercell_neighbor_list.neighbor_index(linear_site_index);
+
+  Eigen::VectorXd &before = context.before();
+  before.resize(n_corr);
+  Eigen::VectorXd &after = dcorr;
+
+  context.set_trial_nlist(configdof, supercell_neighbor_list, unitcell_index);
+  context.calc_restricted_point_corr(neighbor_index, before.data(),
+                                     corr_indices_begin, corr_indices_end);
+  context.set_trial_local_dof_value(dof_values.type_name(), linear_site_index,
+                                    new_value);
+  context.calc_restricted_point_corr(neighbor_index, after.data(),
+                                     corr_indices_begin, corr_indices_end);
+
+  for (auto it = corr_indices_begin; it != corr_indices_end; ++it) {
+    *(dcorr.data() + *it) -= *(before.data() + *it);
+  }
+}
+
+// --- Batched correlations ---
+
+/// \brief Sets correlations for many ConfigDoF in one supercell, one row per
+/// ConfigDoF, evaluated in parallel
+///
+/// \param corr Resized to (configdof.size(), clexulator.corr_size()). Row i
+///     is set to the correlations of `*configdof[i]`.
+/// \param configdof Pointers to the ConfigDoF to evaluate, which must all be
+///     in the supercell described by `supercell_neighbor_list`
+/// \param supercell_neighbor_list Supercell neighbor list
+/// \param clexulator Clexulator, shared (read-only) by all threads
+/// \param n_threads Maximum number of threads to use. Values < 1 use
+///     `default_n_threads()`.
+void correlations(Eigen::MatrixXdRowMajor &corr,
+                  std::vector<ConfigDoF const *> const &configdof,
+                  SuperNeighborList const &supercell_neighbor_list,
+                  Clexulator const &clexulator, Index n_threads) {
+  auto n = clexulator.corr_size();
+  std::vector<unsigned int> correlation_indices(n);
+  std::iota(correlation_indices.begin(), correlation_indices.end(), 0);
+  restricted_correlations(corr, configdof, supercell_neighbor_list, clexulator,
+                          correlation_indices.data(),
+                          end_ptr(correlation_indices), n_threads);
+}
+
+/// \brief Sets restricted correlations for many ConfigDoF in one supercell,
+/// one row per ConfigDoF, evaluated in parallel
+///
+/// \param corr Resized to (configdof.size(), clexulator.corr_size()). Row i
+///     is set to the correlations of `*configdof[i]`, with zero value for any
+///     correlations not in `correlations_indices`.
+///
+/// See `correlations` for other parameters.
+void restricted_correlations(Eigen::MatrixXdRowMajor &corr,
+                             std::vector<ConfigDoF const *> const &configdof,
+                             SuperNeighborList const &supercell_neighbor_list,
+                             Clexulator const &clexulator,
+                             unsigned int const *corr_indices_begin,
+                             unsigned int const *corr_indices_end,
+                             Index n_threads) {
+  Index n_configs = configdof.size();
+  corr.setZero(n_configs, clexulator.corr_size());
+  if (n_threads < 1) {
+    n_threads = default_n_threads();
+  }
+  n_threads = std::max(Index(1), std::min(n_threads, n_configs));
+
+  std::vector<std::unique_ptr<ClexulatorContext>> context(n_threads);
+  std::vector<Eigen::VectorXd> tcorr(n_threads);
+  parallel_for(0, n_configs, n_threads, [&](Index t, Index i) {
+    if (!context[t]) {
+      context[t] = notstd::make_unique<ClexulatorContext>(clexulator);
+    }
+    restricted_correlations(tcorr[t], *configdof[i], supercell_neighbor_list,
+                            *context[t], corr_indices_begin, corr_indices_end);
+    for (auto it = corr_indices_begin; it != corr_indices_end; ++it) {
+      corr(i, *it) = tcorr[t](*it);
+    }
+  });
+}
+
+/// \brief Returns correlations for many configurations, in any supercells,
+/// one row per configuration, evaluated in parallel
+///
+/// \param configurations Pointers to the configurations to evaluate
+/// \param clexulator Clexulator, shared (read-only) by all threads
+/// \param n_threads Maximum number of threads to use. Values < 1 use
+///     `default_n_threads()`.
+///
+/// \returns Matrix of size (configurations.size(), clexulator.corr_size()).
+///     Row i is the correlations of `*configurations[i]`.
+Eigen::MatrixXdRowMajor correlations(
+    std::vector<Configuration const *> const &configurations,
+    Clexulator const &clexulator, Index n_threads) {
+  auto n = clexulator.corr_size();
+  std::vector<unsigned int> correlation_indices(n);
+  std::iota(correlation_indices.begin(), correlation_indices.end(), 0);
+  Eigen::MatrixXdRowMajor corr;
+  restricted_correlations(corr, configurations, clexulator,
+                          correlation_indices.data(),
+                          end_ptr(correlation_indices), n_threads);
+  return corr;
+}
+
+/// \brief Sets restricted correlations for many configurations, in any
+/// supercells, one row per configuration, evaluated in parallel
+///
+/// \param corr Resized to (configurations.size(), clexulator.corr_size()).
+///     Row i is set to the correlations of `*configurations[i]`, with zero
+///     value for any correlations not in `correlations_indices`.
+///
+/// Notes:
+/// - Configurations are evaluated grouped by supercell, so that each thread
+///   mostly streams through the neighbor list of one supercell at a time.
+/// - Supercell neighbor lists are constructed, if necessary, and pinned
+///   before the parallel evaluation begins. Threads only use the pinned
+///   neighbor lists.
+///
+/// See `correlations` for other parameters.
+void restricted_correlations(
+    Eigen::MatrixXdRowMajor &corr,
+    std::vector<Configuration const *> const &configurations,
+    Clexulator const &clexulator, unsigned int const *corr_indices_begin,
+    unsigned int const *corr_indices_end, Index n_threads) {
+  Index n_configs = configurations.size();
+  corr.setZero(n_configs, clexulator.corr_size());
+  if (n_threads < 1) {
+    n_threads = default_n_threads();
+  }
+  n_threads = std::max(Index(1), std::min(n_threads, n_configs));
+
+  // evaluation order: grouped by supercell, stable within a supercell
+  std::vector<Index> order(n_configs);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](Index lhs, Index rhs) {
+    return &configurations[lhs]->supercell() <
+           &configurations[rhs]->supercell();
+  });
+
+  // neighbor list of each configuration, by evaluation order, held so they
+  // are not released while in use
+  std::vector<std::shared_ptr<SuperNeighborList const>> nlist(n_configs);
+  Supercell const *last_supercell = nullptr;
+  for (Index j = 0; j < n_configs; ++j) {
+    Supercell const *supercell = &configurations[order[j]]->supercell();
+    if (supercell != last_supercell) {
+      nlist[j] = supercell->shared_nlist();
+      last_supercell = supercell;
+    } else {
+      nlist[j] = nlist[j - 1];
+    }
+  }
+
+  std::vector<std::unique_ptr<ClexulatorContext>> context(n_threads);
+  std::vector<Eigen::VectorXd> tcorr(n_threads);
+  parallel_for(0, n_configs, n_threads, [&](Index t, Index j) {
+    if (!context[t]) {
+      context[t] = notstd::make_unique<ClexulatorContext>(clexulator);
+    }
+    Index i = order[j];
+    restricted_correlations(tcorr[t], configurations[i]->configdof(),
+                            *nlist[j], *context[t], corr_indices_begin,
+                            corr_indices_end);
+    for (auto it = corr_indices_begin; it != corr_indices_end; ++it) {
+      corr(i, *it) = tcorr[t](*it);
+    }
+  });
+}
+
 /// Return xtal::UnitCellCoord for each row in `all_point_corr`
 std::vector<xtal::UnitCellCoord> make_all_point_corr_unitcellcoord(
     NeighborhoodInfo const &neighborhood_info,
@@ -0,0 +1,180 @@
+#include "casm/clex/ConfigEnumCanonicalOccupations.hh"
+
+#include <stdexcept>
+
+#include "casm/clex/OccupationCanonicalForm.hh"
+#include "casm/clex/Supercell.hh"
+#include "casm/enumerator/ConfigEnumInput.hh"
+#include "casm/symmetry/PermuteIterator.hh"
+#include "casm/symmetry/SupercellSymInfo.hh"
+
+namespace CASM {
+
+/// \brief Conditionally true for ConfigEnumCanonicalOccupations
+template <>
+bool is_guaranteed_for_database_insert(
+    ConfigEnumCanonicalOccupations const &enumerator) {
+  return enumerator.primitive_canonical_guarantee();
+}
+
+/// \brief Construct with a ConfigEnumInput, which must include all sites
+///
+/// \param config_enum_input Specifies the supercell and initial
+///     configuration. All sites must be selected.
+/// \param primitive_only If true, only primitive configurations are output.
+///     Otherwise, non-primitive canonical configurations are also output.
+///
+/// \throws std::runtime_error If not all sites are selected, if there are
+///     anisotropic occupants, or if the initial configuration has non-zero
+///     continuous DoF values.
+ConfigEnumCanonicalOccupations::ConfigEnumCanonicalOccupations(
+    ConfigEnumInput const &config_enum_input, bool primitive_only)
+    : m_n_sites(config_enum_input.configuration().size()),
+      m_max_occupation(config_enum_input.configuration()
+                           .supercell()
+                           .max_allowed_occupation()),
+      m_occupation(Eigen::VectorXi::Zero(m_n_sites)),
+      m_n_assigned(0),
+      m_current(notstd::make_cloneable<Configuration>(
+          config_enum_input.configuration())),
+      m_primitive_only(primitive_only) {
+  if (Index(config_enum_input.sites().size()) != m_n_sites) {
+    throw std::runtime_error(
+        "Error constructing ConfigEnumCanonicalOccupations: all sites must be "
+        "selected");
+  }
+  SupercellSymInfo const &sym_info = m_current->supercell().sym_info();
+  if (!is_occupation_only(m_current->configdof(), sym_info)) {
+    throw std::runtime_error(
+        "Error constructing ConfigEnumCanonicalOccupations: requires "
+        "isotropic occupants and zero-valued continuous DoF");
+  }
+
+  auto begin = sym_info.permute_begin();
+  auto end = sym_info.permute_end();
+  for (auto it = begin; it != end; ++it) {
+    if (it->factor_group_index() == 0 && it->translation_index() == 0) {
+      continue;
+    }
+    for (Index i = 0; i < m_n_sites; ++i) {
+      m_permutations.push_back(it->permute_ind(i));
+    }
+  }
+
+  m_current->set_occupation(m_occupation);
+  reset_properties(*m_current);
+  this->_initialize(&(*m_current));
+
+  if (!_find_next(true)) {
+    this->_invalidate();
+  }
+
+  // set step to 0
+  if (valid()) {
+    _set_step(0);
+  }
+  m_current->set_source(this->source(step()));
+}
+
+std::string ConfigEnumCanonicalOccupations::name() const {
+  return enumerator_name;
+}
+
+/// \brief Returns true if enumerator is guaranteed to output
+///     primitive & canonical configurations only
+bool ConfigEnumCanonicalOccupations::primitive_canonical_guarantee() const {
+  return m_primitive_only;
+}
+
+const std::string ConfigEnumCanonicalOccupations::enumerator_name =
+    "ConfigEnumCanonicalOccupations";
+
+/// Implements increment
+void ConfigEnumCanonicalOccupations::increment() {
+  if (_find_next(false)) {
+    this->_increment_step();
+  } else {
+    this->_invalidate();
+  }
+  m_current->set_source(this->source(step()));
+}
+
+/// Depth-first search over site values, in site index order, abandoning
+/// partial occupations that cannot complete to a canonical occupation
+///
+/// On success, m_occupation is a complete canonical occupation and
+/// *m_current is set to it.
+bool ConfigEnumCanonicalOccupations::_find_next(bool check_current) {
+  if (m_n_sites == 0) {
+    return false;
+  }
+  if (!check_current && !_next_prefix()) {
+    return false;
+  }
+  while (true) {
+    if (!_prefix_may_be_canonical(m_n_assigned)) {
+      if (!_next_prefix()) {
+        return false;
+      }
+      continue;
+    }
+    if (m_n_assigned < m_n_sites) {
+      // descend: assign the lowest value to the next site
+      m_occupation(m_n_assigned) = 0;
+      ++m_n_assigned;
+      continue;
+    }
+    // complete and canonical
+    m_current->set_occupation(m_occupation);
+    if (!m_primitive_only || m_current->is_primitive()) {
+      return true;
+    }
+    if (!_next_prefix()) {
+      return false;
+    }
+  }
+}
+
+/// For each operation, compare the transformed occupation v(i) =
+/// x[perm[i]] with x, position by position, while both are known. If v is
+/// greater at the first known difference, then every completion of x is
+/// non-canonical. The comparison is inconclusive at the first position where
+/// perm[i] is not yet assigned.
+bool ConfigEnumCanonicalOccupations::_prefix_may_be_canonical(
+    Index n_assigned) const {
+  if (n_assigned == 0) {
+    return true;
+  }
+  Index const *perm = m_permutations.data();
+  Index const *perm_end = perm + m_permutations.size();
+  int const *x = m_occupation.data();
+  for (; perm != perm_end; perm += m_n_sites) {
+    for (Index i = 0; i < n_assigned; ++i) {
+      Index j = perm[i];
+      if (j >= n_assigned || x[j] < x[i]) {
+        break;
+      }
+      if (x[j] > x[i]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/// Move to the next value of the last assigned site, backtracking past sites
+/// that are already at their maximum allowed value
+bool ConfigEnumCanonicalOccupations::_next_prefix() {
+  while (m_n_assigned > 0) {
+    Index l = m_n_assigned - 1;
+    if (m_occupation(l) < m_max_occupation(l)) {
+      ++m_occupation(l);
+      return true;
+    }
+    m_occupation(l) = 0;
+    --m_n_assigned;
+  }
+  return false;
+}
+
+}  // namespace CASM
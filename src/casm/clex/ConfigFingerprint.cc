@@ -0,0 +1,240 @@
+#include "casm/clex/ConfigFingerprint.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <set>
+#include <sstream>
+
+#include "casm/clex/ConfigDoF.hh"
+#include "casm/clex/Configuration.hh"
+#include "casm/clex/Supercell.hh"
+#include "casm/crystallography/LinearIndexConverter.hh"
+#include "casm/crystallography/Molecule.hh"
+#include "casm/crystallography/Site.hh"
+#include "casm/crystallography/Structure.hh"
+#include "casm/misc/hash.hh"
+#include "casm/symmetry/SupercellSymInfo.hh"
+#include "casm/symmetry/SymBasisPermute.hh"
+#include "casm/symmetry/SymGroupRep.hh"
+
+namespace CASM {
+
+namespace {
+
+/// Species name used to identify an occupant
+std::string species_name(xtal::Molecule const &mol, bool aniso_occs) {
+  if (mol.is_vacancy()) {
+    return "Va";
+  }
+  if (!aniso_occs) {
+    return mol.name();
+  }
+  std::vector<std::string> atom_names;
+  for (auto const &atom : mol.atoms()) {
+    atom_names.push_back(atom.name());
+  }
+  std::sort(atom_names.begin(), atom_names.end());
+  std::string result;
+  for (auto const &name : atom_names) {
+    result += name + ";";
+  }
+  return result;
+}
+
+/// Pair of sites in the prim, (b, (b_nbor, offset)), at a given distance
+struct PrimPair {
+  Index b;
+  xtal::UnitCellCoord nbor;
+  double dist;
+};
+
+/// Find all site pairs (b, (b_nbor, offset)), with 0 < dist <= max_dist,
+/// for unit cell offsets in the range [-range(i), range(i)]
+std::vector<PrimPair> find_prim_pairs(Structure const &prim,
+                                      Eigen::Vector3l const &range,
+                                      double max_dist) {
+  std::vector<PrimPair> result;
+  Eigen::Matrix3d const &L = prim.lattice().lat_column_mat();
+  double tol = prim.lattice().tol();
+  for (Index b = 0; b < prim.basis().size(); ++b) {
+    Eigen::Vector3d r_b = prim.basis()[b].const_cart();
+    for (Index b_nbor = 0; b_nbor < prim.basis().size(); ++b_nbor) {
+      Eigen::Vector3d r_nbor = prim.basis()[b_nbor].const_cart();
+      for (Index i = -range(0); i <= range(0); ++i) {
+        for (Index j = -range(1); j <= range(1); ++j) {
+          for (Index k = -range(2); k <= range(2); ++k) {
+            xtal::UnitCell offset(i, j, k);
+            double dist =
+                (r_nbor + L * offset.cast<double>() - r_b).norm();
+            if (dist > tol && dist <= max_dist + tol) {
+              result.push_back({b, xtal::UnitCellCoord(b_nbor, offset), dist});
+            }
+          }
+        }
+      }
+    }
+  }
+  return result;
+}
+
+/// Sorted distinct distances, merging values that differ by less than tol
+std::vector<double> distinct_distances(std::vector<PrimPair> const &pairs,
+                                       double tol) {
+  std::vector<double> all;
+  for (auto const &pair : pairs) {
+    all.push_back(pair.dist);
+  }
+  std::sort(all.begin(), all.end());
+  std::vector<double> result;
+  for (double d : all) {
+    if (result.empty() || d - result.back() > tol) {
+      result.push_back(d);
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
+ConfigFingerprintCalculator::ConfigFingerprintCalculator(
+    Supercell const &supercell, Index n_shells)
+    : m_supercell(&supercell), m_n_shells(n_shells) {
+  Structure const &prim = supercell.prim();
+  SupercellSymInfo const &sym_info = supercell.sym_info();
+  Index n_sublat = prim.basis().size();
+
+  // sublattice orbits under the supercell factor group: label each sublattice
+  // by the minimum sublattice index in its orbit
+  m_sublat_orbit.resize(n_sublat);
+  auto const &basis_perm_rep = sym_info.basis_permutation_symrep();
+  for (Index b = 0; b < n_sublat; ++b) {
+    Index min_b = b;
+    for (Index op = 0; op < basis_perm_rep.size(); ++op) {
+      auto const &ucc_perm = *basis_perm_rep[op]->ucc_permutation();
+      min_b = std::min(min_b, ucc_perm[b].sublattice());
+    }
+    m_sublat_orbit[b] = min_b;
+  }
+  std::set<Index> orbit_labels(m_sublat_orbit.begin(), m_sublat_orbit.end());
+  for (Index &orbit : m_sublat_orbit) {
+    orbit = std::distance(orbit_labels.begin(), orbit_labels.find(orbit));
+  }
+  m_n_sublat_orbits = orbit_labels.size();
+
+  // species indices, in order of sorted species names
+  std::set<std::string> species_names;
+  for (auto const &site : prim.basis()) {
+    for (auto const &mol : site.occupant_dof()) {
+      species_names.insert(species_name(mol, sym_info.has_aniso_occs()));
+    }
+  }
+  m_species.resize(n_sublat);
+  for (Index b = 0; b < n_sublat; ++b) {
+    for (auto const &mol : prim.basis()[b].occupant_dof()) {
+      auto it =
+          species_names.find(species_name(mol, sym_info.has_aniso_occs()));
+      m_species[b].push_back(std::distance(species_names.begin(), it));
+    }
+  }
+  m_n_species = std::max(Index(species_names.size()), Index(1));
+
+  // neighbor shells: choose a cutoff from neighbors in adjacent unit cells,
+  // then find all neighbors within the cutoff, so that each shell is complete
+  // and therefore symmetry invariant
+  m_neighbors.resize(n_sublat);
+  if (m_n_shells <= 0) {
+    return;
+  }
+  double tol = prim.lattice().tol();
+  std::vector<double> trial_dist = distinct_distances(
+      find_prim_pairs(prim, Eigen::Vector3l::Ones(), 1e20), tol);
+  if (trial_dist.empty()) {
+    return;
+  }
+  double max_dist =
+      trial_dist[std::min(Index(trial_dist.size()), m_n_shells) - 1];
+
+  Eigen::Matrix3d const &inv_L = prim.lattice().inv_lat_column_mat();
+  Eigen::Vector3l range;
+  for (Index i = 0; i < 3; ++i) {
+    range(i) = std::ceil((max_dist + tol) * inv_L.row(i).norm()) + 1;
+  }
+  std::vector<PrimPair> pairs = find_prim_pairs(prim, range, max_dist);
+  std::vector<double> shell_dist = distinct_distances(pairs, tol);
+  m_n_shells = std::min(Index(shell_dist.size()), m_n_shells);
+  for (auto const &pair : pairs) {
+    Index shell = 0;
+    while (shell + 1 < shell_dist.size() &&
+           pair.dist - shell_dist[shell] > tol) {
+      ++shell;
+    }
+    if (shell < m_n_shells) {
+      m_neighbors[pair.b].emplace_back(shell, pair.nbor);
+    }
+  }
+}
+
+/// \brief Return the fingerprint of occupation values in `configdof`
+std::uint64_t ConfigFingerprintCalculator::operator()(
+    ConfigDoF const &configdof) const {
+  auto const &converter =
+      m_supercell->sym_info().unitcellcoord_index_converter();
+  Eigen::VectorXi const &occupation = configdof.occupation();
+  Index n_sites = configdof.size();
+  bool has_occupation = occupation.size() == n_sites;
+  auto species = [&](Index l, Index b) -> Index {
+    return has_occupation ? m_species[b][occupation[l]] : 0;
+  };
+
+  // site_count[orbit][species]
+  Index n_site_types = m_n_sublat_orbits * m_n_species;
+  std::vector<Index> site_count(n_site_types, 0);
+
+  // pair_count[site type][shell][neighbor site type]
+  std::vector<Index> pair_count(n_site_types * m_n_shells * n_site_types, 0);
+
+  for (Index l = 0; l < n_sites; ++l) {
+    xtal::UnitCellCoord const &bijk = converter(l);
+    Index b = bijk.sublattice();
+    Index type = m_sublat_orbit[b] * m_n_species + species(l, b);
+    ++site_count[type];
+
+    for (auto const &nbor : m_neighbors[b]) {
+      Index b_nbor = nbor.offset.sublattice();
+      Index l_nbor = converter(xtal::UnitCellCoord(
+          b_nbor, bijk.unitcell() + nbor.offset.unitcell()));
+      Index nbor_type =
+          m_sublat_orbit[b_nbor] * m_n_species + species(l_nbor, b_nbor);
+      ++pair_count[(type * m_n_shells + nbor.shell) * n_site_types +
+                   nbor_type];
+    }
+  }
+
+  std::uint64_t seed = n_sites;
+  for (Index count : site_count) {
+    hash_combine(seed, count);
+  }
+  for (Index count : pair_count) {
+    hash_combine(seed, count);
+  }
+  return seed;
+}
+
+/// \brief Return the symmetry-invariant fingerprint of a Configuration
+///
+/// Uses the ConfigFingerprintCalculator of the Configuration's supercell (see
+/// `Supercell::fingerprint_calculator`), which is constructed once per
+/// Supercell.
+std::uint64_t symmetry_fingerprint(Configuration const &config) {
+  return config.supercell().fingerprint_calculator()(config.configdof());
+}
+
+/// \brief Return a fingerprint as a fixed width (16 character) hex string
+std::string fingerprint_string(std::uint64_t fingerprint) {
+  std::stringstream ss;
+  ss << std::hex << std::setw(16) << std::setfill('0') << fingerprint;
+  return ss.str();
+}
+
+}  // namespace CASM
@@ -11,13 +11,16 @@
 #include "casm/casm_io/json/jsonParser.hh"
 #include "casm/clex/Calculable.hh"
 #include "casm/clex/ClexBasisSpecs.hh"
+#include "casm/clex/ClexulatorContext.hh"
 #include "casm/clex/ConfigCorrelations.hh"
+#include "casm/clex/ConfigFingerprint.hh"
 #include "casm/clex/ConfigIOHull.hh"
 #include "casm/clex/ConfigIOLocalCorr.hh"
 #include "casm/clex/ConfigIONovelty.hh"
 #include "casm/clex/ConfigIOStrain.hh"
 #include "casm/clex/ConfigIOStrucScore.hh"
 #include "casm/clex/ConfigMapping.hh"
+#include "casm/clex/CorrelationCache.hh"
 #include "casm/clex/MappedProperties.hh"
 #include "casm/clex/NeighborhoodInfo.hh"
 #include "casm/clex/Norm.hh"
@@ -201,9 +204,18 @@ const std::string Corr::Desc =
 
 /// \brief Returns the atom fraction
 Eigen::VectorXd Corr::evaluate(const Configuration &config) const {
+  if (m_cache != nullptr) {
+    Eigen::VectorXd all_corr =
+        correlations(config, m_clexulator, m_cache.get());
+    Eigen::VectorXd corr(m_correlation_indices.size());
+    for (Index i = 0; i < m_correlation_indices.size(); ++i) {
+      corr(i) = all_corr(m_correlation_indices[i]);
+    }
+    return corr;
+  }
   Eigen::VectorXd corr;
   restricted_extensive_correlations(
-      corr, config.configdof(), config.supercell().nlist(), m_clexulator,
+      corr, config.configdof(), config.supercell().nlist(), *m_context,
       m_correlation_indices.data(), end_ptr(m_correlation_indices));
   corr /= ((double)config.supercell().volume());
   return corr;
@@ -217,7 +229,9 @@ bool Corr::init(const Configuration &_tmplt) const {
                                ? primclex.settings().default_clex()
                                : primclex.settings().clex(m_clex_name);
     m_clexulator = primclex.clexulator(desc.bset);
+    m_cache = primclex.correlation_cache(desc.bset);
   }
+  m_context = std::make_shared<ClexulatorContext>(m_clexulator);
 
   VectorXdAttribute<Configuration>::init(_tmplt);
   m_correlation_indices.clear();
@@ -788,7 +802,8 @@ Clex::Clex(const Clexulator &clexulator, const ECIContainer &eci,
 
 /// \brief Returns the atom fraction
 double Clex::evaluate(const Configuration &config) const {
-  return m_eci * correlations(config, m_clexulator) / _norm(config);
+  return m_eci * correlations(config, m_clexulator, m_cache.get()) /
+         _norm(config);
 }
 
 /// \brief Clone using copy constructor
@@ -805,6 +820,7 @@ bool Clex::init(const Configuration &_tmplt) const {
                                ? primclex.settings().default_clex()
                                : primclex.settings().clex(m_clex_name);
     m_clexulator = primclex.clexulator(desc.bset);
+    m_cache = primclex.correlation_cache(desc.bset);
     m_eci = primclex.eci(desc);
     if (m_eci.index().back() >= m_clexulator.corr_size()) {
       Log &err_log = CASM::err_log();
@@ -878,6 +894,18 @@ GenericConfigFormatter<std::string> scelname() {
       });
 }
 
+GenericConfigFormatter<std::string> fingerprint() {
+  return GenericConfigFormatter<std::string>(
+      "fingerprint",
+      "Symmetry-invariant hash of occupation, as a 16 character hex string. "
+      "Configurations in the same supercell that are equivalent by symmetry "
+      "have the same fingerprint; configurations with different fingerprints "
+      "are distinct. Does not include continuous DoF values.",
+      [](const Configuration &config) -> std::string {
+        return fingerprint_string(symmetry_fingerprint(config));
+      });
+}
+
 GenericConfigFormatter<std::string> calc_status() {
   return GenericConfigFormatter<std::string>(
       "calc_status", "Status of calculation.",
@@ -1257,8 +1285,8 @@ make_string_dictionary<Configuration>() {
   StringAttributeDictionary<Configuration> dict;
 
   dict.insert(name<Configuration>(), configname(), alias<Configuration>(),
-              alias_or_name<Configuration>(), scelname(), calc_status(),
-              failure_type(), point_group_name(), poscar(),
+              alias_or_name<Configuration>(), scelname(), fingerprint(),
+              calc_status(), failure_type(), point_group_name(), poscar(),
               poscar_with_vacancies());
 
   return dict;
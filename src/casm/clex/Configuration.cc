@@ -106,6 +106,62 @@ void Configuration::set_occ(Index site_l, int val) {
   m_configdof.occ(site_l) = val;
 }
 
+namespace {
+
+/// True if the occupation vector is unchanged by translation by the unit cell
+/// with Smith normal form coordinates `t`, where `s` is the Smith normal form
+/// diagonal
+bool is_occupation_translation_invariant(Eigen::VectorXi const &occupation,
+                                         Eigen::Vector3l const &s,
+                                         Eigen::Vector3l const &t) {
+  Index n_unitcells = s(0) * s(1) * s(2);
+  Index n_sublat = occupation.size() / n_unitcells;
+  for (Index b = 0; b < n_sublat; ++b) {
+    int const *x = occupation.data() + b * n_unitcells;
+    for (Index p = 0; p < s(2); ++p) {
+      Index tp = (p + t(2)) % s(2);
+      for (Index n = 0; n < s(1); ++n) {
+        Index tn = (n + t(1)) % s(1);
+        int const *row = x + s(0) * (n + s(1) * p);
+        int const *trow = x + s(0) * (tn + s(1) * tp);
+        // row[m] == trow[(m + t(0)) % s(0)], as two contiguous ranges
+        if (!std::equal(row, row + s(0) - t(0), trow + t(0)) ||
+            !std::equal(row + s(0) - t(0), row + s(0), trow)) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+/// Returns the index of the first non-zero translation that leaves the
+/// occupation vector unchanged, or the number of translations if none does
+///
+/// Unit cells are indexed in the order of their Smith normal form
+/// coordinates, l = m + s0 * (n + s1 * p), where S = diag(s0, s1, s2) is the
+/// Smith normal form of the supercell transformation matrix. In these
+/// coordinates, translation by unit cell t adds t's coordinates modulo S,
+/// so each translation can be checked with strided integer comparisons,
+/// without building the translation permutation.
+Index find_occupation_translation(
+    Eigen::VectorXi const &occupation,
+    Eigen::Matrix3l const &transformation_matrix) {
+  Eigen::Matrix3l U, S, V;
+  smith_normal_form(transformation_matrix, U, S, V);
+  Eigen::Vector3l s = S.diagonal();
+  Index n_unitcells = s(0) * s(1) * s(2);
+  for (Index l = 1; l < n_unitcells; ++l) {
+    Eigen::Vector3l t(l % s(0), (l / s(0)) % s(1), l / (s(0) * s(1)));
+    if (is_occupation_translation_invariant(occupation, s, t)) {
+      return l;
+    }
+  }
+  return n_unitcells;
+}
+
+}  // namespace
+
 /// \brief Check if this is a primitive Configuration
 bool Configuration::is_primitive() const {
   if (!cache().contains("is_primitive")) {
@@ -121,14 +177,25 @@ bool Configuration::is_primitive() const {
 /// translation that maps the Configuration onto itself.
 ///
 /// - If primitive, returns this->supercell().sym_info().translate_end()
+///
+/// - If there are no local continuous DoF, only occupation is compared, using
+///   strided comparisons in Smith normal form coordinates
 PermuteIterator Configuration::find_translation() const {
-  ConfigIsEquivalent f(*this, crystallography_tol());
   const Supercell &scel = supercell();
   auto begin = scel.sym_info().translate_begin();
   auto end = scel.sym_info().translate_end();
   if (++begin == end) {
     return end;
   }
+  if (configdof().local_dofs().empty()) {
+    Index translation_index = find_occupation_translation(
+        occupation(), scel.sym_info().transformation_matrix_to_super());
+    if (translation_index == scel.sym_info().superlattice().size()) {
+      return end;
+    }
+    return PermuteIterator(scel.sym_info(), 0, translation_index);
+  }
+  ConfigIsEquivalent f(*this, crystallography_tol());
   return std::find_if(begin, end, f);
 }
 
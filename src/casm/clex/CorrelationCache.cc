@@ -0,0 +1,379 @@
+#include "casm/clex/CorrelationCache.hh"
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#include "casm/app/DirectoryStructure.hh"
+#include "casm/casm_io/SafeOfstream.hh"
+#include "casm/clex/Clexulator.hh"
+#include "casm/clex/ConfigCorrelations.hh"
+#include "casm/clex/ConfigDoF.hh"
+#include "casm/clex/Configuration.hh"
+#include "casm/clex/Supercell.hh"
+#include "casm/misc/hash.hh"
+
+namespace CASM {
+
+namespace {
+
+/// Increment if the file layout changes
+std::uint64_t const cache_version = 1;
+
+char const corr_magic[8] = {'C', 'A', 'S', 'M', 'C', 'O', 'R', 'R'};
+
+/// Header of correlation cache files, followed by:
+/// - the configuration name of each row (std::uint64_t length, then chars)
+/// - padding to a multiple of 8 bytes
+/// - the configuration DoF hash of each row (std::uint64_t x n_rows)
+/// - correlations (double x n_rows * corr_size, row-major)
+struct CorrFileHeader {
+  char magic[8];
+  std::uint64_t version;
+  std::uint64_t key;
+  std::uint64_t corr_size;
+  std::uint64_t n_rows;
+};
+
+using CASM::fnv1a;
+
+template <typename Derived>
+void fnv1a(std::uint64_t &hash, Eigen::DenseBase<Derived> const &value) {
+  fnv1a(hash, std::int64_t(value.rows()));
+  fnv1a(hash, std::int64_t(value.cols()));
+  for (Index j = 0; j < value.cols(); ++j) {
+    for (Index i = 0; i < value.rows(); ++i) {
+      auto x = value(i, j);
+      fnv1a(hash, &x, sizeof(x));
+    }
+  }
+}
+
+/// Hash the contents of a file, or its absence
+void fnv1a_file(std::uint64_t &hash, fs::path const &path) {
+  if (!fs::exists(path)) {
+    fnv1a(hash, std::int64_t(-1));
+    return;
+  }
+  fs::ifstream in(path, std::ios::binary);
+  char buf[4096];
+  std::int64_t size = 0;
+  while (in.read(buf, sizeof(buf)) || in.gcount()) {
+    fnv1a(hash, buf, in.gcount());
+    size += in.gcount();
+  }
+  fnv1a(hash, size);
+}
+
+template <typename IntType>
+void write_int(std::ostream &out, IntType value) {
+  out.write(reinterpret_cast<char const *>(&value), sizeof(IntType));
+}
+
+template <typename IntType>
+IntType read_int(std::istream &in) {
+  IntType value = 0;
+  in.read(reinterpret_cast<char *>(&value), sizeof(IntType));
+  return value;
+}
+
+void write_padding(std::ostream &out, std::uint64_t n_bytes) {
+  char const zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+  out.write(zeros, (8 - n_bytes % 8) % 8);
+}
+
+}  // namespace
+
+/// \brief Constructor, reads the cache file if it exists and is valid
+///
+/// \param location Cache file path. May be empty to use in memory only.
+/// \param key Hash identifying the basis set
+/// \param corr_size Number of correlations
+CorrelationCache::CorrelationCache(fs::path location, std::uint64_t key,
+                                   Index corr_size)
+    : m_location(location),
+      m_key(key),
+      m_corr_size(corr_size),
+      m_modified(false) {
+  if (!m_location.empty() &&
+      _read(m_location, m_names, m_dof_hash, m_data)) {
+    for (Index i = 0; i < size(); ++i) {
+      m_row[m_names[i]] = i;
+    }
+  }
+}
+
+/// \brief Destructor, commits any inserted rows
+CorrelationCache::~CorrelationCache() {
+  try {
+    commit();
+  } catch (...) {
+    // the cache is an optimization only
+  }
+}
+
+/// \brief Correlations of a configuration, or nullptr if not cached
+///
+/// \param configname Configuration name
+/// \param dof_hash Hash of the configuration DoF values. Rows with a
+///     different hash are not returned.
+///
+/// Returns a pointer to `corr_size()` values, valid until the next insert.
+double const *CorrelationCache::find(std::string const &configname,
+                                     std::uint64_t dof_hash) const {
+  auto it = m_row.find(configname);
+  if (it == m_row.end() || m_dof_hash[it->second] != dof_hash) {
+    return nullptr;
+  }
+  return m_data.data() + it->second * m_corr_size;
+}
+
+/// \brief Insert or replace the correlations of a configuration
+void CorrelationCache::insert(std::string const &configname,
+                              std::uint64_t dof_hash,
+                              Eigen::VectorXd const &corr) {
+  if (corr.size() != m_corr_size) {
+    throw std::runtime_error(
+        "Error in CorrelationCache::insert: expected " +
+        std::to_string(m_corr_size) + " correlations, received " +
+        std::to_string(corr.size()));
+  }
+  _set_row(configname, dof_hash, corr.data());
+  m_modified = true;
+}
+
+/// \brief Write the cache file, if rows were inserted since load
+///
+/// - Rows in the current file, which may have been written by another process
+///   since load, are kept unless this cache has a row with the same name
+void CorrelationCache::commit() {
+  if (!m_modified || m_location.empty()) {
+    return;
+  }
+
+  std::vector<std::string> names;
+  std::vector<std::uint64_t> dof_hash;
+  std::vector<double> data;
+  if (_read(m_location, names, dof_hash, data)) {
+    for (Index i = 0; i < Index(names.size()); ++i) {
+      if (!m_row.count(names[i])) {
+        _set_row(names[i], dof_hash[i], data.data() + i * m_corr_size);
+      }
+    }
+  }
+
+  if (!m_location.parent_path().empty()) {
+    fs::create_directories(m_location.parent_path());
+  }
+  SafeOfstream sout;
+  sout.open(m_location);
+  std::ostream &out = sout.ofstream();
+
+  CorrFileHeader header;
+  std::memcpy(header.magic, corr_magic, 8);
+  header.version = cache_version;
+  header.key = m_key;
+  header.corr_size = m_corr_size;
+  header.n_rows = size();
+  out.write(reinterpret_cast<char const *>(&header), sizeof(header));
+
+  std::uint64_t n_bytes = 0;
+  for (auto const &name : m_names) {
+    write_int<std::uint64_t>(out, name.size());
+    out.write(name.data(), name.size());
+    n_bytes += sizeof(std::uint64_t) + name.size();
+  }
+  write_padding(out, n_bytes);
+  out.write(reinterpret_cast<char const *>(m_dof_hash.data()),
+            m_dof_hash.size() * sizeof(std::uint64_t));
+  out.write(reinterpret_cast<char const *>(m_data.data()),
+            m_data.size() * sizeof(double));
+  sout.close();
+
+  m_modified = false;
+}
+
+/// Read rows from the cache file, if it exists and is valid. Returns false
+/// otherwise.
+bool CorrelationCache::_read(fs::path const &path,
+                             std::vector<std::string> &names,
+                             std::vector<std::uint64_t> &dof_hash,
+                             std::vector<double> &data) const {
+  if (!fs::exists(path)) {
+    return false;
+  }
+  fs::ifstream in(path, std::ios::binary);
+  CorrFileHeader header;
+  if (!in.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+      std::memcmp(header.magic, corr_magic, 8) != 0 ||
+      header.version != cache_version || header.key != m_key ||
+      header.corr_size != std::uint64_t(m_corr_size)) {
+    return false;
+  }
+
+  // check sizes before allocating, in case of a truncated file
+  std::uint64_t file_size = fs::file_size(path);
+  std::uint64_t row_bytes =
+      sizeof(std::uint64_t) * 2 + sizeof(double) * header.corr_size;
+  if (header.n_rows > file_size / row_bytes) {
+    return false;
+  }
+
+  std::vector<std::string> _names(header.n_rows);
+  std::uint64_t n_bytes = 0;
+  for (auto &name : _names) {
+    std::uint64_t length = read_int<std::uint64_t>(in);
+    if (!in || length > file_size) {
+      return false;
+    }
+    name.resize(length);
+    in.read(&name[0], length);
+    n_bytes += sizeof(std::uint64_t) + length;
+  }
+  in.ignore((8 - n_bytes % 8) % 8);
+
+  std::vector<std::uint64_t> _dof_hash(header.n_rows);
+  in.read(reinterpret_cast<char *>(_dof_hash.data()),
+          _dof_hash.size() * sizeof(std::uint64_t));
+  std::vector<double> _data(header.n_rows * header.corr_size);
+  in.read(reinterpret_cast<char *>(_data.data()),
+          _data.size() * sizeof(double));
+  if (!in) {
+    return false;
+  }
+
+  names = std::move(_names);
+  dof_hash = std::move(_dof_hash);
+  data = std::move(_data);
+  return true;
+}
+
+/// Append a row, or replace the existing row with the same name
+void CorrelationCache::_set_row(std::string const &configname,
+                                std::uint64_t dof_hash, double const *corr) {
+  auto it = m_row.find(configname);
+  if (it == m_row.end()) {
+    it = m_row.emplace(configname, size()).first;
+    m_names.push_back(configname);
+    m_dof_hash.push_back(dof_hash);
+    m_data.insert(m_data.end(), corr, corr + m_corr_size);
+  } else {
+    m_dof_hash[it->second] = dof_hash;
+    std::copy(corr, corr + m_corr_size,
+              m_data.begin() + it->second * m_corr_size);
+  }
+}
+
+/// \brief Hash of the DoF values of a configuration
+///
+/// Includes the occupation and the local and global continuous DoF values,
+/// by DoF name.
+std::uint64_t configdof_hash(ConfigDoF const &configdof) {
+  auto const &values = configdof.values();
+  std::uint64_t hash = fnv1a_offset_basis;
+  fnv1a(hash, values.occupation);
+  for (auto const &dof : values.local_dof_values) {
+    fnv1a(hash, dof.first);
+    fnv1a(hash, dof.second);
+  }
+  for (auto const &dof : values.global_dof_values) {
+    fnv1a(hash, dof.first);
+    fnv1a(hash, dof.second);
+  }
+  return hash;
+}
+
+/// \brief Hash of the basis set specs and clexulator source of a basis set,
+/// identifying a CorrelationCache
+///
+/// Changing either file, as by 'casm bset -u', changes the key, which
+/// invalidates cached correlations.
+std::uint64_t correlation_cache_key(DirectoryStructure const &dir,
+                                    std::string const &project_name,
+                                    std::string const &basis_set_name) {
+  std::uint64_t hash = fnv1a_offset_basis;
+  fnv1a(hash, basis_set_name);
+  fnv1a_file(hash, dir.bspecs(basis_set_name));
+  fnv1a_file(hash, dir.clexulator_src(project_name, basis_set_name));
+  return hash;
+}
+
+/// \brief Return true if correlation caches should be used
+///
+/// Correlation caches are used unless the environment variable
+/// "CASM_CORRELATION_CACHE" is "0", "off", or "false".
+bool correlation_cache_enabled() {
+  char *_env = std::getenv("CASM_CORRELATION_CACHE");
+  if (_env != nullptr) {
+    std::string value(_env);
+    if (value == "0" || value == "off" || value == "OFF" ||
+        value == "false" || value == "FALSE") {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// \brief Correlations of a configuration, from a cache if possible
+///
+/// \param config Configuration. The cache is used only for configurations
+///     with an id, as in the configuration database.
+/// \param clexulator Clexulator for the basis set of the cache
+/// \param cache Cache, or nullptr to calculate without a cache
+///
+/// Correlations that are calculated are inserted in the cache.
+Eigen::VectorXd correlations(Configuration const &config,
+                             Clexulator const &clexulator,
+                             CorrelationCache *cache) {
+  if (cache == nullptr || config.id() == "none") {
+    return correlations(config, clexulator);
+  }
+  std::string name = config.name();
+  std::uint64_t dof_hash = configdof_hash(config.configdof());
+  double const *cached = cache->find(name, dof_hash);
+  if (cached != nullptr) {
+    return Eigen::Map<Eigen::VectorXd const>(cached, cache->corr_size());
+  }
+  Eigen::VectorXd corr = correlations(config, clexulator);
+  cache->insert(name, dof_hash, corr);
+  return corr;
+}
+
+/// \brief Calculate and insert the correlations of many configurations that
+/// are not yet in a cache, evaluated in parallel
+///
+/// - Uses the batched `correlations`, so setup is done once per thread and
+///   configurations are grouped by supercell
+Index insert_correlations(
+    CorrelationCache &cache,
+    std::vector<Configuration const *> const &configurations,
+    Clexulator const &clexulator, Index n_threads) {
+  std::vector<Configuration const *> missing;
+  std::vector<std::string> names;
+  std::vector<std::uint64_t> dof_hash;
+  for (Configuration const *config : configurations) {
+    if (config->id() == "none") {
+      continue;
+    }
+    std::string name = config->name();
+    std::uint64_t hash = configdof_hash(config->configdof());
+    if (cache.find(name, hash) == nullptr) {
+      missing.push_back(config);
+      names.push_back(name);
+      dof_hash.push_back(hash);
+    }
+  }
+  if (missing.empty()) {
+    return 0;
+  }
+
+  Eigen::MatrixXdRowMajor corr = correlations(missing, clexulator, n_threads);
+  for (Index i = 0; i < missing.size(); ++i) {
+    cache.insert(names[i], dof_hash[i], corr.row(i).transpose());
+  }
+  return missing.size();
+}
+
+}  // namespace CASM
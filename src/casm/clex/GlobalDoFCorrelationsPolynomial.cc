@@ -0,0 +1,264 @@
+#include "casm/clex/GlobalDoFCorrelationsPolynomial.hh"
+
+#include <functional>
+#include <map>
+#include <sstream>
+
+#include "casm/clex/Clexulator.hh"
+#include "casm/clex/ConfigCorrelations.hh"
+#include "casm/clex/ConfigDoF.hh"
+
+namespace CASM {
+
+namespace {
+
+/// Append all exponent vectors of total order <= max_order, in graded order
+void _make_exponents(std::vector<Eigen::VectorXi> &exponents, Index dim,
+                     Index max_order) {
+  Eigen::VectorXi curr = Eigen::VectorXi::Zero(dim);
+  for (Index order = 0; order <= max_order; ++order) {
+    // enumerate exponent vectors with sum == order, lexicographically
+    std::function<void(Index, Index)> f = [&](Index i, Index remaining) {
+      if (i == dim - 1) {
+        curr(i) = remaining;
+        exponents.push_back(curr);
+        return;
+      }
+      for (Index p = remaining; p >= 0; --p) {
+        curr(i) = p;
+        f(i + 1, remaining - p);
+      }
+    };
+    if (dim > 0) {
+      f(0, order);
+    } else if (order == 0) {
+      exponents.push_back(curr);
+    }
+  }
+}
+
+/// Coefficients of the univariate Newton basis polynomials in x, in terms of
+/// monomials of x: binomial(x / h, a) = sum_q result(a, q) * x^q, for a, q <=
+/// max_order
+Eigen::MatrixXd _newton_to_monomial(Index max_order, double h) {
+  Eigen::MatrixXd result = Eigen::MatrixXd::Zero(max_order + 1, max_order + 1);
+  result(0, 0) = 1.0;
+  for (Index a = 1; a <= max_order; ++a) {
+    // binomial(t, a) = binomial(t, a - 1) * (t - (a - 1)) / a, t = x / h
+    for (Index q = 0; q <= a; ++q) {
+      double x = -(a - 1) * result(a - 1, q);
+      if (q > 0) {
+        x += result(a - 1, q - 1) / h;
+      }
+      result(a, q) = x / a;
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
+/// \brief Constructor, determines the polynomial coefficients
+///
+/// \param configdof Configuration DoF values. The current value of the global
+///     DoF `dof_key` is not used.
+/// \param supercell_neighbor_list Supercell neighbor list
+/// \param clexulator Clexulator
+/// \param dof_key Global continuous DoF type (i.e. "GLstrain")
+/// \param max_poly_order Maximum total polynomial order of the global DoF in
+///     the basis functions
+/// \param corr_indices_begin,corr_indices_end Correlations to include. Other
+///     correlations have zero coefficients.
+/// \param sample_scale Global DoF values are sampled on the grid
+///     `sample_scale / max_poly_order * alpha`, for all exponent vectors
+///     `alpha`, so each component is in [0, sample_scale]
+/// \param tol Tolerance for checking the polynomial against a direct
+///     evaluation, relative to the magnitude of the sampled correlations
+///
+/// Method:
+/// - The correlations are sampled at the grid points, which are unisolvent for
+///   polynomials of total order <= max_poly_order. Forward differences of the
+///   samples give the coefficients of the interpolating polynomial in the
+///   Newton basis, prod_i binomial(e_i / h, alpha_i), which are then expanded
+///   in monomials. No linear system is solved, so the result is deterministic
+///   and exact up to floating point error.
+/// - The polynomial is checked against a direct evaluation at an additional
+///   value, off the grid, and an exception is thrown if the results do not
+///   agree (i.e. `max_poly_order` is too low).
+///
+/// Cost is n_monomials + 1 evaluations of the extensive correlations, where
+/// n_monomials = (dim + max_poly_order)! / (dim! max_poly_order!).
+GlobalDoFCorrelationsPolynomial::GlobalDoFCorrelationsPolynomial(
+    ConfigDoF const &configdof,
+    SuperNeighborList const &supercell_neighbor_list,
+    Clexulator const &clexulator, DoFKey const &dof_key, Index max_poly_order,
+    unsigned int const *corr_indices_begin,
+    unsigned int const *corr_indices_end, double sample_scale, double tol)
+    : m_dof_key(dof_key),
+      m_dim(configdof.global_dof(dof_key).values().size()),
+      m_max_poly_order(max_poly_order),
+      m_correlation_indices(corr_indices_begin, corr_indices_end) {
+  if (max_poly_order < 0) {
+    throw std::runtime_error(
+        "Error constructing GlobalDoFCorrelationsPolynomial: max_poly_order "
+        "must be >= 0");
+  }
+  if (!(sample_scale > 0.0)) {
+    throw std::runtime_error(
+        "Error constructing GlobalDoFCorrelationsPolynomial: sample_scale "
+        "must be > 0");
+  }
+  _make_exponents(m_exponents, m_dim, m_max_poly_order);
+
+  Index n_monomials = m_exponents.size();
+  Index n_corr = clexulator.corr_size();
+  double h = sample_scale / std::max(m_max_poly_order, Index(1));
+
+  std::map<std::vector<int>, Index> exponent_index;
+  for (Index k = 0; k < n_monomials; ++k) {
+    exponent_index.emplace(std::vector<int>(m_exponents[k].data(),
+                                            m_exponents[k].data() + m_dim),
+                           k);
+  }
+
+  // D.col(k): correlations at value = h * exponents[k]
+  ConfigDoF tconfigdof = configdof;
+  Eigen::MatrixXd D = Eigen::MatrixXd::Zero(n_corr, n_monomials);
+  Eigen::VectorXd tcorr;
+  double corr_scale = 1.0;
+  for (Index k = 0; k < n_monomials; ++k) {
+    tconfigdof.global_dof(dof_key).set_values(
+        h * m_exponents[k].cast<double>());
+    restricted_extensive_correlations(tcorr, tconfigdof,
+                                      supercell_neighbor_list, clexulator,
+                                      corr_indices_begin, corr_indices_end);
+    for (unsigned int j : m_correlation_indices) {
+      D(j, k) = tcorr(j);
+      corr_scale = std::max(corr_scale, std::abs(tcorr(j)));
+    }
+  }
+
+  // forward differences, in place, along each dimension:
+  // D.col(k) = Delta^exponents[k] corr(0)
+  for (Index i = 0; i < m_dim; ++i) {
+    for (Index order = 1; order <= m_max_poly_order; ++order) {
+      // visit in order of decreasing exponent i, so D(alpha - e_i) is not yet
+      // updated for this order
+      for (Index k = n_monomials - 1; k >= 0; --k) {
+        if (m_exponents[k](i) < order) {
+          continue;
+        }
+        std::vector<int> lower(m_exponents[k].data(),
+                               m_exponents[k].data() + m_dim);
+        lower[i] -= 1;
+        D.col(k) -= D.col(exponent_index.at(lower));
+      }
+    }
+  }
+
+  // expand the Newton basis in monomials:
+  // W(k_alpha, k_gamma) = prod_i U(alpha_i, gamma_i), for gamma <= alpha
+  Eigen::MatrixXd U = _newton_to_monomial(m_max_poly_order, h);
+  Eigen::MatrixXd W = Eigen::MatrixXd::Zero(n_monomials, n_monomials);
+  for (Index k_alpha = 0; k_alpha < n_monomials; ++k_alpha) {
+    for (Index k_gamma = 0; k_gamma < n_monomials; ++k_gamma) {
+      Eigen::VectorXi const &alpha = m_exponents[k_alpha];
+      Eigen::VectorXi const &gamma = m_exponents[k_gamma];
+      double w = 1.0;
+      for (Index i = 0; i < m_dim && w != 0.0; ++i) {
+        w = (gamma(i) > alpha(i)) ? 0.0 : w * U(alpha(i), gamma(i));
+      }
+      W(k_alpha, k_gamma) = w;
+    }
+  }
+  m_coefficients = D * W;
+
+  // check the polynomial at a value off the grid
+  Eigen::VectorXd value(m_dim);
+  for (Index i = 0; i < m_dim; ++i) {
+    value(i) = -sample_scale * (i + 1) / (m_dim + 1);
+  }
+  tconfigdof.global_dof(dof_key).set_values(value);
+  Eigen::VectorXd expected;
+  restricted_extensive_correlations(expected, tconfigdof,
+                                    supercell_neighbor_list, clexulator,
+                                    corr_indices_begin, corr_indices_end);
+  Eigen::VectorXd found;
+  extensive_correlations(found, value);
+  for (unsigned int j : m_correlation_indices) {
+    double scale = std::max(corr_scale, std::abs(expected(j)));
+    if (std::abs(expected(j) - found(j)) > tol * scale) {
+      std::stringstream msg;
+      msg << "Error constructing GlobalDoFCorrelationsPolynomial: correlation "
+          << j << " is not a polynomial of order <= " << m_max_poly_order
+          << " in '" << dof_key << "' (expected: " << expected(j)
+          << ", found: " << found(j) << "). Check max_poly_order.";
+      throw std::runtime_error(msg.str());
+    }
+  }
+}
+
+/// \brief Evaluate all monomials at a global DoF value
+void GlobalDoFCorrelationsPolynomial::monomials(
+    Eigen::VectorXd &result, Eigen::VectorXd const &value) const {
+  // powers(i, p) = value(i)^p
+  Eigen::MatrixXd powers(m_dim, m_max_poly_order + 1);
+  for (Index i = 0; i < m_dim; ++i) {
+    powers(i, 0) = 1.0;
+    for (Index p = 1; p <= m_max_poly_order; ++p) {
+      powers(i, p) = powers(i, p - 1) * value(i);
+    }
+  }
+  result.resize(m_exponents.size());
+  for (Index k = 0; k < m_exponents.size(); ++k) {
+    double x = 1.0;
+    for (Index i = 0; i < m_dim; ++i) {
+      x *= powers(i, m_exponents[k](i));
+    }
+    result(k) = x;
+  }
+}
+
+/// \brief Extensive correlations at a global DoF value
+///
+/// \param corr Set to size corr_size, with zero value for correlations not
+///     included in `correlation_indices()`
+/// \param value Global DoF value, in the prim DoF basis
+void GlobalDoFCorrelationsPolynomial::extensive_correlations(
+    Eigen::VectorXd &corr, Eigen::VectorXd const &value) const {
+  Eigen::VectorXd m;
+  monomials(m, value);
+  corr = m_coefficients * m;
+}
+
+/// \brief Change in extensive correlations, from one global DoF value to
+/// another
+///
+/// \param dcorr Set to corr(new_value) - corr(curr_value)
+/// \param curr_value,new_value Global DoF values, in the prim DoF basis
+void GlobalDoFCorrelationsPolynomial::delta_corr(
+    Eigen::VectorXd &dcorr, Eigen::VectorXd const &curr_value,
+    Eigen::VectorXd const &new_value) const {
+  Eigen::VectorXd m_curr;
+  Eigen::VectorXd m_new;
+  monomials(m_curr, curr_value);
+  monomials(m_new, new_value);
+  dcorr = m_coefficients * (m_new - m_curr);
+}
+
+/// \brief Sets change in (extensive) correlations due to a global continuous
+/// DoF change, using a GlobalDoFCorrelationsPolynomial
+///
+/// Notes:
+/// - Cost is independent of the supercell size, unlike the
+///   `restricted_delta_corr` overload taking GlobalContinuousConfigDoFValues
+/// - `polynomial` must have been constructed for the configuration's current
+///   values of all other DoF
+void restricted_delta_corr(Eigen::VectorXd &dcorr,
+                           Eigen::VectorXd const &current_value,
+                           Eigen::VectorXd const &new_value,
+                           GlobalDoFCorrelationsPolynomial const &polynomial) {
+  polynomial.delta_corr(dcorr, current_value, new_value);
+}
+
+}  // namespace CASM
@@ -0,0 +1,29 @@
+#include "casm/clex/HasCanonicalForm.hh"
+
+#include <cstdlib>
+#include <string>
+
+namespace CASM {
+
+/// \brief Number of threads used by ConfigCanonicalForm if not specified
+///
+/// Uses the value of the environment variable
+/// "CASM_CANONICAL_FORM_NUM_THREADS", if set and > 0, otherwise 1 (serial).
+/// Canonical form calculations are often already called from parallel loops
+/// over configurations, so they are not split across threads by default.
+Index default_canonical_form_n_threads() {
+  char *_env = std::getenv("CASM_CANONICAL_FORM_NUM_THREADS");
+  if (_env != nullptr) {
+    try {
+      Index n = std::stol(std::string(_env));
+      if (n > 0) {
+        return n;
+      }
+    } catch (std::exception &e) {
+      // fall through to serial
+    }
+  }
+  return 1;
+}
+
+}  // namespace CASM
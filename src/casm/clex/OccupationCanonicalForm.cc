@@ -0,0 +1,216 @@
+#include "casm/clex/OccupationCanonicalForm.hh"
+
+#include <limits>
+#include <vector>
+
+#include "casm/clex/ConfigDoF.hh"
+#include "casm/crystallography/LinearIndexConverter.hh"
+#include "casm/crystallography/UnitCellCoord.hh"
+#include "casm/symmetry/PermuteIterator.hh"
+#include "casm/symmetry/SupercellSymInfo.hh"
+
+namespace CASM {
+
+namespace {
+
+/// \brief Pruned search for the lexicographically maximal transformed
+/// occupation vector
+///
+/// For PermuteIterator (f, t), the transformed occupation is:
+/// \code
+/// v(i) = occupation[F_f[T_t[i]]]
+/// \endcode
+/// where F_f is the factor group permutation and T_t is the translation
+/// permutation, which maps site (b, ijk) to site (b, ijk - trans_t).
+///
+/// For each factor group operation, rather than comparing all translations,
+/// translations are eliminated one site position at a time: at position i,
+/// only translations that give the maximal value of v(i) among the remaining
+/// candidates are kept. Most translations are eliminated within the first few
+/// positions, so most full transformed vectors are never generated, and
+/// translation permutations are never materialized. The search for a factor
+/// group operation also stops as soon as its best candidate is found to be
+/// less than the best vector found so far.
+///
+/// Ties are resolved exactly as by `std::max_element` over
+/// [permute_begin(), permute_end()): the first maximal PermuteIterator wins.
+class OccupationCanonicalSearch {
+ public:
+  OccupationCanonicalSearch(Eigen::VectorXi const &occupation,
+                            SupercellSymInfo const &sym_info)
+      : m_occupation(occupation),
+        m_sym_info(sym_info),
+        m_bijk_converter(sym_info.unitcellcoord_index_converter()),
+        m_n_sites(occupation.size()),
+        m_n_trans(sym_info.superlattice().size()),
+        m_has_best(false),
+        m_best_fg(0),
+        m_best_trans(0) {
+    m_trans.reserve(m_n_trans);
+    for (Index t = 0; t < m_n_trans; ++t) {
+      m_trans.push_back(sym_info.unitcell_index_converter()(t));
+    }
+  }
+
+  /// \brief Use the untransformed occupation as the initial best vector
+  void seed_with_identity() {
+    m_has_best = true;
+    m_best_value.assign(m_occupation.data(), m_occupation.data() + m_n_sites);
+  }
+
+  /// \brief Search all factor group operations
+  ///
+  /// \param stop_if_greater If true, stop and return false as soon as a vector
+  ///     greater than the current best is found
+  ///
+  /// \returns false if stopped early, true otherwise
+  bool search(bool stop_if_greater) {
+    Index n_fg = m_sym_info.factor_group().size();
+    for (Index f = 0; f < n_fg; ++f) {
+      bool greater = false;
+      if (!_search_factor_group_op(f, greater)) {
+        continue;
+      }
+      if (greater && stop_if_greater) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// \brief The best PermuteIterator found
+  PermuteIterator best() const {
+    return m_sym_info.permute_it(m_best_fg, m_best_trans);
+  }
+
+ private:
+  /// \brief Index of site T_t[i]
+  Index _translate(Index t, Index i) const {
+    return m_bijk_converter(m_bijk_converter(i) - m_trans[t]);
+  }
+
+  /// \brief Search translations for one factor group operation
+  ///
+  /// \param f Factor group operation index
+  /// \param greater Set to true if a new best is found that is strictly greater
+  ///     than the previous best
+  ///
+  /// \returns true if a new best was found
+  bool _search_factor_group_op(Index f, bool &greater) {
+    Permutation const &F = m_sym_info.factor_group_permute(f);
+
+    m_candidates.resize(m_n_trans);
+    for (Index t = 0; t < m_n_trans; ++t) {
+      m_candidates[t] = t;
+    }
+
+    // while `tied`, the best candidate matches m_best_value up to position i
+    bool tied = m_has_best;
+    for (Index i = 0; i < m_n_sites; ++i) {
+      if (m_candidates.size() == 1 && !tied) {
+        break;
+      }
+      int max_value = std::numeric_limits<int>::min();
+      m_next.clear();
+      for (Index t : m_candidates) {
+        int value = m_occupation[F[_translate(t, i)]];
+        if (value > max_value) {
+          max_value = value;
+          m_next.clear();
+          m_next.push_back(t);
+        } else if (value == max_value) {
+          m_next.push_back(t);
+        }
+      }
+      std::swap(m_candidates, m_next);
+
+      if (tied) {
+        if (max_value < m_best_value[i]) {
+          return false;
+        }
+        if (max_value > m_best_value[i]) {
+          tied = false;
+        }
+      }
+    }
+
+    // equal to the previous best, which has a lower index
+    if (tied) {
+      return false;
+    }
+
+    greater = m_has_best;
+    m_has_best = true;
+    m_best_fg = f;
+    m_best_trans = m_candidates[0];
+    m_best_value.resize(m_n_sites);
+    for (Index i = 0; i < m_n_sites; ++i) {
+      m_best_value[i] = m_occupation[F[_translate(m_best_trans, i)]];
+    }
+    return true;
+  }
+
+  Eigen::VectorXi const &m_occupation;
+  SupercellSymInfo const &m_sym_info;
+  xtal::UnitCellCoordIndexConverter const &m_bijk_converter;
+  Index m_n_sites;
+  Index m_n_trans;
+  std::vector<xtal::UnitCell> m_trans;
+
+  bool m_has_best;
+  Index m_best_fg;
+  Index m_best_trans;
+  std::vector<int> m_best_value;
+
+  std::vector<Index> m_candidates;
+  std::vector<Index> m_next;
+};
+
+}  // namespace
+
+/// \brief True if Configuration comparison reduces to lexicographic
+/// comparison of isotropic occupation values
+///
+/// This is the case if there are occupation DoF, no anisotropic occupants, and
+/// no continuous DoF. Then `ConfigIsEquivalent` compares only the occupation
+/// vectors, in site order.
+bool is_occupation_only(ConfigDoF const &configdof,
+                        SupercellSymInfo const &sym_info) {
+  return sym_info.has_occupation_dofs() && !sym_info.has_aniso_occs() &&
+         configdof.global_dofs().empty() && configdof.local_dofs().empty();
+}
+
+/// \brief Return the first PermuteIterator, in the order
+/// [permute_begin(), permute_end()), that transforms an occupation vector to
+/// its canonical (lexicographically maximal) form
+///
+/// Equivalent to, but much faster in large supercells than:
+/// \code
+/// std::max_element(sym_info.permute_begin(), sym_info.permute_end(),
+///                  configuration.less());
+/// \endcode
+/// for a Configuration for which `is_occupation_only` is true.
+PermuteIterator occupation_to_canonical(Eigen::VectorXi const &occupation,
+                                        SupercellSymInfo const &sym_info) {
+  OccupationCanonicalSearch f(occupation, sym_info);
+  f.search(false);
+  return f.best();
+}
+
+/// \brief True if no PermuteIterator in [permute_begin(), permute_end())
+/// transforms an occupation vector to a lexicographically greater vector
+///
+/// Equivalent to, but much faster in large supercells than:
+/// \code
+/// std::none_of(sym_info.permute_begin(), sym_info.permute_end(),
+///              configuration.less());
+/// \endcode
+/// for a Configuration for which `is_occupation_only` is true.
+bool occupation_is_canonical(Eigen::VectorXi const &occupation,
+                             SupercellSymInfo const &sym_info) {
+  OccupationCanonicalSearch f(occupation, sym_info);
+  f.seed_with_identity();
+  return f.search(true);
+}
+
+}  // namespace CASM
@@ -0,0 +1,248 @@
+#include "casm/clex/OccupationOrbitCount.hh"
+
+#include <map>
+#include <numeric>
+#include <set>
+#include <vector>
+
+#include "casm/symmetry/PermuteIterator.hh"
+#include "casm/symmetry/SupercellSymInfo.hh"
+
+namespace CASM {
+
+using boost::multiprecision::cpp_int;
+
+namespace {
+
+/// \brief Translation subgroups with non-zero Moebius function mu({e}, H)
+///
+/// In a finite abelian group mu({e}, H) is non-zero only if H is a product,
+/// over primes p, of elementary abelian groups (Z_p)^k_p, in which case
+/// mu({e}, H) = prod_p (-1)^k_p * p^(k_p * (k_p - 1) / 2). These are the
+/// subgroups of the elements of square-free order.
+///
+/// \param translations Supercell translation permutations, as from
+///     `SupercellSymInfo::translation_permutations()`
+/// \returns Pairs of (translation indices in H, mu({e}, H))
+std::vector<std::pair<std::vector<Index>, long>> _translation_subgroups(
+    std::vector<Permutation> const &translations) {
+  Index n_translations = translations.size();
+  std::map<std::vector<Index>, Index> translation_index;
+  for (Index t = 0; t < n_translations; ++t) {
+    translation_index[translations[t].perm_array()] = t;
+  }
+  auto product = [&](Index a, Index b) {
+    Permutation ab = translations[a] * translations[b];
+    return translation_index.at(ab.perm_array());
+  };
+
+  Index identity = 0;
+  while (!translations[identity].is_identity()) {
+    ++identity;
+  }
+
+  // elements of square-free order
+  std::vector<Index> candidates;
+  for (Index t = 0; t < n_translations; ++t) {
+    Index order = 1;
+    for (Index x = t; x != identity; x = product(x, t)) {
+      ++order;
+    }
+    bool square_free = true;
+    for (Index p = 2; p * p <= order; ++p) {
+      if (order % (p * p) == 0) {
+        square_free = false;
+      }
+    }
+    if (square_free) {
+      candidates.push_back(t);
+    }
+  }
+
+  // all subgroups generated by candidates, by adding one generator at a time
+  std::set<std::vector<Index>> subgroups;
+  std::vector<std::vector<Index>> queue{{identity}};
+  subgroups.insert(queue.front());
+  while (queue.size()) {
+    std::vector<Index> subgroup = queue.back();
+    queue.pop_back();
+    for (Index x : candidates) {
+      if (std::binary_search(subgroup.begin(), subgroup.end(), x)) {
+        continue;
+      }
+      std::set<Index> generated;
+      for (Index y = x; !generated.count(y); y = product(y, x)) {
+        for (Index s : subgroup) {
+          generated.insert(product(s, y));
+        }
+      }
+      std::vector<Index> next(generated.begin(), generated.end());
+      if (subgroups.insert(next).second) {
+        queue.push_back(next);
+      }
+    }
+  }
+
+  std::vector<std::pair<std::vector<Index>, long>> result;
+  for (auto const &subgroup : subgroups) {
+    long mu = 1;
+    Index size = subgroup.size();
+    for (Index p = 2; size > 1; ++p) {
+      // for the k-th factor of p, multiply by -p^k
+      long p_to_k = 1;
+      for (; size % p == 0; size /= p) {
+        mu *= -p_to_k;
+        p_to_k *= p;
+      }
+    }
+    result.emplace_back(subgroup, mu);
+  }
+  return result;
+}
+
+}  // namespace
+
+/// \brief Number of occupation vectors, the product of the number of
+/// allowed occupants on each site
+cpp_int count_occupations(Eigen::VectorXi const &max_allowed_occupation) {
+  cpp_int result = 1;
+  for (Index i = 0; i < max_allowed_occupation.size(); ++i) {
+    result *= max_allowed_occupation(i) + 1;
+  }
+  return result;
+}
+
+/// \brief Number of distinct occupations, under the supercell symmetry
+/// group, counted with Burnside's lemma
+///
+/// The number of orbits is the average, over all operations g in
+/// [permute_begin(), permute_end()), of the number of occupations left
+/// unchanged by g. An occupation is unchanged by g if and only if it is
+/// constant on each cycle of g's site permutation, so that number is the
+/// product, over cycles, of the number of allowed occupants in the cycle.
+///
+/// Operations with the same cycle structure give the same product, so cycle
+/// counts are tallied first and each distinct product is only evaluated
+/// once. This assumes isotropic occupants, as for `is_occupation_only`.
+///
+/// \param sym_info Supercell symmetry
+/// \param max_allowed_occupation Maximum occupant index on each site, as
+///     from `Supercell::max_allowed_occupation()`
+cpp_int count_occupation_orbits(SupercellSymInfo const &sym_info,
+                                Eigen::VectorXi const &max_allowed_occupation) {
+  Index n_sites = max_allowed_occupation.size();
+  Index max_n_allowed = max_allowed_occupation.maxCoeff() + 1;
+
+  // n_cycles[k]: number of cycles with k allowed occupants
+  std::map<std::vector<Index>, Index> cycle_structure_count;
+  std::vector<bool> visited(n_sites);
+  std::vector<Index> n_cycles(max_n_allowed + 1);
+  Index n_ops = 0;
+  auto end = sym_info.permute_end();
+  for (auto it = sym_info.permute_begin(); it != end; ++it) {
+    std::fill(visited.begin(), visited.end(), false);
+    std::fill(n_cycles.begin(), n_cycles.end(), 0);
+    for (Index i = 0; i < n_sites; ++i) {
+      if (visited[i]) {
+        continue;
+      }
+      Index n_allowed = max_allowed_occupation(i) + 1;
+      for (Index j = i; !visited[j]; j = it->permute_ind(j)) {
+        visited[j] = true;
+        n_allowed = std::min(n_allowed, Index(max_allowed_occupation(j) + 1));
+      }
+      ++n_cycles[n_allowed];
+    }
+    ++cycle_structure_count[n_cycles];
+    ++n_ops;
+  }
+
+  cpp_int sum = 0;
+  for (auto const &value : cycle_structure_count) {
+    cpp_int n_fixed = 1;
+    for (Index k = 2; k < value.first.size(); ++k) {
+      n_fixed *= boost::multiprecision::pow(cpp_int(k), value.first[k]);
+    }
+    sum += n_fixed * value.second;
+  }
+  return sum / n_ops;
+}
+
+/// \brief Number of distinct primitive occupations, under the supercell
+/// symmetry group
+///
+/// The set of primitive occupations is closed under the supercell symmetry
+/// group, so Burnside's lemma applies to it: the number of orbits is the
+/// average, over operations g, of the number of primitive occupations left
+/// unchanged by g. By Moebius inversion over the lattice of translation
+/// subgroups, that number is the sum, over translation subgroups H, of
+/// mu({e}, H) times the number of occupations left unchanged by both g and H.
+/// Those are the occupations constant on each orbit of the sites under the
+/// group generated by g and H. This assumes isotropic occupants, as for
+/// `is_occupation_only`.
+///
+/// \param sym_info Supercell symmetry
+/// \param max_allowed_occupation Maximum occupant index on each site, as
+///     from `Supercell::max_allowed_occupation()`
+cpp_int count_primitive_occupation_orbits(
+    SupercellSymInfo const &sym_info,
+    Eigen::VectorXi const &max_allowed_occupation) {
+  Index n_sites = max_allowed_occupation.size();
+  Index max_n_allowed = max_allowed_occupation.maxCoeff() + 1;
+  std::vector<Permutation> const &translations =
+      sym_info.translation_permutations();
+  auto subgroups = _translation_subgroups(translations);
+
+  // n_orbits[k]: number of site orbits with k allowed occupants
+  std::map<std::vector<Index>, long> orbit_structure_count;
+  std::vector<Index> parent(n_sites);
+  std::vector<Index> n_allowed(n_sites);
+  std::vector<Index> n_orbits(max_n_allowed + 1);
+  auto find = [&](Index i) {
+    while (parent[i] != i) {
+      i = parent[i] = parent[parent[i]];
+    }
+    return i;
+  };
+  auto join = [&](Index i, Index j) { parent[find(i)] = find(j); };
+
+  Index n_ops = 0;
+  auto end = sym_info.permute_end();
+  for (auto it = sym_info.permute_begin(); it != end; ++it) {
+    for (auto const &subgroup : subgroups) {
+      std::iota(parent.begin(), parent.end(), 0);
+      for (Index i = 0; i < n_sites; ++i) {
+        join(i, it->permute_ind(i));
+        for (Index t : subgroup.first) {
+          join(i, translations[t][i]);
+        }
+      }
+      std::fill(n_allowed.begin(), n_allowed.end(), max_n_allowed);
+      for (Index i = 0; i < n_sites; ++i) {
+        Index &root_n_allowed = n_allowed[find(i)];
+        root_n_allowed =
+            std::min(root_n_allowed, Index(max_allowed_occupation(i) + 1));
+      }
+      std::fill(n_orbits.begin(), n_orbits.end(), 0);
+      for (Index i = 0; i < n_sites; ++i) {
+        if (find(i) == i) {
+          ++n_orbits[n_allowed[i]];
+        }
+      }
+      orbit_structure_count[n_orbits] += subgroup.second;
+    }
+    ++n_ops;
+  }
+
+  cpp_int sum = 0;
+  for (auto const &value : orbit_structure_count) {
+    cpp_int n_fixed = 1;
+    for (Index k = 2; k < value.first.size(); ++k) {
+      n_fixed *= boost::multiprecision::pow(cpp_int(k), value.first[k]);
+    }
+    sum += n_fixed * value.second;
+  }
+  return sum / n_ops;
+}
+
+}  // namespace CASM
@@ -14,10 +14,12 @@
 #include "casm/clex/Clexulator.hh"
 #include "casm/clex/CompositionAxes_impl.hh"
 #include "casm/clex/CompositionConverter.hh"
+#include "casm/clex/CorrelationCache.hh"
 #include "casm/clex/ECIContainer.hh"
 #include "casm/clex/NeighborList.hh"
 #include "casm/clex/NeighborhoodInfo_impl.hh"
 #include "casm/clex/PrimClex_impl.hh"
+#include "casm/clex/SupercellSymCache.hh"
 #include "casm/clex/io/ProtoFuncsPrinter_impl.hh"
 #include "casm/clex/io/file/ChemicalReference_file_io.hh"
 #include "casm/clex/io/file/CompositionAxes_file_io.hh"
@@ -33,6 +35,8 @@
 #include "casm/database/DatabaseTypes_impl.hh"
 #include "casm/symmetry/SubOrbits_impl.hh"
 #include "casm/symmetry/json_io.hh"
+#include "casm/system/PrecompiledHeader.hh"
+#include "casm/system/RuntimeLibrary.hh"
 
 namespace CASM {
 
@@ -89,10 +93,23 @@ struct PrimClex::PrimClexData {
   /// - mutable for lazy construction
   mutable std::shared_ptr<PrimNeighborList> nlist;
 
+  /// On-disk cache of supercell symmetry data
+  /// - mutable for lazy construction
+  mutable bool supercell_sym_cache_checked = false;
+  mutable std::unique_ptr<SupercellSymCache> supercell_sym_cache;
+
   typedef std::string BasisSetName;
   mutable std::map<BasisSetName, ClexBasisSpecs> basis_set_specs;
   mutable std::map<BasisSetName, Clexulator> clexulator;
   mutable std::map<BasisSetName, std::vector<Clexulator>> local_clexulator;
+
+  /// On-disk caches of correlations, which are committed on destruction
+  /// - mutable for lazy construction
+  /// - shared, so that users (i.e. ConfigIO::Corr) remain valid after
+  ///   `refresh`
+  mutable std::map<BasisSetName, std::shared_ptr<CorrelationCache>>
+      correlation_cache;
+
   mutable std::map<BasisSetName, std::unique_ptr<NeighborhoodInfo>>
       neighborhood_info;
   mutable std::map<ClexDescription, ECIContainer> eci;
@@ -222,6 +239,7 @@ void PrimClex::refresh(bool read_settings, bool read_composition,
   if (clear_clex) {
     m_data->nlist.reset();
     m_data->clexulator.clear();
+    m_data->correlation_cache.clear();
     m_data->eci.clear();
   }
 }
@@ -287,6 +305,24 @@ std::shared_ptr<PrimNeighborList> const &PrimClex::shared_nlist() const {
 
 PrimNeighborList &PrimClex::nlist() const { return *shared_nlist(); }
 
+/// Access the on-disk cache of supercell symmetry data, or nullptr if not
+/// used
+///
+/// The cache is used if the PrimClex has a project directory, unless disabled
+/// by setting the environment variable "CASM_SUPERCELL_SYM_CACHE" to "off".
+/// On first access, cache files for other prim are removed.
+SupercellSymCache const *PrimClex::supercell_sym_cache() const {
+  if (!m_data->supercell_sym_cache_checked) {
+    m_data->supercell_sym_cache_checked = true;
+    if (has_dir() && supercell_sym_cache_enabled()) {
+      m_data->supercell_sym_cache = notstd::make_unique<SupercellSymCache>(
+          dir().supercell_cache_dir(), prim_file_hash(dir().prim()));
+      m_data->supercell_sym_cache->remove_stale();
+    }
+  }
+  return m_data->supercell_sym_cache.get();
+}
+
 /// returns true if vacancy are an allowed species
 bool PrimClex::vacancy_allowed() const { return m_data->vacancy_allowed; }
 
@@ -466,6 +502,43 @@ std::vector<Clexulator> PrimClex::local_clexulator(
   return it->second;
 }
 
+/// Access the on-disk cache of correlations for a basis set, or nullptr if
+/// not used
+///
+/// - Not used if there is no project directory, or if disabled by the
+///   environment variable "CASM_CORRELATION_CACHE" (see
+///   `correlation_cache_enabled`)
+std::shared_ptr<CorrelationCache> PrimClex::correlation_cache(
+    std::string const &basis_set_name) const {
+  if (!has_dir() || !correlation_cache_enabled()) {
+    return nullptr;
+  }
+  auto it = m_data->correlation_cache.find(basis_set_name);
+  if (it == m_data->correlation_cache.end()) {
+    std::uint64_t key = correlation_cache_key(dir(), settings().project_name(),
+                                              basis_set_name);
+    Index corr_size = clexulator(basis_set_name).corr_size();
+    it = m_data->correlation_cache
+             .emplace(basis_set_name,
+                      std::make_shared<CorrelationCache>(
+                          dir().correlation_cache(basis_set_name), key,
+                          corr_size))
+             .first;
+  }
+  return it->second;
+}
+
+/// Names of the basis sets with a correlation cache that has been accessed
+///
+/// - Used to evaluate correlations in batches for the caches used by a query
+std::vector<std::string> PrimClex::correlation_cache_basis_sets() const {
+  std::vector<std::string> result;
+  for (auto const &value : m_data->correlation_cache) {
+    result.push_back(value.first);
+  }
+  return result;
+}
+
 bool PrimClex::has_eci(const ClexDescription &key) const {
   auto it = m_data->eci.find(key);
   if (it == m_data->eci.end()) {
@@ -664,6 +737,110 @@ void write_basis_set_data(std::shared_ptr<Structure const> shared_prim,
   for_all_orbits(cluster_specs, log, writer);
 }
 
+namespace {
+
+/// \brief Headers included by every generated clexulator
+///
+/// Note: The ClexParamPack header is not included because
+/// BasicClexParamPack.hh and DiffClexParamPack.hh may not be included in the
+/// same translation unit.
+std::vector<std::string> _clexulator_pch_includes() {
+  return std::vector<std::string>{"<cstddef>",
+                                  "\"casm/clexulator/BaseClexulator.hh\"",
+                                  "\"casm/global/eigen.hh\""};
+}
+
+/// \brief Compile and shared library options for a clexulator
+///
+/// Starts from `settings.compile_options()` and `settings.so_options()`, and:
+/// - If `RuntimeLibrary::default_pgo_mode()` is "generate" or "use", adds
+///   profile-guided optimization options, with profile data in
+///   `<clexulator_dir>/pgo`.
+/// - Unless `RuntimeLibrary::default_pch_mode()` is "off" or `compile` is
+///   false, builds (if necessary) a precompiled header of the CASM and Eigen headers included by
+///   generated clexulators, and includes it. The precompiled header is stored
+///   in `dir.clexulator_pch_dir()`, in a subdirectory specific to the compile
+///   options, and is rebuilt automatically if any of the headers change. If
+///   the precompiled header can not be built, clexulators are compiled without
+///   it.
+///
+/// Compile options are only used if a clexulator must be compiled, so
+/// `compile` should be false if all clexulator shared libraries exist.
+std::pair<std::string, std::string> _clexulator_build_options(
+    ProjectSettings const &settings, std::string const &basis_set_name,
+    bool compile) {
+  std::string compile_options = settings.compile_options();
+  std::string so_options = settings.so_options() + " -lcasm ";
+
+  std::string pgo_mode = RuntimeLibrary::default_pgo_mode().first;
+  fs::path pgo_dir = settings.dir().clexulator_dir(basis_set_name) / "pgo";
+  if (pgo_mode == "generate") {
+    compile_options += " -fprofile-generate=" + pgo_dir.string();
+    so_options += " -fprofile-generate=" + pgo_dir.string();
+  } else if (pgo_mode == "use") {
+    compile_options += " -fprofile-use=" + pgo_dir.string() +
+                       " -fprofile-correction -Wno-missing-profile";
+  } else if (pgo_mode != "off") {
+    throw std::runtime_error(
+        "Error in make_clexulator: CASM_PGO must be one of \"off\", "
+        "\"generate\", or \"use\", found \"" +
+        pgo_mode + "\"");
+  }
+
+  if (!compile || RuntimeLibrary::default_pch_mode().first == "off") {
+    return std::make_pair(compile_options, so_options);
+  }
+
+  std::stringstream ss;
+  ss << std::hex << std::hash<std::string>{}(compile_options);
+  PrecompiledHeader pch{settings.dir().clexulator_pch_dir() / ss.str(),
+                        "clexulator_pch", _clexulator_pch_includes(),
+                        compile_options};
+  if (!pch.is_current()) {
+    log() << "Building precompiled header: " << pch.precompiled_header()
+          << std::endl;
+    try {
+      pch.update();
+    } catch (std::exception &e) {
+      err_log() << e.what() << std::endl;
+      err_log() << "Continuing without precompiled header" << std::endl;
+      return std::make_pair(compile_options, so_options);
+    }
+  }
+  return std::make_pair(compile_options + " " + pch.include_option(),
+                        so_options);
+}
+
+/// \brief True if any clexulator shared library must be compiled
+///
+/// \param clexulator_dir Directory containing the clexulator source code
+/// \param clexulator_name Clexulator name
+/// \param local If true, check the local clexulators in the numbered
+///     subdirectories of `clexulator_dir`, as in `make_local_clexulator`
+bool _clexulator_needs_compile(fs::path const &clexulator_dir,
+                               std::string const &clexulator_name,
+                               bool local) {
+  if (!local) {
+    return !fs::exists(clexulator_dir / (clexulator_name + ".so"));
+  }
+  Index i = 0;
+  fs::path equiv_dir = clexulator_dir / fs::path(std::to_string(i));
+  while (fs::exists(equiv_dir)) {
+    std::string equiv_name = clexulator_name + "_" + std::to_string(i);
+    if (!fs::exists(equiv_dir / (equiv_name + ".cc"))) {
+      break;
+    }
+    if (!fs::exists(equiv_dir / (equiv_name + ".so"))) {
+      return true;
+    }
+    ++i;
+    equiv_dir = clexulator_dir / fs::path(std::to_string(i));
+  }
+  return false;
+}
+
+}  // namespace
+
 /// \brief Make Clexulator from existing source code
 ///
 /// Notes:
@@ -678,10 +855,12 @@ Clexulator make_clexulator(ProjectSettings const &settings,
                              settings.dir());
   std::string clexulator_name =
       settings.project_name() + "_Clexulator_" + basis_set_name;
-  return make_clexulator(clexulator_name,
-                         settings.dir().clexulator_dir(basis_set_name),
-                         prim_neighbor_list, settings.compile_options(),
-                         settings.so_options() + " -lcasm ");
+  fs::path clexulator_dir = settings.dir().clexulator_dir(basis_set_name);
+  auto options = _clexulator_build_options(
+      settings, basis_set_name,
+      _clexulator_needs_compile(clexulator_dir, clexulator_name, false));
+  return make_clexulator(clexulator_name, clexulator_dir, prim_neighbor_list,
+                         options.first, options.second);
 }
 
 /// \brief Make local Clexulator from existing source code
@@ -698,10 +877,13 @@ std::vector<Clexulator> make_local_clexulator(
                              settings.dir());
   std::string clexulator_name =
       settings.project_name() + "_Clexulator_" + basis_set_name;
-  return make_local_clexulator(clexulator_name,
-                               settings.dir().clexulator_dir(basis_set_name),
-                               prim_neighbor_list, settings.compile_options(),
-                               settings.so_options() + " -lcasm ");
+  fs::path clexulator_dir = settings.dir().clexulator_dir(basis_set_name);
+  auto options = _clexulator_build_options(
+      settings, basis_set_name,
+      _clexulator_needs_compile(clexulator_dir, clexulator_name, true));
+  return make_local_clexulator(clexulator_name, clexulator_dir,
+                               prim_neighbor_list, options.first,
+                               options.second);
 }
 
 }  // namespace CASM
@@ -7,8 +7,11 @@
 #include "casm/casm_io/Log.hh"
 #include "casm/casm_io/container/stream_io.hh"
 #include "casm/clex/ChemicalReference.hh"
+#include "casm/clex/ConfigFingerprint.hh"
 #include "casm/clex/NeighborList.hh"
 #include "casm/clex/PrimClex.hh"
+#include "casm/clex/SupercellLRU.hh"
+#include "casm/clex/SupercellSymCache.hh"
 #include "casm/clex/Supercell_impl.hh"
 #include "casm/crystallography/BasicStructure.hh"
 #include "casm/crystallography/CanonicalForm.hh"
@@ -32,31 +35,25 @@ template class DB::Named<
     Comparisons<SupercellCanonicalForm<CRTPBase<Supercell> > > >;
 }
 
-// Copy constructor is needed for proper initialization of supercell sym info
-Supercell::Supercell(const Supercell &RHS)
-    : m_primclex(RHS.m_primclex),
-      m_shared_prim(RHS.m_shared_prim),
-      m_sym_info(make_supercell_sym_info(prim(), RHS.lattice())),
-      m_nlist_size_at_construction(-1) {}
+namespace {
 
-Supercell::Supercell(std::shared_ptr<Structure const> const &_shared_prim,
-                     Eigen::Matrix3l const &transf_mat_init)
-    : m_primclex(nullptr),
-      m_shared_prim(_shared_prim),
-      m_sym_info(make_supercell_sym_info(
-          prim(), Lattice(prim().lattice().lat_column_mat() *
-                              transf_mat_init.cast<double>(),
-                          crystallography_tol()))),
-      m_nlist_size_at_construction(-1) {}
+/// Use site permutations from the PrimClex supercell symmetry cache, if
+/// available
+void load_supercell_sym_cache(PrimClex const &primclex,
+                              SupercellSymInfo const &sym_info) {
+  SupercellSymCache const *cache = primclex.supercell_sym_cache();
+  if (cache && sym_info.permutation_table().layout() ==
+                   SupercellPermutationTable::Layout::none) {
+    cache->load(sym_info);
+  }
+}
 
-Supercell::Supercell(std::shared_ptr<Structure const> const &_shared_prim,
-                     const Lattice &superlattice)
-    : m_primclex(nullptr),
-      m_shared_prim(_shared_prim),
-      m_sym_info(make_supercell_sym_info(prim(), superlattice)),
-      m_nlist_size_at_construction(-1) {
-  auto res = xtal::is_superlattice(superlattice, prim().lattice(),
-                                   crystallography_tol());
+/// Construct the Superlattice of a Supercell, checking that the
+/// transformation matrix is integer
+xtal::Superlattice make_checked_superlattice(Structure const &prim,
+                                             Lattice const &superlattice) {
+  double tol = prim.lattice().tol();
+  auto res = xtal::is_superlattice(superlattice, prim.lattice(), tol);
   if (!res.first) {
     err_log()
         << "Error in Supercell(PrimClex *_prim, const Lattice &superlattice)"
@@ -66,50 +63,96 @@ Supercell::Supercell(std::shared_ptr<Structure const> const &_shared_prim,
     err_log() << "superlattice: \n"
               << superlattice.lat_column_mat() << std::endl;
     err_log() << "prim lattice: \n"
-              << prim().lattice().lat_column_mat() << std::endl;
+              << prim.lattice().lat_column_mat() << std::endl;
     err_log() << "transformation matrix: \n" << res.second << std::endl;
     throw std::invalid_argument(
         "Error constructing Supercell: the transformation matrix is not "
         "integer");
   }
+  return xtal::Superlattice(prim.lattice(), superlattice);
 }
 
+}  // namespace
+
+// Copy constructor is needed for proper initialization of supercell sym info
+// - The copy constructs its own SupercellSymInfo on first use, and is not
+//   registered with the SupercellLRU of RHS
+Supercell::Supercell(const Supercell &RHS)
+    : m_primclex(RHS.m_primclex),
+      m_shared_prim(RHS.m_shared_prim),
+      m_superlattice(RHS.m_superlattice),
+      m_sym_info_ptr(nullptr),
+      m_nlist_ptr(nullptr),
+      m_nlist_size_at_construction(-1),
+      m_lru(nullptr),
+      m_last_use(0),
+      m_fingerprint_calculator_ptr(nullptr) {}
+
+Supercell &Supercell::operator=(const Supercell &RHS) {
+  if (this == &RHS) {
+    return *this;
+  }
+  set_lru(nullptr);
+  _release();
+  m_primclex = RHS.m_primclex;
+  m_shared_prim = RHS.m_shared_prim;
+  m_superlattice = RHS.m_superlattice;
+  return *this;
+}
+
+Supercell::Supercell(std::shared_ptr<Structure const> const &_shared_prim,
+                     Eigen::Matrix3l const &transf_mat_init)
+    : m_primclex(nullptr),
+      m_shared_prim(_shared_prim),
+      m_superlattice(prim().lattice(), transf_mat_init),
+      m_sym_info_ptr(nullptr),
+      m_nlist_ptr(nullptr),
+      m_nlist_size_at_construction(-1),
+      m_lru(nullptr),
+      m_last_use(0),
+      m_fingerprint_calculator_ptr(nullptr) {}
+
+Supercell::Supercell(std::shared_ptr<Structure const> const &_shared_prim,
+                     const Lattice &superlattice)
+    : m_primclex(nullptr),
+      m_shared_prim(_shared_prim),
+      m_superlattice(make_checked_superlattice(prim(), superlattice)),
+      m_sym_info_ptr(nullptr),
+      m_nlist_ptr(nullptr),
+      m_nlist_size_at_construction(-1),
+      m_lru(nullptr),
+      m_last_use(0),
+      m_fingerprint_calculator_ptr(nullptr) {}
+
 Supercell::Supercell(const PrimClex *_prim,
                      const Eigen::Ref<const Eigen::Matrix3l> &transf_mat_init)
     : m_primclex(_prim),
       m_shared_prim(_prim->shared_prim()),
-      m_sym_info(make_supercell_sym_info(
-          prim(), Lattice(prim().lattice().lat_column_mat() *
-                              transf_mat_init.cast<double>(),
-                          crystallography_tol()))),
-      m_nlist_size_at_construction(-1) {}
+      m_superlattice(prim().lattice(), Eigen::Matrix3l(transf_mat_init)),
+      m_sym_info_ptr(nullptr),
+      m_nlist_ptr(nullptr),
+      m_nlist_size_at_construction(-1),
+      m_lru(nullptr),
+      m_last_use(0),
+      m_fingerprint_calculator_ptr(nullptr) {}
 
 Supercell::Supercell(const PrimClex *_prim, const Lattice &superlattice)
     : m_primclex(_prim),
       m_shared_prim(_prim->shared_prim()),
-      m_sym_info(make_supercell_sym_info(prim(), superlattice)),
-      m_nlist_size_at_construction(-1) {
-  auto res = xtal::is_superlattice(superlattice, prim().lattice(),
-                                   crystallography_tol());
-  if (!res.first) {
-    err_log()
-        << "Error in Supercell(PrimClex *_prim, const Lattice &superlattice)"
-        << std::endl
-        << "  Bad supercell, the transformation matrix is not integer."
-        << std::endl;
-    err_log() << "superlattice: \n"
-              << superlattice.lat_column_mat() << std::endl;
-    err_log() << "prim lattice: \n"
-              << prim().lattice().lat_column_mat() << std::endl;
-    err_log() << "transformation matrix: \n" << res.second << std::endl;
-    throw std::invalid_argument(
-        "Error constructing Supercell: the transformation matrix is not "
-        "integer");
+      m_superlattice(make_checked_superlattice(prim(), superlattice)),
+      m_sym_info_ptr(nullptr),
+      m_nlist_ptr(nullptr),
+      m_nlist_size_at_construction(-1),
+      m_lru(nullptr),
+      m_last_use(0),
+      m_fingerprint_calculator_ptr(nullptr) {}
+
+Supercell::~Supercell() {
+  if (m_lru) {
+    m_lru->erase(*this);
   }
 }
 
-Supercell::~Supercell() {}
-
 const Structure &Supercell::prim() const { return *shared_prim(); }
 
 std::shared_ptr<Structure const> const &Supercell::shared_prim() const {
@@ -163,9 +206,7 @@ const PrimClex &Supercell::primclex() const {
 /// linear_index / volume();
 /// \endcode
 Index Supercell::sublat(Index linear_index) const {
-  return this->sym_info()
-      .unitcellcoord_index_converter()(linear_index)
-      .sublattice();
+  return linear_index / volume();
 }
 
 /// \brief Given a Coordinate and tolerance, return linear index into
@@ -222,37 +263,69 @@ Eigen::VectorXi Supercell::max_allowed_occupation() const {
 }
 
 /// Return number of primitive cells that fit inside of *this
-Index Supercell::volume() const {
-  return this->sym_info().unitcell_index_converter().total_sites();
-}
+Index Supercell::volume() const { return m_superlattice.size(); }
 
 Index Supercell::basis_size() const { return prim().basis().size(); }
 
 Index Supercell::num_sites() const { return volume() * basis_size(); }
 
 Eigen::Matrix3l Supercell::transf_mat() const {
-  return this->sym_info().transformation_matrix_to_super();
+  return m_superlattice.transformation_matrix_to_super();
 }
 
 const Lattice &Supercell::lattice() const {
-  return this->sym_info().supercell_lattice();
+  return m_superlattice.superlattice();
 }
 
 /// \brief Returns the SuperNeighborList
+///
+/// - Constructed on first use, and re-constructed if the PrimNeighborList has
+///   been expanded. Construction is thread-safe.
 const SuperNeighborList &Supercell::nlist() const {
-  // if any additions to the prim nlist, must update the super nlist
-  if (primclex().shared_nlist()->size() != m_nlist_size_at_construction) {
-    m_nlist.unique().reset();
+  Index prim_nlist_size = primclex().shared_nlist()->size();
+  SuperNeighborList const *ptr = m_nlist_ptr.load(std::memory_order_acquire);
+
+  // lazy construction of neighbor list, or re-construction if any additions
+  // to the prim nlist
+  if (!ptr || prim_nlist_size != m_nlist_size_at_construction) {
+    std::lock_guard<std::mutex> lock(m_lazy_mutex);
+    PrimNeighborList const &prim_nlist = *primclex().shared_nlist();
+    if (!m_nlist || Index(prim_nlist.size()) != m_nlist_size_at_construction) {
+      Eigen::Matrix3l const &T =
+          m_superlattice.transformation_matrix_to_super();
+
+      // read from the supercell symmetry cache if possible, else construct
+      // and save to the cache
+      std::shared_ptr<SuperNeighborList> nlist;
+      SupercellSymCache const *cache = primclex().supercell_sym_cache();
+      if (cache) {
+        nlist = cache->load_nlist(T, prim_nlist);
+      }
+      if (!nlist) {
+        nlist = std::make_shared<SuperNeighborList>(T, prim_nlist);
+        if (cache) {
+          cache->save_nlist(T, prim_nlist, *nlist);
+        }
+      }
+      m_nlist = nlist;
+      m_nlist_size_at_construction = prim_nlist.size();
+      m_nlist_ptr.store(m_nlist.get(), std::memory_order_release);
+      if (m_lru) {
+        m_lru->insert(*this);
+      }
+    }
+    ptr = m_nlist.get();
   }
+  _mark_used();
+  return *ptr;
+}
 
-  // lazy construction of neighbor list
-  if (!m_nlist) {
-    m_nlist_size_at_construction = primclex().shared_nlist()->size();
-    m_nlist = notstd::make_cloneable<SuperNeighborList>(
-        this->sym_info().superlattice().transformation_matrix_to_super(),
-        *primclex().shared_nlist());
-  }
-  return *m_nlist;
+/// \brief Shared ownership of the SuperNeighborList, which keeps it from
+/// being released
+std::shared_ptr<SuperNeighborList const> Supercell::shared_nlist() const {
+  nlist();
+  std::lock_guard<std::mutex> lock(m_lazy_mutex);
+  return m_nlist;
 }
 
 // Factor group of this supercell
@@ -261,7 +334,127 @@ const SymGroup &Supercell::factor_group() const {
 }
 
 // SymInfo object of this supercell
-const SupercellSymInfo &Supercell::sym_info() const { return m_sym_info; }
+//
+// - Constructed on first use, using site permutations from the PrimClex
+//   supercell symmetry cache if available. Construction is thread-safe.
+const SupercellSymInfo &Supercell::sym_info() const {
+  SupercellSymInfo const *ptr = m_sym_info_ptr.load(std::memory_order_acquire);
+  if (!ptr) {
+    std::lock_guard<std::mutex> lock(m_lazy_mutex);
+    if (!m_sym_info) {
+      m_sym_info = make_unique_supercell_sym_info(prim(), lattice());
+      if (has_primclex()) {
+        load_supercell_sym_cache(primclex(), *m_sym_info);
+      }
+      m_sym_info_ptr.store(m_sym_info.get(), std::memory_order_release);
+      if (m_lru) {
+        m_lru->insert(*this);
+      }
+    }
+    ptr = m_sym_info.get();
+  }
+  _mark_used();
+  return *ptr;
+}
+
+/// \brief Calculates symmetry fingerprints of Configuration in this
+/// Supercell, constructed on first use
+///
+/// - Construction uses `sym_info()`, so it is done without holding the lock
+///   and, if another thread constructed a calculator first, that one is kept
+/// - Released along with the SupercellSymInfo (see SupercellLRU)
+ConfigFingerprintCalculator const &Supercell::fingerprint_calculator() const {
+  ConfigFingerprintCalculator const *ptr =
+      m_fingerprint_calculator_ptr.load(std::memory_order_acquire);
+  if (!ptr) {
+    auto calculator = notstd::make_unique<ConfigFingerprintCalculator>(*this);
+    std::lock_guard<std::mutex> lock(m_lazy_mutex);
+    if (!m_fingerprint_calculator) {
+      m_fingerprint_calculator = std::move(calculator);
+      m_fingerprint_calculator_ptr.store(m_fingerprint_calculator.get(),
+                                         std::memory_order_release);
+    }
+    ptr = m_fingerprint_calculator.get();
+  }
+  return *ptr;
+}
+
+/// \brief Shared ownership of the SupercellSymInfo, which keeps it from being
+/// released
+///
+/// - SupercellPin hold shared ownership of the SupercellSymInfo
+std::shared_ptr<SupercellSymInfo const> Supercell::shared_sym_info() const {
+  sym_info();
+  std::lock_guard<std::mutex> lock(m_lazy_mutex);
+  return m_sym_info;
+}
+
+/// \brief True if the SupercellSymInfo is currently constructed
+bool Supercell::has_sym_info() const { return m_sym_info_ptr != nullptr; }
+
+/// \brief Register with a SupercellLRU, or nullptr to unregister
+///
+/// - Registered Supercell may have their SupercellSymInfo and
+///   SuperNeighborList released by `SupercellLRU::shrink` when not recently
+///   used and not pinned
+void Supercell::set_lru(SupercellLRU *lru) const {
+  std::lock_guard<std::mutex> lock(m_lazy_mutex);
+  if (m_lru == lru) {
+    return;
+  }
+  if (m_lru) {
+    m_lru->erase(*this);
+  }
+  m_lru = lru;
+  if (m_lru && (m_sym_info || m_nlist)) {
+    m_lru->insert(*this);
+    m_last_use = m_lru->tick();
+  }
+}
+
+/// Release the SupercellSymInfo and SuperNeighborList, to be re-constructed
+/// on next use
+///
+/// - Site permutations are saved to the PrimClex supercell symmetry cache
+///   first, if available, so that re-construction is inexpensive
+/// - Only called by SupercellLRU::shrink and operator=,
+///   when no other thread is using this
+void Supercell::_release() const {
+  std::lock_guard<std::mutex> lock(m_lazy_mutex);
+  if (m_sym_info && has_primclex()) {
+    SupercellSymCache const *cache = primclex().supercell_sym_cache();
+    if (cache) {
+      cache->save(*m_sym_info);
+    }
+  }
+  m_sym_info_ptr = nullptr;
+  m_sym_info.reset();
+  m_nlist_ptr = nullptr;
+  m_nlist.reset();
+  m_nlist_size_at_construction = -1;
+  m_fingerprint_calculator_ptr = nullptr;
+  m_fingerprint_calculator.reset();
+  if (m_lru) {
+    m_lru->erase(*this);
+  }
+}
+
+/// True if the SupercellSymInfo or SuperNeighborList are shared
+///
+/// - If so, the Supercell is pinned and not released by SupercellLRU::shrink
+bool Supercell::_is_pinned() const {
+  std::lock_guard<std::mutex> lock(m_lazy_mutex);
+  return m_sym_info.use_count() > 1 || m_nlist.use_count() > 1;
+}
+
+/// Notify m_lru of use
+///
+/// - Does nothing if not registered or if the capacity is unlimited
+void Supercell::_mark_used() const {
+  if (m_lru && m_lru->capacity() > 0) {
+    m_last_use.store(m_lru->tick(), std::memory_order_relaxed);
+  }
+}
 
 bool Supercell::operator<(const Supercell &B) const {
   if (shared_prim() != B.shared_prim()) {
@@ -0,0 +1,108 @@
+#include "casm/clex/SupercellLRU.hh"
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "casm/clex/NeighborList.hh"
+#include "casm/clex/Supercell.hh"
+
+namespace CASM {
+
+SupercellLRU::SupercellLRU(Index capacity)
+    : m_capacity(capacity), m_clock(0) {}
+
+/// \brief Set maximum number of resident Supercell, and `shrink()`
+///
+/// - Must not be called while other threads are using registered Supercell
+void SupercellLRU::set_capacity(Index capacity) {
+  m_capacity = capacity;
+  shrink();
+}
+
+/// \brief Number of resident Supercell
+Index SupercellLRU::size() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_resident.size();
+}
+
+/// \brief Release the least recently used, not pinned, Supercell until
+/// within capacity
+///
+/// \returns Number of Supercell released
+///
+/// - Must not be called while other threads are using registered Supercell
+/// - Pinned Supercell are skipped, so more than `capacity()` may remain
+///   resident
+Index SupercellLRU::shrink() {
+  if (m_capacity < 1) {
+    return 0;
+  }
+  std::vector<Supercell const *> by_use;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (Index(m_resident.size()) <= m_capacity) {
+      return 0;
+    }
+    by_use.assign(m_resident.begin(), m_resident.end());
+  }
+  std::sort(by_use.begin(), by_use.end(),
+            [](Supercell const *A, Supercell const *B) {
+              return A->m_last_use < B->m_last_use;
+            });
+
+  // Supercell::_release calls erase, so m_mutex is not held here
+  Index n_released = 0;
+  Index n_excess = Index(by_use.size()) - m_capacity;
+  for (Supercell const *scel : by_use) {
+    if (n_released == n_excess) {
+      break;
+    }
+    if (!scel->_is_pinned()) {
+      scel->_release();
+      ++n_released;
+    }
+  }
+  return n_released;
+}
+
+/// \brief Add a Supercell, which has just constructed its SupercellSymInfo
+/// or SuperNeighborList, to the resident Supercell
+///
+/// - Does not release any Supercell
+void SupercellLRU::insert(Supercell const &scel) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_resident.insert(&scel);
+}
+
+/// \brief Remove a Supercell, without releasing it
+///
+/// - Called by Supercell when released or destroyed
+void SupercellLRU::erase(Supercell const &scel) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_resident.erase(&scel);
+}
+
+SupercellPin::SupercellPin(Supercell const &scel, bool include_nlist)
+    : m_sym_info(scel.shared_sym_info()),
+      m_nlist(include_nlist ? scel.shared_nlist() : nullptr) {}
+
+/// \brief Default SupercellLRU capacity for the supercell database
+///
+/// Set by the environment variable "CASM_MAX_RESIDENT_SUPERCELLS". If not
+/// set, or not a positive integer, the capacity is unlimited.
+Index default_supercell_lru_capacity() {
+  char *_env = std::getenv("CASM_MAX_RESIDENT_SUPERCELLS");
+  if (_env == nullptr) {
+    return 0;
+  }
+  try {
+    long value = std::stol(std::string(_env));
+    return value > 0 ? value : 0;
+  } catch (...) {
+    return 0;
+  }
+}
+
+}  // namespace CASM
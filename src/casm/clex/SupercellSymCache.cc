@@ -0,0 +1,480 @@
+#include "casm/clex/SupercellSymCache.hh"
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#include "casm/clexulator/NeighborList.hh"
+#include "casm/crystallography/Superlattice.hh"
+#include "casm/misc/hash.hh"
+#include "casm/symmetry/SupercellPermutationTable.hh"
+#include "casm/symmetry/SupercellSymInfo.hh"
+#include "casm/symmetry/SymGroup.hh"
+
+namespace CASM {
+
+namespace {
+
+typedef SupercellPermutationTable::Layout Layout;
+typedef SupercellPermutationTable::value_type value_type;
+
+/// Increment if the file layout changes
+std::uint64_t const cache_version = 1;
+
+char const sym_magic[8] = {'C', 'A', 'S', 'M', 'S', 'Y', 'M', '1'};
+
+char const nlist_magic[8] = {'C', 'A', 'S', 'M', 'N', 'B', 'L', '1'};
+
+/// Header of ".sym" files, followed by:
+/// - the prim factor group index of each supercell factor group operation
+///   (std::uint64_t x n_factor_group), and
+/// - Layout::factored SupercellPermutationTable rows (value_type x
+///   (n_factor_group + n_translations) * n_sites)
+struct SymFileHeader {
+  char magic[8];
+  std::uint64_t version;
+  std::uint64_t prim_hash;
+  std::int64_t T[9];
+  std::uint64_t n_factor_group;
+  std::uint64_t n_translations;
+  std::uint64_t n_sites;
+};
+
+/// Header of ".nlist" files, followed by:
+/// - neighbor site indices (value_type x n_unitcells * n_site_neighbors)
+/// - neighbor unitcell indices (value_type x n_unitcells *
+///   n_unitcell_neighbors)
+/// - site index to neighbor index (std::int32_t x n_sites)
+struct NListFileHeader {
+  char magic[8];
+  std::uint64_t version;
+  std::uint64_t prim_hash;
+  std::int64_t T[9];
+  std::uint64_t nlist_hash;
+  std::uint64_t n_unitcells;
+  std::uint64_t n_sites;
+  std::uint64_t n_site_neighbors;
+  std::uint64_t n_unitcell_neighbors;
+  std::uint64_t overlaps;
+};
+
+void set_T(std::int64_t *dest, Eigen::Matrix3l const &T) {
+  for (Index i = 0; i < 3; ++i) {
+    for (Index j = 0; j < 3; ++j) {
+      dest[3 * i + j] = T(i, j);
+    }
+  }
+}
+
+SymFileHeader make_sym_header(std::uint64_t prim_hash,
+                              SupercellSymInfo const &sym_info) {
+  SymFileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, sym_magic, sizeof(header.magic));
+  header.version = cache_version;
+  header.prim_hash = prim_hash;
+  set_T(header.T, sym_info.superlattice().transformation_matrix_to_super());
+  header.n_factor_group = sym_info.factor_group().size();
+  header.n_translations = sym_info.superlattice().size();
+  header.n_sites = sym_info.unitcellcoord_index_converter().total_sites();
+  return header;
+}
+
+NListFileHeader make_nlist_header(
+    std::uint64_t prim_hash, Eigen::Matrix3l const &T,
+    clexulator::PrimNeighborList const &prim_nlist) {
+  NListFileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, nlist_magic, sizeof(header.magic));
+  header.version = cache_version;
+  header.prim_hash = prim_hash;
+  set_T(header.T, T);
+  header.nlist_hash = neighbor_list_hash(prim_nlist);
+  header.n_unitcells = std::abs(T.determinant());
+  header.n_sites = header.n_unitcells * prim_nlist.n_sublattices();
+  header.n_site_neighbors =
+      prim_nlist.size() * prim_nlist.sublat_indices().size();
+  header.n_unitcell_neighbors = prim_nlist.size();
+  header.overlaps = 0;
+  return header;
+}
+
+/// Prim factor group index of each supercell factor group operation
+std::vector<std::uint64_t> factor_group_indices(
+    SupercellSymInfo const &sym_info) {
+  std::vector<std::uint64_t> indices;
+  for (auto const &op : sym_info.factor_group()) {
+    indices.push_back(op.index());
+  }
+  return indices;
+}
+
+std::size_t sym_file_size(SymFileHeader const &header) {
+  return sizeof(SymFileHeader) +
+         header.n_factor_group * sizeof(std::uint64_t) +
+         SupercellPermutationTable::required_bytes(
+             Layout::factored, header.n_factor_group, header.n_translations,
+             header.n_sites);
+}
+
+/// Check that an existing ".sym" file has the expected header and size,
+/// without reading the permutations
+bool sym_file_matches(fs::path const &path, SymFileHeader const &expected,
+                      std::vector<std::uint64_t> const &fg_indices) {
+  boost::system::error_code ec;
+  if (fs::file_size(path, ec) != sym_file_size(expected) || ec) {
+    return false;
+  }
+  fs::ifstream in(path, std::ios::binary);
+  SymFileHeader header;
+  std::vector<std::uint64_t> file_fg_indices(fg_indices.size());
+  in.read(reinterpret_cast<char *>(&header), sizeof(header));
+  in.read(reinterpret_cast<char *>(file_fg_indices.data()),
+          file_fg_indices.size() * sizeof(std::uint64_t));
+  return in && std::memcmp(&header, &expected, sizeof(header)) == 0 &&
+         file_fg_indices == fg_indices;
+}
+
+template <typename T>
+void write_raw(std::ostream &out, T const *data, std::size_t n) {
+  out.write(reinterpret_cast<char const *>(data), n * sizeof(T));
+}
+
+template <typename T>
+bool read_raw(std::istream &in, std::vector<T> &data, std::size_t n) {
+  data.resize(n);
+  in.read(reinterpret_cast<char *>(data.data()), n * sizeof(T));
+  return static_cast<bool>(in);
+}
+
+/// Write to a temporary file in the same directory, then rename, so that
+/// readers never see a partially written file
+template <typename WriteFunction>
+bool write_atomically(fs::path const &path, WriteFunction write) {
+  boost::system::error_code ec;
+  fs::create_directories(path.parent_path(), ec);
+  if (ec) {
+    return false;
+  }
+  fs::path tmp = path.parent_path() /
+                 fs::unique_path(path.filename().string() + ".%%%%-%%%%.tmp");
+  {
+    fs::ofstream out(tmp, std::ios::binary);
+    write(out);
+    out.close();
+    if (!out) {
+      fs::remove(tmp, ec);
+      return false;
+    }
+  }
+  fs::rename(tmp, path, ec);
+  if (ec) {
+    fs::remove(tmp, ec);
+    return false;
+  }
+  return true;
+}
+
+std::string T_filename(Eigen::Matrix3l const &T, std::string extension) {
+  std::stringstream ss;
+  ss << "T";
+  for (Index i = 0; i < 3; ++i) {
+    for (Index j = 0; j < 3; ++j) {
+      ss << "_" << T(i, j);
+    }
+  }
+  ss << extension;
+  return ss.str();
+}
+
+std::string hash_string(std::uint64_t hash) {
+  std::stringstream ss;
+  ss << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return ss.str();
+}
+
+}  // namespace
+
+SupercellSymCache::SupercellSymCache(fs::path cache_dir,
+                                     std::uint64_t prim_hash)
+    : m_cache_dir(std::move(cache_dir)), m_prim_hash(prim_hash) {}
+
+/// \brief Directory containing files for this prim
+fs::path SupercellSymCache::dir() const {
+  return m_cache_dir / hash_string(m_prim_hash);
+}
+
+/// \brief Path to the site permutations file for a supercell
+fs::path SupercellSymCache::sym_path(Eigen::Matrix3l const &T) const {
+  return dir() / T_filename(T, ".sym");
+}
+
+/// \brief Path to the neighbor list file for a supercell
+fs::path SupercellSymCache::nlist_path(Eigen::Matrix3l const &T) const {
+  return dir() / T_filename(T, ".nlist");
+}
+
+/// \brief Set SupercellSymInfo permutations from the cache, if present and
+/// valid
+///
+/// On success, the file is memory-mapped and set as `sym_info`'s
+/// Layout::factored permutation table, which is then also used to construct
+/// `sym_info.site_permutation_symrep()`.
+///
+/// \returns True if permutations were read from the cache
+bool SupercellSymCache::load(SupercellSymInfo const &sym_info) const {
+  namespace bip = boost::interprocess;
+
+  fs::path path = sym_path(
+      sym_info.superlattice().transformation_matrix_to_super());
+  boost::system::error_code ec;
+  if (!fs::is_regular_file(path, ec)) {
+    return false;
+  }
+
+  SymFileHeader expected = make_sym_header(m_prim_hash, sym_info);
+  std::vector<std::uint64_t> fg_indices = factor_group_indices(sym_info);
+
+  std::shared_ptr<bip::mapped_region> region;
+  try {
+    bip::file_mapping mapping(path.string().c_str(), bip::read_only);
+    region = std::make_shared<bip::mapped_region>(mapping, bip::read_only);
+  } catch (bip::interprocess_exception const &e) {
+    return false;
+  }
+  if (region->get_size() != sym_file_size(expected)) {
+    return false;
+  }
+
+  char const *begin = static_cast<char const *>(region->get_address());
+  std::size_t fg_indices_bytes = fg_indices.size() * sizeof(std::uint64_t);
+  if (std::memcmp(begin, &expected, sizeof(expected)) != 0 ||
+      std::memcmp(begin + sizeof(expected), fg_indices.data(),
+                  fg_indices_bytes) != 0) {
+    return false;
+  }
+
+  auto data = reinterpret_cast<value_type const *>(begin + sizeof(expected) +
+                                                   fg_indices_bytes);
+  sym_info.set_permutation_table(SupercellPermutationTable(
+      Layout::factored, expected.n_factor_group, expected.n_translations,
+      expected.n_sites, region, data));
+  return true;
+}
+
+/// \brief Save SupercellSymInfo permutations to the cache, if not already
+/// present
+///
+/// Uses `sym_info.permutation_table()` if it has Layout::factored, otherwise
+/// the permutations are calculated.
+///
+/// \returns True if a valid file exists in the cache after the call
+bool SupercellSymCache::save(SupercellSymInfo const &sym_info) const {
+  fs::path path = sym_path(
+      sym_info.superlattice().transformation_matrix_to_super());
+  SymFileHeader header = make_sym_header(m_prim_hash, sym_info);
+  std::vector<std::uint64_t> fg_indices = factor_group_indices(sym_info);
+  if (sym_file_matches(path, header, fg_indices)) {
+    return true;
+  }
+
+  if (header.n_sites > std::numeric_limits<value_type>::max()) {
+    return false;
+  }
+  SupercellPermutationTable table = sym_info.permutation_table();
+  if (table.layout() != Layout::factored) {
+    table = SupercellPermutationTable(sym_info, Layout::factored);
+  }
+
+  return write_atomically(path, [&](std::ostream &out) {
+    write_raw(out, &header, 1);
+    write_raw(out, fg_indices.data(), fg_indices.size());
+    write_raw(out, table.data(), table.memory_size() / sizeof(value_type));
+  });
+}
+
+/// \brief Read a SuperNeighborList from the cache, if present and valid
+///
+/// \returns The SuperNeighborList, or nullptr if not present in the cache or
+///     if `prim_nlist` has changed since it was saved
+std::unique_ptr<clexulator::SuperNeighborList> SupercellSymCache::load_nlist(
+    Eigen::Matrix3l const &T,
+    clexulator::PrimNeighborList const &prim_nlist) const {
+  fs::ifstream in(nlist_path(T), std::ios::binary);
+  if (!in) {
+    return nullptr;
+  }
+
+  NListFileHeader expected = make_nlist_header(m_prim_hash, T, prim_nlist);
+  NListFileHeader header;
+  if (!in.read(reinterpret_cast<char *>(&header), sizeof(header))) {
+    return nullptr;
+  }
+  expected.overlaps = header.overlaps;
+  if (std::memcmp(&header, &expected, sizeof(header)) != 0) {
+    return nullptr;
+  }
+
+  Index n_unitcells = header.n_unitcells;
+  std::vector<value_type> site_data;
+  std::vector<value_type> unitcell_data;
+  std::vector<std::int32_t> neighbor_index_data;
+  if (!read_raw(in, site_data, n_unitcells * header.n_site_neighbors) ||
+      !read_raw(in, unitcell_data,
+                n_unitcells * header.n_unitcell_neighbors) ||
+      !read_raw(in, neighbor_index_data, header.n_sites) ||
+      in.peek() != std::char_traits<char>::eof()) {
+    return nullptr;
+  }
+
+  typedef clexulator::SuperNeighborList::size_type size_type;
+  std::vector<std::vector<size_type>> site(n_unitcells);
+  std::vector<std::vector<size_type>> unitcell(n_unitcells);
+  auto site_it = site_data.begin();
+  auto unitcell_it = unitcell_data.begin();
+  for (Index i = 0; i < n_unitcells; ++i) {
+    site[i].assign(site_it, site_it + header.n_site_neighbors);
+    site_it += header.n_site_neighbors;
+    unitcell[i].assign(unitcell_it, unitcell_it + header.n_unitcell_neighbors);
+    unitcell_it += header.n_unitcell_neighbors;
+  }
+  std::vector<int> site_index_to_neighbor_index(neighbor_index_data.begin(),
+                                                neighbor_index_data.end());
+
+  return std::unique_ptr<clexulator::SuperNeighborList>(
+      new clexulator::SuperNeighborList(
+          n_unitcells, std::move(site), std::move(unitcell),
+          std::move(site_index_to_neighbor_index), header.overlaps != 0));
+}
+
+/// \brief Save a SuperNeighborList to the cache
+///
+/// \param T Supercell transformation matrix
+/// \param prim_nlist The PrimNeighborList used to construct `nlist`
+/// \param nlist The SuperNeighborList
+///
+/// \returns True if successfully written
+bool SupercellSymCache::save_nlist(
+    Eigen::Matrix3l const &T, clexulator::PrimNeighborList const &prim_nlist,
+    clexulator::SuperNeighborList const &nlist) const {
+  NListFileHeader header = make_nlist_header(m_prim_hash, T, prim_nlist);
+  header.overlaps = nlist.overlaps() ? 1 : 0;
+  if (nlist.n_unitcells() != header.n_unitcells ||
+      header.n_sites > std::numeric_limits<value_type>::max()) {
+    return false;
+  }
+
+  std::vector<value_type> site_data;
+  std::vector<value_type> unitcell_data;
+  for (Index i = 0; i < nlist.n_unitcells(); ++i) {
+    if (nlist.sites(i).size() != header.n_site_neighbors ||
+        nlist.unitcells(i).size() != header.n_unitcell_neighbors) {
+      return false;
+    }
+    site_data.insert(site_data.end(), nlist.sites(i).begin(),
+                     nlist.sites(i).end());
+    unitcell_data.insert(unitcell_data.end(), nlist.unitcells(i).begin(),
+                         nlist.unitcells(i).end());
+  }
+  std::vector<std::int32_t> neighbor_index_data;
+  for (Index l = 0; l < header.n_sites; ++l) {
+    neighbor_index_data.push_back(nlist.neighbor_index(l));
+  }
+
+  return write_atomically(nlist_path(T), [&](std::ostream &out) {
+    write_raw(out, &header, 1);
+    write_raw(out, site_data.data(), site_data.size());
+    write_raw(out, unitcell_data.data(), unitcell_data.size());
+    write_raw(out, neighbor_index_data.data(), neighbor_index_data.size());
+  });
+}
+
+/// \brief Remove cache files for other prim
+///
+/// Removes all sub-directories of `cache_dir()` other than `dir()`. Files
+/// that are memory-mapped by other processes remain valid until unmapped.
+void SupercellSymCache::remove_stale() const {
+  boost::system::error_code ec;
+  if (!fs::is_directory(m_cache_dir, ec)) {
+    return;
+  }
+  std::string current = dir().filename().string();
+  std::vector<fs::path> stale;
+  for (fs::directory_iterator it(m_cache_dir, ec), end; !ec && it != end;
+       it.increment(ec)) {
+    if (fs::is_directory(it->path(), ec) &&
+        it->path().filename().string() != current) {
+      stale.push_back(it->path());
+    }
+  }
+  for (auto const &path : stale) {
+    fs::remove_all(path, ec);
+  }
+}
+
+/// \brief Hash of the contents of a prim file, for use as a SupercellSymCache
+/// key
+///
+/// Any change to the prim file, including formatting, invalidates the cache.
+std::uint64_t prim_file_hash(fs::path const &prim_path) {
+  fs::ifstream in(prim_path, std::ios::binary);
+  std::string contents((std::istreambuf_iterator<char>(in)),
+                       std::istreambuf_iterator<char>());
+  std::uint64_t hash = fnv1a_offset_basis;
+  fnv1a(hash, contents.data(), contents.size());
+  return hash;
+}
+
+/// \brief Hash of the PrimNeighborList parameters and current neighborhood
+///
+/// Includes the weight matrix, sublattice indices, and the neighboring
+/// UnitCell, in order, so the hash changes if the PrimNeighborList is
+/// expanded.
+std::uint64_t neighbor_list_hash(
+    clexulator::PrimNeighborList const &prim_nlist) {
+  std::uint64_t hash = fnv1a_offset_basis;
+  Eigen::Matrix3l W = prim_nlist.weight_matrix();
+  for (Index i = 0; i < 3; ++i) {
+    for (Index j = 0; j < 3; ++j) {
+      fnv1a(hash, W(i, j));
+    }
+  }
+  fnv1a(hash, prim_nlist.n_sublattices());
+  fnv1a(hash, prim_nlist.sublat_indices().size());
+  for (int b : prim_nlist.sublat_indices()) {
+    fnv1a(hash, b);
+  }
+  fnv1a(hash, prim_nlist.size());
+  for (auto const &unitcell : prim_nlist) {
+    for (Index i = 0; i < 3; ++i) {
+      fnv1a(hash, unitcell(i));
+    }
+  }
+  return hash;
+}
+
+/// \brief Return true if the supercell symmetry cache should be used
+///
+/// The cache is used unless the environment variable
+/// "CASM_SUPERCELL_SYM_CACHE" is set to "0", "off", or "false".
+bool supercell_sym_cache_enabled() {
+  char *_env = std::getenv("CASM_SUPERCELL_SYM_CACHE");
+  if (_env != nullptr) {
+    std::string value(_env);
+    if (value == "0" || value == "off" || value == "OFF" ||
+        value == "false" || value == "FALSE") {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace CASM
@@ -1,5 +1,7 @@
 #include "casm/clexulator/NeighborList.hh"
 
+#include <stdexcept>
+
 #include "casm/container/Counter.hh"
 #include "casm/crystallography/LinearIndexConverter.hh"
 #include "casm/misc/CASM_Eigen_math.hh"
@@ -301,6 +303,30 @@ SuperNeighborList::SuperNeighborList(
   m_overlaps = std::adjacent_find(nlist.begin(), nlist.end()) != nlist.end();
 }
 
+/// \brief Construct from previously calculated data (i.e. read from a cache)
+///
+/// \param prim_grid_size Number of unit cells in the supercell
+/// \param site Neighboring site indices, `site[unitcell_index]`
+/// \param unitcell Neighboring unit cell indices, `unitcell[unitcell_index]`
+/// \param site_index_to_neighbor_index Neighbor index of each site in the
+///     supercell, -1 for sites on sublattices not in the neighbor list
+/// \param overlaps True if periodic images of the neighbor list overlap
+SuperNeighborList::SuperNeighborList(
+    size_type prim_grid_size, std::vector<std::vector<size_type> > site,
+    std::vector<std::vector<size_type> > unitcell,
+    std::vector<int> site_index_to_neighbor_index, bool overlaps)
+    : m_prim_grid_size(prim_grid_size),
+      m_site(std::move(site)),
+      m_unitcell(std::move(unitcell)),
+      m_site_index_to_neighbor_index(std::move(site_index_to_neighbor_index)),
+      m_overlaps(overlaps) {
+  if (m_site.size() != m_prim_grid_size ||
+      m_unitcell.size() != m_prim_grid_size) {
+    throw std::runtime_error(
+        "Error constructing SuperNeighborList: size mismatch");
+  }
+}
+
 /// \brief Clone
 std::unique_ptr<SuperNeighborList> SuperNeighborList::clone() const {
   return std::unique_ptr<SuperNeighborList>(new SuperNeighborList(*this));
@@ -15,6 +15,7 @@
 #include "casm/crystallography/Niggli.hh"
 #include "casm/crystallography/OccupantDoFIsEquivalent.hh"
 #include "casm/crystallography/Site.hh"
+#include "casm/crystallography/SiteLookup.hh"
 #include "casm/crystallography/Superlattice.hh"
 #include "casm/crystallography/SuperlatticeEnumerator.hh"
 #include "casm/crystallography/SymTools.hh"
@@ -63,18 +64,18 @@ void expand_with_time_reversal(xtal::SymOpVector *growing_point_group) {
 
 /// Returns pair (success, drift). 'success' is true if translatable_basis +
 /// translation can be permuted to map onto 'basis', to within distance 'tol'
-/// (in Angstr.). 'drift' is vector from center of mass of 'translatable_basis'
-/// to center of mass of 'basis'
+/// (in Angstr.), as used to construct 'basis_lookup'. 'drift' is vector from
+/// center of mass of 'translatable_basis' to center of mass of 'basis'
 std::pair<bool, xtal::Coordinate> map_translated_basis_and_calc_drift(
-    const std::vector<xtal::Site> &basis,
+    const std::vector<xtal::Site> &basis, const xtal::SiteLookup &basis_lookup,
     const std::vector<xtal::Site> &translatable_basis,
-    const xtal::Coordinate &translation, double tol) {
+    const xtal::Coordinate &translation) {
   xtal::Coordinate drift = xtal::Coordinate::origin(translation.lattice());
 
   if (basis.size() != translatable_basis.size()) return {false, drift};
 
   for (const xtal::Site &s_tb : translatable_basis) {
-    Index ix = xtal::find_index(basis, s_tb + translation, tol);
+    Index ix = basis_lookup.find_index(s_tb + translation);
     if (ix >= basis.size())
       return {false, xtal::Coordinate::origin(translation.lattice())};
     // (basis[ix]-s_tb) is exact_translation for mapping pair, translation is
@@ -114,6 +115,10 @@ xtal::SymOpVector make_factor_group_from_point_group(
     return point_group;
   }
 
+  // grid-binned basis site lookup, so that mapping the basis is
+  // O(N_basis) rather than O(N_basis^2)
+  xtal::SiteLookup basis_lookup(struc.basis(), struc.lattice(), tol);
+
   xtal::SymOpVector factor_group;
   Index i = 0;
   for (const xtal::SymOp &point_group_operation : point_group) {
@@ -149,7 +154,7 @@ xtal::SymOpVector make_factor_group_from_point_group(
       // basis site, do the rest of them match too?
       // Determine if mapping is successful, and calculate center-of-mass drift
       std::tie(success, drift) = map_translated_basis_and_calc_drift(
-          struc.basis(), transformed_basis, translation, tol);
+          struc.basis(), basis_lookup, transformed_basis, translation);
 
       // The mapping failed, continue to the next site for a new translation
       if (!success) {
@@ -302,12 +307,15 @@ BasicStructure make_primitive(const BasicStructure &non_primitive_struc,
 
   // Fill up the basis
   BasicStructure primitive_struc(primitive_lattice);
+  SiteLookup basis_lookup(primitive_struc.basis(), primitive_struc.lattice(),
+                          tol);
   for (Site site_for_prim : non_primitive_struc.basis()) {
     site_for_prim.set_lattice(primitive_struc.lattice(), CART);
-    if (find_index(primitive_struc.basis(), site_for_prim, tol) ==
+    if (basis_lookup.find_index(site_for_prim) ==
         primitive_struc.basis().size()) {
       site_for_prim.within();
       primitive_struc.set_basis().emplace_back(std::move(site_for_prim));
+      basis_lookup.insert(primitive_struc.basis().size() - 1);
     }
   }
 
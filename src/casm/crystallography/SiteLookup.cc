@@ -0,0 +1,116 @@
+#include "casm/crystallography/SiteLookup.hh"
+
+#include <algorithm>
+#include <cmath>
+
+#include "casm/crystallography/Lattice.hh"
+#include "casm/crystallography/Site.hh"
+
+namespace CASM {
+namespace xtal {
+
+namespace {
+
+/// Limit grid size so that cell keys fit in a long
+long const max_n_cells = 1L << 20;
+
+}  // namespace
+
+/// \brief Constructor
+///
+/// \param basis Sites to look up. All must have `lattice` as their home
+///     lattice.
+/// \param lattice Lattice used for periodic distances
+/// \param tol Distance tolerance (in Angstr.), as for `find_index`
+SiteLookup::SiteLookup(std::vector<Site> const &basis, Lattice const &lattice,
+                       double tol)
+    : m_basis(&basis), m_lattice(&lattice), m_tol(tol) {
+  // If `site.min_dist(test_site) < tol`, then the periodically wrapped
+  // difference in fractional coordinate i is at most
+  // `tol * inv_lat_column_mat().row(i).norm()`, so use cells at least that
+  // wide (with a margin for round-off). Then candidates are always in
+  // neighboring cells.
+  Eigen::Matrix3d const &inv_lat = m_lattice->inv_lat_column_mat();
+  for (Index i = 0; i < 3; ++i) {
+    double width = 1.001 * m_tol * inv_lat.row(i).norm();
+    double n = (width > 0.) ? std::floor(1. / width) : double(max_n_cells);
+    m_n_cells(i) = std::max(1L, std::min(max_n_cells, long(n)));
+  }
+
+  for (Index i = 0; i < m_basis->size(); ++i) {
+    insert(i);
+  }
+}
+
+/// \brief Add `basis[basis_index]` to the lookup
+void SiteLookup::insert(Index basis_index) {
+  std::vector<Index> &bin =
+      m_bins[_key(_cell((*m_basis)[basis_index].const_cart()))];
+  bin.insert(std::lower_bound(bin.begin(), bin.end(), basis_index),
+             basis_index);
+}
+
+/// \brief Equivalent to `find_index(basis, test_site, tol)`
+///
+/// \returns The lowest index, i, such that `basis[i].compare_type(test_site)`
+///     and `basis[i].min_dist(test_site) < tol`, or `basis.size()` if none
+Index SiteLookup::find_index(Site const &test_site) const {
+  Eigen::Vector3l cell = _cell(test_site.const_cart());
+
+  // keys of the (up to) 27 neighboring cells; fewer if a grid dimension has
+  // fewer than three cells
+  std::vector<key_type> keys;
+  Eigen::Vector3l neighbor;
+  for (long i = -1; i <= 1; ++i) {
+    for (long j = -1; j <= 1; ++j) {
+      for (long k = -1; k <= 1; ++k) {
+        neighbor << i, j, k;
+        neighbor += cell;
+        for (Index d = 0; d < 3; ++d) {
+          neighbor(d) = (neighbor(d) + m_n_cells(d)) % m_n_cells(d);
+        }
+        keys.push_back(_key(neighbor));
+      }
+    }
+  }
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+  Index result = m_basis->size();
+  for (key_type key : keys) {
+    auto it = m_bins.find(key);
+    if (it == m_bins.end()) {
+      continue;
+    }
+    for (Index i : it->second) {
+      if (i >= result) {
+        break;
+      }
+      Site const &site = (*m_basis)[i];
+      if (site.compare_type(test_site) && site.min_dist(test_site) < m_tol) {
+        result = i;
+        break;
+      }
+    }
+  }
+  return result;
+}
+
+/// Grid cell of a Cartesian position
+Eigen::Vector3l SiteLookup::_cell(Eigen::Vector3d const &cart) const {
+  Eigen::Vector3d frac = m_lattice->inv_lat_column_mat() * cart;
+  Eigen::Vector3l cell;
+  for (Index i = 0; i < 3; ++i) {
+    double f = frac(i) - std::floor(frac(i));
+    cell(i) = std::max(
+        0L, std::min(m_n_cells(i) - 1, long(std::floor(f * m_n_cells(i)))));
+  }
+  return cell;
+}
+
+SiteLookup::key_type SiteLookup::_key(Eigen::Vector3l const &cell) const {
+  return cell(0) + m_n_cells(0) * (cell(1) + m_n_cells(1) * cell(2));
+}
+
+}  // namespace xtal
+}  // namespace CASM
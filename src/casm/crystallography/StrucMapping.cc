@@ -339,12 +339,16 @@ bool identical(AssignmentNode const &A, AssignmentNode const &B) {
 //*******************************************************************************************
 
 MappingNode MappingNode::invalid() {
-  static MappingNode result(LatticeNode(Lattice::cubic(), Lattice::cubic(),
-                                        Lattice::cubic(), Lattice::cubic(), 1),
-                            0.5);
-  result.is_viable = false;
-  result.is_valid = false;
-  result.is_partitioned = false;
+  // initialized once, so that structures may be mapped in parallel
+  static MappingNode const result = []() {
+    MappingNode node(LatticeNode(Lattice::cubic(), Lattice::cubic(),
+                                 Lattice::cubic(), Lattice::cubic(), 1),
+                     0.5);
+    node.is_viable = false;
+    node.is_valid = false;
+    node.is_partitioned = false;
+    return node;
+  }();
   return result;
 }
 
@@ -367,31 +367,52 @@ std::map<DoFKey, std::vector<DoFSetInfo>> local_dof_info(
   return result;
 }
 
-SupercellSymInfo make_supercell_sym_info(Structure const &prim,
-                                         Lattice const &super_lattice) {
-  // Structure data needs to be reorganized for SupercellSymInfo construction
+namespace {
+
+/// Structure data needs to be reorganized for SupercellSymInfo construction
+struct SupercellSymInfoArgs {
+  SupercellSymInfoArgs(Structure const &prim) {
+    for (auto const &key : xtal::global_dof_types(prim)) {
+      global_dof_symrep_IDs.emplace(
+          std::make_pair(key, prim.global_dof_symrep_ID(key)));
+    }
+
+    for (auto const &key : xtal::continuous_local_dof_types(prim)) {
+      std::vector<SymGroupRepID> treps(prim.basis().size());
+      for (Index b = 0; b < prim.basis().size(); ++b) {
+        if (prim.basis()[b].has_dof(key))
+          treps[b] = prim.site_dof_symrep_IDs()[b][key];
+      }
+      local_dof_symrep_IDs.emplace(std::make_pair(key, std::move(treps)));
+    }
+  }
 
   // map of global DoFKey -> SymGroupRepID
   std::map<DoFKey, SymGroupRepID> global_dof_symrep_IDs;
-  for (auto const &key : xtal::global_dof_types(prim)) {
-    global_dof_symrep_IDs.emplace(
-        std::make_pair(key, prim.global_dof_symrep_ID(key)));
-  }
 
   // map of site DoFKey -> std::vector<SymGroupRepID>
   std::map<DoFKey, std::vector<SymGroupRepID>> local_dof_symrep_IDs;
-  for (auto const &key : xtal::continuous_local_dof_types(prim)) {
-    std::vector<SymGroupRepID> treps(prim.basis().size());
-    for (Index b = 0; b < prim.basis().size(); ++b) {
-      if (prim.basis()[b].has_dof(key))
-        treps[b] = prim.site_dof_symrep_IDs()[b][key];
-    }
-    local_dof_symrep_IDs.emplace(std::make_pair(key, std::move(treps)));
-  }
+};
 
+}  // namespace
+
+SupercellSymInfo make_supercell_sym_info(Structure const &prim,
+                                         Lattice const &super_lattice) {
+  SupercellSymInfoArgs args(prim);
   return SupercellSymInfo(
       prim.lattice(), super_lattice, prim.basis().size(), prim.factor_group(),
-      prim.basis_permutation_symrep_ID(), global_dof_symrep_IDs,
-      prim.occupant_symrep_IDs(), local_dof_symrep_IDs);
+      prim.basis_permutation_symrep_ID(), args.global_dof_symrep_IDs,
+      prim.occupant_symrep_IDs(), args.local_dof_symrep_IDs);
+}
+
+/// Construct SupercellSymInfo on the heap (SupercellSymInfo holds handles to
+/// its own members, so it should not be copied or moved after construction)
+std::unique_ptr<SupercellSymInfo> make_unique_supercell_sym_info(
+    Structure const &prim, Lattice const &super_lattice) {
+  SupercellSymInfoArgs args(prim);
+  return std::unique_ptr<SupercellSymInfo>(new SupercellSymInfo(
+      prim.lattice(), super_lattice, prim.basis().size(), prim.factor_group(),
+      prim.basis_permutation_symrep_ID(), args.global_dof_symrep_IDs,
+      prim.occupant_symrep_IDs(), args.local_dof_symrep_IDs));
 }
 }  // namespace CASM
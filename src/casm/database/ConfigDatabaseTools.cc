@@ -1,12 +1,57 @@
 #include "casm/database/ConfigDatabaseTools.hh"
 
+#include <cstdint>
+#include <set>
+#include <unordered_map>
+
+#include "casm/clex/ConfigIsEquivalent.hh"
 #include "casm/clex/Configuration.hh"
 #include "casm/clex/FillSupercell.hh"
+#include "casm/clex/PrimClex.hh"
+#include "casm/clex/SupercellLRU.hh"
+#include "casm/crystallography/CanonicalForm.hh"
+#include "casm/crystallography/Structure.hh"
 #include "casm/database/ScelDatabaseTools.hh"
+#include "casm/misc/hash.hh"
+#include "casm/misc/parallel.hh"
 
 namespace CASM {
 namespace DB {
 
+namespace {
+
+/// Construct lazily constructed Supercell data, so that the Supercell may be
+/// used by more than one thread
+void prepare_for_threads(Supercell const &supercell) {
+  auto const &sym_info = supercell.sym_info();
+  sym_info.site_permutation_symrep();
+  sym_info.factor_group().get_multi_table();
+  sym_info.factor_group().get_alt_multi_table();
+  supercell.name();
+  if (supercell.has_primclex()) {
+    supercell.primclex().supercell_sym_cache();
+  }
+}
+
+/// Data for one configuration of a batch inserted by
+/// `make_canonical_and_insert`
+struct BatchItem {
+  std::unique_ptr<Configuration> primitive;
+  std::unique_ptr<Lattice> canonical_lattice;
+  std::unique_ptr<Lattice> primitive_canonical_lattice;
+  Supercell const *canonical_supercell = nullptr;
+  Supercell const *primitive_canonical_supercell = nullptr;
+
+  // canonical form of primitive, in canonical supercell
+  std::unique_ptr<Configuration> canonical_primitive;
+
+  // canonical form, in canonical supercell, if different from
+  // canonical_primitive and not primitive_only
+  std::unique_ptr<Configuration> canonical;
+};
+
+}  // namespace
+
 // /// Returns the canonical form Configuration in the canonical Supercell
 // ///
 // /// Note:
@@ -97,7 +142,7 @@ Configuration in_canonical_supercell(Configuration const &configuration,
   Supercell const &canon_supercell_of_configuration =
       *(make_canonical_and_insert(
             configuration.supercell().shared_prim(),
-            configuration.supercell().sym_info().supercell_lattice(),
+            configuration.supercell().lattice(),
             supercell_db)
             .first);
 
@@ -152,5 +197,161 @@ ConfigInsertResult make_canonical_and_insert(
   }
   return res;
 }
+
+/// Insert a batch of configurations (in primitive & canonical form) in the
+/// database
+///
+/// \param configurations Configurations to insert
+/// \param primitive_only If true, only the primitive Configuration are
+///     inserted.
+/// \param n_threads Maximum number of threads used to make configurations
+///     primitive and canonical. Values < 1 use `default_n_threads()`.
+///
+/// \returns One result per configuration, as by `make_canonical_and_insert`
+///
+/// Equivalent to calling `make_canonical_and_insert` for each configuration,
+/// in order, except:
+/// - Primitive and canonical forms are found by multiple threads. Canonical
+///   Supercell are inserted in "supercell_db" by the calling thread before
+///   configurations are made canonical.
+/// - Configurations equivalent to an earlier configuration in the batch are
+///   found using a hash, and are not inserted again.
+/// - Configurations are inserted by the calling thread in order, so
+///   configuration names do not depend on the number of threads.
+/// - Supercell used by the batch are pinned (see SupercellPin) before they
+///   are used by multiple threads, so they are not released by
+///   `supercell_db.shrink_resident()` while the batch is in progress,
+///   whatever `supercell_db.max_resident()` is.
+/// - Making non-primitive configurations primitive constructs new Supercell
+///   in the worker threads; the representations this adds to the prim
+///   factor group are allocated under a lock (see MasterSymGroup).
+/// - If an exception is thrown making configurations canonical, no
+///   configurations in the batch are inserted.
+std::vector<ConfigInsertResult> make_canonical_and_insert(
+    std::vector<Configuration> const &configurations,
+    Database<Supercell> &supercell_db,
+    Database<Configuration> &configuration_db, bool primitive_only,
+    Index n_threads) {
+  Index size = configurations.size();
+  if (!size) {
+    return std::vector<ConfigInsertResult>();
+  }
+  std::vector<BatchItem> items(size);
+
+  // make primitive and find canonical supercell lattices
+  std::set<Supercell const *> supercells;
+  std::vector<SupercellPin> pins;
+  for (Configuration const &configuration : configurations) {
+    if (supercells.insert(&configuration.supercell()).second) {
+      pins.emplace_back(configuration.supercell());
+      prepare_for_threads(configuration.supercell());
+    }
+  }
+  auto const &shared_prim = configurations[0].supercell().shared_prim();
+  auto const &pg = shared_prim->point_group();
+  double xtal_tol = shared_prim->lattice().tol();
+  parallel_for(0, size, n_threads, [&](Index thread_index, Index i) {
+    BatchItem &item = items[i];
+    Configuration const &configuration = configurations[i];
+    item.primitive = notstd::make_unique<Configuration>(
+        configuration.primitive());
+    item.canonical_lattice = notstd::make_unique<Lattice>(
+        xtal::canonical::equivalent(configuration.supercell().lattice(), pg,
+                                    xtal_tol));
+    item.primitive_canonical_lattice =
+        notstd::make_unique<Lattice>(xtal::canonical::equivalent(
+            item.primitive->supercell().lattice(), pg, xtal_tol));
+  });
+
+  // insert canonical supercells
+  std::set<Supercell const *> canonical_supercells;
+  for (BatchItem &item : items) {
+    item.canonical_supercell =
+        &*supercell_db.emplace(shared_prim, *item.canonical_lattice).first;
+    item.primitive_canonical_supercell =
+        &*supercell_db.emplace(shared_prim, *item.primitive_canonical_lattice)
+              .first;
+    canonical_supercells.insert(item.canonical_supercell);
+    canonical_supercells.insert(item.primitive_canonical_supercell);
+  }
+  for (Supercell const *supercell : canonical_supercells) {
+    pins.emplace_back(*supercell);
+    prepare_for_threads(*supercell);
+  }
+
+  // make canonical
+  parallel_for(0, size, n_threads, [&](Index thread_index, Index i) {
+    BatchItem &item = items[i];
+    item.canonical_primitive = notstd::make_unique<Configuration>(
+        fill_supercell(*item.primitive, *item.primitive_canonical_supercell)
+            .canonical_form());
+    if (!primitive_only &&
+        !(*item.canonical_supercell == *item.primitive_canonical_supercell)) {
+      item.canonical = notstd::make_unique<Configuration>(
+          fill_supercell(configurations[i], *item.canonical_supercell)
+              .canonical_form());
+    }
+  });
+
+  // insert, in order, skipping configurations equivalent to earlier
+  // configurations in the batch
+  typedef Database<Configuration>::iterator iterator;
+  std::unordered_multimap<std::size_t,
+                          std::pair<Configuration const *, iterator>>
+      inserted;
+  auto insert = [&](Configuration const &config) {
+    std::size_t hash = config_hash(config);
+    if (inserted.count(hash) >= config_hash_max_compare) {
+      // the database finds duplicates by ordered comparison
+      return configuration_db.insert(config);
+    }
+    auto range = inserted.equal_range(hash);
+    if (range.first != range.second) {
+      ConfigIsEquivalent is_equivalent = config.equal_to();
+      for (auto it = range.first; it != range.second; ++it) {
+        if (is_equivalent(*it->second.first)) {
+          return std::make_pair(it->second.second, false);
+        }
+      }
+    }
+    auto result = configuration_db.insert(config);
+    inserted.emplace(hash, std::make_pair(&config, result.first));
+    return result;
+  };
+
+  std::vector<ConfigInsertResult> results(size);
+  for (Index i = 0; i < size; ++i) {
+    BatchItem const &item = items[i];
+    ConfigInsertResult &res = results[i];
+    std::tie(res.primitive_it, res.insert_primitive) =
+        insert(*item.canonical_primitive);
+
+    if (*item.canonical_supercell == *item.primitive_canonical_supercell) {
+      res.insert_canonical = res.insert_primitive;
+      res.canonical_it = res.primitive_it;
+    } else if (primitive_only) {
+      res.insert_canonical = false;
+      res.canonical_it = configuration_db.end();
+    } else {
+      std::tie(res.canonical_it, res.insert_canonical) =
+          insert(*item.canonical);
+    }
+  }
+  return results;
+}
+
+/// Hash of supercell name and occupation
+///
+/// Equivalent Configuration have the same hash. Continuous DoF values are
+/// compared with a tolerance, so they are not included.
+std::size_t config_hash(Configuration const &config) {
+  std::uint64_t seed = std::hash<std::string>()(config.supercell().name());
+  Eigen::VectorXi const &occupation = config.occupation();
+  for (Index i = 0; i < occupation.size(); ++i) {
+    hash_combine(seed, occupation(i));
+  }
+  return seed;
+}
+
 }  // namespace DB
 }  // namespace CASM
@@ -0,0 +1,105 @@
+#include "casm/database/ConfigIdReservation.hh"
+
+#include <boost/filesystem.hpp>
+
+#include "casm/app/DirectoryStructure.hh"
+#include "casm/casm_io/SafeOfstream.hh"
+#include "casm/casm_io/container/json_io.hh"
+#include "casm/casm_io/json/jsonParser.hh"
+#include "casm/clex/PrimClex.hh"
+#include "casm/database/DatabaseHandler.hh"
+
+namespace CASM {
+namespace DB {
+
+const Index ConfigIdReservation::block_size = 1024;
+
+ConfigIdReservation::ConfigIdReservation(PrimClex const &_primclex)
+    : m_primclex(&_primclex) {}
+
+ConfigIdReservation::~ConfigIdReservation() {
+  try {
+    release();
+  } catch (...) {
+    // the ids remain reserved, which only leaves a gap in ids
+  }
+}
+
+/// \brief Return an id for a new Configuration in a supercell
+///
+/// \param scelname Supercell name
+/// \param next_id The next id the database would assign in the supercell,
+///     which is the minimum id that may be reserved
+///
+/// - Ids are taken from the block reserved by this process for the
+///   supercell. If there is none, or it is used up, a new block beginning at
+///   the greater of `next_id` and the first id not reserved by any process is
+///   reserved.
+Index ConfigIdReservation::next(std::string const &scelname, Index next_id) {
+  if (!m_primclex->has_dir()) {
+    return next_id;
+  }
+  auto it = m_blocks.find(scelname);
+  if (it != m_blocks.end() && it->second.first < it->second.second) {
+    return it->second.first++;
+  }
+
+  auto lock = m_primclex->db_handler().lock(DatabaseLock::Mode::exclusive);
+  std::map<std::string, Index> reserved = _read();
+  Index &end = reserved[scelname];
+  Index begin = std::max(end, next_id);
+  end = begin + block_size;
+  _write(reserved);
+
+  m_blocks[scelname] = std::make_pair(begin + 1, end);
+  return begin;
+}
+
+/// \brief Release reserved ids that were not used
+///
+/// - For each supercell, the unused ids of the block reserved by this process
+///   are released if no other process has reserved ids since
+void ConfigIdReservation::release() {
+  if (m_blocks.empty() || !m_primclex->has_dir()) {
+    m_blocks.clear();
+    return;
+  }
+  auto lock = m_primclex->db_handler().lock(DatabaseLock::Mode::exclusive);
+  std::map<std::string, Index> reserved = _read();
+  bool changed = false;
+  for (auto const &block : m_blocks) {
+    auto it = reserved.find(block.first);
+    if (it != reserved.end() && it->second == block.second.second) {
+      it->second = block.second.first;
+      changed = true;
+    }
+  }
+  if (changed) {
+    _write(reserved);
+  }
+  m_blocks.clear();
+}
+
+std::map<std::string, Index> ConfigIdReservation::_read() const {
+  std::map<std::string, Index> reserved;
+  fs::path path = m_primclex->dir().casm_dir() / "config_id_reserved.json";
+  if (fs::exists(path)) {
+    jsonParser json(path);
+    from_json(reserved, json);
+  }
+  return reserved;
+}
+
+void ConfigIdReservation::_write(
+    std::map<std::string, Index> const &reserved) const {
+  fs::path path = m_primclex->dir().casm_dir() / "config_id_reserved.json";
+  jsonParser json;
+  to_json(reserved, json);
+  SafeOfstream file;
+  file.open(path);
+  json.print(file.ofstream());
+  file.close();
+}
+
+}  // namespace DB
+}  // namespace CASM
@@ -15,6 +15,7 @@
 #include "casm/database/ScelDatabase.hh"
 #include "casm/database/Selection_impl.hh"
 #include "casm/database/Update_impl.hh"
+#include "casm/misc/parallel.hh"
 
 namespace CASM {
 
@@ -108,6 +109,27 @@ StructureMap<Configuration>::StructureMap(ConfigMapping::Settings const &_set,
       new ConfigMapper(primclex, _set, primclex.crystallography_tol()));
 }
 
+/// Construct with the same settings, but a separate ConfigMapper, so that the
+/// copy may map structures in another thread
+///
+/// Note:
+/// - ConfigMapper caches lattices as it maps structures and is not safe to
+///   share between threads
+StructureMap<Configuration>::StructureMap(
+    StructureMap<Configuration> const &other)
+    : StructureMap(other.settings(), *other.m_primclex_ptr) {}
+
+StructureMap<Configuration>::~StructureMap() {}
+
+/// Result of mapping one structure, before database insertion
+struct StructureMap<Configuration>::Mapped {
+  // pos_path, has_files, and fail_msg if the file does not exist
+  ConfigIO::Result res;
+
+  // mapping results
+  std::unique_ptr<ConfigMapperResult> map_result;
+};
+
 /// \brief Specialized import method for ConfigType
 ///
 /// \param p Path to structure or properties.calc.json file. Not guaranteed to
@@ -124,6 +146,73 @@ StructureMap<Configuration>::map(
     fs::path p, std::vector<std::string> const &req_properties,
     std::unique_ptr<Configuration> const &hint_config,
     map_result_inserter result) const {
+  Mapped mapped;
+  _map_structure(p, hint_config.get(), mapped);
+  return _insert(mapped, req_properties, hint_config.get(), result);
+}
+
+/// \brief Map many structures, using multiple threads
+///
+/// - Structures are read and mapped by a pool of threads, each with its own
+///   ConfigMapper, and at most a few structures per thread are mapped ahead
+///   of database insertion
+/// - Mapped configurations are inserted in the database by the calling thread
+///   in order of i, as by calling `map` for each path, so the database and
+///   results do not depend on the number of threads
+/// - An exception reading or mapping a structure is rethrown after the
+///   results for all preceding paths are inserted, as by calling `map`
+/// - Mapping with a hint uses a copy of the hint in its own Supercell, so
+///   that Supercell in the database are not modified by other threads
+/// - Mapping constructs new Supercell and makes configurations canonical in
+///   the mapping threads; the representations this adds to the prim factor
+///   group are allocated under a lock (see MasterSymGroup)
+void StructureMap<Configuration>::map_all(
+    std::vector<fs::path> const &paths,
+    std::vector<std::unique_ptr<Configuration> > const &hints,
+    std::vector<std::string> const &req_properties, Index n_threads,
+    std::function<void(Index, std::vector<ConfigIO::Result> &)> f) const {
+  Index size = paths.size();
+  if (n_threads < 1) {
+    n_threads = default_n_threads();
+  }
+  n_threads = std::max(Index(1), std::min(n_threads, size));
+
+  // lazily constructed PrimClex data used by mapping
+  m_primclex_ptr->supercell_sym_cache();
+
+  std::vector<std::unique_ptr<StructureMap<Configuration> > > mappers;
+  for (Index t = 1; t < n_threads; ++t) {
+    mappers.emplace_back(new StructureMap<Configuration>(*this));
+  }
+
+  auto map_f = [&](Index t, Index i) {
+    StructureMap<Configuration> const &mapper = t ? *mappers[t - 1] : *this;
+    std::unique_ptr<Configuration> hint_copy;
+    if (hints.size() && hints[i]) {
+      hint_copy = notstd::make_unique<Configuration>(
+          std::make_shared<Supercell>(hints[i]->supercell()),
+          hints[i]->configdof());
+    }
+    Mapped mapped;
+    mapper._map_structure(paths[i], hint_copy.get(), mapped);
+    return mapped;
+  };
+
+  std::vector<ConfigIO::Result> tvec;
+  auto consume_f = [&](Index i, Mapped &&mapped) {
+    tvec.clear();
+    Configuration const *hint = hints.size() ? hints[i].get() : nullptr;
+    _insert(mapped, req_properties, hint, std::back_inserter(tvec));
+    f(i, tvec);
+  };
+
+  parallel_pipeline(size, n_threads, -1, map_f, consume_f);
+}
+
+/// \brief Read and map a structure, without modifying the database
+void StructureMap<Configuration>::_map_structure(
+    fs::path const &p, Configuration const *hint_config,
+    Mapped &mapped) const {
   // need to set Result data (w/ defaults):
   // - std::string pos = "";
   // - MappedProperties mapped_props {origin:"", to:"", unmapped:{}, mapped:{}};
@@ -131,7 +220,7 @@ StructureMap<Configuration>::map(
   // - bool has_complete_data = false;
   // - bool is_new_config = false;
   // - std::string fail_msg = "";
-  ConfigIO::Result res;
+  ConfigIO::Result &res = mapped.res;
   res.pos_path = p.string();
 
   if (!fs::exists(res.pos_path)) {
@@ -144,8 +233,18 @@ StructureMap<Configuration>::map(
   SimpleStructure sstruc = this->_make_structure(res.pos_path);
 
   // do mapping
-  ConfigMapperResult map_result =
-      m_configmapper->import_structure(sstruc, hint_config.get());
+  mapped.map_result = notstd::make_unique<ConfigMapperResult>(
+      m_configmapper->import_structure(sstruc, hint_config));
+}
+
+/// \brief Insert mapped configurations in the database and output results
+StructureMap<Configuration>::map_result_inserter
+StructureMap<Configuration>::_insert(
+    Mapped const &mapped, std::vector<std::string> const &req_properties,
+    Configuration const *hint_config, map_result_inserter result) const {
+  ConfigIO::Result res = mapped.res;
+  ConfigMapperResult const &map_result = *mapped.map_result;
+  fs::path p = res.pos_path;
 
   if (!map_result.success()) {
     res.fail_msg = map_result.fail_msg;
@@ -418,7 +517,14 @@ const std::string Import<Configuration>::desc =
     "        If true, data and files will be imported that overwrite existing\n"
     "        data and files, if the score calculated by the \n"
     "        \"conflict_score\" for the configuration being mapped to will be\n"
-    "        improved.\n\n";
+    "        improved.\n\n"
+
+    "  n_threads: integer (optional)\n"
+    "      Number of threads used to map structures. By default, the value \n"
+    "      of the environment variable CASM_NUM_THREADS, if set, else the \n"
+    "      number of cores. Configurations are always inserted in the order \n"
+    "      of the structure files, so results do not depend on the number \n"
+    "      of threads.\n\n";
 
 int Import<Configuration>::run(const PrimClex &primclex,
                                const jsonParser &kwargs,
@@ -430,6 +536,7 @@ int Import<Configuration>::run(const PrimClex &primclex,
 
   ImportSettings import_settings;
   if (kwargs.contains("data")) from_json(import_settings, kwargs["data"]);
+  kwargs.get_if(import_settings.n_threads, "n_threads");
 
   // get input report_dir, check if exists, and create new report_dir.i if
   // necessary
@@ -444,6 +551,7 @@ int Import<Configuration>::run(const PrimClex &primclex,
   jsonParser used_settings;
   used_settings["mapping"] = mapper.settings();
   used_settings["data"] = import_settings;
+  used_settings["n_threads"] = import_settings.n_threads;
 
   // -- print used settings --
   Log &log = CASM::log();
@@ -496,6 +604,11 @@ const std::string Update<Configuration>::desc =
     " \n"
     "    determine which to update. \n"
 
+    "  n_threads: integer (optional)\n"
+    "    Number of threads used to map structures. By default, the value of \n"
+    "    the environment variable CASM_NUM_THREADS, if set, else the number \n"
+    "    of cores. Results do not depend on the number of threads.\n"
+
     "Settings: \n\n"
 
     "  mapping: JSON object (optional)\n"
@@ -736,6 +849,8 @@ int Update<Configuration>::run(const PrimClex &primclex,
 
   // TODO: this could take more settings, for now output_as_json fixed true
   UpdateSettings update_settings;
+  kwargs.get_if(update_settings.n_threads, "n_threads");
+  used["n_threads"] = update_settings.n_threads;
 
   // 'mapping' subsettings are used to construct ConfigMapper and return 'used'
   // settings values still need to figure out how to specify this in general
@@ -2,6 +2,7 @@
 #include "casm/clex/PrimClex.hh"
 #include "casm/database/DatabaseHandler_impl.hh"
 #include "casm/database/json/jsonDatabase.hh"
+#include "casm/database/journal/journalDatabase.hh"
 
 namespace CASM {
 
@@ -15,6 +16,7 @@ DatabaseHandler::DatabaseHandler(const PrimClex &_primclex)
     : m_primclex(&_primclex),
       m_default_db_name(m_primclex->settings().default_database_name()) {
   jsonDB::insert(*this);
+  journalDB::insert(*this);
 }
 
 DatabaseHandler::~DatabaseHandler() { close(); }
@@ -28,6 +30,22 @@ void DatabaseHandler::close() {
   }
 }
 
+/// Lock the project databases, shared for reading or exclusive for writing
+///
+/// - The lock file is ".casm/database.lock"
+/// - Locks may be nested, see DatabaseLockFile
+/// - Does nothing if the project has no root directory
+DatabaseLock DatabaseHandler::lock(DatabaseLock::Mode mode) const {
+  if (!m_primclex->has_dir()) {
+    return DatabaseLock(nullptr, mode);
+  }
+  if (!m_lock_file) {
+    m_lock_file.reset(new DatabaseLockFile(m_primclex->dir().casm_dir() /
+                                           "database.lock"));
+  }
+  return DatabaseLock(m_lock_file.get(), mode);
+}
+
 }  // namespace DB
 
 }  // namespace CASM
@@ -0,0 +1,94 @@
+#include "casm/database/DatabaseLock.hh"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace CASM {
+namespace DB {
+
+DatabaseLockFile::DatabaseLockFile(fs::path const &_path)
+    : m_path(_path), m_fd(-1), m_n_exclusive(0) {}
+
+DatabaseLockFile::~DatabaseLockFile() {
+  if (m_fd >= 0) {
+    ::close(m_fd);
+  }
+}
+
+/// \brief Acquire a lock, blocking until it is available
+///
+/// - The lock file is created if it does not exist
+///
+/// \throws std::runtime_error if the lock file can not be opened or locked
+void DatabaseLockFile::lock(bool exclusive) {
+  if (m_fd < 0) {
+    m_fd = ::open(m_path.string().c_str(), O_RDWR | O_CREAT, 0666);
+    if (m_fd < 0) {
+      throw std::runtime_error(std::string("Error opening lock file: ") +
+                               m_path.string());
+    }
+  }
+  if (exclusive) {
+    if (m_n_exclusive == 0) {
+      _flock(LOCK_EX);
+    }
+    ++m_n_exclusive;
+  } else if (m_held.empty()) {
+    _flock(LOCK_SH);
+  }
+  m_held.push_back(exclusive);
+}
+
+/// \brief Release the most recently acquired lock
+///
+/// - An upgraded lock is downgraded to a shared lock when the last exclusive
+///   lock is released
+void DatabaseLockFile::unlock() {
+  if (m_held.empty()) {
+    throw std::runtime_error(std::string("Error unlocking lock file: ") +
+                             m_path.string() + ": not locked");
+  }
+  bool exclusive = m_held.back();
+  m_held.pop_back();
+  if (exclusive) {
+    --m_n_exclusive;
+  }
+  if (m_held.empty()) {
+    _flock(LOCK_UN);
+  } else if (exclusive && m_n_exclusive == 0) {
+    _flock(LOCK_SH);
+  }
+}
+
+void DatabaseLockFile::_flock(int operation) {
+  int result;
+  do {
+    result = ::flock(m_fd, operation);
+  } while (result != 0 && errno == EINTR);
+  if (result != 0) {
+    throw std::runtime_error(std::string("Error locking lock file: ") +
+                             m_path.string());
+  }
+}
+
+std::string file_version(fs::path const &path) {
+  struct stat file_stat;
+  if (::stat(path.string().c_str(), &file_stat) != 0) {
+    return std::string();
+  }
+  std::stringstream ss;
+  ss << file_stat.st_dev << ":" << file_stat.st_ino << ":"
+     << file_stat.st_size << ":" << file_stat.st_mtim.tv_sec << "."
+     << file_stat.st_mtim.tv_nsec;
+  return ss.str();
+}
+
+}  // namespace DB
+}  // namespace CASM
@@ -35,6 +35,36 @@ std::pair<PropertiesDatabase::iterator, bool> PropertiesDatabase::insert(
   return res;
 }
 
+/// \brief Insert data in bulk
+///
+/// - Equivalent to inserting each value, except that the 'to' -> 'origin'
+///   links of each 'to' configuration are updated once
+/// - Values with an 'origin' already in the database are not inserted
+///
+/// \returns Number of values inserted
+PropertiesDatabase::size_type PropertiesDatabase::insert(
+    const std::vector<MappedProperties> &values) {
+  _reserve(size() + values.size());
+
+  // insert data
+  std::map<std::string, std::vector<std::string> > origins;
+  size_type n_inserted = 0;
+  for (const auto &value : values) {
+    if (_insert(value).second) {
+      origins[value.to].push_back(value.origin);
+      ++n_inserted;
+    }
+  }
+
+  // insert 'to' -> 'origin' links
+  for (const auto &value : origins) {
+    auto tset = all_origins(value.first);
+    tset.insert(value.second.begin(), value.second.end());
+    _set_all_origins(value.first, tset);
+  }
+  return n_inserted;
+}
+
 /// \brief Erase the 'origin' data element at provided iterator
 PropertiesDatabase::iterator PropertiesDatabase::erase(iterator pos) {
   auto tset = all_origins(pos->to);
@@ -44,5 +74,30 @@ PropertiesDatabase::iterator PropertiesDatabase::erase(iterator pos) {
   return _erase(pos);
 }
 
+/// \brief Change the 'to' Configuration of all data mapped to renamed
+/// Configuration
+PropertiesDatabase::size_type PropertiesDatabase::rename_to(
+    std::map<std::string, std::string> const &renamed) {
+  std::vector<MappedProperties> values;
+  for (auto const &name : renamed) {
+    if (name.first == name.second) {
+      continue;
+    }
+    auto tset = all_origins(name.first);
+    std::vector<std::string> origins(tset.begin(), tset.end());
+    for (auto const &origin : origins) {
+      auto it = find_via_origin(origin);
+      if (it == end()) {
+        continue;
+      }
+      MappedProperties value = *it;
+      erase(it);
+      value.to = name.second;
+      values.push_back(value);
+    }
+  }
+  return insert(values);
+}
+
 }  // namespace DB
 }  // namespace CASM
@@ -46,6 +46,7 @@ Database<Supercell>::_on_insert_or_emplace(
     const value_type &obj = *result.first;
 
     // update
+    obj.set_lru(&m_lru);
     m_name_to_scel.insert(std::make_pair(obj.name(), result.first));
     master_selection().data().emplace(obj.name(), false);
   }
@@ -58,7 +58,7 @@ namespace DB {
 Supercell const &canonical_supercell(Supercell const &supercell,
                                      Database<Supercell> &supercell_db) {
   return *(make_canonical_and_insert(supercell.shared_prim(),
-                                     supercell.sym_info().supercell_lattice(),
+                                     supercell.lattice(),
                                      supercell_db)
                .first);
 }
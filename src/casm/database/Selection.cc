@@ -6,6 +6,7 @@
 #include "casm/clex/PrimClex_impl.hh"
 #include "casm/database/DatabaseTypes_impl.hh"
 #include "casm/database/Selected_impl.hh"
+#include "casm/database/SelectionBitset.hh"
 #include "casm/database/Selection_impl.hh"
 #include "casm/global/errors.hh"
 
@@ -195,6 +196,11 @@ Selection<ObjType>::Selection(Database<ObjType> &_db, fs::path selection_path)
     if (selection_path.extension() == ".json" ||
         selection_path.extension() == ".JSON") {
       from_json(jsonParser(selection_path));
+    } else if (selection_path.extension() == ".bin") {
+      SelectionBitset<ObjType> bitset(
+          std::make_shared<SelectionIndex<ObjType> >(db()));
+      bitset.read(selection_path);
+      bitset.to_selection(*this);
     } else {
       fs::ifstream select_file(selection_path);
       read(select_file);
@@ -493,8 +499,15 @@ void Selection<ObjType>::write(const DataFormatterDictionary<ObjType> &dict,
     out_path = primclex().dir().template master_selection<ObjType>();
   }
 
-  if (write_json || out_path.extension() == ".json" ||
-      out_path.extension() == ".JSON") {
+  if (!write_json && out_path.extension() == ".bin") {
+    SelectionBitset<ObjType> bitset(
+        std::make_shared<SelectionIndex<ObjType> >(db()), *this);
+    if (only_selected) {
+      bitset.subset();
+    }
+    bitset.write(out_path);
+  } else if (write_json || out_path.extension() == ".json" ||
+             out_path.extension() == ".JSON") {
     jsonParser json;
     this->to_json(dict, json, only_selected);
     SafeOfstream sout;
@@ -0,0 +1,269 @@
+#include "casm/database/SelectionBitset.hh"
+
+#include <bitset>
+#include <boost/filesystem/fstream.hpp>
+#include <cstring>
+#include <stdexcept>
+
+#include "casm/casm_io/SafeOfstream.hh"
+#include "casm/database/Database.hh"
+#include "casm/database/DatabaseTypes_impl.hh"
+#include "casm/database/Selection.hh"
+#include "casm/misc/hash.hh"
+
+namespace CASM {
+namespace DB {
+
+namespace {
+
+/// Binary selection file header: magic, format version
+const char selection_magic[8] = {'C', 'A', 'S', 'M', 'S', 'E', 'L', 'B'};
+const std::uint32_t selection_format = 1;
+
+/// FNV-1a hash of a string, which does not depend on the standard library
+std::uint64_t string_hash(std::string const &value) {
+  std::uint64_t hash = fnv1a_offset_basis;
+  fnv1a(hash, value.data(), value.size());
+  return hash;
+}
+
+Index n_words(Index n) { return (n + 63) / 64; }
+
+Index count(std::vector<std::uint64_t> const &bits) {
+  Index result = 0;
+  for (std::uint64_t word : bits) {
+    result += std::bitset<64>(word).count();
+  }
+  return result;
+}
+
+template <typename IntType>
+void write_int(std::ostream &out, IntType value) {
+  out.write(reinterpret_cast<char const *>(&value), sizeof(IntType));
+}
+
+template <typename IntType>
+IntType read_int(std::istream &in) {
+  IntType value = 0;
+  in.read(reinterpret_cast<char *>(&value), sizeof(IntType));
+  return value;
+}
+
+}  // namespace
+
+// --- SelectionIndex ---
+
+template <typename ObjType>
+SelectionIndex<ObjType>::SelectionIndex(Database<ObjType> const &db)
+    : m_fingerprint(0) {
+  m_names.reserve(db.size());
+  for (auto it = db.begin(); it != db.end(); ++it) {
+    m_ordinal.emplace(it.name(), m_names.size());
+    m_names.push_back(it.name());
+    hash_combine(m_fingerprint, string_hash(m_names.back()));
+  }
+}
+
+template <typename ObjType>
+Index SelectionIndex<ObjType>::ordinal(std::string const &name) const {
+  auto it = m_ordinal.find(name);
+  if (it == m_ordinal.end()) {
+    return -1;
+  }
+  return it->second;
+}
+
+// --- SelectionBitset ---
+
+template <typename ObjType>
+SelectionBitset<ObjType>::SelectionBitset(index_ptr _index)
+    : m_index(_index),
+      m_included(n_words(m_index->size()), 0),
+      m_selected(n_words(m_index->size()), 0) {
+  for (Index i = 0; i < size(); ++i) {
+    set(i, false);
+  }
+}
+
+/// \brief Construct from a Selection
+///
+/// Objects in the selection that are not in the index are ignored.
+template <typename ObjType>
+SelectionBitset<ObjType>::SelectionBitset(index_ptr _index,
+                                          Selection<ObjType> const &selection)
+    : m_index(_index),
+      m_included(n_words(m_index->size()), 0),
+      m_selected(n_words(m_index->size()), 0) {
+  for (auto const &value : selection.data()) {
+    Index ordinal = m_index->ordinal(value.first);
+    if (ordinal >= 0) {
+      set(ordinal, value.second);
+    }
+  }
+}
+
+template <typename ObjType>
+Index SelectionBitset<ObjType>::included_size() const {
+  return count(m_included);
+}
+
+template <typename ObjType>
+Index SelectionBitset<ObjType>::selected_size() const {
+  return count(m_selected);
+}
+
+template <typename ObjType>
+void SelectionBitset<ObjType>::set(Index ordinal, bool selected) {
+  std::uint64_t mask = std::uint64_t(1) << (ordinal & 63);
+  m_included[ordinal >> 6] |= mask;
+  if (selected) {
+    m_selected[ordinal >> 6] |= mask;
+  } else {
+    m_selected[ordinal >> 6] &= ~mask;
+  }
+}
+
+template <typename ObjType>
+SelectionBitset<ObjType> &SelectionBitset<ObjType>::operator|=(
+    SelectionBitset const &other) {
+  _check_index(other);
+  for (Index i = 0; i < Index(m_selected.size()); ++i) {
+    m_included[i] |= other.m_selected[i];
+    m_selected[i] |= other.m_selected[i];
+  }
+  return *this;
+}
+
+template <typename ObjType>
+SelectionBitset<ObjType> &SelectionBitset<ObjType>::operator&=(
+    SelectionBitset const &other) {
+  _check_index(other);
+  for (Index i = 0; i < Index(m_selected.size()); ++i) {
+    m_selected[i] &= other.m_selected[i] | ~other.m_included[i];
+    m_included[i] |= other.m_included[i];
+  }
+  return *this;
+}
+
+template <typename ObjType>
+SelectionBitset<ObjType> &SelectionBitset<ObjType>::operator^=(
+    SelectionBitset const &other) {
+  _check_index(other);
+  for (Index i = 0; i < Index(m_selected.size()); ++i) {
+    m_included[i] |= other.m_selected[i];
+    m_selected[i] ^= other.m_selected[i];
+  }
+  return *this;
+}
+
+template <typename ObjType>
+void SelectionBitset<ObjType>::flip() {
+  for (Index i = 0; i < Index(m_selected.size()); ++i) {
+    m_selected[i] = ~m_selected[i] & m_included[i];
+  }
+}
+
+template <typename ObjType>
+void SelectionBitset<ObjType>::subset() {
+  m_included = m_selected;
+}
+
+/// \brief Replace the contents of a Selection
+///
+/// - Included objects are inserted into `selection.data()`, which is
+///   cleared first
+template <typename ObjType>
+void SelectionBitset<ObjType>::to_selection(
+    Selection<ObjType> &selection) const {
+  auto &data = selection.data();
+  data.clear();
+  for (Index w = 0; w < Index(m_included.size()); ++w) {
+    std::uint64_t word = m_included[w];
+    while (word) {
+      Index ordinal = w * 64 + lowest_set_bit(word);
+      data.emplace(m_index->name(ordinal), is_selected(ordinal));
+      word &= word - 1;
+    }
+  }
+}
+
+/// \brief Write in binary form
+///
+/// Format: magic, format version, number of objects, index fingerprint,
+/// then the included and selected words.
+template <typename ObjType>
+void SelectionBitset<ObjType>::write(fs::path const &path) const {
+  SafeOfstream sout;
+  sout.open(path);
+  std::ostream &out = sout.ofstream();
+  out.write(selection_magic, 8);
+  write_int<std::uint32_t>(out, selection_format);
+  write_int<std::uint64_t>(out, size());
+  write_int<std::uint64_t>(out, m_index->fingerprint());
+  for (std::uint64_t word : m_included) {
+    write_int(out, word);
+  }
+  for (std::uint64_t word : m_selected) {
+    write_int(out, word);
+  }
+  sout.close();
+}
+
+/// \brief Read from binary form
+///
+/// \throws std::runtime_error if the file was not written for a database with
+///     the same names in the same order as this index
+template <typename ObjType>
+void SelectionBitset<ObjType>::read(fs::path const &path) {
+  fs::ifstream in(path, std::ios::binary);
+  char magic[8];
+  in.read(magic, 8);
+  if (!in || std::memcmp(magic, selection_magic, 8) != 0 ||
+      read_int<std::uint32_t>(in) != selection_format) {
+    throw std::runtime_error(
+        "Error reading binary selection: invalid format: " + path.string());
+  }
+  std::uint64_t n = read_int<std::uint64_t>(in);
+  std::uint64_t fingerprint = read_int<std::uint64_t>(in);
+  if (n != std::uint64_t(size()) || fingerprint != m_index->fingerprint()) {
+    throw std::runtime_error(
+        "Error reading binary selection: database has changed since the "
+        "selection was written: " +
+        path.string());
+  }
+  for (auto &word : m_included) {
+    word = read_int<std::uint64_t>(in);
+  }
+  for (auto &word : m_selected) {
+    word = read_int<std::uint64_t>(in);
+  }
+  if (!in) {
+    throw std::runtime_error("Error reading binary selection: too short: " +
+                             path.string());
+  }
+}
+
+template <typename ObjType>
+void SelectionBitset<ObjType>::_check_index(
+    SelectionBitset const &other) const {
+  if (m_index != other.m_index &&
+      m_index->fingerprint() != other.m_index->fingerprint()) {
+    throw std::runtime_error(
+        "Error in SelectionBitset: selections use different indices");
+  }
+}
+
+}  // namespace DB
+}  // namespace CASM
+
+// explicit template instantiations
+#define INST_SelectionBitset(r, data, type) \
+  template class SelectionIndex<type>;      \
+  template class SelectionBitset<type>;
+
+namespace CASM {
+namespace DB {
+
+BOOST_PP_SEQ_FOR_EACH(INST_SelectionBitset, _, CASM_DB_TYPES)
+}  // namespace DB
+}  // namespace CASM
@@ -0,0 +1,45 @@
+#include "casm/database/journal/MappedFile.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <stdexcept>
+#include <string>
+
+namespace CASM {
+namespace DB {
+
+MappedFile::MappedFile(fs::path const &path) : m_data(nullptr), m_size(0) {
+  int fd = ::open(path.string().c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error(std::string("Error opening file: ") +
+                             path.string());
+  }
+  struct stat file_stat;
+  bool is_empty = true;
+  if (::fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+    is_empty = false;
+    void *ptr =
+        ::mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (ptr != MAP_FAILED) {
+      m_data = static_cast<char const *>(ptr);
+      m_size = file_stat.st_size;
+    }
+  }
+  ::close(fd);
+  if (!m_data && !is_empty) {
+    throw std::runtime_error(std::string("Error mapping file: ") +
+                             path.string());
+  }
+}
+
+MappedFile::~MappedFile() {
+  if (m_data) {
+    ::munmap(const_cast<char *>(m_data), m_size);
+  }
+}
+
+}  // namespace DB
+}  // namespace CASM
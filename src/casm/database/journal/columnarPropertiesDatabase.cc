@@ -0,0 +1,665 @@
+#include "casm/database/journal/columnarPropertiesDatabase.hh"
+
+#include <boost/filesystem.hpp>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#include "casm/casm_io/SafeOfstream.hh"
+#include "casm/casm_io/container/json_io.hh"
+#include "casm/clex/PrimClex.hh"
+#include "casm/database/DatabaseHandler.hh"
+#include "casm/database/journal/MappedFile.hh"
+
+namespace CASM {
+namespace DB {
+
+namespace {
+
+/// File header: magic, format version
+const char props_magic[8] = {'C', 'A', 'S', 'M', 'P', 'R', 'O', 'P'};
+const std::uint32_t props_format = 1;
+
+/// Writes the sections of a columnar properties file
+///
+/// Arrays are aligned to 8 bytes, relative to the beginning of the file, so
+/// that they can be read in place from a memory map.
+class Writer {
+ public:
+  Writer(std::ostream &_out) : m_out(_out), m_pos(0) {}
+
+  void put_bytes(char const *data, std::size_t size) {
+    m_out.write(data, size);
+    m_pos += size;
+  }
+
+  template <typename T>
+  void put(T value) {
+    put_bytes(reinterpret_cast<char const *>(&value), sizeof(T));
+  }
+
+  void put_str(std::string const &value) {
+    put<std::uint32_t>(value.size());
+    put_bytes(value.data(), value.size());
+  }
+
+  template <typename T>
+  void put_array(std::vector<T> const &values) {
+    put_bytes(reinterpret_cast<char const *>(values.data()),
+              values.size() * sizeof(T));
+  }
+
+  void align() {
+    char const zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    put_bytes(zeros, (8 - m_pos % 8) % 8);
+  }
+
+ private:
+  std::ostream &m_out;
+  std::size_t m_pos;
+};
+
+/// Reads the sections of a columnar properties file, checking bounds
+class Reader {
+ public:
+  Reader(char const *_data, std::size_t _size, fs::path const &_path)
+      : m_begin(_data), m_it(_data), m_end(_data + _size), m_path(_path) {}
+
+  template <typename T>
+  T get() {
+    _check(sizeof(T));
+    T value;
+    std::memcpy(&value, m_it, sizeof(T));
+    m_it += sizeof(T);
+    return value;
+  }
+
+  std::string get_str() {
+    std::uint32_t size = get<std::uint32_t>();
+    _check(size);
+    std::string value(m_it, size);
+    m_it += size;
+    return value;
+  }
+
+  /// Location of an array of 'n' values, which is not copied
+  template <typename T>
+  T const *get_array(std::uint64_t n) {
+    if (n > std::uint64_t(m_end - m_it) / sizeof(T)) {
+      _fail();
+    }
+    T const *value = reinterpret_cast<T const *>(m_it);
+    m_it += n * sizeof(T);
+    return value;
+  }
+
+  void align() {
+    std::size_t pos = m_it - m_begin;
+    _check((8 - pos % 8) % 8);
+    m_it += (8 - pos % 8) % 8;
+  }
+
+ private:
+  void _check(std::size_t size) const {
+    if (std::size_t(m_end - m_it) < size) {
+      _fail();
+    }
+  }
+
+  void _fail() const {
+    throw std::runtime_error(std::string("Error invalid format: ") +
+                             m_path.string());
+  }
+
+  char const *m_begin;
+  char const *m_it;
+  char const *m_end;
+  fs::path m_path;
+};
+
+}  // namespace
+
+const MappedProperties &columnarPropertiesDatabaseIterator::dereference()
+    const {
+  return m_db->_materialize(m_it->second);
+}
+
+const std::uint32_t columnarPropertiesDatabase::Column::absent;
+
+columnarPropertiesDatabase::Column::Column()
+    : m_n_mapped(0),
+      m_mapped_shape(nullptr),
+      m_mapped_offset(nullptr),
+      m_mapped_data(nullptr) {}
+
+/// \brief True if the row has a value for this property
+bool columnarPropertiesDatabase::Column::has(Index ordinal) const {
+  if (ordinal < m_n_mapped) {
+    return m_mapped_shape && m_mapped_shape[2 * ordinal] != absent;
+  }
+  Index i = ordinal - m_n_mapped;
+  return 2 * i < Index(m_shape.size()) && m_shape[2 * i] != absent;
+}
+
+/// \brief Value of the property for a row, which must have one
+///
+/// - The value refers to the column, and is invalidated if a row is inserted
+///   or the database is closed
+Eigen::Map<Eigen::MatrixXd const> columnarPropertiesDatabase::Column::value(
+    Index ordinal) const {
+  if (ordinal < m_n_mapped) {
+    return Eigen::Map<Eigen::MatrixXd const>(
+        m_mapped_data + m_mapped_offset[ordinal],
+        m_mapped_shape[2 * ordinal], m_mapped_shape[2 * ordinal + 1]);
+  }
+  Index i = ordinal - m_n_mapped;
+  return Eigen::Map<Eigen::MatrixXd const>(
+      m_data.data() + m_offset[i], m_shape[2 * i], m_shape[2 * i + 1]);
+}
+
+columnarPropertiesDatabase::columnarPropertiesDatabase(
+    const PrimClex &_primclex, std::string calc_type, fs::path location,
+    fs::path json_location)
+    : PropertiesDatabase(_primclex),
+      m_is_open(false),
+      m_is_modified(false),
+      m_calc_type(calc_type),
+      m_location(location),
+      m_json_location(json_location),
+      m_n_mapped(0),
+      m_n_materialized(0) {}
+
+columnarPropertiesDatabase::~columnarPropertiesDatabase() {}
+
+/// Read the rows, and the location of the columns, from the file
+///
+/// - No MappedProperties are constructed, unless needed to sort the origins
+///   of a configuration with more than one origin
+DatabaseBase &columnarPropertiesDatabase::open() {
+  if (m_is_open) {
+    return *this;
+  }
+
+  auto lock = primclex().db_handler().lock(DatabaseLock::Mode::shared);
+  if (!m_location.empty() && fs::exists(m_location)) {
+    m_file_version = file_version(m_location);
+    m_mapped.reset(new MappedFile(m_location));
+    _read_mapped();
+  } else if (!m_json_location.empty() && fs::exists(m_json_location)) {
+    _read_json(m_json_location);
+    m_is_modified = true;
+  }
+  m_is_open = true;
+  return *this;
+}
+
+/// Write all rows that are not erased to a new file
+///
+/// Format: magic, format version, number of rows, number of columns, the
+/// conflict score settings as JSON, then for each row its 'origin', 'to',
+/// 'init_config', and 'file_data', then for each column its kind, property
+/// name, number of values, and the shape and offset of each row followed by
+/// the values.
+void columnarPropertiesDatabase::commit() {
+  if (!m_is_open || m_location.empty() || !m_is_modified) {
+    return;
+  }
+
+  auto lock = primclex().db_handler().lock(DatabaseLock::Mode::exclusive);
+  if (file_version(m_location) != m_file_version) {
+    _merge();
+  }
+
+  // rows are written in order of origin
+  std::vector<Index> ordinals;
+  ordinals.reserve(m_data.size());
+  for (const auto &value : m_data) {
+    ordinals.push_back(value.second);
+  }
+
+  std::vector<column_key> keys;
+  for (const auto &column : m_columns) {
+    for (Index ordinal : ordinals) {
+      if (column.second.has(ordinal)) {
+        keys.push_back(column.first);
+        break;
+      }
+    }
+  }
+
+  jsonParser meta;
+  meta["default_conflict_score"] = m_default_score;
+  meta["conflict_score"].put_obj();
+  for (const auto &val : m_origins) {
+    if (val.second.key_comp().score_method() != m_default_score) {
+      meta["conflict_score"][val.first] = val.second.key_comp().score_method();
+    }
+  }
+  std::stringstream meta_ss;
+  meta.print(meta_ss, 0, 12);
+
+  SafeOfstream file;
+  fs::create_directories(m_location.parent_path());
+  file.open(m_location);
+  Writer out(file.ofstream());
+  out.put_bytes(props_magic, 8);
+  out.put<std::uint32_t>(props_format);
+  out.put<std::uint32_t>(0);
+  out.put<std::uint64_t>(ordinals.size());
+  out.put<std::uint64_t>(keys.size());
+  out.put_str(meta_ss.str());
+  out.align();
+
+  for (Index ordinal : ordinals) {
+    const Row &row = m_rows[ordinal];
+    out.put_str(row.origin);
+    out.put_str(row.to);
+    out.put_str(row.init_config);
+    out.put_str(row.file_data.path());
+    out.put<std::int64_t>(row.file_data.timestamp());
+  }
+  out.align();
+
+  std::vector<std::uint32_t> shape;
+  std::vector<std::uint64_t> offset;
+  for (const auto &key : keys) {
+    const Column &column = m_columns.find(key)->second;
+    shape.clear();
+    offset.clear();
+    std::uint64_t n_values = 0;
+    for (Index ordinal : ordinals) {
+      offset.push_back(n_values);
+      if (!column.has(ordinal)) {
+        shape.push_back(Column::absent);
+        shape.push_back(0);
+        continue;
+      }
+      auto value = column.value(ordinal);
+      shape.push_back(value.rows());
+      shape.push_back(value.cols());
+      n_values += value.size();
+    }
+
+    out.put<std::uint32_t>(static_cast<std::uint32_t>(key.first));
+    out.put_str(key.second);
+    out.align();
+    out.put<std::uint64_t>(n_values);
+    out.put_array(shape);
+    out.put_array(offset);
+    for (Index ordinal : ordinals) {
+      if (column.has(ordinal)) {
+        auto value = column.value(ordinal);
+        out.put_bytes(reinterpret_cast<char const *>(value.data()),
+                      value.size() * sizeof(double));
+      }
+    }
+  }
+  file.close();
+  m_file_version = file_version(m_location);
+  m_inserted.clear();
+  m_erased.clear();
+  m_is_modified = false;
+}
+
+void columnarPropertiesDatabase::close() {
+  m_data.clear();
+  m_origins.clear();
+  m_columns.clear();
+  m_rows.clear();
+  m_mapped.reset();
+  m_n_mapped = 0;
+  m_n_materialized = 0;
+  m_file_version.clear();
+  m_inserted.clear();
+  m_erased.clear();
+  m_is_modified = false;
+  m_is_open = false;
+}
+
+/// \brief Begin iterator
+columnarPropertiesDatabase::iterator columnarPropertiesDatabase::begin()
+    const {
+  return _iterator(m_data.begin());
+}
+
+/// \brief End iterator
+columnarPropertiesDatabase::iterator columnarPropertiesDatabase::end() const {
+  return _iterator(m_data.end());
+}
+
+columnarPropertiesDatabase::size_type columnarPropertiesDatabase::size()
+    const {
+  return m_data.size();
+}
+
+/// \brief Return iterator to MappedProperties that is the best mapping to
+/// specified config
+///
+/// - Prefers self-mapped, else best scoring
+columnarPropertiesDatabase::iterator columnarPropertiesDatabase::find_via_to(
+    std::string to_configname) const {
+  auto it = m_origins.find(to_configname);
+  if (it == m_origins.end()) {
+    return end();
+  }
+  // it->second is set of all 'origin' -> 'to'
+  return find_via_origin(*it->second.begin());
+}
+
+/// \brief Return iterator to MappedProperties that is from the specified config
+columnarPropertiesDatabase::iterator
+columnarPropertiesDatabase::find_via_origin(std::string origin) const {
+  return _iterator(m_data.find(origin));
+}
+
+/// \brief Names of all configurations that relaxed 'origin'->'to'
+std::set<std::string, PropertiesDatabase::Compare>
+columnarPropertiesDatabase::all_origins(std::string to_configname) const {
+  auto it = m_origins.find(to_configname);
+  if (it == m_origins.end()) {
+    return _make_set(to_configname, m_default_score);
+  } else {
+    return it->second;
+  }
+}
+
+/// \brief Change the score method for a single configuration
+void columnarPropertiesDatabase::set_score_method(
+    std::string to_configname, const ScoreMappedProperties &score) {
+  auto it = m_origins.find(to_configname);
+  if (it == m_origins.end()) {
+    // do nothing if default score
+    if (score == m_default_score) {
+      return;
+    }
+
+    auto tmp = _make_set(to_configname, score);
+    m_origins.insert({to_configname, tmp});
+  } else {
+    // if no change, return
+    if (it->second.value_comp().score_method() == score) {
+      return;
+    }
+
+    // construct new set and copy from old set
+    auto tmp = _make_set(to_configname, score);
+    for (const auto &origin : it->second) {
+      tmp.insert(origin);
+    }
+    it->second = tmp;
+  }
+  m_is_modified = true;
+}
+
+/// \brief Row ordinal of the MappedProperties at an iterator
+///
+/// - Valid until the database is committed or closed
+Index columnarPropertiesDatabase::ordinal(iterator const &it) const {
+  return static_cast<columnarPropertiesDatabaseIterator *>(it.get())
+      ->base()
+      ->second;
+}
+
+/// \brief Column of a global property, or nullptr if no row has it
+columnarPropertiesDatabase::Column const *
+columnarPropertiesDatabase::global_column(std::string const &name) const {
+  auto it = m_columns.find(column_key(ColumnKind::global, name));
+  return it == m_columns.end() ? nullptr : &it->second;
+}
+
+/// \brief Column of a site property, or nullptr if no row has it
+columnarPropertiesDatabase::Column const *
+columnarPropertiesDatabase::site_column(std::string const &name) const {
+  auto it = m_columns.find(column_key(ColumnKind::site, name));
+  return it == m_columns.end() ? nullptr : &it->second;
+}
+
+columnarPropertiesDatabase::iterator columnarPropertiesDatabase::_iterator(
+    columnarPropertiesDatabaseIterator::base_iterator _it) const {
+  return iterator(columnarPropertiesDatabaseIterator(this, _it));
+}
+
+MappedProperties const &columnarPropertiesDatabase::_materialize(
+    Index ordinal) const {
+  const Row &row = m_rows[ordinal];
+  if (!row.value) {
+    row.value.reset(new MappedProperties());
+    MappedProperties &value = *row.value;
+    value.origin = row.origin;
+    value.to = row.to;
+    value.init_config = row.init_config;
+    value.file_data = row.file_data;
+    for (const auto &column : m_columns) {
+      if (!column.second.has(ordinal)) {
+        continue;
+      }
+      if (column.first.first == ColumnKind::global) {
+        value.global[column.first.second] = column.second.value(ordinal);
+      } else {
+        value.site[column.first.second] = column.second.value(ordinal);
+      }
+    }
+    ++m_n_materialized;
+  }
+  return *row.value;
+}
+
+void columnarPropertiesDatabase::_read_mapped() {
+  Reader in(m_mapped->data(), m_mapped->size(), m_location);
+  char const *magic = in.get_array<char>(8);
+  if (std::memcmp(magic, props_magic, 8) != 0 ||
+      in.get<std::uint32_t>() != props_format) {
+    throw std::runtime_error(std::string("Error invalid format: ") +
+                             m_location.string());
+  }
+  in.get<std::uint32_t>();
+  std::uint64_t n_rows = in.get<std::uint64_t>();
+  std::uint64_t n_columns = in.get<std::uint64_t>();
+
+  jsonParser meta = jsonParser::parse(in.get_str());
+  in.align();
+  CASM::from_json(m_default_score, meta["default_conflict_score"]);
+  {
+    auto it = meta["conflict_score"].begin();
+    auto end = meta["conflict_score"].end();
+    for (; it != end; ++it) {
+      set_score_method(it.name(), it->get<ScoreMappedProperties>());
+    }
+  }
+
+  m_rows.resize(n_rows);
+  std::map<std::string, std::vector<std::string> > origins;
+  for (Index i = 0; i < Index(n_rows); ++i) {
+    Row &row = m_rows[i];
+    row.origin = in.get_str();
+    row.to = in.get_str();
+    row.init_config = in.get_str();
+    std::string path = in.get_str();
+    row.file_data = FileData(path, in.get<std::int64_t>());
+    m_data.emplace(row.origin, i);
+    origins[row.to].push_back(row.origin);
+  }
+  in.align();
+  m_n_mapped = n_rows;
+
+  for (std::uint64_t i = 0; i < n_columns; ++i) {
+    ColumnKind kind = ColumnKind(in.get<std::uint32_t>());
+    std::string name = in.get_str();
+    in.align();
+    Column &column = m_columns[column_key(kind, name)];
+    column.m_n_mapped = m_n_mapped;
+    std::uint64_t n_values = in.get<std::uint64_t>();
+    column.m_mapped_shape = in.get_array<std::uint32_t>(2 * n_rows);
+    column.m_mapped_offset = in.get_array<std::uint64_t>(n_rows);
+    column.m_mapped_data = in.get_array<double>(n_values);
+  }
+
+  for (const auto &value : origins) {
+    auto tset = all_origins(value.first);
+    tset.insert(value.second.begin(), value.second.end());
+    _set_all_origins(value.first, tset);
+  }
+  m_is_modified = false;
+}
+
+/// Apply the changes committed by another process since open
+///
+/// - Rows erased by another process are erased, unless inserted by this
+///   process
+/// - Rows inserted by another process are inserted, unless erased or
+///   inserted by this process
+/// - Rows replaced by another process, as indicated by a change of
+///   'file_data', are replaced, unless erased or inserted by this process
+/// - Conflict score settings of this process are kept
+void columnarPropertiesDatabase::_merge() {
+  columnarPropertiesDatabase current(primclex(), m_calc_type, m_location);
+  current.open();
+
+  std::vector<std::string> erased;
+  for (const auto &value : m_data) {
+    if (!m_inserted.count(value.first) && !current.m_data.count(value.first)) {
+      erased.push_back(value.first);
+    }
+  }
+  for (const auto &origin : erased) {
+    erase_via_origin(origin);
+  }
+
+  std::vector<MappedProperties> inserted;
+  for (const auto &value : current.m_data) {
+    auto it = m_data.find(value.first);
+    if (it == m_data.end()) {
+      if (m_erased.count(value.first)) {
+        continue;
+      }
+    } else if (m_inserted.count(value.first) ||
+               m_rows[it->second].file_data ==
+                   current.m_rows[value.second].file_data) {
+      continue;
+    } else {
+      erase_via_origin(value.first);
+    }
+    inserted.push_back(current._materialize(value.second));
+  }
+  insert(inserted);
+}
+
+void columnarPropertiesDatabase::_read_json(fs::path const &path) {
+  jsonParser json{path};
+
+  CASM::from_json(m_default_score, json["default_conflict_score"]);
+  {
+    auto it = json["conflict_score"].begin();
+    auto end = json["conflict_score"].end();
+    for (; it != end; ++it) {
+      set_score_method(it.name(), it->get<ScoreMappedProperties>());
+    }
+  }
+
+  std::vector<MappedProperties> values;
+  {
+    auto it = json["data"].begin();
+    auto end = json["data"].end();
+    for (; it != end; ++it) {
+      values.emplace_back();
+      CASM::from_json(values.back(), *it);
+    }
+  }
+  insert(values);
+}
+
+void columnarPropertiesDatabase::_append(const MappedProperties &value) {
+  Index ordinal = m_rows.size();
+  Index i = ordinal - m_n_mapped;
+
+  auto append = [&](ColumnKind kind,
+                    std::map<std::string, Eigen::MatrixXd> const &props) {
+    for (const auto &prop : props) {
+      Column &column = m_columns[column_key(kind, prop.first)];
+      column.m_n_mapped = m_n_mapped;
+      column.m_shape.resize(2 * i, Column::absent);
+      column.m_offset.resize(i, 0);
+      column.m_shape.push_back(prop.second.rows());
+      column.m_shape.push_back(prop.second.cols());
+      column.m_offset.push_back(column.m_data.size());
+      column.m_data.insert(column.m_data.end(), prop.second.data(),
+                           prop.second.data() + prop.second.size());
+    }
+  };
+  append(ColumnKind::global, value.global);
+  append(ColumnKind::site, value.site);
+
+  m_rows.emplace_back();
+  Row &row = m_rows.back();
+  row.origin = value.origin;
+  row.to = value.to;
+  row.init_config = value.init_config;
+  row.file_data = value.file_data;
+}
+
+/// \brief Reserve space for rows
+///
+/// - Erased rows remain until the next commit, so space is reserved for
+///   'n - size()' rows in addition to the current rows
+void columnarPropertiesDatabase::_reserve(size_type n) {
+  if (n > size()) {
+    m_rows.reserve(m_rows.size() + n - size());
+  }
+}
+
+/// \brief Private _insert MappedProperties, without modifying 'origins'
+std::pair<columnarPropertiesDatabase::iterator, bool>
+columnarPropertiesDatabase::_insert(const MappedProperties &value) {
+  auto it = m_data.find(value.origin);
+  if (it != m_data.end()) {
+    return std::make_pair(_iterator(it), false);
+  }
+  _append(value);
+  m_inserted.insert(value.origin);
+  m_is_modified = true;
+  auto res = m_data.emplace(value.origin, m_rows.size() - 1);
+  return std::make_pair(_iterator(res.first), true);
+}
+
+/// \brief Private _erase MappedProperties, without modifying 'origins'
+///
+/// - The values remain in the columns until the next commit
+columnarPropertiesDatabase::iterator columnarPropertiesDatabase::_erase(
+    iterator pos) {
+  auto base_it =
+      static_cast<columnarPropertiesDatabaseIterator *>(pos.get())->base();
+  Row &row = m_rows[base_it->second];
+  if (row.value) {
+    row.value.reset();
+    --m_n_materialized;
+  }
+  m_erased.insert(base_it->first);
+  m_is_modified = true;
+  return _iterator(m_data.erase(base_it));
+}
+
+/// \brief Names of all configurations that relaxed 'origin'->'to'
+void columnarPropertiesDatabase::_set_all_origins(
+    std::string to_configname, const std::set<std::string, Compare> &_set) {
+  auto it = m_origins.find(to_configname);
+  if (it == m_origins.end()) {
+    if (_set.size()) {
+      m_origins.insert({to_configname, _set});
+    }
+  } else {
+    if (!_set.size()) {
+      m_origins.erase(it);
+    } else {
+      it->second = _set;
+    }
+  }
+}
+
+std::set<std::string, PropertiesDatabase::Compare>
+columnarPropertiesDatabase::_make_set(
+    std::string to_configname, const ScoreMappedProperties &score) const {
+  return std::set<std::string, Compare>(Compare(this, to_configname, score));
+}
+
+}  // namespace DB
+}  // namespace CASM
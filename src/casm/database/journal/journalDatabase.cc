@@ -0,0 +1,1054 @@
+#include "casm/database/journal/journalDatabase.hh"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/range/iterator_range.hpp>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <sstream>
+
+#include "casm/app/DirectoryStructure.hh"
+#include "casm/app/QueryHandler_impl.hh"
+#include "casm/casm_io/container/json_io.hh"
+#include "casm/clex/PrimClex_impl.hh"
+#include "casm/clex/io/json/ConfigDoF_json_io.hh"
+#include "casm/database/DatabaseHandler_impl.hh"
+#include "casm/database/DatabaseLock.hh"
+#include "casm/database/DatabaseTypes_impl.hh"
+#include "casm/database/Database_impl.hh"
+#include "casm/database/journal/MappedFile.hh"
+#include "casm/database/journal/columnarPropertiesDatabase.hh"
+#include "casm/database/json/jsonDatabase.hh"
+#include "casm/misc/hash.hh"
+
+namespace CASM {
+
+const std::string traits<DB::journalDB>::name = "journalDB";
+
+const std::string traits<DB::journalDB>::version = "1.0";
+
+namespace DB {
+
+namespace {
+
+/// The journalDB uses jsonDB for Supercell
+struct InsertScelImpl {
+  InsertScelImpl(DatabaseHandler &_db_handler) : db_handler(_db_handler) {}
+  DatabaseHandler &db_handler;
+
+  void eval() {
+    db_handler.insert<Supercell>(
+        traits<journalDB>::name,
+        notstd::make_unique<jsonDatabase<Supercell> >(db_handler.primclex()));
+  }
+};
+
+/// The journalDB uses columnarPropertiesDatabase for properties, reading
+/// existing jsonDB properties if there are no columnar properties yet
+struct InsertPropsImpl {
+  InsertPropsImpl(DatabaseHandler &_db_handler)
+      : db_handler(_db_handler),
+        primclex(_db_handler.primclex()),
+        dir(primclex.dir()),
+        journal_dir(dir.root_dir()),
+        json_dir(dir.root_dir()) {}
+
+  DatabaseHandler &db_handler;
+  const PrimClex &primclex;
+  const DirectoryStructure &dir;
+  journalDB::DirectoryStructure journal_dir;
+  jsonDB::DirectoryStructure json_dir;
+
+  template <typename T>
+  void eval() {
+    for (auto calc_type : dir.all_calctype()) {
+      fs::path location = journal_dir.props_list<T>(calc_type);
+      fs::path json_location = json_dir.props_list<T>(calc_type);
+      db_handler.insert_props<T>(
+          traits<journalDB>::name, calc_type,
+          notstd::make_unique<columnarPropertiesDatabase>(
+              primclex, calc_type, location, json_location));
+    }
+  }
+};
+
+/// File header: magic, format version, generation
+const char journal_magic[8] = {'C', 'A', 'S', 'M', 'J', 'R', 'N', 'L'};
+const std::uint32_t journal_format = 1;
+const std::size_t header_size = 8 + 4 + 8;
+
+/// Journal records are not compacted until the journal is at least this
+/// large, in bytes
+const unsigned long long min_compaction_size = 1 << 20;
+
+enum class RecordType : unsigned char {
+  insert = 1,
+  erase = 2,
+  update = 3,
+  cache = 4,
+  config_id = 5
+};
+
+/// FNV-1a checksum of a record payload
+std::uint32_t checksum(char const *data, std::size_t size) {
+  return fnv1a_32(data, size);
+}
+
+template <typename IntType>
+void put_int(std::string &data, IntType value) {
+  char bytes[sizeof(IntType)];
+  std::memcpy(bytes, &value, sizeof(IntType));
+  data.append(bytes, sizeof(IntType));
+}
+
+template <typename IntType>
+IntType get_int(char const *data) {
+  IntType value;
+  std::memcpy(&value, data, sizeof(IntType));
+  return value;
+}
+
+std::string make_header(unsigned long long generation) {
+  std::string header(journal_magic, 8);
+  put_int<std::uint32_t>(header, journal_format);
+  put_int<std::uint64_t>(header, generation);
+  return header;
+}
+
+/// Builds one record: size and checksum of the payload, then the payload,
+/// which is a RecordType followed by length-prefixed strings
+class RecordWriter {
+ public:
+  RecordWriter(RecordType type) : m_payload(1, static_cast<char>(type)) {}
+
+  RecordWriter &operator<<(std::string const &value) {
+    put_int<std::uint32_t>(m_payload, value.size());
+    m_payload += value;
+    return *this;
+  }
+
+  /// Append the complete record to `data`
+  void write(std::string &data) const {
+    put_int<std::uint32_t>(data, m_payload.size());
+    put_int<std::uint32_t>(data,
+                           checksum(m_payload.data(), m_payload.size()));
+    data += m_payload;
+  }
+
+ private:
+  std::string m_payload;
+};
+
+/// Reads the fields of one record payload, without copying
+class RecordReader {
+ public:
+  RecordReader(char const *begin, char const *end)
+      : m_it(begin + 1), m_end(end), m_type(RecordType(*begin)) {}
+
+  RecordType type() const { return m_type; }
+
+  /// Location and size of the next field
+  std::pair<char const *, std::size_t> next() {
+    if (m_end - m_it < 4) {
+      throw std::runtime_error("Error reading journalDB record: too short");
+    }
+    std::uint32_t size = get_int<std::uint32_t>(m_it);
+    m_it += 4;
+    if (std::uint64_t(m_end - m_it) < size) {
+      throw std::runtime_error("Error reading journalDB record: too short");
+    }
+    std::pair<char const *, std::size_t> value(m_it, size);
+    m_it += size;
+    return value;
+  }
+
+  std::string next_str() {
+    auto value = next();
+    return std::string(value.first, value.second);
+  }
+
+ private:
+  char const *m_it;
+  char const *m_end;
+  RecordType m_type;
+};
+
+/// Compact JSON string, as stored in records
+std::string to_record_string(jsonParser const &json) {
+  std::stringstream ss;
+  json.print(ss, 0, 12);
+  return ss.str();
+}
+
+/// Convert a jsonDB configuration list to journalDB records, with header
+std::string json_config_list_to_records(fs::path const &path) {
+  jsonParser json(path);
+  if (!json.is_obj() || !json.contains("supercells")) {
+    throw std::runtime_error(std::string("Error invalid format: ") +
+                             path.string());
+  }
+  std::string data = make_header(0);
+  if (json.contains("config_id")) {
+    std::map<std::string, Index> config_id;
+    from_json(config_id, json["config_id"]);
+    for (auto const &value : config_id) {
+      RecordWriter writer(RecordType::config_id);
+      writer << value.first << std::to_string(value.second);
+      writer.write(data);
+    }
+  }
+  auto scel_it = json["supercells"].begin();
+  auto scel_end = json["supercells"].end();
+  for (; scel_it != scel_end; ++scel_it) {
+    auto config_it = scel_it->begin();
+    auto config_end = scel_it->end();
+    for (; config_it != config_end; ++config_it) {
+      std::string source;
+      auto source_it = config_it->find("source");
+      if (source_it != config_it->end()) {
+        source = to_record_string(*source_it);
+      }
+      std::string cache;
+      auto cache_it = config_it->find("cache");
+      if (cache_it != config_it->end()) {
+        cache = to_record_string(*cache_it);
+      }
+      RecordWriter writer(RecordType::insert);
+      writer << scel_it.name() << config_it.name()
+             << to_record_string((*config_it)["dof"]) << source << cache;
+      writer.write(data);
+    }
+  }
+  return data;
+}
+
+/// Open a file with POSIX `open`, and close it on destruction
+class FileDescriptor {
+ public:
+  FileDescriptor(fs::path const &path, int flags) : m_path(path) {
+    m_fd = ::open(path.string().c_str(), flags, 0666);
+    if (m_fd < 0) {
+      throw std::runtime_error(std::string("Error opening journalDB file: ") +
+                               path.string());
+    }
+  }
+
+  FileDescriptor(FileDescriptor const &) = delete;
+  FileDescriptor &operator=(FileDescriptor const &) = delete;
+
+  ~FileDescriptor() { ::close(m_fd); }
+
+  /// Write all of `data`
+  void write(std::string const &data) {
+    std::size_t n_written = 0;
+    while (n_written < data.size()) {
+      ssize_t n =
+          ::write(m_fd, data.data() + n_written, data.size() - n_written);
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      if (n < 0) {
+        throw std::runtime_error(
+            std::string("Error writing journalDB file: ") + m_path.string());
+      }
+      n_written += n;
+    }
+  }
+
+  /// Flush written data, or for a directory, changed entries, to disk
+  void sync() {
+    if (::fsync(m_fd) != 0) {
+      throw std::runtime_error(std::string("Error syncing journalDB file: ") +
+                               m_path.string());
+    }
+  }
+
+ private:
+  fs::path m_path;
+  int m_fd;
+};
+
+/// Write a file by writing a temporary file and renaming it into place
+///
+/// The temporary file is synced before it is renamed, and the directory is
+/// synced after, so that after a crash the file has either its old or new
+/// contents.
+void write_atomic(fs::path const &path, std::string const &data) {
+  fs::path tmp_path = path.string() + ".tmp";
+  {
+    FileDescriptor file(tmp_path, O_WRONLY | O_CREAT | O_TRUNC);
+    file.write(data);
+    file.sync();
+  }
+  fs::rename(tmp_path, path);
+  FileDescriptor dir(path.parent_path(), O_RDONLY | O_DIRECTORY);
+  dir.sync();
+}
+
+/// Append to a file, and sync it, so that a commit is durable once it returns
+void append_durable(fs::path const &path, std::string const &data) {
+  FileDescriptor file(path, O_WRONLY | O_APPEND);
+  file.write(data);
+  file.sync();
+}
+
+void write_insert(std::string &data, Configuration const &config,
+                  RecordType type = RecordType::insert) {
+  jsonParser dof_json;
+  to_json(config.configdof(), dof_json);
+  jsonParser source_json;
+  to_json(config.source(), source_json);
+  RecordWriter writer(type);
+  writer << config.supercell().name() << config.id()
+         << to_record_string(dof_json) << to_record_string(source_json)
+         << to_record_string(config.cache());
+  writer.write(data);
+  config.set_cache_saved();
+}
+
+/// Parse a Configuration name into supercell name and id
+///
+/// \returns false if `name` is not of the form "scelname/id"
+bool parse_name(std::string const &name, std::string &scelname, Index &id) {
+  auto pos = name.rfind('/');
+  if (pos == std::string::npos || pos + 1 == name.size() ||
+      name.find_first_not_of("0123456789", pos + 1) != std::string::npos) {
+    return false;
+  }
+  scelname = name.substr(0, pos);
+  id = std::stol(name.substr(pos + 1));
+  return true;
+}
+
+}  // namespace
+
+/// Iterates over the index, constructing Configuration on dereference
+class journalDatabase<Configuration>::Iterator
+    : public DatabaseIteratorBase<Configuration> {
+ public:
+  Iterator(journalDatabase<Configuration> const *_db, base_iterator _it)
+      : m_db(_db), m_it(_it) {}
+
+  std::string name() const override {
+    return m_it->first.first + "/" + std::to_string(m_it->first.second);
+  }
+
+  base_iterator base() const { return m_it; }
+
+ private:
+  void increment() override { ++m_it; }
+
+  Configuration const &dereference() const override {
+    return m_db->_materialize(m_it);
+  }
+
+  bool equal(const DatabaseIteratorBase<Configuration> &other) const override {
+    return m_it == static_cast<const Iterator &>(other).m_it;
+  }
+
+  Iterator *_clone() const override { return new Iterator(*this); }
+
+  journalDatabase<Configuration> const *m_db;
+  base_iterator m_it;
+};
+
+void journalDB::insert(DatabaseHandler &db_handler) {
+  InsertScelImpl(db_handler).eval();
+  db_handler.insert<Configuration>(
+      traits<journalDB>::name,
+      notstd::make_unique<journalDatabase<Configuration> >(
+          db_handler.primclex()));
+  if (db_handler.primclex().has_dir()) {
+    DB::for_each_config_type(InsertPropsImpl(db_handler));
+  }
+}
+
+journalDB::DirectoryStructure::DirectoryStructure(const fs::path _root)
+    : m_dir(_root) {}
+
+template <typename DataObject>
+fs::path journalDB::DirectoryStructure::snapshot() const {
+  return m_dir.casm_dir() / traits<journalDB>::name /
+         (traits<DataObject>::short_name + "_snapshot.bin");
+}
+
+template <typename DataObject>
+fs::path journalDB::DirectoryStructure::journal() const {
+  return m_dir.casm_dir() / traits<journalDB>::name /
+         (traits<DataObject>::short_name + "_journal.bin");
+}
+
+template <typename DataObject>
+fs::path journalDB::DirectoryStructure::props_list(
+    std::string calctype) const {
+  return m_dir.casm_dir() / traits<journalDB>::name /
+         (std::string("calctype.") + calctype) /
+         (traits<DataObject>::short_name + "_props.bin");
+}
+
+journalDatabase<Configuration>::journalDatabase(const PrimClex &_primclex)
+    : Database<Configuration>(_primclex),
+      m_is_open(false),
+      m_n_materialized(0),
+      m_id_reservation(_primclex),
+      m_generation(0),
+      m_snapshot_size(0),
+      m_journal_size(0),
+      m_needs_compaction(false) {}
+
+journalDatabase<Configuration>::~journalDatabase() {}
+
+/// Read the index from the snapshot and journal
+///
+/// - No Configuration are constructed
+journalDatabase<Configuration> &journalDatabase<Configuration>::open() {
+  if (m_is_open) {
+    return *this;
+  }
+
+  m_pending.clear();
+  m_generation = 0;
+  m_snapshot_size = 0;
+  m_journal_size = 0;
+  m_needs_compaction = false;
+
+  auto lock = primclex().db_handler().lock(DatabaseLock::Mode::shared);
+
+  if (!primclex().has_dir()) {
+    m_is_open = true;
+    master_selection() = Selection<Configuration>(*this);
+    return *this;
+  }
+
+  journalDB::DirectoryStructure dir(primclex().dir().root_dir());
+  fs::path snapshot_path = dir.snapshot<Configuration>();
+  fs::path journal_path = dir.journal<Configuration>();
+  fs::path json_path =
+      jsonDB::DirectoryStructure(primclex().dir().root_dir())
+          .obj_list<Configuration>();
+
+  if (fs::exists(snapshot_path)) {
+    m_mapped.emplace_back(new MappedFile(snapshot_path));
+    MappedFile const &file = *m_mapped.back();
+    m_snapshot_size = _replay(file.data(), file.size(), m_generation, false);
+    if (m_snapshot_size == 0) {
+      throw std::runtime_error(std::string("Error invalid format: ") +
+                               snapshot_path.string());
+    }
+  } else if (fs::exists(json_path)) {
+    m_migrated = json_config_list_to_records(json_path);
+    _replay(m_migrated.data(), m_migrated.size(), m_generation, false);
+    m_needs_compaction = true;
+  }
+  if (!m_needs_compaction && fs::exists(journal_path)) {
+    m_mapped.emplace_back(new MappedFile(journal_path));
+    MappedFile const &file = *m_mapped.back();
+    m_journal_size = _replay(file.data(), file.size(), m_generation, true);
+  }
+
+  // the master selection file is read by name; only construct the master
+  // selection from the index if there is no file
+  fs::path master_selection_path =
+      primclex().dir().template master_selection<Configuration>();
+  if (fs::exists(master_selection_path)) {
+    master_selection() = Selection<Configuration>(*this);
+  } else {
+    master_selection() = Selection<Configuration>(*this, "EMPTY");
+    for (auto it = m_index.begin(); it != m_index.end(); ++it) {
+      master_selection().data().emplace(Iterator(this, it).name(), false);
+    }
+  }
+  this->read_aliases();
+
+  m_is_open = true;
+  return *this;
+}
+
+void journalDatabase<Configuration>::commit() {
+  if (!m_is_open) {
+    throw std::runtime_error(
+        "Error in journalDatabase<Configuration>::commit(): Database not "
+        "open");
+  }
+  if (!primclex().has_dir()) {
+    throw std::runtime_error(
+        "Error in journalDatabase<Configuration>::commit(): CASM project has "
+        "no root directory.");
+  }
+
+  journalDB::DirectoryStructure dir(primclex().dir().root_dir());
+  fs::create_directories(dir.journal<Configuration>().parent_path());
+
+  auto lock = primclex().db_handler().lock(DatabaseLock::Mode::exclusive);
+  m_renamed_on_commit.clear();
+
+  // record cache updates; only constructed Configuration can be updated
+  for (const auto &value : m_index) {
+    Configuration const *config = value.second.config.get();
+    if (config && config->cache_updated()) {
+      RecordWriter writer(RecordType::cache);
+      writer << value.first.first << std::to_string(value.first.second)
+             << to_record_string(config->cache());
+      writer.write(m_pending);
+      config->set_cache_saved();
+    }
+  }
+
+  if (_is_changed_on_disk()) {
+    _merge();
+  }
+
+  if (m_needs_compaction) {
+    compact();
+  } else if (!m_pending.empty()) {
+    fs::path journal_path = dir.journal<Configuration>();
+
+    // start a new journal, or drop any incomplete record left by an
+    // interrupted commit
+    if (m_journal_size == 0) {
+      write_atomic(journal_path, make_header(m_generation));
+      m_journal_size = header_size;
+    } else if (fs::file_size(journal_path) != m_journal_size) {
+      fs::resize_file(journal_path, m_journal_size);
+    }
+
+    append_durable(journal_path, m_pending);
+    m_journal_size += m_pending.size();
+    m_pending.clear();
+
+    if (m_journal_size > std::max(m_snapshot_size, min_compaction_size)) {
+      compact();
+    }
+  }
+
+  m_id_reservation.release();
+
+  this->write_aliases();
+  auto handler = primclex().settings().query_handler<Configuration>();
+  handler.set_selected(master_selection());
+
+  bool write_json = false;
+  bool only_selected = false;
+  master_selection().write(
+      handler.dict(),
+      primclex().dir().template master_selection<Configuration>(), write_json,
+      only_selected);
+}
+
+/// True if another process has committed since this database was opened
+bool journalDatabase<Configuration>::_is_changed_on_disk() const {
+  journalDB::DirectoryStructure dir(primclex().dir().root_dir());
+  fs::path snapshot_path = dir.snapshot<Configuration>();
+  fs::path journal_path = dir.journal<Configuration>();
+
+  unsigned long long generation = 0;
+  if (fs::exists(snapshot_path)) {
+    fs::ifstream file(snapshot_path, std::ios::binary);
+    char header[header_size];
+    file.read(header, header_size);
+    if (!file || std::memcmp(header, journal_magic, 8) != 0) {
+      return true;
+    }
+    generation = get_int<std::uint64_t>(header + 12);
+  }
+  unsigned long long journal_size = 0;
+  if (fs::exists(journal_path)) {
+    journal_size = fs::file_size(journal_path);
+  }
+  return generation != m_generation || journal_size != m_journal_size;
+}
+
+/// Re-open from the current files and apply the changes made since this
+/// database was opened
+///
+/// - Inserted Configuration keep their reserved ids
+/// - Inserted Configuration that are equivalent to a Configuration inserted
+///   by another process are not inserted again, and are recorded in
+///   `renamed_on_commit()`
+/// - Updates, erasures, and cache updates of Configuration that were erased
+///   by another process are ignored
+/// - Selected values in the master selection are kept, by name
+/// - Iterators and references are invalidated
+void journalDatabase<Configuration>::_merge() {
+  std::string pending;
+  std::swap(pending, m_pending);
+  auto selected = master_selection().data();
+
+  close();
+  open();
+
+  // (scelname, id) of inserted Configuration -> id after merge, if changed
+  std::map<key_type, Index> ids;
+  auto current_key = [&](std::string const &scelname, std::string const &id) {
+    key_type key(scelname, std::stol(id));
+    auto it = ids.find(key);
+    if (it != ids.end()) {
+      key.second = it->second;
+    }
+    return key;
+  };
+  auto as_field = [](std::pair<char const *, std::size_t> value) {
+    return Field(value.first, value.second);
+  };
+
+  char const *it = pending.data();
+  char const *end = pending.data() + pending.size();
+  while (it != end) {
+    std::uint32_t record_size = get_int<std::uint32_t>(it);
+    RecordReader reader(it + 8, it + 8 + record_size);
+    it += 8 + record_size;
+
+    std::string scelname = reader.next_str();
+    if (reader.type() == RecordType::config_id) {
+      continue;
+    }
+    key_type key = current_key(scelname, reader.next_str());
+    auto index_it = m_index.find(key);
+
+    switch (reader.type()) {
+      case RecordType::insert: {
+        Entry fields;
+        fields.dof = as_field(reader.next());
+        fields.source = as_field(reader.next());
+        fields.cache = as_field(reader.next());
+        std::unique_ptr<Configuration> config = _make_config(key, fields);
+        iterator result = search(*config);
+        if (result == this->end()) {
+          if (index_it == m_index.end()) {
+            _insert(key, *config);
+            break;
+          }
+          // the id was taken by a process that does not reserve ids
+          result = insert(*config).first;
+        }
+        // else, equivalent to a Configuration inserted by another process
+        ids[key] = static_cast<Iterator *>(result.get())->base()->first.second;
+        m_renamed_on_commit[key.first + "/" + std::to_string(key.second)] =
+            result.name();
+        break;
+      }
+      case RecordType::update: {
+        if (index_it != m_index.end()) {
+          Entry fields;
+          fields.dof = as_field(reader.next());
+          fields.source = as_field(reader.next());
+          fields.cache = as_field(reader.next());
+          update(*_make_config(key, fields));
+        }
+        break;
+      }
+      case RecordType::erase: {
+        if (index_it != m_index.end()) {
+          erase(_iterator(index_it));
+        }
+        break;
+      }
+      case RecordType::cache: {
+        if (index_it != m_index.end()) {
+          std::string cache = reader.next_str();
+          _materialize(index_it);
+          index_it->second.config->set_initial_cache(jsonParser::parse(cache));
+          RecordWriter writer(RecordType::cache);
+          writer << key.first << std::to_string(key.second) << cache;
+          writer.write(m_pending);
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  }
+
+  for (auto const &value : selected) {
+    std::string scelname;
+    Index id;
+    if (!parse_name(value.first, scelname, id)) {
+      continue;
+    }
+    key_type key = current_key(scelname, std::to_string(id));
+    std::string name = key.first + "/" + std::to_string(key.second);
+    auto selected_it = master_selection().data().find(name);
+    if (selected_it != master_selection().data().end()) {
+      selected_it->second = value.second;
+    }
+  }
+}
+
+/// Write a new snapshot of all Configuration and reset the journal
+///
+/// Pending changes are included in the snapshot. Records of Configuration
+/// that have not been constructed are copied without parsing.
+void journalDatabase<Configuration>::compact() {
+  if (!primclex().has_dir()) {
+    throw std::runtime_error(
+        "Error in journalDatabase<Configuration>::compact(): CASM project has "
+        "no root directory.");
+  }
+  journalDB::DirectoryStructure dir(primclex().dir().root_dir());
+  fs::create_directories(dir.snapshot<Configuration>().parent_path());
+
+  auto lock = primclex().db_handler().lock(DatabaseLock::Mode::exclusive);
+  if (_is_changed_on_disk()) {
+    _merge();
+  }
+
+  unsigned long long generation = m_generation + 1;
+  std::string data = make_header(generation);
+  for (auto const &value : m_config_id) {
+    RecordWriter writer(RecordType::config_id);
+    writer << value.first << std::to_string(value.second);
+    writer.write(data);
+  }
+  for (const auto &value : m_index) {
+    Entry const &entry = value.second;
+    if (entry.config) {
+      write_insert(data, *entry.config);
+    } else {
+      RecordWriter writer(RecordType::insert);
+      writer << value.first.first << std::to_string(value.first.second)
+             << entry.dof.str() << entry.source.str() << entry.cache.str();
+      writer.write(data);
+    }
+  }
+
+  // index fields continue to point into the previously mapped files, which
+  // remain valid after they are replaced
+  write_atomic(dir.snapshot<Configuration>(), data);
+  m_snapshot_size = data.size();
+  m_generation = generation;
+
+  write_atomic(dir.journal<Configuration>(), make_header(m_generation));
+  m_journal_size = header_size;
+  m_pending.clear();
+  m_needs_compaction = false;
+}
+
+void journalDatabase<Configuration>::close() {
+  m_id_reservation.release();
+  m_search_index.clear();
+  m_index.clear();
+  m_config_id.clear();
+  m_pending.clear();
+  m_mapped.clear();
+  m_migrated.clear();
+  m_n_materialized = 0;
+
+  m_is_open = false;
+}
+
+journalDatabase<Configuration>::iterator journalDatabase<Configuration>::begin()
+    const {
+  return _iterator(m_index.begin());
+}
+
+journalDatabase<Configuration>::iterator journalDatabase<Configuration>::end()
+    const {
+  return _iterator(m_index.end());
+}
+
+journalDatabase<Configuration>::size_type journalDatabase<Configuration>::size()
+    const {
+  return m_index.size();
+}
+
+/// Number of Configuration currently constructed
+journalDatabase<Configuration>::size_type
+journalDatabase<Configuration>::size_materialized() const {
+  return m_n_materialized;
+}
+
+std::pair<journalDatabase<Configuration>::iterator, bool>
+journalDatabase<Configuration>::insert(const Configuration &config) {
+  std::string scelname = config.supercell().name();
+  search_type &search_index = _search_index(scelname);
+  auto search_it = search_index.find(&config);
+  if (search_it != search_index.end()) {
+    return std::make_pair(
+        _iterator(m_index.find(key_type(scelname, search_it->second))),
+        false);
+  }
+
+  // set the config id, from the ids reserved by this process
+  Index &next_id = m_config_id.emplace(scelname, 0).first->second;
+  Index id = m_id_reservation.next(scelname, next_id);
+  while (m_index.count(key_type(scelname, id))) {
+    id = m_id_reservation.next(scelname, id + 1);
+  }
+  return std::make_pair(_iterator(_insert(key_type(scelname, id), config)),
+                        true);
+}
+
+/// Insert with a particular key, recording the change
+///
+/// - The key must not be in use, and `config` must not be in the database
+journalDatabase<Configuration>::base_iterator
+journalDatabase<Configuration>::_insert(key_type const &key,
+                                        Configuration const &config) {
+  Index &next_id = m_config_id.emplace(key.first, 0).first->second;
+  next_id = std::max(next_id, key.second + 1);
+
+  auto result = m_index.emplace(key, Entry());
+  Entry &entry = result.first->second;
+  entry.config = notstd::make_unique<Configuration>(config);
+  this->clear_name(*entry.config);
+  this->set_id(*entry.config, key.second);
+  ++m_n_materialized;
+
+  auto search_it = m_search_index.find(key.first);
+  if (search_it != m_search_index.end()) {
+    search_it->second.emplace(entry.config.get(), key.second);
+  }
+  master_selection().data().emplace(entry.config->name(), 0);
+  write_insert(m_pending, *entry.config);
+  return result.first;
+}
+
+journalDatabase<Configuration>::iterator journalDatabase<Configuration>::update(
+    const Configuration &config) {
+  auto it = this->find(config.name());
+  if (it == this->end()) {
+    throw std::runtime_error(
+        "Error in journalDatabase<Configuration>::update: Configuration not "
+        "found");
+  }
+  base_iterator base_it = static_cast<Iterator *>(it.get())->base();
+  Entry const &entry = base_it->second;
+  Index id = base_it->first.second;
+
+  // if the supercell has a search index, all its Configuration are constructed
+  auto search_it = m_search_index.find(base_it->first.first);
+  if (search_it != m_search_index.end()) {
+    search_it->second.erase(entry.config.get());
+  } else if (!entry.config) {
+    ++m_n_materialized;
+  }
+  entry.config = notstd::make_unique<Configuration>(config);
+  this->clear_name(*entry.config);
+  this->set_id(*entry.config, id);
+  if (search_it != m_search_index.end()) {
+    search_it->second.emplace(entry.config.get(), id);
+  }
+
+  write_insert(m_pending, *entry.config, RecordType::update);
+  return it;
+}
+
+journalDatabase<Configuration>::iterator journalDatabase<Configuration>::erase(
+    iterator pos) {
+  base_iterator base_it = static_cast<Iterator *>(pos.get())->base();
+  RecordWriter writer(RecordType::erase);
+  writer << base_it->first.first << std::to_string(base_it->first.second);
+  writer.write(m_pending);
+  return _iterator(_erase(base_it));
+}
+
+/// Find by name, without constructing the Configuration
+journalDatabase<Configuration>::iterator journalDatabase<Configuration>::find(
+    const std::string &name_or_alias) const {
+  std::string scelname;
+  Index id;
+  if (!parse_name(this->name(name_or_alias), scelname, id)) {
+    return end();
+  }
+  return _iterator(m_index.find(key_type(scelname, id)));
+}
+
+/// Range of Configuration in a particular supecell
+boost::iterator_range<journalDatabase<Configuration>::iterator>
+journalDatabase<Configuration>::scel_range(const std::string &scelname) const {
+  auto begin = m_index.lower_bound(
+      key_type(scelname, std::numeric_limits<Index>::min()));
+  auto end = m_index.upper_bound(
+      key_type(scelname, std::numeric_limits<Index>::max()));
+  return boost::make_iterator_range(_iterator(begin), _iterator(end));
+}
+
+/// Find canonical Configuration in database by comparing DoF
+///
+/// \param config A Configuration in canonical form
+///
+/// - Constructs all Configuration in the same supercell, on first use
+typename journalDatabase<Configuration>::iterator
+journalDatabase<Configuration>::search(const Configuration &config) const {
+  std::string scelname = config.supercell().name();
+  search_type const &search_index = _search_index(scelname);
+  auto search_it = search_index.find(&config);
+  if (search_it == search_index.end()) {
+    return end();
+  }
+  return _iterator(m_index.find(key_type(scelname, search_it->second)));
+}
+
+journalDatabase<Configuration>::iterator
+journalDatabase<Configuration>::_iterator(base_iterator it) const {
+  return iterator(Iterator(this, it));
+}
+
+/// Construct the Configuration for an index entry, if not yet constructed
+Configuration const &journalDatabase<Configuration>::_materialize(
+    base_iterator it) const {
+  Entry const &entry = it->second;
+  if (entry.config) {
+    return *entry.config;
+  }
+
+  entry.config = _make_config(it->first, entry);
+  ++m_n_materialized;
+  return *entry.config;
+}
+
+/// Construct a Configuration from the fields of a record
+std::unique_ptr<Configuration> journalDatabase<Configuration>::_make_config(
+    key_type const &key, Entry const &fields) const {
+  auto const &scel_db =
+      primclex().db_handler().db<Supercell>(traits<journalDB>::name);
+  auto scel_it = scel_db.find(key.first);
+  if (scel_it == scel_db.end()) {
+    throw std::runtime_error(
+        "Error in journalDatabase<Configuration>: Supercell not found: " +
+        key.first);
+  }
+  auto config = notstd::make_unique<Configuration>(*scel_it);
+  from_json(config->configdof(), jsonParser::parse(fields.dof.str()));
+  if (fields.source.size) {
+    config->set_source(jsonParser::parse(fields.source.str()));
+  }
+  if (fields.cache.size) {
+    config->set_initial_cache(jsonParser::parse(fields.cache.str()));
+  }
+  this->clear_name(*config);
+  this->set_id(*config, key.second);
+  return config;
+}
+
+/// Construct all Configuration in a supercell and index them by DoF
+journalDatabase<Configuration>::search_type &
+journalDatabase<Configuration>::_search_index(
+    std::string const &scelname) const {
+  auto result = m_search_index.emplace(scelname, search_type());
+  search_type &search_index = result.first->second;
+  if (result.second) {
+    auto begin = m_index.lower_bound(
+        key_type(scelname, std::numeric_limits<Index>::min()));
+    auto end = m_index.upper_bound(
+        key_type(scelname, std::numeric_limits<Index>::max()));
+    for (auto it = begin; it != end; ++it) {
+      search_index.emplace(&_materialize(it), it->first.second);
+    }
+  }
+  return search_index;
+}
+
+/// Erase from the containers, without recording the change
+journalDatabase<Configuration>::base_iterator
+journalDatabase<Configuration>::_erase(base_iterator it) {
+  master_selection().data().erase(Iterator(this, it).name());
+  auto search_it = m_search_index.find(it->first.first);
+  if (search_it != m_search_index.end()) {
+    search_it->second.erase(&_materialize(it));
+  }
+  if (it->second.config) {
+    --m_n_materialized;
+  }
+  return m_index.erase(it);
+}
+
+/// Read records from a mapped file, or the migrated jsonDB data
+///
+/// Reading stops at the first incomplete or corrupt record. Index fields
+/// point into `data`, which must remain valid until close.
+std::size_t journalDatabase<Configuration>::_replay(
+    char const *data, std::size_t size, unsigned long long &generation,
+    bool match_generation) {
+  if (size < header_size || std::memcmp(data, journal_magic, 8) != 0) {
+    return 0;
+  }
+  if (get_int<std::uint32_t>(data + 8) != journal_format) {
+    throw std::runtime_error("Error journalDB format mismatch");
+  }
+  std::uint64_t data_generation = get_int<std::uint64_t>(data + 12);
+  if (match_generation && generation != data_generation) {
+    return 0;
+  }
+  generation = data_generation;
+
+  auto set_min_config_id = [&](std::string const &scelname, Index value) {
+    Index &id = m_config_id[scelname];
+    id = std::max(id, value);
+  };
+  auto as_field = [](std::pair<char const *, std::size_t> value) {
+    return Field(value.first, value.second);
+  };
+
+  char const *it = data + header_size;
+  char const *end = data + size;
+  while (end - it >= 8) {
+    std::uint32_t record_size = get_int<std::uint32_t>(it);
+    std::uint32_t sum = get_int<std::uint32_t>(it + 4);
+    if (record_size == 0 || std::uint64_t(end - it - 8) < record_size ||
+        checksum(it + 8, record_size) != sum) {
+      break;
+    }
+    RecordReader reader(it + 8, it + 8 + record_size);
+    switch (reader.type()) {
+      case RecordType::insert:
+      case RecordType::update: {
+        std::string scelname = reader.next_str();
+        Index id = std::stol(reader.next_str());
+        Entry &entry = m_index[key_type(scelname, id)];
+        entry.dof = as_field(reader.next());
+        entry.source = as_field(reader.next());
+        entry.cache = as_field(reader.next());
+        set_min_config_id(scelname, id + 1);
+        break;
+      }
+      case RecordType::erase: {
+        std::string scelname = reader.next_str();
+        Index id = std::stol(reader.next_str());
+        m_index.erase(key_type(scelname, id));
+        break;
+      }
+      case RecordType::cache: {
+        std::string scelname = reader.next_str();
+        Index id = std::stol(reader.next_str());
+        auto entry_it = m_index.find(key_type(scelname, id));
+        if (entry_it != m_index.end()) {
+          entry_it->second.cache = as_field(reader.next());
+        }
+        break;
+      }
+      case RecordType::config_id: {
+        std::string scelname = reader.next_str();
+        set_min_config_id(scelname, std::stol(reader.next_str()));
+        break;
+      }
+      default:
+        throw std::runtime_error(
+            "Error reading journalDB record: unknown record type");
+    }
+    it += 8 + record_size;
+  }
+  return it - data;
+}
+
+}  // namespace DB
+}  // namespace CASM
+
+// explicit template instantiations
+#define INST_journalDB(r, data, type)                                      \
+  template fs::path journalDB::DirectoryStructure::snapshot<type>() const; \
+  template fs::path journalDB::DirectoryStructure::journal<type>() const;  \
+  template fs::path journalDB::DirectoryStructure::props_list<type>(       \
+      std::string calctype) const;
+
+namespace CASM {
+namespace DB {
+
+BOOST_PP_SEQ_FOR_EACH(INST_journalDB, _, CASM_DB_CONFIG_TYPES)
+}  // namespace DB
+}  // namespace CASM
@@ -2,14 +2,19 @@
 
 #include <boost/filesystem.hpp>
 #include <boost/range/iterator_range.hpp>
+#include <cstdint>
 
 #include "casm/app/DirectoryStructure.hh"
 #include "casm/app/QueryHandler_impl.hh"
 #include "casm/casm_io/SafeOfstream.hh"
 #include "casm/casm_io/container/json_io.hh"
+#include "casm/clex/ConfigIsEquivalent.hh"
 #include "casm/clex/PrimClex_impl.hh"
+#include "casm/clex/SupercellSymCache.hh"
 #include "casm/clex/io/json/ConfigDoF_json_io.hh"
+#include "casm/database/ConfigDatabaseTools.hh"
 #include "casm/database/DatabaseHandler_impl.hh"
+#include "casm/database/DatabaseLock.hh"
 #include "casm/database/DatabaseTypes_impl.hh"
 #include "casm/database/Database_impl.hh"
 #include "casm/database/json/jsonPropertiesDatabase.hh"
@@ -63,6 +68,7 @@ struct InsertPropsImpl {
     }
   }
 };
+
 }  // namespace
 
 void jsonDB::insert(DatabaseHandler &db_handler) {
@@ -99,6 +105,7 @@ jsonDatabase<Supercell> &jsonDatabase<Supercell>::open() {
     return *this;
   }
 
+  auto lock = primclex().db_handler().lock(DatabaseLock::Mode::shared);
   if (primclex().has_dir()) {
     jsonDB::DirectoryStructure dir(primclex().dir().root_dir());
     if (fs::exists(dir.obj_list<Supercell>())) {
@@ -107,6 +114,10 @@ jsonDatabase<Supercell> &jsonDatabase<Supercell>::open() {
       _read_SCEL();
     }
   }
+  m_opened_names.clear();
+  for (const auto &scel : *this) {
+    m_opened_names.insert(scel.name());
+  }
   master_selection() = Selection<Supercell>(*this);
   this->read_aliases();
 
@@ -121,6 +132,9 @@ void jsonDatabase<Supercell>::commit() {
         "directory.");
   }
 
+  auto lock = primclex().db_handler().lock(DatabaseLock::Mode::exclusive);
+  _merge();
+
   jsonParser json;
   json["version"] = traits<jsonDB>::version;
 
@@ -136,6 +150,18 @@ void jsonDatabase<Supercell>::commit() {
   json.print(file.ofstream());
   file.close();
 
+  // save supercell site permutations not already in the cache, so they need
+  // not be re-calculated next run (only for supercells that were used, others
+  // were either saved when released or never constructed)
+  SupercellSymCache const *cache = primclex().supercell_sym_cache();
+  if (cache) {
+    for (const auto &scel : *this) {
+      if (scel.has_sym_info()) {
+        cache->save(scel.sym_info());
+      }
+    }
+  }
+
   this->write_aliases();
   auto handler = primclex().settings().query_handler<Supercell>();
   handler.set_selected(master_selection());
@@ -148,6 +174,34 @@ void jsonDatabase<Supercell>::close() {
   m_is_open = false;
 
   this->clear();
+  m_opened_names.clear();
+}
+
+/// Insert Supercell that were committed by another process since open
+///
+/// - Supercell in the current file that were not present on open, and so
+///   were not erased by this process, are inserted
+void jsonDatabase<Supercell>::_merge() {
+  jsonDB::DirectoryStructure dir(primclex().dir().root_dir());
+  if (!fs::exists(dir.obj_list<Supercell>())) {
+    return;
+  }
+  jsonParser json(dir.obj_list<Supercell>());
+  if (!json.is_obj() || !json.contains("supercells")) {
+    return;
+  }
+  auto it = json["supercells"].begin();
+  auto end = json["supercells"].end();
+  for (; it != end; ++it) {
+    if (m_opened_names.count(it.name()) ||
+        this->find(it.name()) != this->end()) {
+      continue;
+    }
+    Eigen::Matrix3l mat;
+    from_json(mat, *it);
+    this->emplace(&primclex(), mat);
+    m_opened_names.insert(it.name());
+  }
 }
 
 void jsonDatabase<Supercell>::_read_scel_list() {
@@ -218,13 +272,17 @@ void jsonDatabase<Supercell>::_read_SCEL() {
 }
 
 jsonDatabase<Configuration>::jsonDatabase(const PrimClex &_primclex)
-    : Database<Configuration>(_primclex), m_is_open(false) {}
+    : Database<Configuration>(_primclex),
+      m_is_open(false),
+      m_id_reservation(_primclex) {}
 
 jsonDatabase<Configuration> &jsonDatabase<Configuration>::open() {
   if (m_is_open) {
     return *this;
   }
 
+  auto lock = primclex().db_handler().lock(DatabaseLock::Mode::shared);
+
   if (!primclex().has_dir()) {
     m_is_open = true;
     master_selection() = Selection<Configuration>(*this);
@@ -233,6 +291,7 @@ jsonDatabase<Configuration> &jsonDatabase<Configuration>::open() {
 
   jsonDB::DirectoryStructure dir(primclex().dir().root_dir());
   fs::path config_list_path = dir.obj_list<Configuration>();
+  m_file_version = file_version(config_list_path);
 
   if (!fs::exists(config_list_path)) {
     m_is_open = true;
@@ -312,12 +371,18 @@ void jsonDatabase<Configuration>::commit() {
         "root directory.");
   }
 
+  auto lock = primclex().db_handler().lock(DatabaseLock::Mode::exclusive);
+  m_renamed_on_commit.clear();
+
   jsonDB::DirectoryStructure dir(primclex().dir().root_dir());
   fs::path config_list_path = dir.obj_list<Configuration>();
   if (primclex().db_handler().db<Supercell>(traits<jsonDB>::name).size() == 0) {
     fs::remove(config_list_path);
     return;
   }
+  if (file_version(config_list_path) != m_file_version) {
+    _merge();
+  }
 
   jsonParser json;
   if (fs::exists(config_list_path)) {
@@ -349,6 +414,11 @@ void jsonDatabase<Configuration>::commit() {
   json_spirit::write_stream((json_spirit::mValue &)json, file.ofstream(),
                             indent, prec);
   file.close();
+  m_file_version = file_version(config_list_path);
+  m_inserted.clear();
+  m_updated.clear();
+  m_erased.clear();
+  m_id_reservation.release();
 
   this->write_aliases();
   auto handler = primclex().settings().query_handler<Configuration>();
@@ -363,7 +433,14 @@ void jsonDatabase<Configuration>::commit() {
 }
 
 void jsonDatabase<Configuration>::close() {
+  m_id_reservation.release();
+  m_file_version.clear();
+  m_inserted.clear();
+  m_updated.clear();
+  m_erased.clear();
   m_name_to_config.clear();
+  m_hash_index.clear();
+  m_hash_overflow.clear();
   m_config_list.clear();
   m_scel_range.clear();
 
@@ -386,6 +463,10 @@ jsonDatabase<Configuration>::size_type jsonDatabase<Configuration>::size()
 
 std::pair<jsonDatabase<Configuration>::iterator, bool>
 jsonDatabase<Configuration>::insert(const Configuration &config) {
+  auto hash_it = _hash_find(config);
+  if (hash_it != m_config_list.end()) {
+    return std::make_pair(_iterator(hash_it), false);
+  }
   auto result = m_config_list.insert(config);
 
   return _on_insert_or_emplace(result, true);
@@ -404,7 +485,14 @@ jsonDatabase<Configuration>::iterator jsonDatabase<Configuration>::update(
   if (selection_it != master_selection().data().end()) {
     is_selected = selection_it->second;
   }
+  bool is_inserted = m_inserted.count(config.name());
   this->erase(it);
+  if (is_inserted) {
+    m_inserted.insert(config.name());
+  } else {
+    m_erased.erase(config.name());
+    m_updated.insert(config.name());
+  }
   auto result = m_config_list.insert(config);
   master_selection().data().emplace(config.name(), is_selected);
   return _on_insert_or_emplace(result, false).first;
@@ -418,6 +506,18 @@ jsonDatabase<Configuration>::iterator jsonDatabase<Configuration>::erase(
   // erase name & alias
   m_name_to_config.erase(base_it->name());
   master_selection().data().erase(base_it->name());
+  m_updated.erase(base_it->name());
+  if (!m_inserted.erase(base_it->name())) {
+    m_erased.insert(base_it->name());
+  }
+  // erase from hash index
+  auto hash_range = m_hash_index.equal_range(config_hash(*base_it));
+  for (auto it = hash_range.first; it != hash_range.second; ++it) {
+    if (it->second == base_it) {
+      m_hash_index.erase(it);
+      break;
+    }
+  }
   // update scel_range
   auto _scel_range_it = m_scel_range.find(base_it->supercell().name());
   if (_scel_range_it->second.first == _scel_range_it->second.second) {
@@ -458,15 +558,111 @@ jsonDatabase<Configuration>::scel_range(const std::string &scelname) const {
 ///
 /// \param config A Configuration in canonical form
 ///
-/// - Find in set<Configuration>
+/// - Find using a hash of supercell name and occupation, then compare DoF
+///   only for Configuration with the same hash. If many Configuration have
+///   the same hash, as when they differ only in continuous DoF values, find
+///   by ordered comparison.
 typename jsonDatabase<Configuration>::iterator
 jsonDatabase<Configuration>::search(const Configuration &config) const {
-  // not clear if using m_scel_range to search on a sub-range would help...
-  auto res = m_config_list.find(config);
-  if (res == m_config_list.end()) {
-    return end();
+  return _iterator(_hash_find(config));
+}
+
+/// Find an equivalent Configuration using m_hash_index
+///
+/// - Compares DoF for at most config_hash_max_compare Configuration, then
+///   uses m_config_list.find if more Configuration have the same hash
+///
+/// \returns m_config_list.end() if not found
+jsonDatabase<Configuration>::base_iterator
+jsonDatabase<Configuration>::_hash_find(const Configuration &config) const {
+  std::size_t hash = config_hash(config);
+  auto hash_range = m_hash_index.equal_range(hash);
+  if (hash_range.first != hash_range.second) {
+    ConfigIsEquivalent is_equivalent = config.equal_to();
+    for (auto it = hash_range.first; it != hash_range.second; ++it) {
+      if (is_equivalent(*it->second)) {
+        return it->second;
+      }
+    }
+  }
+  if (m_hash_overflow.count(hash)) {
+    return m_config_list.find(config);
+  }
+  return m_config_list.end();
+}
+
+/// Re-open from the current file and apply the changes made since open
+///
+/// - Inserted Configuration keep their reserved ids
+/// - Inserted Configuration that are equivalent to a Configuration inserted
+///   by another process are not inserted again, and are recorded in
+///   `renamed_on_commit()`
+/// - Updated Configuration, including those with an updated cache, replace
+///   the committed version, unless erased by another process
+/// - Selected values in the master selection are kept, by name
+/// - Iterators and references are invalidated
+void jsonDatabase<Configuration>::_merge() {
+  std::vector<Configuration> inserted;
+  std::vector<Configuration> updated;
+  for (const auto &config : m_config_list) {
+    if (m_inserted.count(config.name())) {
+      inserted.push_back(config);
+    } else if (m_updated.count(config.name()) || config.cache_updated()) {
+      updated.push_back(config);
+    }
+  }
+  std::set<std::string> erased;
+  std::swap(erased, m_erased);
+  auto selected = master_selection().data();
+
+  close();
+  open();
+
+  for (const auto &name : erased) {
+    auto it = find(name);
+    if (it != end()) {
+      erase(it);
+    }
+  }
+
+  for (const auto &config : updated) {
+    if (find(config.name()) != end()) {
+      update(config);
+    }
+  }
+
+  for (const auto &config : inserted) {
+    auto hash_it = _hash_find(config);
+    if (hash_it != m_config_list.end()) {
+      // equivalent to a Configuration inserted by another process
+      m_renamed_on_commit[config.name()] = hash_it->name();
+      continue;
+    }
+    if (find(config.name()) == end()) {
+      std::pair<base_iterator, bool> result = m_config_list.insert(config);
+      _on_insert_or_emplace(result, false);
+      Index &next_id = m_config_id[config.supercell().name()];
+      next_id = std::max(next_id, std::stol(config.id()) + 1);
+      m_inserted.insert(config.name());
+      continue;
+    }
+    // the id was taken by a process that does not reserve ids
+    Configuration tmp{config};
+    this->clear_name(tmp);
+    m_renamed_on_commit[config.name()] = insert(tmp).first.name();
+  }
+
+  for (const auto &value : selected) {
+    std::string name = value.first;
+    auto renamed_it = m_renamed_on_commit.find(name);
+    if (renamed_it != m_renamed_on_commit.end()) {
+      name = renamed_it->second;
+    }
+    auto selected_it = master_selection().data().find(name);
+    if (selected_it != master_selection().data().end()) {
+      selected_it->second = value.second;
+    }
   }
-  return _iterator(res);
 }
 
 /// Update m_name_to_config and m_scel_range after performing an insert or
@@ -478,18 +674,26 @@ jsonDatabase<Configuration>::_on_insert_or_emplace(
     const Configuration &config = *result.first;
 
     if (is_new) {
-      // set the config id, and increment
-      auto _config_id_it = m_config_id.find(config.supercell().name());
-      if (_config_id_it == m_config_id.end()) {
-        _config_id_it =
-            m_config_id.insert(std::make_pair(config.supercell().name(), 0))
-                .first;
+      // set the config id, reserved so that it is not used by another process
+      std::string scelname = config.supercell().name();
+      Index &next_id = m_config_id[scelname];
+      Index id = m_id_reservation.next(scelname, next_id);
+      while (m_name_to_config.count(scelname + "/" + std::to_string(id))) {
+        id = m_id_reservation.next(scelname, next_id);
       }
-      this->set_id(config, _config_id_it->second++);
+      next_id = std::max(next_id, id + 1);
+      this->set_id(config, id);
+      m_inserted.insert(config.name());
     }
 
     // update name -> config
     m_name_to_config.insert(std::make_pair(config.name(), result.first));
+    std::size_t hash = config_hash(config);
+    if (m_hash_index.count(hash) < config_hash_max_compare) {
+      m_hash_index.emplace(hash, result.first);
+    } else {
+      m_hash_overflow.insert(hash);
+    }
 
     // check if scel_range needs updating
     auto _scel_range_it = m_scel_range.find(config.supercell().name());
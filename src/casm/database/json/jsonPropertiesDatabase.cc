@@ -4,6 +4,8 @@
 
 #include "casm/casm_io/SafeOfstream.hh"
 #include "casm/casm_io/container/json_io.hh"
+#include "casm/clex/PrimClex.hh"
+#include "casm/database/DatabaseHandler.hh"
 #include "casm/global/errors.hh"
 
 namespace CASM {
@@ -23,8 +25,12 @@ DatabaseBase &jsonPropertiesDatabase::open() {
     return *this;
   }
 
+  auto lock = primclex().db_handler().lock(DatabaseLock::Mode::shared);
+  m_file_version = file_version(m_location);
   jsonParser json{m_location};
   this->from_json(json);
+  m_inserted.clear();
+  m_erased.clear();
   m_is_open = true;
   return *this;
 }
@@ -34,6 +40,11 @@ void jsonPropertiesDatabase::commit() {
     return;
   }
 
+  auto lock = primclex().db_handler().lock(DatabaseLock::Mode::exclusive);
+  if (file_version(m_location) != m_file_version) {
+    _merge();
+  }
+
   jsonParser json;
   this->to_json(json);
 
@@ -46,11 +57,17 @@ void jsonPropertiesDatabase::commit() {
   json_spirit::write_stream((json_spirit::mValue &)json, file.ofstream(),
                             indent, prec);
   file.close();
+  m_file_version = file_version(m_location);
+  m_inserted.clear();
+  m_erased.clear();
 }
 
 void jsonPropertiesDatabase::close() {
   m_data.clear();
   m_origins.clear();
+  m_file_version.clear();
+  m_inserted.clear();
+  m_erased.clear();
   m_is_open = false;
 }
 
@@ -179,6 +196,9 @@ jsonPropertiesDatabase::iterator jsonPropertiesDatabase::_iterator(
 std::pair<jsonPropertiesDatabase::iterator, bool>
 jsonPropertiesDatabase::_insert(const MappedProperties &value) {
   auto res = m_data.emplace(value.origin, value);
+  if (res.second) {
+    m_inserted.insert(value.origin);
+  }
   return std::make_pair(_iterator(res.first), res.second);
 }
 
@@ -186,6 +206,7 @@ jsonPropertiesDatabase::_insert(const MappedProperties &value) {
 jsonPropertiesDatabase::iterator jsonPropertiesDatabase::_erase(iterator pos) {
   auto base_it =
       static_cast<jsonPropertiesDatabaseIterator *>(pos.get())->base();
+  m_erased.insert(base_it->first);
   return _iterator(m_data.erase(base_it));
 }
 
@@ -206,6 +227,44 @@ void jsonPropertiesDatabase::_set_all_origins(
   }
 }
 
+/// Apply the changes committed by another process since open
+///
+/// - Same rules as columnarPropertiesDatabase: rows erased, inserted, or
+///   replaced by another process are erased, inserted, or replaced, unless
+///   erased or inserted by this process
+/// - Conflict score settings of this process are kept
+void jsonPropertiesDatabase::_merge() {
+  jsonPropertiesDatabase current(primclex(), m_calc_type, m_location);
+  current.open();
+
+  std::vector<std::string> erased;
+  for (const auto &value : m_data) {
+    if (!m_inserted.count(value.first) && !current.m_data.count(value.first)) {
+      erased.push_back(value.first);
+    }
+  }
+  for (const auto &origin : erased) {
+    erase_via_origin(origin);
+  }
+
+  std::vector<MappedProperties> inserted;
+  for (const auto &value : current.m_data) {
+    auto it = m_data.find(value.first);
+    if (it == m_data.end()) {
+      if (m_erased.count(value.first)) {
+        continue;
+      }
+    } else if (m_inserted.count(value.first) ||
+               it->second.file_data == value.second.file_data) {
+      continue;
+    } else {
+      erase_via_origin(value.first);
+    }
+    inserted.push_back(value.second);
+  }
+  insert(inserted);
+}
+
 std::set<std::string, PropertiesDatabase::Compare>
 jsonPropertiesDatabase::_make_set(std::string to_configname,
                                   const ScoreMappedProperties &score) const {
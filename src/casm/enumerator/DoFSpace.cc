@@ -5,6 +5,7 @@
 #include "casm/crystallography/Structure.hh"
 #include "casm/crystallography/SymTools.hh"
 #include "casm/enumerator/ConfigEnumInput_impl.hh"
+#include "casm/symmetry/SparseCollectiveDoFSymRep.hh"
 #include "casm/symmetry/SupercellSymInfo.hh"
 #include "casm/symmetry/SymRepTools.hh"
 #include "casm/symmetry/VectorSpaceSymReport.hh"
@@ -883,9 +884,34 @@ VectorSpaceSymReport vector_space_sym_report(
 /// \param group Group used for vector space symmetry report
 /// \param calc_wedges If true, calculate the irreducible wedges for the vector
 /// space. This may take a long time.
+/// \param blocked_decomposition If true, and the DoF is local, find irreps
+/// separately in blocks of the DoF space that are not mixed by symmetry,
+/// using a sparse representation. This is much faster for large numbers of
+/// sites. If false, the full DoF space is decomposed at once.
 SymRepTools_v2::VectorSpaceSymReport vector_space_sym_report_v2(
     DoFSpace const &dof_space, SupercellSymInfo const &sym_info,
-    std::vector<PermuteIterator> const &group, bool calc_wedges) {
+    std::vector<PermuteIterator> const &group, bool calc_wedges,
+    bool blocked_decomposition) {
+  xtal::BasicStructure const &prim_struc = dof_space.shared_prim()->structure();
+  if (blocked_decomposition &&
+      !prim_struc.global_dofs().count(dof_space.dof_key())) {
+    if (!dof_space.sites().has_value()) {
+      throw std::runtime_error(
+          "Error in vector_space_sym_report_v2: Local DoF, but no sites");
+    }
+    auto group_and_rep = make_sparse_collective_dof_symrep(
+        dof_space.sites().value(), sym_info, dof_space.dof_key(), group);
+    bool allow_complex = true;
+    SymRepTools_v2::IrrepDecomposition irrep_decomposition =
+        make_irrep_decomposition(group_and_rep.second, group_and_rep.first,
+                                 dof_space.basis(), allow_complex);
+    SymRepTools_v2::VectorSpaceSymReport result =
+        SymRepTools_v2::vector_space_sym_report(irrep_decomposition,
+                                                calc_wedges);
+    result.axis_glossary = dof_space.axis_glossary();
+    return result;
+  }
+
   // We need a temporary mastersymgroup to manage the symmetry representation
   // for the DoF
   MasterSymGroup g;
@@ -936,12 +962,13 @@ DoFSpace make_symmetry_adapted_dof_space(
 DoFSpace make_symmetry_adapted_dof_space_v2(
     DoFSpace const &dof_space, SupercellSymInfo const &sym_info,
     std::vector<PermuteIterator> const &group, bool calc_wedges,
-    std::optional<SymRepTools_v2::VectorSpaceSymReport> &symmetry_report) {
+    std::optional<SymRepTools_v2::VectorSpaceSymReport> &symmetry_report,
+    bool blocked_decomposition) {
   using namespace DoFSpace_impl;
 
   try {
-    symmetry_report =
-        vector_space_sym_report_v2(dof_space, sym_info, group, calc_wedges);
+    symmetry_report = vector_space_sym_report_v2(
+        dof_space, sym_info, group, calc_wedges, blocked_decomposition);
   } catch (std::exception &e) {
     error_report_v2(dof_space, sym_info, group, calc_wedges, symmetry_report);
     CASM::err_log() << "Error constructing vector space symmetry report: "
@@ -372,7 +372,8 @@ void output_dof_space(Index state_index, std::string const &identifier,
     try {
       if (options.sym_axes) {
         dof_space = make_symmetry_adapted_dof_space_v2(
-            dof_space, sym_info, group, options.calc_wedge, report);
+            dof_space, sym_info, group, options.calc_wedge, report,
+            options.blocked_decomposition);
       }
     } catch (make_symmetry_adapted_dof_space_error &e) {
       if (output.output_status()) {
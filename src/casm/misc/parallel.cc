@@ -0,0 +1,30 @@
+#include "casm/misc/parallel.hh"
+
+#include <cstdlib>
+#include <string>
+
+namespace CASM {
+
+/// \brief Number of threads used by parallel algorithms if not specified
+///
+/// Uses, in order of priority:
+/// - the value of the environment variable "CASM_NUM_THREADS", if set and > 0
+/// - std::thread::hardware_concurrency(), if > 0
+/// - 1
+Index default_n_threads() {
+  char *_env = std::getenv("CASM_NUM_THREADS");
+  if (_env != nullptr) {
+    try {
+      Index n = std::stol(std::string(_env));
+      if (n > 0) {
+        return n;
+      }
+    } catch (std::exception &e) {
+      // fall through to hardware_concurrency
+    }
+  }
+  Index n = std::thread::hardware_concurrency();
+  return n > 0 ? n : 1;
+}
+
+}  // namespace CASM
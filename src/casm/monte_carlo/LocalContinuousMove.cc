@@ -0,0 +1,126 @@
+#include "casm/monte_carlo/LocalContinuousMove.hh"
+
+#include "casm/clex/ConfigDoF.hh"
+#include "casm/external/MersenneTwister/MersenneTwister.h"
+
+namespace CASM {
+namespace Monte {
+
+/// \brief Constructor
+///
+/// \param configdof ConfigDoF, used to determine which sites have the local
+///     continuous DoF `settings.dof` and its dimension on each sublattice
+/// \param settings Move settings
+LocalContinuousMoveProposer::LocalContinuousMoveProposer(
+    ConfigDoF const &configdof, LocalContinuousMoveSettings const &settings)
+    : m_settings(settings) {
+  if (!configdof.has_local_dof(m_settings.dof)) {
+    throw std::runtime_error(
+        "Error constructing LocalContinuousMoveProposer: no local DoF of type '" +
+        m_settings.dof + "'");
+  }
+  if (m_settings.max_step <= 0.0) {
+    throw std::runtime_error(
+        "Error constructing LocalContinuousMoveProposer: max_step must be > 0");
+  }
+  auto const &dof_values = configdof.local_dof(m_settings.dof);
+  Index n_sublat = dof_values.info().size();
+  m_volume = dof_values.values().cols() / n_sublat;
+  for (Index b = 0; b < n_sublat; ++b) {
+    Index dim = dof_values.info()[b].dim();
+    m_sublat_dim.push_back(dim);
+    if (dim == 0) {
+      continue;
+    }
+    for (Index l = b * m_volume; l < (b + 1) * m_volume; ++l) {
+      m_site_index.push_back(l);
+    }
+  }
+}
+
+/// \brief DoF dimension on a site, by linear site index
+Index LocalContinuousMoveProposer::site_dim(Index linear_site_index) const {
+  return m_sublat_dim[linear_site_index / m_volume];
+}
+
+/// \brief Choose whether the next move is an over-relaxation move
+bool LocalContinuousMoveProposer::choose_over_relaxation(
+    MTRand &mtrand) const {
+  return m_settings.over_relaxation > 0.0 &&
+         mtrand.rand53() < m_settings.over_relaxation;
+}
+
+/// \brief Choose a random site with the local continuous DoF
+Index LocalContinuousMoveProposer::propose_site(MTRand &mtrand) const {
+  if (!m_site_index.size()) {
+    throw std::runtime_error(
+        "Error in LocalContinuousMoveProposer: no sites with DoF '" +
+        m_settings.dof + "'");
+  }
+  return m_site_index[mtrand.randInt(m_site_index.size() - 1)];
+}
+
+/// \brief Propose a random step on a randomly chosen site
+///
+/// The step is drawn uniformly from the ball of radius `max_step`, in the
+/// subspace of dimension `site_dim(l)`. If `normalize`, the new value is then
+/// rescaled to unit length.
+LocalContinuousMod &LocalContinuousMoveProposer::propose(
+    LocalContinuousMod &mod, ConfigDoF const &configdof, MTRand &mtrand) const {
+  Index l = propose_site(mtrand);
+  Index dim = site_dim(l);
+  Eigen::VectorXd value =
+      configdof.local_dof(m_settings.dof).site_value(l);
+
+  // uniform in ball: random direction, radius ~ u^(1/dim)
+  Eigen::VectorXd step(dim);
+  double norm = 0.0;
+  while (norm < 1e-12) {
+    for (Index i = 0; i < dim; ++i) {
+      step(i) = mtrand.randNorm();
+    }
+    norm = step.norm();
+  }
+  double r = m_settings.max_step * std::pow(mtrand.rand53(), 1.0 / dim);
+  value.head(dim) += (r / norm) * step;
+
+  if (m_settings.normalize) {
+    double len = value.head(dim).norm();
+    if (len > 1e-12) {
+      value.head(dim) /= len;
+    }
+  }
+  mod.set(l, l / m_volume, value);
+  return mod;
+}
+
+/// \brief Propose an over-relaxation move, reflecting the current value on a
+/// site about the local field
+///
+/// \param mod Set to the proposed change
+/// \param linear_site_index Site to modify, typically from `propose_site`
+/// \param local_field The part of the energy linear in the site value, `h`,
+///     such that E(value) ~ E_0 + h.dot(value). It must not depend on the
+///     current site value for the move to be symmetric.
+/// \param configdof Current DoF values
+///
+/// The new value is `2 * (value.dot(h) / h.dot(h)) * h - value`. If the local
+/// field is zero, the value is unchanged.
+LocalContinuousMod &LocalContinuousMoveProposer::propose_over_relaxation(
+    LocalContinuousMod &mod, Index linear_site_index,
+    Eigen::VectorXd const &local_field, ConfigDoF const &configdof) const {
+  Index l = linear_site_index;
+  Index dim = site_dim(l);
+  Eigen::VectorXd value =
+      configdof.local_dof(m_settings.dof).site_value(l);
+  Eigen::VectorXd h = local_field.head(dim);
+  double hh = h.dot(h);
+  if (hh > 1e-24) {
+    value.head(dim) = 2.0 * (value.head(dim).dot(h) / hh) * h - value.head(dim);
+  }
+  mod.set(l, l / m_volume, value);
+  return mod;
+}
+
+}  // namespace Monte
+}  // namespace CASM
@@ -1,6 +1,7 @@
 #include "casm/casm_io/dataformatter/DataFormatter_impl.hh"
 #include "casm/casm_io/dataformatter/FormattedDataFile_impl.hh"
 #include "casm/database/ConfigDatabase.hh"
+#include "casm/database/ConfigDatabaseTools.hh"
 #include "casm/database/ScelDatabase.hh"
 #include "casm/monte_carlo/MonteCarloEnum_impl.hh"
 #include "casm/monte_carlo/canonical/CanonicalSettings.hh"
@@ -99,9 +100,25 @@ void MonteCarloEnum::save_configs(bool dry_run) {
 
   // transform hall of fame configurations so that they fill the canonical
   // equivalent supercell, and add to project
+  std::vector<Configuration> configurations;
+  for (const auto &val : halloffame()) {
+    configurations.push_back(val.second);
+  }
+  std::vector<ConfigInsertResult> insert_results =
+      DB::make_canonical_and_insert(
+          configurations, primclex().db<Supercell>(),
+          primclex().db<Configuration>(), save_primitive_only());
+
+  Index i = 0;
   for (const auto &val : halloffame()) {
     double score = val.first;
-    auto insert_res = val.second.insert(save_primitive_only());
+    auto const &insert_res = insert_results[i++];
+    if (insert_res.insert_primitive) {
+      insert_res.primitive_it->supercell().set_primclex(&primclex());
+    }
+    if (insert_res.insert_canonical) {
+      insert_res.canonical_it->supercell().set_primclex(&primclex());
+    }
 
     // store config source info
     jsonParser json_src;
@@ -1,7 +1,11 @@
 #include "casm/monte_carlo/MonteCorrelations.hh"
 
+#include "casm/clex/ClexulatorContext.hh"
 #include "casm/clex/Clexulator.hh"
 #include "casm/clex/ConfigCorrelations.hh"
+#include "casm/clex/ConfigDoF.hh"
+#include "casm/clex/ECIContainer.hh"
+#include "casm/misc/algorithm.hh"
 #include "casm/monte_carlo/Conversions.hh"
 #include "casm/monte_carlo/OccLocation.hh"
 
@@ -67,5 +71,79 @@ void restricted_delta_corr(Eigen::VectorXd &dcorr, OccEvent const &occ_event,
   }
 }
 
+/// \brief Sets change in (extensive) correlations due to a local continuous
+/// DoF change, restricted to specified correlations
+///
+/// \param dcorr, Eigen::VectorXd of change in correlations. Will be set to
+///     size `context.corr_size()` if necessary. Only elements corresponding to
+///     indices in `correlations_indices` will be modified.
+/// \param local_continuous_mod Proposed change
+/// \param dof_key Local continuous DoF type being changed
+/// \param configdof Current DoF values. Not modified, the proposed value is
+///     evaluated in the context's copy of the neighborhood DoF values.
+/// \param supercell_neighbor_list Supercell neighbor list
+/// \param context Per-thread context used to evaluate the Clexulator. Only
+///     the point correlations of the modified site are evaluated.
+///
+void restricted_delta_corr(Eigen::VectorXd &dcorr,
+                           LocalContinuousMod const &local_continuous_mod,
+                           DoFKey const &dof_key, ConfigDoF const &configdof,
+                           SuperNeighborList const &supercell_neighbor_list,
+                           ClexulatorContext &context,
+                           unsigned int const *corr_indices_begin,
+                           unsigned int const *corr_indices_end) {
+  restricted_delta_corr(dcorr, local_continuous_mod.site_index(),
+                        local_continuous_mod.to_value(), configdof,
+                        supercell_neighbor_list, configdof.local_dof(dof_key),
+                        context, corr_indices_begin, corr_indices_end);
+}
+
+/// \brief Sets the local field acting on a local continuous DoF site
+///
+/// The local field is the part of the (extensive) energy, `eci * corr`, that
+/// is linear in the value on a single site:
+/// \code
+/// field(k) = (E(value = +e_k) - E(value = -e_k)) / 2
+/// \endcode
+/// where `e_k` is the k-th unit vector in the prim DoF basis. Terms even in the
+/// site value cancel, so the result does not depend on the current site value,
+/// which is what is needed for symmetric over-relaxation moves.
+///
+/// \param field Set to the local field, with size equal to the DoF dimension
+///     on the site's sublattice
+/// \param linear_site_index Site index
+/// \param dof_key Local continuous DoF type
+/// \param configdof Current DoF values. Not modified, the trial values are
+///     evaluated in the context's copy of the neighborhood DoF values.
+/// \param supercell_neighbor_list Supercell neighbor list
+/// \param context Per-thread context used to evaluate the Clexulator
+/// \param eci ECI, only correlations with ECI are evaluated
+///
+void local_field(Eigen::VectorXd &field, Index linear_site_index,
+                 DoFKey const &dof_key, ConfigDoF const &configdof,
+                 SuperNeighborList const &supercell_neighbor_list,
+                 ClexulatorContext &context, ECIContainer const &eci) {
+  auto const &dof_values = configdof.local_dof(dof_key);
+  Index volume = dof_values.values().cols() / dof_values.info().size();
+  Index dim = dof_values.info()[linear_site_index / volume].dim();
+  Eigen::VectorXd value = dof_values.site_value(linear_site_index);
+  field.resize(dim);
+
+  Eigen::VectorXd dcorr_plus;
+  Eigen::VectorXd dcorr_minus;
+  for (Index k = 0; k < dim; ++k) {
+    value.setZero();
+    value(k) = 1.0;
+    restricted_delta_corr(dcorr_plus, linear_site_index, value, configdof,
+                          supercell_neighbor_list, dof_values, context,
+                          eci.index().data(), end_ptr(eci.index()));
+    value(k) = -1.0;
+    restricted_delta_corr(dcorr_minus, linear_site_index, value, configdof,
+                          supercell_neighbor_list, dof_values, context,
+                          eci.index().data(), end_ptr(eci.index()));
+    field(k) = 0.5 * (eci * dcorr_plus.data() - eci * dcorr_minus.data());
+  }
+}
+
 }  // namespace Monte
 }  // namespace CASM
@@ -98,11 +98,35 @@ Canonical::Canonical(const PrimClex &primclex,
   _log() << std::pair<const OccCandidateList &, const Conversions &>(m_cand,
                                                                      m_convert)
          << std::endl;
+
+  auto local_continuous_move_settings =
+      settings.make_local_continuous_move_settings();
+  if (local_continuous_move_settings.has_value()) {
+    m_local_continuous = notstd::make_unique<LocalContinuousMoveProposer>(
+        configdof(), *local_continuous_move_settings);
+    m_context = notstd::make_unique<ClexulatorContext>(_clexulator());
+
+    auto const &s = m_local_continuous->settings();
+    _log().custom("Local continuous moves");
+    _log() << "dof: " << s.dof << "\n"
+           << "sites: " << m_local_continuous->size() << "\n"
+           << "probability: " << s.probability << "\n"
+           << "max_step: " << s.max_step << "\n"
+           << "normalize: " << std::boolalpha << s.normalize << "\n"
+           << "over_relaxation: " << s.over_relaxation << "\n"
+           << std::endl;
+  }
 }
 
 /// \brief Return number of steps per pass. Equals number of sites with variable
-/// occupation.
-Index Canonical::steps_per_pass() const { return m_occ_loc.size(); }
+/// occupation, plus the number of sites with the local continuous DoF if local
+/// continuous moves are enabled.
+Index Canonical::steps_per_pass() const {
+  if (m_local_continuous) {
+    return m_occ_loc.size() + m_local_continuous->size();
+  }
+  return m_occ_loc.size();
+}
 
 /// \brief Return current conditions
 const Canonical::CondType &Canonical::conditions() const { return m_condition; }
@@ -210,7 +234,20 @@ void Canonical::set_state(const CanonicalConditions &new_conditions,
 /// picks what occupant it changes to. Then calculates delta properties
 /// associated with that change.
 ///
+/// If local continuous moves are enabled, then with probability
+/// `local_continuous_moves/probability` (or always, if there are no canonical
+/// swaps) a local continuous DoF change is proposed instead.
+///
 const Canonical::EventType &Canonical::propose() {
+  if (m_local_continuous &&
+      (!m_cand.canonical_swap().size() ||
+       _mtrand().rand53() < m_local_continuous->settings().probability)) {
+    _propose_local_continuous(m_event);
+    _update_deltas(m_event);
+    return m_event;
+  }
+
+  m_event.set_is_local_continuous(false);
   m_occ_loc.propose_canonical(m_event.occ_event(), m_cand.canonical_swap(),
                               _mtrand());
 
@@ -245,6 +282,45 @@ const Canonical::EventType &Canonical::propose() {
   return m_event;
 }
 
+/// \brief Propose a local continuous DoF change
+///
+/// Proposes either a random step or, with probability
+/// `local_continuous_moves/over_relaxation`, an over-relaxation move that
+/// reflects the site value about the local field.
+void Canonical::_propose_local_continuous(CanonicalEvent &event) {
+  LocalContinuousMoveProposer const &proposer = *m_local_continuous;
+  event.set_is_local_continuous(true);
+  if (proposer.choose_over_relaxation(_mtrand())) {
+    Index l = proposer.propose_site(_mtrand());
+    Eigen::VectorXd field;
+    local_field(field, l, proposer.settings().dof, configdof(),
+                supercell().nlist(), *m_context, _eci());
+    proposer.propose_over_relaxation(event.local_continuous_mod(), l, field,
+                                     configdof());
+  } else {
+    proposer.propose(event.local_continuous_mod(), configdof(), _mtrand());
+  }
+
+  if (debug()) {
+    LocalContinuousMod const &mod = event.local_continuous_mod();
+    Index l = mod.site_index();
+    _log().custom("Propose event");
+    _log() << "- Mutating site (linear index): " << l << "\n"
+           << "  Mutating site (b, i, j, k): " << m_convert.l_to_bijk(l) << "\n"
+           << "  Current value: "
+           << configdof()
+                  .local_dof(proposer.settings().dof)
+                  .site_value(l)
+                  .transpose()
+           << "\n"
+           << "  Proposed value: " << mod.to_value().transpose() << "\n";
+    _log() << "\n";
+    _log() << "  beta: " << m_condition.beta() << "\n"
+           << "  T: " << m_condition.temperature() << std::endl
+           << std::endl;
+  }
+}
+
 /// \brief Based on a random number, decide if the change in energy from the
 /// proposed event is low enough to be accepted.
 bool Canonical::check(const CanonicalEvent &event) {
@@ -283,8 +359,15 @@ void Canonical::accept(const EventType &event) {
     _log() << std::endl;
   }
 
-  // Apply occ mods && update occ locations table
-  m_occ_loc.apply(event.occ_event(), _configdof());
+  if (event.is_local_continuous()) {
+    LocalContinuousMod const &mod = event.local_continuous_mod();
+    _configdof()
+        .local_dof(m_local_continuous->settings().dof)
+        .site_value(mod.site_index()) = mod.to_value();
+  } else {
+    // Apply occ mods && update occ locations table
+    m_occ_loc.apply(event.occ_event(), _configdof());
+  }
 
   // Next update all properties that changed from the event
   _formation_energy() += event.dEf() / supercell().volume();
@@ -428,9 +511,16 @@ double Canonical::potential_energy(const Configuration &config) const {
 
 /// \brief Calculate delta correlations for an event
 void Canonical::_set_dCorr(CanonicalEvent &event) const {
-  restricted_delta_corr(event.dCorr(), event.occ_event(), m_convert,
-                        configdof(), supercell().nlist(), _clexulator(),
-                        _eci().index().data(), end_ptr(_eci().index()));
+  if (event.is_local_continuous()) {
+    restricted_delta_corr(event.dCorr(), event.local_continuous_mod(),
+                          m_local_continuous->settings().dof, configdof(),
+                          supercell().nlist(), *m_context,
+                          _eci().index().data(), end_ptr(_eci().index()));
+  } else {
+    restricted_delta_corr(event.dCorr(), event.occ_event(), m_convert,
+                          configdof(), supercell().nlist(), _clexulator(),
+                          _eci().index().data(), end_ptr(_eci().index()));
+  }
 
   if (debug()) {
     _print_correlations(event.dCorr(), "delta correlations", "dCorr");
@@ -481,8 +571,19 @@ void Canonical::_update_deltas(CanonicalEvent &event) const {
 
   // ---- set deta (intensive) -------------
   if (m_order_parameter != nullptr) {
-    event.deta() = m_order_parameter->occ_delta(
-        event.occ_event().linear_site_index, event.occ_event().new_occ);
+    if (event.is_local_continuous()) {
+      if (m_order_parameter->dof_space().dof_key() !=
+          m_local_continuous->settings().dof) {
+        event.deta().setZero(this->eta().size());
+      } else {
+        event.deta() = m_order_parameter->local_delta(
+            event.local_continuous_mod().site_index(),
+            event.local_continuous_mod().to_value());
+      }
+    } else {
+      event.deta() = m_order_parameter->occ_delta(
+          event.occ_event().linear_site_index, event.occ_event().new_occ);
+    }
   }
 
   if (debug()) {
@@ -56,5 +56,26 @@ OccEvent &CanonicalEvent::occ_event() { return m_occ_event; }
 /// \brief const Access the data describing this event
 const OccEvent &CanonicalEvent::occ_event() const { return m_occ_event; }
 
+/// \brief True if this event is a local continuous DoF change, false if it is
+/// an occupation change
+bool CanonicalEvent::is_local_continuous() const {
+  return m_is_local_continuous;
+}
+
+/// \brief Set whether this event is a local continuous DoF change
+void CanonicalEvent::set_is_local_continuous(bool _is_local_continuous) {
+  m_is_local_continuous = _is_local_continuous;
+}
+
+/// \brief Access the local continuous DoF change
+LocalContinuousMod &CanonicalEvent::local_continuous_mod() {
+  return m_local_continuous_mod;
+}
+
+/// \brief const Access the local continuous DoF change
+const LocalContinuousMod &CanonicalEvent::local_continuous_mod() const {
+  return m_local_continuous_mod;
+}
+
 }  // namespace Monte
 }  // namespace CASM
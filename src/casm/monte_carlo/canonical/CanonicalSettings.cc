@@ -2,6 +2,7 @@
 
 #include "casm/casm_io/container/json_io.hh"
 #include "casm/enumerator/io/json/DoFSpace.hh"
+#include "casm/monte_carlo/io/json/LocalContinuousMove_json_io.hh"
 #include "casm/monte_carlo/canonical/CanonicalConditions.hh"
 #include "casm/monte_carlo/canonical/CanonicalIO.hh"
 #include "casm/monte_carlo/canonical/CanonicalSettings_impl.hh"
@@ -171,6 +172,22 @@ CanonicalSettings::make_order_parameter_subspaces() const {
   return std::make_shared<std::vector<std::vector<int>>>(value);
 }
 
+/// \brief Make local continuous DoF move settings, if any
+///
+/// Reads optional ["model"]["local_continuous_moves"]. If present, Monte Carlo
+/// events are a mix of occupation swaps and local continuous DoF changes. See
+/// `from_json(LocalContinuousMoveSettings &, jsonParser const &)` for the
+/// expected format.
+std::optional<LocalContinuousMoveSettings>
+CanonicalSettings::make_local_continuous_move_settings() const {
+  if (!_is_setting("model", "local_continuous_moves")) {
+    return std::nullopt;
+  }
+  LocalContinuousMoveSettings value;
+  from_json(value, (*this)["model"]["local_continuous_moves"]);
+  return value;
+}
+
 // --- Sampler settings ---------------------
 
 CanonicalConditions CanonicalSettings::_conditions(std::string name,
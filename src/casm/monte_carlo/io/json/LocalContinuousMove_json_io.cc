@@ -0,0 +1,44 @@
+#include "casm/monte_carlo/io/json/LocalContinuousMove_json_io.hh"
+
+#include "casm/casm_io/json/jsonParser.hh"
+#include "casm/monte_carlo/LocalContinuousMove.hh"
+
+namespace CASM {
+namespace Monte {
+
+jsonParser &to_json(LocalContinuousMoveSettings const &settings,
+                    jsonParser &json) {
+  json.put_obj();
+  json["dof"] = settings.dof;
+  json["probability"] = settings.probability;
+  json["max_step"] = settings.max_step;
+  json["normalize"] = settings.normalize;
+  json["over_relaxation"] = settings.over_relaxation;
+  return json;
+}
+
+/// \brief Read LocalContinuousMoveSettings
+///
+/// Expected format (all but "dof" optional):
+/// \code
+/// {
+///   "dof": "disp",           // local continuous DoF type
+///   "probability": 0.5,      // probability of a local continuous move,
+///                            //   versus an occupation move, if both are
+///                            //   possible
+///   "max_step": 0.1,         // maximum step length (prim DoF basis)
+///   "normalize": false,      // keep site values at unit length (spins)
+///   "over_relaxation": 0.0   // fraction of local continuous moves that are
+///                            //   over-relaxation moves
+/// }
+/// \endcode
+void from_json(LocalContinuousMoveSettings &settings, jsonParser const &json) {
+  from_json(settings.dof, json["dof"]);
+  json.get_else(settings.probability, "probability", 0.5);
+  json.get_else(settings.max_step, "max_step", 0.1);
+  json.get_else(settings.normalize, "normalize", false);
+  json.get_else(settings.over_relaxation, "over_relaxation", 0.0);
+}
+
+}  // namespace Monte
+}  // namespace CASM
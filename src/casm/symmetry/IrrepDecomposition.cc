@@ -1,5 +1,6 @@
 #include "casm/symmetry/IrrepDecomposition.hh"
 
+#include <algorithm>
 #include <iostream>
 
 #include "casm/misc/CASM_Eigen_math.hh"
@@ -9,6 +10,47 @@ namespace CASM {
 
 namespace SymRepTools_v2 {
 
+namespace {
+
+/// Order irreps as `irrep_decomposition` does: identity first, then by
+/// dimension, then 'gerade' before 'ungerade', then by characters
+bool irrep_characters_less(IrrepInfo const &A, IrrepInfo const &B) {
+  auto is_identity = [](Eigen::VectorXcd const &characters) {
+    std::complex<double> size{double(characters.size()), 0.};
+    return almost_equal(characters(0), std::complex<double>(1., 0.), TOL) &&
+           almost_equal(characters.sum(), size, TOL);
+  };
+  auto is_gerade = [](Eigen::VectorXcd const &characters) {
+    return almost_equal(characters(0), characters(characters.size() - 1),
+                        TOL);
+  };
+
+  bool A_is_identity = is_identity(A.characters);
+  bool B_is_identity = is_identity(B.characters);
+  if (A_is_identity != B_is_identity) {
+    return A_is_identity;
+  }
+  if (!almost_equal(A.characters(0), B.characters(0), TOL)) {
+    return A.characters(0).real() < B.characters(0).real();
+  }
+  bool A_is_gerade = is_gerade(A.characters);
+  bool B_is_gerade = is_gerade(B.characters);
+  if (A_is_gerade != B_is_gerade) {
+    return A_is_gerade;
+  }
+  for (Index i = 0; i < A.characters.size(); ++i) {
+    if (!almost_equal(A.characters(i).real(), B.characters(i).real(), TOL))
+      return A.characters(i).real() > B.characters(i).real();
+  }
+  for (Index i = 0; i < A.characters.size(); ++i) {
+    if (!almost_equal(A.characters(i).imag(), B.characters(i).imag(), TOL))
+      return A.characters(i).imag() > B.characters(i).imag();
+  }
+  return false;
+}
+
+}  // namespace
+
 IrrepInfo::IrrepInfo(Eigen::MatrixXcd _trans_mat, Eigen::VectorXcd _characters)
     : trans_mat(std::move(_trans_mat)),
       characters(std::move(_characters)),
@@ -86,56 +128,120 @@ IrrepDecomposition::IrrepDecomposition(
       all_subgroups(_all_subgroups) {
   using namespace IrrepDecompositionImpl;
 
-  Index dim = fullspace_rep[0].rows();
-
   // 1) Expand subspace by application of group, and orthonormalization
   subspace = make_invariant_space(fullspace_rep, head_group, init_subspace);
 
-  // 2) Perform irrep_decomposition
-  // In some cases the `irrep_decomposition` method does not find all irreps.
-  // As long as it finds at least one, this loop will try again in the remaining
-  // subspace.
-  Eigen::MatrixXd subspace_i = subspace;
-  Eigen::MatrixXd finished_subspace = make_kernel(subspace);
-  while (finished_subspace.cols() != dim) {
-    // Irreps are found in a subspace specified via the subspace matrix rep
-    MatrixRep subspace_rep_i = make_subspace_rep(fullspace_rep, subspace_i);
-    std::vector<IrrepInfo> subspace_irreps_i =
-        irrep_decomposition(subspace_rep_i, head_group, allow_complex);
-
-    // If not irreps found in the subspace, this method has failed
-    // If the irreps do not span the whole subspace, we'll try again
-    if (subspace_irreps_i.size() == 0) {
-      std::stringstream msg;
-      msg << "Error in IrrepDecomposition: failed to find all irreps";
-      throw std::runtime_error(msg.str());
-    }
+  // 2) Perform irrep_decomposition and symmetrize the irreps
+  irreps = make_symmetrized_irreps(fullspace_rep, head_group, subspace,
+                                   cyclic_subgroups, all_subgroups,
+                                   allow_complex);
+
+  // 3) Combine to form symmetry adapted subspace
+  symmetry_adapted_subspace = full_trans_mat(irreps).adjoint();
+}
+
+/// IrrepDecomposition constructor, using a sparse representation
+///
+/// \param rep Full space sparse matrix representation
+///     (rep[0].rows() == init_subspace.rows()). Must be orthogonal.
+/// \param head_group Group for which the irreps are to be found
+/// \param translation_group Subgroup of head_group consisting of pure
+///     translations. May be empty.
+/// \param init_subspace Input subspace in which irreps are to be found. Will be
+///     expanded (column space increased) by application of rep and
+///     orthogonalization to form an invariant subspace (i.e. column space
+///     dimension is not increased by application of elements in head_group)
+/// \param _cyclic_subgroups Cyclic subgroups of head_group. Cyclic subgropus
+///     are those formed by repeated application of a single element. Used for
+///     symmetrization of the irrep subspaces.
+/// \param _all_subgroups All subgroups of head_group. Used for
+///     symmetrization of the irrep subspaces if symmetrization using
+///     _cyclic_subgroups fails.
+/// \param allow_complex If true, all irreps may be complex-valued, if false,
+///     complex irreps are combined to form real representations
+///
+/// This finds the same irreps, with the same multiplicities and spanning the
+/// same subspace, as the dense constructor, but avoids decomposing the full
+/// space at once. (Repeated irreps may be spanned by different bases.) The
+/// invariant subspace is first split into smaller invariant subspaces (see
+/// `make_blocked_subspaces`): by blocks of coordinates that are not mixed by
+/// symmetry (i.e. orbits of sites, for local DoF), and then by the translation
+/// invariant part of each block. Irreps are found and symmetrized in each of
+/// those subspaces separately, using a representation of dimension equal to the
+/// subspace dimension. For large supercells, this scales with the number of
+/// site orbits, rather than with the square of the full space dimension.
+///
+/// Irreps are then sorted as by `irrep_decomposition`: identity first, then by
+/// dimension, and repeated irreps (with equal character vectors) are
+/// sequential and distinguished by IrrepInfo::index.
+IrrepDecomposition::IrrepDecomposition(
+    SparseMatrixRep const &_fullspace_rep, GroupIndices const &_head_group,
+    GroupIndices const &_translation_group,
+    Eigen::MatrixXd const &init_subspace,
+    GroupIndicesOrbitVector const &_cyclic_subgroups,
+    GroupIndicesOrbitVector const &_all_subgroups, bool allow_complex)
+    : sparse_fullspace_rep(_fullspace_rep),
+      head_group(_head_group),
+      cyclic_subgroups(_cyclic_subgroups),
+      all_subgroups(_all_subgroups) {
+  using namespace IrrepDecompositionImpl;
 
-    // Symmetrize all the irreps that were found
-    std::vector<IrrepInfo> symmetrized_subspace_irreps_i =
-        symmetrize_irreps(subspace_rep_i, head_group, subspace_irreps_i,
-                          cyclic_subgroups, all_subgroups);
-    // Transform the irreps trans_mat to act on vectors in the fullspace
-    std::vector<IrrepInfo> symmetrized_fullspace_irreps_i =
-        make_fullspace_irreps(symmetrized_subspace_irreps_i, subspace_i);
-    // Save the new fullspace irreps
-    for (auto const irrep : symmetrized_fullspace_irreps_i) {
+  // 1) Expand subspace by application of group, and orthonormalization
+  subspace = make_invariant_space(_fullspace_rep, head_group, init_subspace);
+
+  // 2) Perform irrep_decomposition in each invariant block of the subspace
+  std::vector<Eigen::MatrixXd> blocked_subspaces = make_blocked_subspaces(
+      _fullspace_rep, head_group, _translation_group, subspace);
+  for (Eigen::MatrixXd const &blocked_subspace : blocked_subspaces) {
+    MatrixRep blocked_rep = make_subspace_rep(_fullspace_rep, blocked_subspace);
+    Eigen::MatrixXd blocked_identity =
+        Eigen::MatrixXd::Identity(blocked_subspace.cols(),
+                                  blocked_subspace.cols());
+    std::vector<IrrepInfo> blocked_irreps =
+        make_symmetrized_irreps(blocked_rep, head_group, blocked_identity,
+                                cyclic_subgroups, all_subgroups, allow_complex);
+    for (auto const &irrep :
+         make_fullspace_irreps(blocked_irreps, blocked_subspace)) {
       irreps.push_back(irrep);
     }
+  }
 
-    // Combine the irrep spaces and add to finished_subspace
-    Eigen::MatrixXd finished_subspace_i =
-        full_trans_mat(symmetrized_fullspace_irreps_i).adjoint();
-    finished_subspace = extend(finished_subspace, finished_subspace_i);
-
-    // If not all irreps have been found, try again in remaining space
-    subspace_i = make_kernel(finished_subspace);
+  // 3) Sort irreps found in different blocks, and re-index repeated irreps
+  std::stable_sort(irreps.begin(), irreps.end(), irrep_characters_less);
+  for (Index i = 0; i < irreps.size(); ++i) {
+    irreps[i].index = 0;
+    if (i > 0 &&
+        almost_equal(irreps[i].characters, irreps[i - 1].characters, TOL)) {
+      irreps[i].index = irreps[i - 1].index + 1;
+    }
   }
 
-  // 3) Combine to form symmetry adapted subspace
+  // 4) Combine to form symmetry adapted subspace
   symmetry_adapted_subspace = full_trans_mat(irreps).adjoint();
 }
 
+/// Dense full space matrix representation of element `element_index`
+///
+/// If constructed from a sparse representation, the dense matrix is made on
+/// each call.
+Eigen::MatrixXd IrrepDecomposition::fullspace_matrix(
+    Index element_index) const {
+  if (!sparse_fullspace_rep.empty()) {
+    return Eigen::MatrixXd(sparse_fullspace_rep[element_index]);
+  }
+  return fullspace_rep[element_index];
+}
+
+/// Apply the full space matrix representation of element `element_index`
+/// to the columns of `vectors`
+Eigen::MatrixXd IrrepDecomposition::apply(
+    Index element_index, Eigen::MatrixXd const &vectors) const {
+  if (!sparse_fullspace_rep.empty()) {
+    return sparse_fullspace_rep[element_index] * vectors;
+  }
+  return fullspace_rep[element_index] * vectors;
+}
+
 }  // namespace SymRepTools_v2
 
 }  // namespace CASM
@@ -168,4 +274,37 @@ SymRepTools_v2::IrrepDecomposition make_irrep_decomposition(
   return irrep_decomposition;
 }
 
+/// Make an IrrepDecompotion using a sparse representation of CASM::SymGroup
+///
+/// \param rep Sparse, orthogonal, matrix representation, where rep[i] is the
+///     matrix for the element with `op.index() == i` in the master group of
+///     head_group
+/// \param head_group Group for which irreps are to be found. Operations that
+///     are pure translations are used to split the decomposition into smaller
+///     blocks.
+/// \param init_subspace Input subspace in which irreps are to be found
+/// \param allow_complex If true, all irreps may be complex-valued, if false,
+///     complex irreps are combined to form real representations
+SymRepTools_v2::IrrepDecomposition make_irrep_decomposition(
+    SymRepTools_v2::SparseMatrixRep const &rep, SymGroup const &head_group,
+    Eigen::MatrixXd const &init_subspace, bool allow_complex) {
+  SymRepTools_v2::GroupIndices head_group_indices;
+  SymRepTools_v2::GroupIndices translation_group_indices;
+  for (SymOp const &op : head_group) {
+    head_group_indices.insert(op.index());
+    if (!op.time_reversal() && op.matrix().isIdentity(TOL)) {
+      translation_group_indices.insert(op.index());
+    }
+  }
+  SymRepTools_v2::GroupIndicesOrbitVector cyclic_subgroups =
+      head_group.small_subgroups();
+  SymRepTools_v2::GroupIndicesOrbitVector all_subgroups =
+      head_group.subgroups();
+  SymRepTools_v2::IrrepDecomposition irrep_decomposition{
+      rep,           head_group_indices, translation_group_indices,
+      init_subspace, cyclic_subgroups,   all_subgroups,
+      allow_complex};
+  return irrep_decomposition;
+}
+
 }  // namespace CASM
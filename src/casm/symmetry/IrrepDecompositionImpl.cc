@@ -1,6 +1,10 @@
 #include "casm/symmetry/IrrepDecompositionImpl.hh"
 
+#include <cmath>
 #include <iostream>
+#include <map>
+#include <numeric>
+#include <sstream>
 
 #include "casm/misc/CASM_Eigen_math.hh"
 #include "casm/misc/CASM_math.hh"
@@ -845,6 +849,308 @@ std::vector<IrrepInfo> symmetrize_irreps(
   return symmetrized_irreps;
 }
 
+/// \brief Find symmetrized irreps that span an invariant subspace
+///
+/// \param rep Matrix representation of head_group
+/// \param head_group Group for which the irreps are to be found
+/// \param subspace Orthonormal basis for a subspace, invariant under
+///     head_group, in which to find irreps (subspace.rows() == rep[0].rows())
+/// \param cyclic_subgroups, all_subgroups Subgroups of head_group, used for
+///     symmetrization
+/// \param allow_complex If true, all irreps may be complex-valued, if false,
+///     complex irreps are combined to form real representations
+///
+/// \result Symmetrized irreps, which act on vectors in the space of `rep`
+/// (irreps[i].vector_dim() == rep[0].rows()) and together span `subspace`.
+///
+/// In some cases the `irrep_decomposition` method does not find all irreps.
+/// As long as it finds at least one, this tries again in the remaining
+/// subspace.
+std::vector<IrrepInfo> make_symmetrized_irreps(
+    MatrixRep const &rep, GroupIndices const &head_group,
+    Eigen::MatrixXd const &subspace,
+    GroupIndicesOrbitVector const &cyclic_subgroups,
+    GroupIndicesOrbitVector const &all_subgroups, bool allow_complex) {
+  std::vector<IrrepInfo> irreps;
+  Index dim = subspace.rows();
+  Eigen::MatrixXd subspace_i = subspace;
+  Eigen::MatrixXd finished_subspace = make_kernel(subspace);
+  while (finished_subspace.cols() != dim) {
+    // Irreps are found in a subspace specified via the subspace matrix rep
+    MatrixRep subspace_rep_i = make_subspace_rep(rep, subspace_i);
+    std::vector<IrrepInfo> subspace_irreps_i =
+        irrep_decomposition(subspace_rep_i, head_group, allow_complex);
+
+    // If not irreps found in the subspace, this method has failed
+    // If the irreps do not span the whole subspace, we'll try again
+    if (subspace_irreps_i.size() == 0) {
+      std::stringstream msg;
+      msg << "Error in IrrepDecomposition: failed to find all irreps";
+      throw std::runtime_error(msg.str());
+    }
+
+    // Symmetrize all the irreps that were found
+    std::vector<IrrepInfo> symmetrized_subspace_irreps_i =
+        symmetrize_irreps(subspace_rep_i, head_group, subspace_irreps_i,
+                          cyclic_subgroups, all_subgroups);
+    // Transform the irreps trans_mat to act on vectors in the fullspace
+    std::vector<IrrepInfo> symmetrized_fullspace_irreps_i =
+        make_fullspace_irreps(symmetrized_subspace_irreps_i, subspace_i);
+    // Save the new fullspace irreps
+    for (auto const &irrep : symmetrized_fullspace_irreps_i) {
+      irreps.push_back(irrep);
+    }
+
+    // Combine the irrep spaces and add to finished_subspace
+    Eigen::MatrixXd finished_subspace_i =
+        full_trans_mat(symmetrized_fullspace_irreps_i).adjoint();
+    finished_subspace = extend(finished_subspace, finished_subspace_i);
+
+    // If not all irreps have been found, try again in remaining space
+    subspace_i = make_kernel(finished_subspace);
+  }
+  return irreps;
+}
+
+/// Orthonormal basis for the null space of `matrix`
+///
+/// Unlike `make_kernel`, this does not assume `matrix` has full rank.
+Eigen::MatrixXd make_null_space(Eigen::MatrixXd const &matrix) {
+  Eigen::ColPivHouseholderQR<Eigen::MatrixXd> colqr(matrix.transpose());
+  colqr.setThreshold(TOL);
+  Eigen::MatrixXd Q = colqr.householderQ();
+  return Q.rightCols(matrix.cols() - colqr.rank());
+}
+
+/// Expand subspace by application of group, and orthogonalize
+///
+/// Equivalent to the dense `make_invariant_space`, but the images of the
+/// subspace are added one group element at a time, so memory is proportional
+/// to the size of the result rather than to the size of the group.
+Eigen::MatrixXd make_invariant_space(SparseMatrixRep const &rep,
+                                     GroupIndices const &head_group,
+                                     Eigen::MatrixXd const &subspace) {
+  Index dim = subspace.rows();
+  if (subspace.cols() == dim && subspace.isIdentity()) {
+    return subspace;
+  }
+
+  Eigen::ColPivHouseholderQR<Eigen::MatrixXd> colqr(subspace);
+  colqr.setThreshold(TOL);
+  Eigen::MatrixXd Q = colqr.householderQ();
+  Eigen::MatrixXd result = Q.leftCols(colqr.rank());
+
+  // repeat until no element of head_group extends the space
+  bool extended = true;
+  while (extended && result.cols() != dim) {
+    extended = false;
+    for (Index element_index : head_group) {
+      Eigen::MatrixXd image = rep[element_index] * result;
+      image -= result * (result.transpose() * image);
+      if (image.norm() < TOL) {
+        continue;
+      }
+      Eigen::MatrixXd symspace(dim, result.cols() + image.cols());
+      symspace << result, image;
+      colqr.compute(symspace);
+      if (colqr.rank() > result.cols()) {
+        Q = colqr.householderQ();
+        result = Q.leftCols(colqr.rank());
+        extended = true;
+      }
+    }
+  }
+  return result;
+}
+
+// Create `subspace_rep`, a transformed copy of `fullspace_rep` that acts
+// on coordinates with `subspace` columns as a basis. Matrices in
+// `subspace_rep` are shape (subspace.cols() x subspace.cols())
+MatrixRep make_subspace_rep(SparseMatrixRep const &fullspace_rep,
+                            Eigen::MatrixXd const &subspace) {
+  Eigen::MatrixXd trans_mat = subspace.transpose();
+  Eigen::MatrixXd rightmat =
+      subspace.jacobiSvd(Eigen::ComputeThinU | Eigen::ComputeThinV)
+          .solve(Eigen::MatrixXd::Identity(trans_mat.cols(), trans_mat.cols()))
+          .transpose();
+  MatrixRep subspace_rep;
+  for (Index i = 0; i < fullspace_rep.size(); ++i) {
+    Eigen::MatrixXd image = fullspace_rep[i] * rightmat;
+    subspace_rep.push_back(trans_mat * image);
+  }
+  return subspace_rep;
+}
+
+/// \brief Find sets of full space coordinates that are not mixed by any
+/// element of head_group
+///
+/// Coordinates i and j are in the same block if, for any element of
+/// head_group, rep[element](i, j) is non-zero. Each block spans a subspace that
+/// is invariant under head_group. For a collective local DoF representation,
+/// blocks are the DoF of orbits of equivalent sites.
+///
+/// \result Blocks of coordinates, each in increasing order, with blocks sorted
+///     by their first coordinate
+std::vector<std::vector<Index>> make_invariant_blocks(
+    SparseMatrixRep const &rep, GroupIndices const &head_group) {
+  Index dim = rep.size() ? rep[0].rows() : 0;
+
+  // union-find on coordinates, root is lowest coordinate in set
+  std::vector<Index> parent(dim);
+  std::iota(parent.begin(), parent.end(), 0);
+  auto find_root = [&](Index i) {
+    while (parent[i] != i) {
+      parent[i] = parent[parent[i]];
+      i = parent[i];
+    }
+    return i;
+  };
+
+  for (Index element_index : head_group) {
+    auto const &matrix = rep[element_index];
+    for (Index col = 0; col < matrix.outerSize(); ++col) {
+      for (Eigen::SparseMatrix<double>::InnerIterator it(matrix, col); it;
+           ++it) {
+        if (std::abs(it.value()) < TOL) {
+          continue;
+        }
+        Index a = find_root(it.row());
+        Index b = find_root(col);
+        if (a != b) {
+          parent[std::max(a, b)] = std::min(a, b);
+        }
+      }
+    }
+  }
+
+  std::vector<std::vector<Index>> blocks;
+  std::map<Index, Index> root_to_block;
+  for (Index i = 0; i < dim; ++i) {
+    Index root = find_root(i);
+    auto it = root_to_block.find(root);
+    if (it == root_to_block.end()) {
+      it = root_to_block.emplace(root, blocks.size()).first;
+      blocks.emplace_back();
+    }
+    blocks[it->second].push_back(i);
+  }
+  return blocks;
+}
+
+/// \brief Split an invariant subspace into smaller orthogonal invariant
+/// subspaces, using invariant blocks and translations
+///
+/// \param rep Sparse, orthogonal, matrix representation of head_group
+/// \param head_group Group for which `subspace` is invariant
+/// \param translation_group Normal subgroup of head_group of pure
+///     translations. May be empty.
+/// \param subspace Orthonormal basis for a subspace invariant under
+///     head_group
+///
+/// The subspace is split by:
+/// 1. Invariant blocks (see `make_invariant_blocks`)
+/// 2. Within each block, the subspace invariant under translation_group and
+///    its orthogonal complement (both are invariant under head_group because
+///    translation_group is a normal subgroup)
+/// 3. The part of each of those spaces contained in `subspace`, plus any
+///    remaining part of `subspace` that mixes blocks (for example, if
+///    `subspace` excludes homogeneous modes)
+///
+/// \result Orthonormal bases, each of shape (subspace.rows() x dim_i), of
+///     mutually orthogonal invariant subspaces which together span `subspace`
+std::vector<Eigen::MatrixXd> make_blocked_subspaces(
+    SparseMatrixRep const &rep, GroupIndices const &head_group,
+    GroupIndices const &translation_group, Eigen::MatrixXd const &subspace) {
+  Index dim = subspace.rows();
+  std::vector<Eigen::MatrixXd> result;
+  if (subspace.cols() == 0) {
+    return result;
+  }
+
+  // part of the full space excluded from `subspace`
+  Eigen::MatrixXd excluded(dim, 0);
+  if (subspace.cols() != dim) {
+    excluded = make_kernel(subspace);
+  }
+
+  auto add_subspace = [&](Eigen::MatrixXd const &block_subspace) {
+    if (excluded.cols() == 0) {
+      result.push_back(block_subspace);
+      return;
+    }
+    Eigen::MatrixXd null_space =
+        make_null_space(excluded.transpose() * block_subspace);
+    if (null_space.cols()) {
+      result.push_back(block_subspace * null_space);
+    }
+  };
+
+  // position of each full space coordinate in its block
+  std::vector<Index> block_position(dim);
+  std::vector<std::vector<Index>> blocks =
+      make_invariant_blocks(rep, head_group);
+
+  for (std::vector<Index> const &block : blocks) {
+    Index block_dim = block.size();
+    Eigen::MatrixXd block_space = Eigen::MatrixXd::Zero(dim, block_dim);
+    for (Index i = 0; i < block_dim; ++i) {
+      block_space(block[i], i) = 1.0;
+      block_position[block[i]] = i;
+    }
+    if (translation_group.size() < 2) {
+      add_subspace(block_space);
+      continue;
+    }
+
+    // projector onto the translation invariant subspace of the block
+    Eigen::MatrixXd projector = Eigen::MatrixXd::Zero(block_dim, block_dim);
+    for (Index element_index : translation_group) {
+      auto const &matrix = rep[element_index];
+      for (Index col : block) {
+        for (Eigen::SparseMatrix<double>::InnerIterator it(matrix, col); it;
+             ++it) {
+          if (std::abs(it.value()) < TOL) {
+            continue;
+          }
+          projector(block_position[it.row()], block_position[col]) +=
+              it.value();
+        }
+      }
+    }
+    projector /= double(translation_group.size());
+
+    std::vector<Eigen::MatrixXd> projectors{
+        projector,
+        Eigen::MatrixXd::Identity(block_dim, block_dim) - projector};
+    for (Eigen::MatrixXd const &matrix : projectors) {
+      Eigen::ColPivHouseholderQR<Eigen::MatrixXd> colqr(matrix);
+      colqr.setThreshold(TOL);
+      if (colqr.rank() == 0) {
+        continue;
+      }
+      Eigen::MatrixXd Q = colqr.householderQ();
+      add_subspace(block_space * Q.leftCols(colqr.rank()));
+    }
+  }
+
+  // remaining part of `subspace`, which mixes blocks
+  Index found_dim = 0;
+  for (auto const &found : result) {
+    found_dim += found.cols();
+  }
+  if (found_dim != subspace.cols()) {
+    Eigen::MatrixXd all(dim, found_dim + excluded.cols());
+    Index col = 0;
+    for (auto const &found : result) {
+      all.block(0, col, dim, found.cols()) = found;
+      col += found.cols();
+    }
+    all.rightCols(excluded.cols()) = excluded;
+    result.push_back(make_null_space(all.transpose()));
+  }
+  return result;
+}
+
 }  // namespace IrrepDecompositionImpl
 
 }  // namespace SymRepTools_v2
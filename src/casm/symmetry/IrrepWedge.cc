@@ -12,10 +12,11 @@ namespace SymRepTools_v2 {
 
 namespace IrrepWedgeImpl {
 
-/// \param _rep The dimension of _rep should match the dimension of the irrep
-static IrrepWedge _wedge_from_pseudo_irrep(IrrepInfo const &irrep,
-                                           MatrixRep const &_rep,
-                                           GroupIndices const &head_group) {
+/// \param irrep_decomposition The full space dimension should match the
+///     vector dimension of the irrep
+static IrrepWedge _wedge_from_pseudo_irrep(
+    IrrepInfo const &irrep, IrrepDecomposition const &irrep_decomposition) {
+  GroupIndices const &head_group = irrep_decomposition.head_group;
   Eigen::MatrixXd t_axes = irrep.trans_mat.transpose().real();
   Eigen::MatrixXd axes = vector_space_prepare(t_axes, TOL);
   Eigen::VectorXd v = axes.col(0);
@@ -28,7 +29,7 @@ static IrrepWedge _wedge_from_pseudo_irrep(IrrepInfo const &irrep,
   for (Index i = 1; i < axes.cols(); ++i) {
     double bestproj = -1;
     for (Index element_index : head_group) {
-      v = _rep[element_index] * axes.col(0);
+      v = irrep_decomposition.apply(element_index, axes.col(0));
       // std::cout << "v: " << v.transpose() << std::endl;
       bool skip_op = false;
       for (Index j = 0; j < i; ++j) {
@@ -109,8 +110,6 @@ SubWedge make_dummy_subwedge(Eigen::MatrixXd const &axes) {
 std::vector<IrrepWedge> make_irrep_wedges(
     IrrepDecomposition const &irrep_decomposition) {
   std::vector<IrrepInfo> const &irreps = irrep_decomposition.irreps;
-  MatrixRep const &fullspace_rep = irrep_decomposition.fullspace_rep;
-  GroupIndices const &head_group = irrep_decomposition.head_group;
 
   std::vector<IrrepWedge> wedges;
   wedges.reserve(irreps.size());
@@ -133,8 +132,8 @@ std::vector<IrrepWedge> make_irrep_wedges(
     // std::cout << "Irrep directions: " << irrep.directions.size() <<
     // std::endl;
     if (irrep.directions.empty()) {
-      wedges.back() = IrrepWedgeImpl::_wedge_from_pseudo_irrep(
-          irrep, fullspace_rep, head_group);
+      wedges.back() =
+          IrrepWedgeImpl::_wedge_from_pseudo_irrep(irrep, irrep_decomposition);
       continue;
     }
 
@@ -188,7 +187,6 @@ std::vector<SubWedge> make_symrep_subwedges(
   };
 
   std::vector<IrrepWedge> init_wedges = make_irrep_wedges(irrep_decomposition);
-  MatrixRep const &fullspace_rep = irrep_decomposition.fullspace_rep;
   GroupIndices const &head_group = irrep_decomposition.head_group;
 
   std::vector<SubWedge> result;
@@ -212,7 +210,7 @@ std::vector<SubWedge> make_symrep_subwedges(
     subgroups.push_back({});
     for (Index element_index : head_group) {
       IrrepWedge test_wedge{wedge};
-      test_wedge.axes = fullspace_rep[element_index] * wedge.axes;
+      test_wedge.axes = irrep_decomposition.apply(element_index, wedge.axes);
       Index o = 0;
       for (; o < irrep_wedge_orbits.back().size(); ++o) {
         if (irrep_wedge_compare(irrep_wedge_orbits.back()[o], test_wedge)) {
@@ -260,8 +258,8 @@ std::vector<SubWedge> make_symrep_subwedges(
     result.emplace_back(twedge);
     for (Index p : subgroups[imax]) {
       for (Index i = 0; i < twedge.size(); i++)
-        twedge[i].axes =
-            fullspace_rep[p] * result.back().irrep_wedges()[i].axes;
+        twedge[i].axes = irrep_decomposition.apply(
+            p, result.back().irrep_wedges()[i].axes);
       if (!contains(tot_wedge_orbits.back(), twedge, tot_wedge_compare)) {
         tot_wedge_orbits.back().push_back(twedge);
       }
@@ -12,14 +12,21 @@
 namespace CASM {
 
 PermuteIterator::PermuteIterator()
-    : m_tmp_translation_permute(0), m_tmp_translation_index(-1) {}
+    : m_tmp_translation_permute(0),
+      m_tmp_translation_index(-1),
+      m_tmp_indices_factor_group_index(-1),
+      m_tmp_indices_translation_index(-1) {}
 
+/// m_tmp_indices may point into iter.m_tmp_translation_permute, so it is not
+/// copied
 PermuteIterator::PermuteIterator(const PermuteIterator &iter)
     : m_sym_info(iter.m_sym_info),
       m_factor_group_index(iter.m_factor_group_index),
       m_translation_index(iter.m_translation_index),
       m_tmp_translation_permute(iter.m_tmp_translation_permute),
-      m_tmp_translation_index(iter.m_tmp_translation_index) {}
+      m_tmp_translation_index(iter.m_tmp_translation_index),
+      m_tmp_indices_factor_group_index(-1),
+      m_tmp_indices_translation_index(-1) {}
 
 PermuteIterator::PermuteIterator(SupercellSymInfo const &_sym_info,
                                  Index _factor_group_index,
@@ -28,7 +35,9 @@ PermuteIterator::PermuteIterator(SupercellSymInfo const &_sym_info,
       m_factor_group_index(_factor_group_index),
       m_translation_index(_translation_index),
       m_tmp_translation_permute(0),
-      m_tmp_translation_index(-1) {}
+      m_tmp_translation_index(-1),
+      m_tmp_indices_factor_group_index(-1),
+      m_tmp_indices_translation_index(-1) {}
 
 PermuteIterator &PermuteIterator::operator=(PermuteIterator iter) {
   swap(*this, iter);
@@ -139,8 +148,48 @@ SymOp PermuteIterator::sym_op() const {
          sym_info().factor_group()[m_factor_group_index];
 }
 
+/// Index-wise permutation defined via:
+///    after_permutation[i] =
+///    before_permutation[permute_iterator.permute_ind(i)];
+///
+/// The permutation rows are looked up, as for PermuteIndices, only when the
+/// operation pointed at changes.
 Index PermuteIterator::permute_ind(Index i) const {
-  return factor_group_permute()[translation_permute()[i]];
+  if (m_factor_group_index != m_tmp_indices_factor_group_index ||
+      m_translation_index != m_tmp_indices_translation_index) {
+    m_tmp_indices = PermuteIndices(*this);
+    m_tmp_indices_factor_group_index = m_factor_group_index;
+    m_tmp_indices_translation_index = m_translation_index;
+  }
+  return m_tmp_indices[i];
+}
+
+PermuteIndices::PermuteIndices()
+    : m_row(nullptr),
+      m_factor_group(nullptr),
+      m_factor_group_permute(nullptr),
+      m_translation_permute(nullptr) {}
+
+PermuteIndices::PermuteIndices(PermuteIterator const &permute_it)
+    : m_row(nullptr),
+      m_factor_group(nullptr),
+      m_factor_group_permute(nullptr),
+      m_translation_permute(nullptr) {
+  SupercellPermutationTable const &table =
+      permute_it.sym_info().permutation_table();
+  Index f = permute_it.factor_group_index();
+  Index t = permute_it.translation_index();
+  if (table.layout() == SupercellPermutationTable::Layout::combined) {
+    m_row = table.combined(f, t);
+  } else if (table.layout() == SupercellPermutationTable::Layout::factored) {
+    m_row = table.translation(t);
+    m_factor_group = table.factor_group(f);
+  } else {
+    m_factor_group_permute =
+        permute_it.factor_group_permute().perm_array().data();
+    m_translation_permute =
+        permute_it.translation_permute().perm_array().data();
+  }
 }
 
 bool PermuteIterator::operator<(const PermuteIterator &iter) const {
@@ -448,6 +497,11 @@ void swap(PermuteIterator &a, PermuteIterator &b) {
   std::swap(a.m_translation_index, b.m_translation_index);
   std::swap(a.m_tmp_translation_permute, b.m_tmp_translation_permute);
   std::swap(a.m_tmp_translation_index, b.m_tmp_translation_index);
+  std::swap(a.m_tmp_indices, b.m_tmp_indices);
+  std::swap(a.m_tmp_indices_factor_group_index,
+            b.m_tmp_indices_factor_group_index);
+  std::swap(a.m_tmp_indices_translation_index,
+            b.m_tmp_indices_translation_index);
 }
 
 /// Return true if the permutation does not given sites and other sites
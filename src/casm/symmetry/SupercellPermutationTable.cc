@@ -0,0 +1,158 @@
+#include "casm/symmetry/SupercellPermutationTable.hh"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "casm/container/Permutation.hh"
+#include "casm/crystallography/LinearIndexConverter.hh"
+#include "casm/crystallography/UnitCellCoord.hh"
+#include "casm/symmetry/SupercellSymInfo.hh"
+#include "casm/symmetry/SymGroup.hh"
+#include "casm/symmetry/SymGroupRep.hh"
+#include "casm/symmetry/SymPermutation.hh"
+
+namespace CASM {
+
+namespace {
+
+/// Write a translation permutation row, using stored translation
+/// permutations if available, without constructing a Permutation
+void fill_translation_row(SupercellSymInfo const &sym_info,
+                          Index translation_index,
+                          SupercellPermutationTable::value_type *row) {
+  typedef SupercellPermutationTable::value_type value_type;
+  if (sym_info.translation_permutations().size() != 0) {
+    for (Index i : sym_info.translation_permutations()[translation_index]
+                       .perm_array()) {
+      *row++ = value_type(i);
+    }
+    return;
+  }
+
+  // see make_translation_permutation
+  auto const &bijk_index_converter = sym_info.unitcellcoord_index_converter();
+  UnitCell translation_uc =
+      sym_info.unitcell_index_converter()(translation_index);
+  for (Index old_site_ix = 0; old_site_ix < bijk_index_converter.total_sites();
+       ++old_site_ix) {
+    xtal::UnitCellCoord old_site_ucc = bijk_index_converter(old_site_ix);
+    row[bijk_index_converter(old_site_ucc + translation_uc)] =
+        value_type(old_site_ix);
+  }
+}
+
+}  // namespace
+
+SupercellPermutationTable::SupercellPermutationTable()
+    : m_layout(Layout::none),
+      m_n_factor_group(0),
+      m_n_translations(0),
+      m_n_sites(0),
+      m_data(nullptr) {}
+
+/// \brief Construct the largest layout that requires at most `max_bytes`
+///
+/// Layout::combined is preferred, then Layout::factored. If neither fits in
+/// `max_bytes`, nothing is stored.
+SupercellPermutationTable::SupercellPermutationTable(
+    SupercellSymInfo const &sym_info, std::size_t max_bytes)
+    : SupercellPermutationTable() {
+  Index n_factor_group = sym_info.factor_group().size();
+  Index n_translations = sym_info.superlattice().size();
+  Index n_sites = sym_info.unitcellcoord_index_converter().total_sites();
+
+  Layout layout = Layout::none;
+  if (required_bytes(Layout::combined, n_factor_group, n_translations,
+                     n_sites) <= max_bytes) {
+    layout = Layout::combined;
+  } else if (required_bytes(Layout::factored, n_factor_group, n_translations,
+                            n_sites) <= max_bytes) {
+    layout = Layout::factored;
+  }
+  *this = SupercellPermutationTable(sym_info, layout);
+}
+
+/// \brief Construct with a particular layout
+SupercellPermutationTable::SupercellPermutationTable(
+    SupercellSymInfo const &sym_info, Layout layout)
+    : m_layout(layout),
+      m_n_factor_group(sym_info.factor_group().size()),
+      m_n_translations(sym_info.superlattice().size()),
+      m_n_sites(sym_info.unitcellcoord_index_converter().total_sites()),
+      m_data(nullptr) {
+  if (m_layout == Layout::none) {
+    return;
+  }
+  if (m_n_sites > std::numeric_limits<value_type>::max()) {
+    throw std::runtime_error(
+        "Error in SupercellPermutationTable: too many sites for 32-bit "
+        "indices.");
+  }
+
+  // rows are filled directly, so no more than memory_size() is used
+  auto rows = std::make_shared<std::vector<value_type>>(
+      memory_size() / sizeof(value_type));
+  value_type *data = rows->data();
+  if (m_layout == Layout::combined) {
+    // translation row of combined(0, t) is used as scratch space, and
+    // overwritten last
+    for (Index t = 0; t < m_n_translations; ++t) {
+      value_type *trans_row = data + t * m_n_sites;
+      fill_translation_row(sym_info, t, trans_row);
+      for (Index f = m_n_factor_group - 1; f >= 0; --f) {
+        Permutation const &fg_permute = sym_info.factor_group_permute(f);
+        value_type *row = data + (f * m_n_translations + t) * m_n_sites;
+        for (Index i = 0; i < m_n_sites; ++i) {
+          row[i] = value_type(fg_permute[trans_row[i]]);
+        }
+      }
+    }
+  } else {
+    value_type *row = data;
+    for (Index f = 0; f < m_n_factor_group; ++f, row += m_n_sites) {
+      Permutation const &fg_permute = sym_info.factor_group_permute(f);
+      std::copy(fg_permute.perm_array().begin(),
+                fg_permute.perm_array().end(), row);
+    }
+    for (Index t = 0; t < m_n_translations; ++t, row += m_n_sites) {
+      fill_translation_row(sym_info, t, row);
+    }
+  }
+  m_data = rows->data();
+  m_storage = rows;
+}
+
+/// \brief Construct a table that uses existing data (i.e. a memory-mapped
+/// file)
+///
+/// \param layout,n_factor_group,n_translations,n_sites Table layout and size
+/// \param storage Keeps `data` valid for the lifetime of the table and its
+///     copies
+/// \param data Rows, in layout order. Must contain `required_bytes(layout,
+///     n_factor_group, n_translations, n_sites)`.
+SupercellPermutationTable::SupercellPermutationTable(
+    Layout layout, Index n_factor_group, Index n_translations, Index n_sites,
+    std::shared_ptr<void const> storage, value_type const *data)
+    : m_layout(layout),
+      m_n_factor_group(n_factor_group),
+      m_n_translations(n_translations),
+      m_n_sites(n_sites),
+      m_storage(std::move(storage)),
+      m_data(data) {}
+
+/// \brief Bytes required to store a particular layout
+std::size_t SupercellPermutationTable::required_bytes(Layout layout,
+                                                      Index n_factor_group,
+                                                      Index n_translations,
+                                                      Index n_sites) {
+  std::size_t n_rows = 0;
+  if (layout == Layout::combined) {
+    n_rows = std::size_t(n_factor_group) * std::size_t(n_translations);
+  } else if (layout == Layout::factored) {
+    n_rows = std::size_t(n_factor_group) + std::size_t(n_translations);
+  }
+  return n_rows * std::size_t(n_sites) * sizeof(value_type);
+}
+
+}  // namespace CASM
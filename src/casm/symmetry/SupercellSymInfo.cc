@@ -2,6 +2,9 @@
 
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
 
 #include "casm/casm_io/container/stream_io.hh"
 #include "casm/crystallography/CanonicalForm.hh"
@@ -12,6 +15,7 @@
 #include "casm/crystallography/UnitCellCoord.hh"
 #include "casm/misc/CASM_math.hh"
 #include "casm/symmetry/PermuteIterator.hh"
+#include "casm/symmetry/SparseCollectiveDoFSymRep.hh"
 #include "casm/symmetry/SupercellSymInfo.hh"
 #include "casm/symmetry/SymBasisPermute.hh"
 #include "casm/symmetry/SymGroup.hh"
@@ -69,6 +73,26 @@ std::vector<Permutation> make_translation_permutations(
   return translation_permutations;
 }
 
+/// \brief Default memory budget, in bytes, for materializing SupercellSymInfo
+/// site permutations
+///
+/// Set by the environment variable CASM_PERMUTATION_TABLE_MAX_BYTES. If not
+/// set, or 0, site permutations are not materialized by default.
+std::size_t default_permutation_table_max_bytes() {
+  char *_env = std::getenv("CASM_PERMUTATION_TABLE_MAX_BYTES");
+  if (_env == nullptr) {
+    return 0;
+  }
+  try {
+    return std::stoull(_env);
+  } catch (std::exception const &e) {
+    std::stringstream msg;
+    msg << "Error: could not convert CASM_PERMUTATION_TABLE_MAX_BYTES='"
+        << _env << "' to a number of bytes.";
+    throw std::runtime_error(msg.str());
+  }
+}
+
 SupercellSymInfo::SupercellSymInfo(
     Lattice const &_prim_lat, Lattice const &_super_lat,
     Index num_sites_in_prim, SymGroup const &_prim_factor_group,
@@ -117,6 +141,11 @@ SupercellSymInfo::SupercellSymInfo(
     m_occ_symreps[b] =
         SymGroupRep::RemoteHandle(factor_group(), occ_symrep_IDs[b]);
   }
+
+  std::size_t max_bytes = default_permutation_table_max_bytes();
+  if (max_bytes > 0) {
+    materialize_permutations(max_bytes);
+  }
 }
 
 SymGroupRepID make_permutation_representation(
@@ -180,20 +209,73 @@ SymGroupRep::RemoteHandle const &SupercellSymInfo::basis_permutation_symrep()
 ///   of the "prim_factor_group_index" (index into
 ///   `this->prim().factor_group()`).
 ///
+/// If a SupercellPermutationTable with Layout::factored has been set, for
+/// instance from a SupercellSymCache, the permutations are copied from the
+/// table rather than calculated.
+///
 SymGroupRep::RemoteHandle const &SupercellSymInfo::site_permutation_symrep()
     const {
   if (m_site_perm_symrep.empty()) {
-    m_site_perm_symrep = SymGroupRep::RemoteHandle(
-        this->factor_group(),
-        make_permutation_representation(
-            this->factor_group(), this->unitcellcoord_index_converter(),
-            this->prim_lattice(),
-            this->basis_permutation_symrep().symrep_ID()));
+    SymGroupRepID perm_rep_ID;
+    if (m_permutation_table.layout() ==
+        SupercellPermutationTable::Layout::factored) {
+      perm_rep_ID = this->factor_group().allocate_representation();
+      Index n_sites = m_permutation_table.n_sites();
+      for (Index f = 0; f < this->factor_group().size(); ++f) {
+        auto row = m_permutation_table.factor_group(f);
+        std::vector<Index> permutation(row, row + n_sites);
+        this->factor_group()[f].set_rep(perm_rep_ID,
+                                        SymPermutation(permutation));
+      }
+    } else {
+      perm_rep_ID = make_permutation_representation(
+          this->factor_group(), this->unitcellcoord_index_converter(),
+          this->prim_lattice(), this->basis_permutation_symrep().symrep_ID());
+    }
+    m_site_perm_symrep =
+        SymGroupRep::RemoteHandle(this->factor_group(), perm_rep_ID);
   }
 
   return m_site_perm_symrep;
 }
 
+/// \brief Materialize site permutations of all supercell operations, using
+/// at most `max_bytes`
+///
+/// After this is called, PermuteIterator::permute_ind reads site permutations
+/// from `permutation_table()`. The largest SupercellPermutationTable layout
+/// that fits in `max_bytes` is used; if none fits, any existing table is
+/// cleared. Not thread-safe: call before sharing the SupercellSymInfo between
+/// threads. Existing PermuteIterator and PermuteIndices must not be used
+/// after this is called.
+///
+/// \returns The layout used
+SupercellPermutationTable::Layout SupercellSymInfo::materialize_permutations(
+    std::size_t max_bytes) const {
+  m_permutation_table = SupercellPermutationTable(*this, max_bytes);
+  return m_permutation_table.layout();
+}
+
+/// \brief Use previously materialized site permutations
+///
+/// The table must have been constructed for this supercell, i.e. with the
+/// same supercell factor group and number of sites. Not thread-safe: call
+/// before sharing the SupercellSymInfo between threads. Existing
+/// PermuteIterator and PermuteIndices must not be used after this is called.
+void SupercellSymInfo::set_permutation_table(
+    SupercellPermutationTable table) const {
+  if (table.layout() != SupercellPermutationTable::Layout::none &&
+      (table.n_factor_group() != this->factor_group().size() ||
+       table.n_translations() != this->superlattice().size() ||
+       table.n_sites() !=
+           this->unitcellcoord_index_converter().total_sites())) {
+    throw std::runtime_error(
+        "Error in SupercellSymInfo::set_permutation_table: table size does not "
+        "match the supercell");
+  }
+  m_permutation_table = std::move(table);
+}
+
 /// Site permutation corresponding to supercell factor group operation
 const Permutation &SupercellSymInfo::factor_group_permute(
     Index supercell_factor_group_index) const {
@@ -373,6 +455,65 @@ xtal::Superlattice make_superlattice_from_supercell_name(
   }
 }
 
+namespace {
+
+/// Make map of site_index -> beginning row in basis for that site
+///
+/// The number of rows per site is the dof dimension on that site. Sets
+/// `total_dim` to the total dof dimension.
+std::map<Index, Index> make_site_index_to_basis_index(
+    std::set<Index> const &site_indices, SupercellSymInfo const &_syminfo,
+    SupercellSymInfo::SublatSymReps const &subreps, Index &total_dim) {
+  std::map<Index, Index> site_index_to_basis_index;
+  total_dim = 0;
+  for (Index site_index : site_indices) {
+    Index b = _syminfo.unitcellcoord_index_converter()(site_index).sublattice();
+    Index site_dof_dim = subreps[b].dim();
+    site_index_to_basis_index[site_index] = total_dim;
+    total_dim += site_dof_dim;
+  }
+  return site_index_to_basis_index;
+}
+
+/// Call `f(row, col, U)` for each site block, U, of the collective DoF symrep
+/// matrix of `perm`, where (row, col) is the position of the block
+///
+/// See `make_collective_dof_symrep` for conventions.
+template <typename BlockFunction>
+void for_each_collective_dof_block(
+    PermuteIterator const &perm, std::set<Index> const &site_indices,
+    std::map<Index, Index> const &site_index_to_basis_index,
+    SupercellSymInfo::SublatSymReps const &subreps,
+    SupercellSymInfo const &_syminfo, BlockFunction f) {
+  for (Index site_index : site_indices) {
+    // "to_site" (after applying symmetry) determines row of block
+    // can't fail, because it was built from [begin, end)
+    Index to_site_index = site_index;
+    Index row = site_index_to_basis_index.find(to_site_index)->second;
+
+    // "from_site" (before applying symmetry) determines col of block
+    // could fail, if mismatch between [begin, end) and group
+    Index from_site_index = perm.permute_ind(site_index);
+    auto col_it = site_index_to_basis_index.find(from_site_index);
+    if (col_it == site_index_to_basis_index.end()) {
+      throw std::runtime_error(
+          "Error in collective_dof_symrep: Input group includes permutations "
+          "between selected and unselected sites.");
+    }
+    Index col = col_it->second;
+
+    // "from_site" sublattice and factor group op index
+    // are used to lookup the site dof rep matrix
+    Index from_site_b =
+        _syminfo.unitcellcoord_index_converter()(from_site_index).sublattice();
+    Eigen::MatrixXd const &U =
+        *(subreps[from_site_b][perm.factor_group_index()]->MatrixXd());
+    f(row, col, U);
+  }
+}
+
+}  // namespace
+
 /// \brief Make the matrix representation for group '_group' describing the
 /// transformation of DoF '_key' among a subset of sites
 ///
@@ -433,52 +574,103 @@ std::pair<MasterSymGroup, SymGroupRepID> make_collective_dof_symrep(
 
   // make map of site_index -> beginning row in basis for that site
   // (number of rows per site == dof dimension on that site)
-  std::map<Index, Index> site_index_to_basis_index;
   Index total_dim = 0;
-  for (Index site_index : site_indices) {
-    Index b = _syminfo.unitcellcoord_index_converter()(site_index).sublattice();
-    Index site_dof_dim = subreps[b].dim();
-    site_index_to_basis_index[site_index] = total_dim;
-    total_dim += site_dof_dim;
-  }
+  std::map<Index, Index> site_index_to_basis_index =
+      make_site_index_to_basis_index(site_indices, _syminfo, subreps,
+                                     total_dim);
 
   // make matrix rep, by filling in blocks with site dof symreps
   Eigen::MatrixXd trep(total_dim, total_dim);
   Index g = 0;
   for (PermuteIterator const &perm : _group) {
     trep.setZero();
-    for (Index site_index : site_indices) {
-      // "to_site" (after applying symmetry) determines row of block
-      // can't fail, because it was built from [begin, end)
-      Index to_site_index = site_index;
-      Index row = site_index_to_basis_index.find(to_site_index)->second;
-
-      // "from_site" (before applying symmetry) determines col of block
-      // could fail, if mismatch between [begin, end) and group
-      Index from_site_index = perm.permute_ind(site_index);
-      auto col_it = site_index_to_basis_index.find(from_site_index);
-      if (col_it == site_index_to_basis_index.end()) {
-        throw std::runtime_error(
-            "Error in collective_dof_symrep: Input group includes permutations "
-            "between selected and unselected sites.");
-      }
-      Index col = col_it->second;
-
-      // "from_site" sublattice and factor group op index
-      // are used to lookup the site dof rep matrix
-      Index from_site_b =
-          _syminfo.unitcellcoord_index_converter()(from_site_index)
-              .sublattice();
-      Eigen::MatrixXd U =
-          *(subreps[from_site_b][perm.factor_group_index()]->MatrixXd());
-
-      // insert matrix as block in collective dof symrep
-      trep.block(row, col, U.rows(), U.cols()) = U;
-    }
+    for_each_collective_dof_block(
+        perm, site_indices, site_index_to_basis_index, subreps, _syminfo,
+        [&](Index row, Index col, Eigen::MatrixXd const &U) {
+          // insert matrix as block in collective dof symrep
+          trep.block(row, col, U.rows(), U.cols()) = U;
+        });
     result.first[g++].set_rep(result.second, SymMatrixXd(trep));
   }
   result.first.sort();
   return result;
 }
 
+/// \brief Make the sparse matrix representation for group '_group'
+/// describing the transformation of DoF '_key' among a subset of sites
+///
+/// Equivalent to `make_collective_dof_symrep`, but the matrices are stored
+/// as sparse matrices, which need memory proportional to the number of sites
+/// rather than its square. This allows `make_irrep_decomposition` to be used
+/// for large numbers of sites.
+///
+/// \param site_indices Set of site indices that define subset of sites of
+///     interest
+/// \param _syminfo SupercellSymInfo object that defines all symmetry properties
+///     of supercell
+/// \param _key DoFKey specifying which local DoF is of interest
+/// \param _group vector of PermuteIterators forming the group that is to be
+///     represented (this may be larger than a crystallographic factor group)
+///
+/// \result A std::pair containing a MasterSymGroup instantiation of _group,
+/// sorted as by `make_collective_dof_symrep`, and the representation matrices,
+/// where `result.second[i]` is the matrix for `result.first[i]`
+///
+std::pair<MasterSymGroup, SymRepTools_v2::SparseMatrixRep>
+make_sparse_collective_dof_symrep(std::set<Index> const &site_indices,
+                                  SupercellSymInfo const &_syminfo,
+                                  DoFKey const &_key,
+                                  std::vector<PermuteIterator> const &_group) {
+  std::pair<MasterSymGroup, SymRepTools_v2::SparseMatrixRep> result;
+  if (_group.empty())
+    throw std::runtime_error(
+        "Empty group passed to sparse_collective_dof_symrep()");
+  MasterSymGroup &master_group = result.first;
+  master_group.set_lattice(_syminfo.supercell_lattice());
+  for (PermuteIterator const &perm : _group) {
+    master_group.push_back(perm.sym_op());
+  }
+
+  // Sorting reorders the operations, so temporarily store the position of
+  // each operation in `_group` as a 1x1 representation to find which
+  // PermuteIterator corresponds to each operation afterwards
+  SymGroupRepID position_id = master_group.allocate_representation();
+  for (Index g = 0; g < master_group.size(); ++g) {
+    master_group[g].set_rep(position_id,
+                            SymMatrixXd(Eigen::MatrixXd::Constant(1, 1, g)));
+  }
+  master_group.sort();
+
+  SupercellSymInfo::SublatSymReps const &subreps =
+      _key == "occ" ? _syminfo.occ_symreps() : _syminfo.local_dof_symreps(_key);
+  Index total_dim = 0;
+  std::map<Index, Index> site_index_to_basis_index =
+      make_site_index_to_basis_index(site_indices, _syminfo, subreps,
+                                     total_dim);
+
+  std::vector<Eigen::Triplet<double>> triplets;
+  for (Index g = 0; g < master_group.size(); ++g) {
+    Eigen::MatrixXd const &position =
+        *master_group[g].representation(position_id).MatrixXd();
+    PermuteIterator const &perm = _group[std::lround(position(0, 0))];
+
+    triplets.clear();
+    for_each_collective_dof_block(
+        perm, site_indices, site_index_to_basis_index, subreps, _syminfo,
+        [&](Index row, Index col, Eigen::MatrixXd const &U) {
+          for (Index i = 0; i < U.rows(); ++i) {
+            for (Index j = 0; j < U.cols(); ++j) {
+              if (U(i, j) != 0.0) {
+                triplets.emplace_back(row + i, col + j, U(i, j));
+              }
+            }
+          }
+        });
+    Eigen::SparseMatrix<double> matrix(total_dim, total_dim);
+    matrix.setFromTriplets(triplets.begin(), triplets.end());
+    result.second.push_back(std::move(matrix));
+  }
+  return result;
+}
+
 }  // namespace CASM
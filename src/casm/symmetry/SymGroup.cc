@@ -1,5 +1,10 @@
 #include "casm/symmetry/SymGroup.hh"
 
+#include <algorithm>
+#include <array>
+#include <map>
+#include <set>
+
 #include "casm/casm_io/Log.hh"
 #include "casm/casm_io/container/stream_io.hh"
 #include "casm/container/Counter.hh"
@@ -356,8 +361,137 @@ static std::map<std::string, std::string> _nonmagnetic_point_group_info(
   }
   return result;
 }
+
+/// Bucket key for the point operation of a SymOp: its matrix in fractional
+/// coordinates, and time reversal
+typedef std::array<long, 10> _PointOpKey;
+
+static _PointOpKey _point_op_key(Eigen::Matrix3l const &frac_matrix,
+                                 bool time_reversal) {
+  _PointOpKey key;
+  for (Index i = 0; i < 3; ++i) {
+    for (Index j = 0; j < 3; ++j) {
+      key[3 * i + j] = frac_matrix(i, j);
+    }
+  }
+  key[9] = time_reversal ? 1 : 0;
+  return key;
+}
+
+/// \brief Bucket group operations by integer fractional point operation
+///
+/// \param group Group to bucket
+/// \param lat_ptr Lattice for fractional coordinates. May be nullptr.
+/// \param tol Tolerance used by `compare_periodic`
+/// \param frac_matrices Set to the integer fractional matrix of each operation
+/// \param buckets Set to operation indices, in increasing order, by key
+///
+/// \returns False if the buckets may not be used to replace a search of all
+///     operations: if there is no lattice, if an operation is not a lattice
+///     point operation, or if two operations in different buckets are close
+///     enough (within 2*tol) that a product could match operations in
+///     different buckets.
+static bool _make_point_op_buckets(
+    SymGroup const &group, Lattice const *lat_ptr, double tol,
+    std::vector<Eigen::Matrix3l> &frac_matrices,
+    std::map<_PointOpKey, std::vector<Index>> &buckets) {
+  if (lat_ptr == nullptr) {
+    return false;
+  }
+  Eigen::Matrix3d const &L = lat_ptr->lat_column_mat();
+  Eigen::Matrix3d const &L_inv = lat_ptr->inv_lat_column_mat();
+  for (Index i = 0; i < group.size(); ++i) {
+    Eigen::Matrix3d frac = L_inv * group[i].matrix() * L;
+    Eigen::Matrix3l frac_int = lround(frac);
+    if ((frac - frac_int.cast<double>()).cwiseAbs().maxCoeff() > 1e-3) {
+      return false;
+    }
+    frac_matrices.push_back(frac_int);
+    buckets[_point_op_key(frac_int, group[i].time_reversal())].push_back(i);
+  }
+
+  // bucket representative (first op) and radius (max distance from
+  // representative), to check bucket separation via the triangle inequality
+  std::vector<std::pair<Index, double>> bounds;
+  for (auto const &bucket : buckets) {
+    Index rep = bucket.second[0];
+    double radius = 0.;
+    for (Index i : bucket.second) {
+      radius = std::max(
+          radius, (group[i].matrix() - group[rep].matrix()).norm());
+    }
+    bounds.emplace_back(rep, radius);
+  }
+  for (Index a = 0; a < bounds.size(); ++a) {
+    for (Index b = a + 1; b < bounds.size(); ++b) {
+      SymOp const &op_a = group[bounds[a].first];
+      SymOp const &op_b = group[bounds[b].first];
+      if (op_a.time_reversal() == op_b.time_reversal() &&
+          (op_a.matrix() - op_b.matrix()).norm() <
+              2. * tol + bounds[a].second + bounds[b].second) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/// Return an element that generates the cyclic group `cyclic`
+static Index _cyclic_generator(SymGroup const &group,
+                               std::set<Index> const &cyclic) {
+  for (Index op : cyclic) {
+    Index order = 1;
+    Index power = op;
+    while (power != 0 && order <= cyclic.size()) {
+      power = group.ind_prod(op, power);
+      ++order;
+    }
+    if (order == cyclic.size()) {
+      return op;
+    }
+  }
+  return *cyclic.rbegin();
+}
+
+/// Return the group generated by `generators` (breadth-first products)
+static std::set<Index> _group_closure(SymGroup const &group,
+                                      std::vector<Index> const &generators) {
+  std::vector<bool> contains(group.size(), false);
+  std::vector<Index> elements({0});
+  contains[0] = true;
+  for (Index ii = 0; ii < elements.size(); ++ii) {
+    for (Index gen : generators) {
+      Index prod = group.ind_prod(elements[ii], gen);
+      if (prod < group.size() && !contains[prod]) {
+        contains[prod] = true;
+        elements.push_back(prod);
+      }
+    }
+  }
+  return std::set<Index>(elements.begin(), elements.end());
+}
+
 }  // namespace Local
 
+void SymGroupRepArray::push_back(SymGroupRep *rep) {
+  Index i = size();
+  Index b = _block(i);
+  if (!m_blocks[b]) {
+    m_blocks[b].reset(new SymGroupRep *[Index(1) << b]);
+  }
+  m_blocks[b][i + 1 - (Index(1) << b)] = rep;
+  m_size.store(i + 1, std::memory_order_release);
+}
+
+void SymGroupRepArray::clear() {
+  m_size.store(0, std::memory_order_release);
+  for (auto &block : m_blocks) {
+    block.reset();
+  }
+}
+
+//*******************************************************************************************
+
 // INITIALIZE STATIC MEMBER MasterSymGroup::GROUP_COUNT
 // THIS MUST OCCUR IN A .CC FILE; MAY CAUSE PROBLEMS IF WE
 // CHANGE COMPILING/LINKING STRATEGY
@@ -371,8 +505,6 @@ MasterSymGroup::MasterSymGroup(const MasterSymGroup &RHS)
       m_coord_rep_ID(RHS.m_coord_rep_ID),
       m_reg_rep_ID(RHS.m_reg_rep_ID),
       m_identity_rep_IDs(RHS.m_identity_rep_IDs) {
-  m_rep_array.reserve(RHS.m_rep_array.size());
-
   for (Index i = 0; i < RHS.m_rep_array.size(); i++) {
     _add_representation(RHS.m_rep_array[i]->copy());
   }
@@ -392,7 +524,6 @@ MasterSymGroup &MasterSymGroup::operator=(const MasterSymGroup &RHS) {
   SymGroup::operator=(RHS);
   m_coord_rep_ID = RHS.m_coord_rep_ID;
   m_reg_rep_ID = RHS.m_reg_rep_ID;
-  m_rep_array.reserve(RHS.m_rep_array.size());
   for (Index i = 0; i < RHS.m_rep_array.size(); i++)
     _add_representation(RHS.m_rep_array[i]->copy());
 
@@ -413,6 +544,7 @@ void MasterSymGroup::push_back(const SymOp &op) {
 //*******************************************************************************************
 
 const SymGroup &MasterSymGroup::point_group() const {
+  std::lock_guard<std::recursive_mutex> lock(m_rep_mutex);
   if (!m_point_group.size()) {
     m_point_group = copy_no_trans(false);
   }
@@ -422,6 +554,7 @@ const SymGroup &MasterSymGroup::point_group() const {
 //*******************************************************************************************
 
 void MasterSymGroup::clear() {
+  std::lock_guard<std::recursive_mutex> lock(m_rep_mutex);
   SymGroup ::clear();
   m_point_group.clear();
   for (Index i = 0; i < m_rep_array.size(); i++) {
@@ -443,6 +576,7 @@ void MasterSymGroup::clear() {
 //*******************************************************************************************
 
 SymGroupRepID MasterSymGroup::coord_rep_ID() const {
+  std::lock_guard<std::recursive_mutex> lock(m_rep_mutex);
   if (m_coord_rep_ID.empty()) _add_coord_rep();
   return m_coord_rep_ID;
 }
@@ -450,6 +584,7 @@ SymGroupRepID MasterSymGroup::coord_rep_ID() const {
 //*******************************************************************************************
 
 SymGroupRepID MasterSymGroup::reg_rep_ID() const {
+  std::lock_guard<std::recursive_mutex> lock(m_rep_mutex);
   if (m_reg_rep_ID.empty()) _add_reg_rep();
   return m_reg_rep_ID;
 }
@@ -457,6 +592,7 @@ SymGroupRepID MasterSymGroup::reg_rep_ID() const {
 //*******************************************************************************************
 
 SymGroupRepID MasterSymGroup::identity_rep_ID(Index dim) const {
+  std::lock_guard<std::recursive_mutex> lock(m_rep_mutex);
   if (m_identity_rep_IDs.size() < dim + 1) {
     auto tail = std::vector<SymGroupRepID>(dim + 1 - m_identity_rep_IDs.size());
     m_identity_rep_IDs.insert(m_identity_rep_IDs.end(), tail.begin(),
@@ -476,8 +612,7 @@ SymGroupRepID MasterSymGroup::identity_rep_ID(Index dim) const {
 //*******************************************************************************************
 
 SymGroupRep const &MasterSymGroup::coord_rep() const {
-  if (m_coord_rep_ID.empty()) _add_coord_rep();
-  return representation(m_coord_rep_ID);
+  return representation(coord_rep_ID());
 }
 
 //*******************************************************************************************
@@ -491,8 +626,7 @@ void MasterSymGroup::set_rep(SymGroupRepID rep_ID,
 //*******************************************************************************************
 
 SymGroupRep const &MasterSymGroup::reg_rep() const {
-  if (m_reg_rep_ID.empty()) _add_reg_rep();
-  return representation(m_reg_rep_ID);
+  return representation(reg_rep_ID());
 }
 
 //*******************************************************************************************
@@ -698,6 +832,7 @@ SymGroupRepID MasterSymGroup::add_transformed_rep(
 //*******************************************************************************************
 
 SymGroupRepID MasterSymGroup::allocate_representation() const {
+  std::lock_guard<std::recursive_mutex> lock(m_rep_mutex);
   SymGroupRepID new_ID(group_index(), m_rep_array.size());
   m_rep_array.push_back(new SymGroupRep(*this, new_ID));
   return new_ID;
@@ -713,6 +848,7 @@ SymGroupRepID MasterSymGroup::add_representation(
 //*******************************************************************************************
 
 SymGroupRepID MasterSymGroup::_add_representation(SymGroupRep *new_rep) const {
+  std::lock_guard<std::recursive_mutex> lock(m_rep_mutex);
   SymGroupRepID new_ID(group_index(), m_rep_array.size());
   m_rep_array.push_back(new_rep);
   m_rep_array.back()->set_master_group(*this, new_ID);
@@ -1295,6 +1431,9 @@ std::vector<std::set<std::set<Index>>> SymGroup::_small_subgroups() const {
   // identity is a small subgroup
   result.push_back({{0}});
 
+  // all subgroups found so far, for fast duplicate checks
+  std::set<std::set<Index>> found({{0}});
+
   for (i = 1; i < multi_table.size(); i++) {
     std::set<Index> tgroup({0, i});
     j = i;  // ind_prod(i, i);
@@ -1303,14 +1442,7 @@ std::vector<std::set<std::set<Index>>> SymGroup::_small_subgroups() const {
       tgroup.insert(j);
     }
 
-    bool add = true;
-    for (auto const &orbit : result) {
-      if (orbit.begin()->size() == tgroup.size() && orbit.count(tgroup) > 0) {
-        add = false;
-        break;
-      }
-    }
-    if (!add) continue;
+    if (found.count(tgroup)) continue;
 
     // use equiv_map to find the equivalent subgroups
     result.push_back({});
@@ -1325,6 +1457,7 @@ std::vector<std::set<std::set<Index>>> SymGroup::_small_subgroups() const {
         tempind = ind_prod(op, ind_inverse(coset[0]));
         tequiv.insert(ind_prod(coset[0], tempind));
       }
+      found.insert(tequiv);
       result.back().insert(std::move(tequiv));
     }
   }
@@ -1338,54 +1471,80 @@ std::vector<std::set<std::set<Index>>> SymGroup::_small_subgroups() const {
  *  large_group. Repeat for all (large_group, small_group) pairs,
  *  until no new m_subgroups are found. This is probably not the
  *  fastest algorithm, but it is complete
+ *
+ *  For speed with large groups, closures are generated from a small set of
+ *  generators (generators of the large_group plus one generator of the cyclic
+ *  small_group) rather than from all elements, and duplicate subgroups are
+ *  found by lookup in the set of all subgroups found so far.
  */
 
 void SymGroup::_generate_subgroups() const {
   auto small = _small_subgroups();
   m_subgroups = small;
-  Index i, k, ii, jj, tempind;
+
+  // all subgroups found so far, for fast duplicate checks
+  std::set<std::set<Index>> found;
+
+  // generators[i] generate *m_subgroups[i].begin()
+  std::vector<std::vector<Index>> generators;
+
+  // small_generators[k] generates the k-th small subgroup, in iteration order
+  std::vector<Index> small_generators;
+  for (auto const &orbit : small) {
+    for (auto const &equiv : orbit) {
+      found.insert(equiv);
+      small_generators.push_back(Local::_cyclic_generator(*this, equiv));
+    }
+    generators.push_back(
+        {Local::_cyclic_generator(*this, *orbit.begin())});
+  }
+
+  Index i, tempind;
   for (i = 0; i < m_subgroups.size(); i++) {
     // std::cout << "i is " << i << " and m_subgroups.size() is " <<
     // m_subgroups.size() << std::endl;
+    Index small_index = 0;
     for (auto const &orbit : small) {
       for (auto const &equiv : orbit) {
-        std::set<Index> tgroup = *(m_subgroups[i].begin());
-        Index init_size = tgroup.size();
-        tgroup.insert(equiv.begin(), equiv.end());
-        if (tgroup.size() == init_size) continue;
+        Index small_generator = small_generators[small_index++];
+        std::set<Index> const &large = *(m_subgroups[i].begin());
+        if (std::includes(large.begin(), large.end(), equiv.begin(),
+                          equiv.end()))
+          continue;
 
         // find group closure
-        std::vector<Index> vgroup(tgroup.begin(), tgroup.end());
-        for (ii = 0; ii < vgroup.size(); ii++) {
-          for (jj = 0; jj < vgroup.size(); jj++) {
-            Index prod = ind_prod(vgroup[ii], vgroup[jj]);
-            if (tgroup.insert(prod).second) {
-              vgroup.push_back(prod);
-            }
-          }
-        }
+        std::vector<Index> tgenerators = generators[i];
+        tgenerators.push_back(small_generator);
+        std::set<Index> tgroup = Local::_group_closure(*this, tgenerators);
 
-        for (k = 0; k < m_subgroups.size(); k++) {
-          if (m_subgroups[k].begin()->size() == tgroup.size() &&
-              m_subgroups[k].count(tgroup) > 0)
-            break;
-        }
-        // std::cout << " k is " << k << " and m_subgroups.size() is " <<
-        // m_subgroups.size() << std::endl;
-        if (k < m_subgroups.size()) continue;
+        if (found.count(tgroup)) continue;
         // add the new group
 
         // use equiv_map to find the equivalent subgroups
         m_subgroups.push_back({});
 
+        // conjugating element for each equivalent subgroup
+        std::map<std::set<Index>, Index> conjugator;
         for (auto const &coset : left_cosets(tgroup.begin(), tgroup.end())) {
           std::set<Index> tequiv;
           for (Index op : tgroup) {
             tempind = ind_prod(op, ind_inverse(coset[0]));
             tequiv.insert(ind_prod(coset[0], tempind));
           }
+          found.insert(tequiv);
+          conjugator.emplace(tequiv, coset[0]);
           m_subgroups.back().insert(std::move(tequiv));
         }
+
+        // generators of the first equivalent subgroup are conjugates of
+        // tgenerators
+        Index c = conjugator[*m_subgroups.back().begin()];
+        std::vector<Index> rep_generators;
+        for (Index op : tgenerators) {
+          rep_generators.push_back(
+              ind_prod(c, ind_prod(op, ind_inverse(c))));
+        }
+        generators.push_back(std::move(rep_generators));
       }
     }
   }
@@ -1497,18 +1656,17 @@ void SymGroup::_generate_conjugacy_classes() const {
 
   conjugacy_classes.clear();
 
-  int k;
+  Index k;
+
+  // in_any_class[i]: operation i is in some conjugacy class
+  // last_class[i]: index of last conjugacy class operation i was added to
+  std::vector<bool> in_any_class(size(), false);
+  std::vector<Index> last_class(size(), -1);
 
   for (Index i = 0; i < size(); i++) {
-    bool dup_class(false);
-    for (Index j = 0; j < conjugacy_classes.size(); j++) {
-      if (contains(conjugacy_classes[j], i)) {
-        dup_class = true;
-        break;
-      }
-    }
-    if (dup_class) continue;
+    if (in_any_class[i]) continue;
 
+    Index current_class = conjugacy_classes.size();
     conjugacy_classes.push_back(std::vector<Index>());
 
     for (Index j = 0; j < size(); j++) {
@@ -1521,7 +1679,13 @@ void SymGroup::_generate_conjugacy_classes() const {
       // std::cout << k << " -- compare to explicit value " <<
       // multi_table[tk][j];
 
-      if (!contains(conjugacy_classes.back(), k)) {
+      if (k < size()) {
+        if (last_class[k] != current_class) {
+          last_class[k] = current_class;
+          in_any_class[k] = true;
+          conjugacy_classes.back().push_back(k);
+        }
+      } else if (!contains(conjugacy_classes.back(), k)) {
         // std::cout << " so " << k << " goes in class " <<
         // conjugacy_classes.size()-1;
         conjugacy_classes.back().push_back(k);
@@ -1709,19 +1873,47 @@ bool SymGroup::_generate_multi_table() const {  // AAB
   Index i, j;
   multi_table.resize(size(), std::vector<Index>(size(), -1));
 
+  // Fast path: a product can only match operations with the same point
+  // operation, and the integer fractional matrix of a product is the product
+  // of the integer fractional matrices. So, if the point operations are
+  // separated well enough, only operations in the product's bucket need to be
+  // checked, giving the same result as `find_periodic` over all operations.
+  std::vector<Eigen::Matrix3l> frac_matrices;
+  std::map<Local::_PointOpKey, std::vector<Index>> buckets;
+  bool use_buckets = Local::_make_point_op_buckets(*this, m_lat_ptr, TOL,
+                                                   frac_matrices, buckets);
+
   for (i = 0; i < size(); i++) {
+    // in_row[k]: multi_table[i][j'] == k for some j' < j
+    std::vector<bool> in_row(size(), false);
     for (j = 0; j < size(); j++) {
-      multi_table[i][j] = find_periodic(at(i) * at(j));
-      if (multi_table[i][j] >= size() ||
-          find_index(multi_table[i], multi_table[i][j]) != j) {
+      SymOp product = at(i) * at(j);
+      Index result = size();
+      if (use_buckets) {
+        auto it = buckets.find(Local::_point_op_key(
+            frac_matrices[i] * frac_matrices[j], product.time_reversal()));
+        if (it != buckets.end()) {
+          for (Index k : it->second) {
+            if (compare_periodic(at(k), product, lattice(), periodicity(),
+                                 TOL)) {
+              result = k;
+              break;
+            }
+          }
+        }
+      }
+      if (result == size()) {
+        result = find_periodic(product);
+      }
+      multi_table[i][j] = result;
+      if (multi_table[i][j] >= size() || in_row[multi_table[i][j]]) {
         // this is a hack (sort of). If find_periodic doesn't work, we try
         // find_no trans, which *should* work. In other words, we are using
         // 'inuition' to determine that user doesn't really care about the
         // translational aspects. If our intuition is wrong, there will will
         // probably be an obvious failure later.
-        multi_table[i][j] = find_no_trans(at(i) * at(j));
-        if (multi_table[i][j] >= size() ||
-            find_index(multi_table[i], multi_table[i][j]) != j) {
+        multi_table[i][j] = find_no_trans(product);
+        if (multi_table[i][j] >= size() || in_row[multi_table[i][j]]) {
           // if(multi_table[i][j] >= size()) {
           // std::cout << "This SymGroup is not a group because the combination
           // of at least two of its elements is not contained in the set.\n";
@@ -1742,6 +1934,7 @@ bool SymGroup::_generate_multi_table() const {  // AAB
           return false;
         }
       }
+      in_row[multi_table[i][j]] = true;
     }
   }
 
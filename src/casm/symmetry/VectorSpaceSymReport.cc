@@ -16,8 +16,8 @@ VectorSpaceSymReport vector_space_sym_report(
   result.symmetry_adapted_subspace =
       irrep_decomposition.symmetry_adapted_subspace;
   for (Index element_index : irrep_decomposition.head_group) {
-    auto matrix_rep = irrep_decomposition.fullspace_rep[element_index];
-    result.symgroup_rep.push_back(matrix_rep);
+    result.symgroup_rep.push_back(
+        irrep_decomposition.fullspace_matrix(element_index));
   }
   result.axis_glossary =
       std::vector<std::string>(result.symmetry_adapted_subspace.rows(), "x");
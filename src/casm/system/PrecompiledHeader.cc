@@ -0,0 +1,177 @@
+#include "casm/system/PrecompiledHeader.hh"
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <sstream>
+
+#include "casm/system/Popen.hh"
+
+namespace CASM {
+
+namespace {
+
+std::string _read_file(fs::path const &path) {
+  std::ifstream in(path.string());
+  std::stringstream ss;
+  ss << in.rdbuf();
+  return ss.str();
+}
+
+/// \brief Read prerequisites from a make-style dependency file
+std::vector<fs::path> _read_depfile(fs::path const &path) {
+  std::string contents = _read_file(path);
+  std::vector<fs::path> result;
+
+  // skip target
+  std::size_t pos = contents.find(": ");
+  if (pos == std::string::npos) {
+    return result;
+  }
+  std::string token;
+  for (std::size_t i = pos + 2; i < contents.size(); ++i) {
+    char c = contents[i];
+    if (c == '\\' && i + 1 < contents.size()) {
+      char next = contents[i + 1];
+      if (next == '\n') {
+        ++i;
+        continue;
+      }
+      if (next == ' ') {
+        token.push_back(' ');
+        ++i;
+        continue;
+      }
+    }
+    if (c == ' ' || c == '\n' || c == '\t') {
+      if (!token.empty()) {
+        result.emplace_back(token);
+        token.clear();
+      }
+      continue;
+    }
+    token.push_back(c);
+  }
+  if (!token.empty()) {
+    result.emplace_back(token);
+  }
+  return result;
+}
+
+}  // namespace
+
+/// \brief Constructor
+///
+/// \param dir Directory where the header and precompiled header are written
+/// \param name Header base name, the header is written to `dir / (name +
+///     ".hh")`
+/// \param includes Header names, as they would appear in an `#include`
+///     directive, i.e. `"<cstddef>"` or `"\"casm/global/eigen.hh\""`
+/// \param compile_options Compile command, without input or output files, as
+///     used to compile the source files that will use the precompiled header
+///
+PrecompiledHeader::PrecompiledHeader(fs::path dir, std::string name,
+                                     std::vector<std::string> includes,
+                                     std::string compile_options)
+    : m_dir(dir),
+      m_name(name),
+      m_includes(includes),
+      m_compile_options(compile_options) {}
+
+/// \brief Path to the header
+fs::path PrecompiledHeader::header() const { return m_dir / (m_name + ".hh"); }
+
+/// \brief Path to the precompiled header
+fs::path PrecompiledHeader::precompiled_header() const {
+  return m_dir / (m_name + ".hh.gch");
+}
+
+/// \brief True if the precompiled header exists and is up-to-date
+///
+/// Checks that:
+/// - the header and precompiled header exist,
+/// - the header contents and build command are unchanged, and
+/// - no prerequisite listed in the dependency file is missing or newer than
+///   the precompiled header.
+bool PrecompiledHeader::is_current() const {
+  fs::path gch = precompiled_header();
+  fs::path depfile = m_dir / (m_name + ".hh.d");
+  fs::path cmdfile = m_dir / (m_name + ".hh.cmd");
+  if (!fs::exists(header()) || !fs::exists(gch) || !fs::exists(depfile) ||
+      !fs::exists(cmdfile)) {
+    return false;
+  }
+  if (_read_file(header()) != _header_contents() ||
+      _read_file(cmdfile) != _build_command()) {
+    return false;
+  }
+  std::time_t gch_time = fs::last_write_time(gch);
+  for (fs::path const &dep : _read_depfile(depfile)) {
+    boost::system::error_code ec;
+    std::time_t t = fs::last_write_time(dep, ec);
+    if (ec || t > gch_time) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// \brief Build the precompiled header, if it is not up-to-date
+///
+/// Throws std::runtime_error if the precompiled header can not be built. In
+/// that case, any partially written precompiled header is removed so that the
+/// header is used directly.
+void PrecompiledHeader::update() {
+  if (is_current()) {
+    return;
+  }
+  fs::create_directories(m_dir);
+  {
+    std::ofstream out(header().string());
+    out << _header_contents();
+  }
+
+  fs::path cmdfile = m_dir / (m_name + ".hh.cmd");
+  fs::remove(cmdfile);
+
+  std::string cmd = _build_command();
+  Popen p;
+  p.popen(cmd);
+  if (p.exit_code()) {
+    fs::remove(precompiled_header());
+    std::stringstream msg;
+    msg << "Error building precompiled header: " << precompiled_header()
+        << "\n"
+        << "Attempted: " << cmd << "\n"
+        << p.gets();
+    throw std::runtime_error(msg.str());
+  }
+
+  std::ofstream out(cmdfile.string());
+  out << cmd;
+}
+
+/// \brief Compiler option that includes the header, and so uses the
+/// precompiled header if it is valid
+///
+/// If the precompiled header is missing or can not be used with the current
+/// compile options, the compiler silently parses the header instead.
+std::string PrecompiledHeader::include_option() const {
+  return "-include " + header().string();
+}
+
+std::string PrecompiledHeader::_header_contents() const {
+  std::stringstream ss;
+  ss << "// Generated by CASM. Do not edit.\n";
+  for (auto const &include : m_includes) {
+    ss << "#include " << include << "\n";
+  }
+  return ss.str();
+}
+
+std::string PrecompiledHeader::_build_command() const {
+  return m_compile_options + " -x c++-header -MD -MF " +
+         (m_dir / (m_name + ".hh.d")).string() + " -o " +
+         precompiled_header().string() + " -c " + header().string();
+}
+
+}  // namespace CASM
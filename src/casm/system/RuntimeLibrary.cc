@@ -166,6 +166,14 @@ std::vector<std::string> _soflags_env() {
   return std::vector<std::string>{"CASM_SOFLAGS"};
 }
 
+std::vector<std::string> _pch_env() {
+  return std::vector<std::string>{"CASM_PCH"};
+}
+
+std::vector<std::string> _pgo_env() {
+  return std::vector<std::string>{"CASM_PGO"};
+}
+
 // std::vector<std::string> _casm_env() {
 //   return std::vector<std::string> {
 //     "CASM_PREFIX"
@@ -268,6 +276,36 @@ std::pair<std::string, std::string> RuntimeLibrary::default_cxx() {
   return _use_env(_cxx_env(), "g++");
 }
 
+/// \brief Return default precompiled header mode and specifying variable
+///
+/// \returns "$CASM_PCH" if environment variable CASM_PCH exists, otherwise
+///          "on". Use "off" to compile clexulators without a precompiled
+///          header.
+std::pair<std::string, std::string> RuntimeLibrary::default_pch_mode() {
+  return _use_env(_pch_env(), "on");
+}
+
+/// \brief Return default profile-guided optimization mode and specifying
+/// variable
+///
+/// \returns "$CASM_PGO" if environment variable CASM_PGO exists, otherwise
+///          "off"
+///
+/// Profile-guided optimization of clexulators is a two step process:
+/// 1. Compile with `CASM_PGO=generate`, which instruments the clexulator. Then
+///    run a representative training calculation, for example `casm query -k
+///    corr` or a short Monte Carlo run. Profile data is written to the "pgo"
+///    subdirectory of the clexulator directory.
+/// 2. Remove the compiled clexulator ("*.o", "*.so") and compile with
+///    `CASM_PGO=use`, which uses the profile data to optimize the clexulator
+///    used for production calculations.
+///
+/// Clexulators are only compiled if the shared library does not already exist,
+/// so the compiled clexulator must be removed when changing modes.
+std::pair<std::string, std::string> RuntimeLibrary::default_pgo_mode() {
+  return _use_env(_pgo_env(), "off");
+}
+
 /// \brief Default c++ compiler options
 ///
 /// \returns "-O3 -Wall -fPIC --std=c++17"
@@ -0,0 +1,91 @@
+#include "gtest/gtest.h"
+
+/// What is being tested:
+#include "casm/clex/ConfigEnumCanonicalOccupations.hh"
+
+/// What is being used to test it:
+#include "casm/clex/ConfigEnumAllOccupations.hh"
+#include "casm/clex/Supercell.hh"
+#include "casm/crystallography/Structure.hh"
+#include "casm/enumerator/ConfigEnumInput.hh"
+#include "crystallography/TestStructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+std::vector<std::vector<int>> as_vectors(
+    std::vector<Configuration> const &configurations) {
+  std::vector<std::vector<int>> result;
+  for (auto const &configuration : configurations) {
+    Eigen::VectorXi const &occ = configuration.occupation();
+    result.emplace_back(occ.data(), occ.data() + occ.size());
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+/// Check that ConfigEnumCanonicalOccupations enumerates the same
+/// configurations as ConfigEnumAllOccupations, without duplicates
+void check_same_as_all_occupations(
+    std::shared_ptr<Structure const> const &shared_prim,
+    Eigen::Matrix3l const &T, bool primitive_only) {
+  Supercell supercell{shared_prim, T};
+  ConfigEnumInput initial_state{supercell};
+
+  ConfigEnumAllOccupations all_enumerator{initial_state, primitive_only, true};
+  std::vector<Configuration> expected{all_enumerator.begin(),
+                                      all_enumerator.end()};
+
+  ConfigEnumCanonicalOccupations enumerator{initial_state, primitive_only};
+  EXPECT_EQ(is_guaranteed_for_database_insert(enumerator), primitive_only);
+  std::vector<Configuration> found{enumerator.begin(), enumerator.end()};
+
+  auto found_occ = as_vectors(found);
+  EXPECT_TRUE(std::adjacent_find(found_occ.begin(), found_occ.end()) ==
+              found_occ.end());
+  EXPECT_EQ(found_occ, as_vectors(expected));
+  for (auto const &configuration : found) {
+    EXPECT_TRUE(configuration.is_canonical());
+  }
+}
+
+}  // namespace
+
+TEST(ConfigEnumCanonicalOccupationsTest, ZrO) {
+  auto shared_prim = std::make_shared<Structure const>(test::ZrO_prim());
+  Eigen::Matrix3l T;
+
+  T = Eigen::Matrix3l::Identity();
+  check_same_as_all_occupations(shared_prim, T, true);
+
+  T << 1, 0, 0, 0, 1, 0, 0, 0, 2;
+  check_same_as_all_occupations(shared_prim, T, true);
+  check_same_as_all_occupations(shared_prim, T, false);
+
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+  check_same_as_all_occupations(shared_prim, T, true);
+}
+
+TEST(ConfigEnumCanonicalOccupationsTest, FCCTernary) {
+  auto shared_prim =
+      std::make_shared<Structure const>(test::FCC_ternary_prim());
+  Eigen::Matrix3l T;
+
+  T << -1, 1, 1, 1, -1, 1, 1, 1, -1;
+  check_same_as_all_occupations(shared_prim, T, true);
+  check_same_as_all_occupations(shared_prim, T, false);
+
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+  check_same_as_all_occupations(shared_prim, T, true);
+}
+
+TEST(ConfigEnumCanonicalOccupationsTest, RequiresAllSites) {
+  auto shared_prim = std::make_shared<Structure const>(test::ZrO_prim());
+  auto shared_supercell = std::make_shared<Supercell const>(
+      shared_prim, Eigen::Matrix3l::Identity());
+  Configuration configuration{shared_supercell};
+  ConfigEnumInput initial_state{configuration, std::set<Index>{2}};
+  EXPECT_THROW(ConfigEnumCanonicalOccupations{initial_state},
+               std::runtime_error);
+}
@@ -0,0 +1,111 @@
+#include "gtest/gtest.h"
+
+/// What is being tested:
+#include "casm/clex/ConfigFingerprint.hh"
+
+/// What is being used to test it:
+#include "casm/clex/Configuration_impl.hh"
+#include "casm/crystallography/Structure.hh"
+#include "casm/external/MersenneTwister/MersenneTwister.h"
+#include "crystallography/TestStructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+void set_random_occupation(Configuration &config, MTRand &mtrand) {
+  for (Index l = 0; l < config.size(); ++l) {
+    Index n_occ = config.supercell().max_allowed_occupation()[l] + 1;
+    config.set_occ(l, mtrand.randInt(n_occ - 1));
+  }
+}
+
+/// Check that the fingerprint is invariant under all supercell permutations,
+/// for random occupations
+void check_fingerprint_invariance(
+    std::shared_ptr<Structure const> const &shared_prim,
+    Eigen::Matrix3l const &T, Index n_trials) {
+  auto shared_supercell = std::make_shared<Supercell const>(shared_prim, T);
+  SupercellSymInfo const &sym_info = shared_supercell->sym_info();
+  ConfigFingerprintCalculator fingerprint(*shared_supercell);
+  Configuration config(shared_supercell);
+
+  // the Supercell constructs its calculator once
+  EXPECT_EQ(&shared_supercell->fingerprint_calculator(),
+            &shared_supercell->fingerprint_calculator());
+
+  MTRand mtrand(MTRand::uint32(0));
+  for (Index trial = 0; trial < n_trials; ++trial) {
+    set_random_occupation(config, mtrand);
+    std::uint64_t expected = fingerprint(config.configdof());
+    EXPECT_EQ(symmetry_fingerprint(config), expected);
+    for (auto it = sym_info.permute_begin(); it != sym_info.permute_end();
+         ++it) {
+      Configuration equiv = copy_apply(it, config);
+      EXPECT_EQ(fingerprint(equiv.configdof()), expected);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(ConfigFingerprintTest, FCCTernaryInvariance) {
+  auto shared_prim =
+      std::make_shared<Structure const>(test::FCC_ternary_prim());
+
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+  check_fingerprint_invariance(shared_prim, T, 5);
+
+  T << -1, 1, 1, 1, -1, 1, 3, 3, -3;
+  check_fingerprint_invariance(shared_prim, T, 5);
+}
+
+TEST(ConfigFingerprintTest, ZrOInvariance) {
+  auto shared_prim = std::make_shared<Structure const>(test::ZrO_prim());
+
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 1;
+  check_fingerprint_invariance(shared_prim, T, 5);
+}
+
+TEST(ConfigFingerprintTest, DistinctConfigurations) {
+  auto shared_prim =
+      std::make_shared<Structure const>(test::FCC_ternary_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+  auto shared_supercell = std::make_shared<Supercell const>(shared_prim, T);
+  ConfigFingerprintCalculator fingerprint(*shared_supercell);
+
+  // different compositions
+  Configuration config_a(shared_supercell);
+  Configuration config_b(shared_supercell);
+  Index l_origin =
+      shared_supercell->linear_index(xtal::UnitCellCoord(0, 0, 0, 0));
+  config_b.set_occ(l_origin, 1);
+  EXPECT_NE(fingerprint(config_a.configdof()),
+            fingerprint(config_b.configdof()));
+
+  // same composition: B-B nearest neighbors (config_b) vs. B-B second
+  // nearest neighbors (config_d)
+  Index l_nn = shared_supercell->linear_index(xtal::UnitCellCoord(0, 1, 0, 0));
+  Index l_2nn =
+      shared_supercell->linear_index(xtal::UnitCellCoord(0, -1, 1, 1));
+  config_b.set_occ(l_nn, 1);
+  Configuration config_d(shared_supercell);
+  config_d.set_occ(l_origin, 1);
+  config_d.set_occ(l_2nn, 1);
+  EXPECT_NE(fingerprint(config_b.configdof()),
+            fingerprint(config_d.configdof()));
+  EXPECT_FALSE(config_b.is_sym_equivalent(config_d));
+
+  // fingerprint pre-filter is consistent with canonical form comparison
+  MTRand mtrand(MTRand::uint32(0));
+  for (Index trial = 0; trial < 10; ++trial) {
+    set_random_occupation(config_a, mtrand);
+    set_random_occupation(config_b, mtrand);
+    bool expected = config_a.canonical_form() == config_b.canonical_form();
+    EXPECT_EQ(config_a.is_sym_equivalent(config_b), expected);
+    EXPECT_TRUE(config_a.is_sym_equivalent(config_a.canonical_form()));
+  }
+}
@@ -70,6 +70,7 @@ TEST(ConfigIOTest, DatumFormatters) {
   // String
   check(configname());
   check(scelname());
+  check(fingerprint());
 
   // Boolean
   check(OnHull());
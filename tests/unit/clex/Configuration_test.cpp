@@ -582,3 +582,40 @@ TEST(ConfigurationTest, TestConfigurationName) {
     }
   }
 }
+
+TEST(ConfigurationTest, FindTranslation) {
+  // compare the occupation-only translation check against ConfigIsEquivalent
+  auto shared_prim =
+      std::make_shared<Structure const>(test::FCC_ternary_prim());
+  std::vector<Eigen::Matrix3l> transformation_matrices(3);
+  transformation_matrices[0] << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+  transformation_matrices[1] << -1, 1, 1, 1, -1, 1, 3, 3, -3;
+  transformation_matrices[2] << 1, 0, 0, 0, 2, 0, 0, 0, 6;
+
+  for (auto const &T : transformation_matrices) {
+    auto shared_supercell = std::make_shared<Supercell const>(shared_prim, T);
+    SupercellSymInfo const &sym_info = shared_supercell->sym_info();
+    Index n_unitcells = sym_info.superlattice().size();
+
+    // periodic configurations, built by tiling a pattern over the unit cells
+    // with unit cell index divisible by `period`
+    for (Index period = 1; period <= n_unitcells; ++period) {
+      if (n_unitcells % period) {
+        continue;
+      }
+      Configuration config{shared_supercell};
+      Eigen::VectorXi occupation = config.occupation();
+      for (Index l = 0; l < occupation.size(); ++l) {
+        occupation(l) = (l % period) % 3;
+      }
+      config.set_occupation(occupation);
+
+      ConfigIsEquivalent f(config, config.crystallography_tol());
+      auto begin = sym_info.translate_begin();
+      auto end = sym_info.translate_end();
+      auto expected = std::find_if(++begin, end, f);
+      EXPECT_EQ(config.find_translation(), expected);
+      EXPECT_EQ(config.is_primitive(), expected == end);
+    }
+  }
+}
@@ -0,0 +1,105 @@
+#include "gtest/gtest.h"
+
+/// What is being tested:
+#include "casm/clex/CorrelationCache.hh"
+
+/// What is being used to test it:
+#include <boost/filesystem.hpp>
+
+#include "Common.hh"
+#include "casm/clex/ConfigDoF.hh"
+#include "casm/clex/Configuration.hh"
+#include "casm/clex/Supercell.hh"
+#include "casm/crystallography/Structure.hh"
+#include "crystallography/TestStructures.hh"
+
+using namespace CASM;
+
+TEST(CorrelationCacheTest, InsertAndFind) {
+  test::TmpDir tmpdir;
+  fs::path location = tmpdir.path() / "correlations" / "bset.bin";
+
+  Eigen::VectorXd corr_A(3);
+  corr_A << 1.0, 0.5, 0.25;
+  Eigen::VectorXd corr_B(3);
+  corr_B << 1.0, -0.5, 0.125;
+
+  {
+    CorrelationCache cache(location, 1234, 3);
+    EXPECT_EQ(cache.size(), 0);
+    cache.insert("SCEL1_1_1_1_0_0_0/0", 11, corr_A);
+    cache.insert("SCEL2_2_1_1_0_0_0/1", 22, corr_B);
+    EXPECT_EQ(cache.size(), 2);
+
+    double const *found = cache.find("SCEL1_1_1_1_0_0_0/0", 11);
+    ASSERT_TRUE(found != nullptr);
+    EXPECT_TRUE(almost_equal(Eigen::Map<Eigen::VectorXd const>(found, 3),
+                             corr_A));
+
+    // rows with a different DoF hash are not returned
+    EXPECT_TRUE(cache.find("SCEL1_1_1_1_0_0_0/0", 12) == nullptr);
+    EXPECT_TRUE(cache.find("SCEL1_1_1_1_0_0_0/1", 11) == nullptr);
+
+    // replace an existing row
+    cache.insert("SCEL1_1_1_1_0_0_0/0", 12, corr_B);
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_TRUE(cache.find("SCEL1_1_1_1_0_0_0/0", 11) == nullptr);
+
+    EXPECT_THROW(cache.insert("SCEL1_1_1_1_0_0_0/2", 33, Eigen::VectorXd(2)),
+                 std::runtime_error);
+    cache.commit();
+  }
+  EXPECT_TRUE(fs::exists(location));
+
+  // read back from file
+  {
+    CorrelationCache cache(location, 1234, 3);
+    EXPECT_EQ(cache.size(), 2);
+    double const *found = cache.find("SCEL2_2_1_1_0_0_0/1", 22);
+    ASSERT_TRUE(found != nullptr);
+    EXPECT_TRUE(almost_equal(Eigen::Map<Eigen::VectorXd const>(found, 3),
+                             corr_B));
+  }
+
+  // a different key, as after the basis set changes, ignores the file
+  {
+    CorrelationCache cache(location, 4321, 3);
+    EXPECT_EQ(cache.size(), 0);
+  }
+}
+
+TEST(CorrelationCacheTest, MergeOnCommit) {
+  test::TmpDir tmpdir;
+  fs::path location = tmpdir.path() / "bset.bin";
+
+  Eigen::VectorXd corr = Eigen::VectorXd::Ones(2);
+
+  // Two caches open the same file, as separate processes would
+  CorrelationCache cache_A(location, 1234, 2);
+  CorrelationCache cache_B(location, 1234, 2);
+  cache_A.insert("A", 1, corr);
+  cache_A.commit();
+  cache_B.insert("B", 2, corr);
+  cache_B.commit();
+
+  CorrelationCache cache(location, 1234, 2);
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_TRUE(cache.find("A", 1) != nullptr);
+  EXPECT_TRUE(cache.find("B", 2) != nullptr);
+}
+
+TEST(CorrelationCacheTest, ConfigDoFHash) {
+  auto shared_prim = std::make_shared<Structure const>(test::ZrO_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 1, 0, 0, 0, 1;
+  auto shared_supercell = std::make_shared<Supercell const>(shared_prim, T);
+
+  Configuration config_A(shared_supercell);
+  Configuration config_B(shared_supercell);
+  EXPECT_EQ(configdof_hash(config_A.configdof()),
+            configdof_hash(config_B.configdof()));
+
+  config_B.set_occ(4, 1);
+  EXPECT_NE(configdof_hash(config_A.configdof()),
+            configdof_hash(config_B.configdof()));
+}
@@ -4,6 +4,7 @@
 #include "casm/clex/ClexBasisFunctionInfo_impl.hh"
 #include "casm/clex/ClexBasis_impl.hh"
 #include "casm/clex/Clexulator.hh"
+#include "casm/clex/ClexulatorContext.hh"
 #include "casm/clex/ConfigCorrelations.hh"
 #include "casm/clex/Configuration.hh"
 #include "casm/clex/NeighborhoodInfo_impl.hh"
@@ -518,6 +519,82 @@ void assert_correlations_equivalence(PrimClex const &primclex,
     ASSERT_TRUE(almost_equal(C_corr_restricted(i), 0.));
   }
 
+  // -- check correlations evaluated with a ClexulatorContext --
+  ClexulatorContext context(clexulator);
+  Eigen::VectorXd C_corr_context;
+  correlations(C_corr_context, configdof, supercell_neighbor_list, context);
+  assert_equal(*neighborhood_info, clex_basis_function_info, C_corr, "C_corr",
+               C_corr_context, "C_corr_context");
+
+  Eigen::VectorXd C_ext_corr_context;
+  extensive_correlations(C_ext_corr_context, configdof, supercell_neighbor_list,
+                         context);
+  assert_equal(*neighborhood_info, clex_basis_function_info, C_ext_corr,
+               "C_ext_corr", C_ext_corr_context, "C_ext_corr_context");
+
+  // -- check delta correlations evaluated with a ClexulatorContext --
+  // (first site of each sublattice)
+  Eigen::VectorXi max_allowed =
+      configuration.supercell().max_allowed_occupation();
+  auto const &all_indices = context.all_correlation_indices();
+  for (Index l = 0; l < configdof.size(); l += configdof.n_vol()) {
+    if (max_allowed(l) == 0) {
+      continue;
+    }
+    int curr_occ = configdof.occ(l);
+    int new_occ = (curr_occ == 0) ? 1 : 0;
+    Eigen::VectorXd C_dcorr;
+    restricted_delta_corr(C_dcorr, l, new_occ, configdof,
+                          supercell_neighbor_list, clexulator,
+                          all_indices.data(), end_ptr(all_indices));
+
+    Eigen::VectorXd C_dcorr_context;
+    restricted_delta_corr(C_dcorr_context, l, new_occ, configdof,
+                          supercell_neighbor_list, context, all_indices.data(),
+                          end_ptr(all_indices));
+    assert_equal(*neighborhood_info, clex_basis_function_info, C_dcorr,
+                 "C_dcorr", C_dcorr_context, "C_dcorr_context");
+    ASSERT_EQ(configdof.occ(l), curr_occ);
+  }
+
+  // -- check batched correlations --
+  std::vector<ConfigDoF const *> batch_configdof(5, &configdof);
+  Eigen::MatrixXdRowMajor C_batch_corr;
+  Index n_threads = 2;
+  correlations(C_batch_corr, batch_configdof, supercell_neighbor_list,
+               clexulator, n_threads);
+  ASSERT_EQ(C_batch_corr.rows(), batch_configdof.size());
+  ASSERT_EQ(C_batch_corr.cols(), clexulator.corr_size());
+  for (Index i = 0; i < C_batch_corr.rows(); ++i) {
+    Eigen::VectorXd row = C_batch_corr.row(i);
+    assert_equal(*neighborhood_info, clex_basis_function_info, C_corr,
+                 "C_corr", row, "C_batch_corr");
+  }
+
+  // -- check restricted batched correlations --
+  restricted_correlations(C_batch_corr, batch_configdof,
+                          supercell_neighbor_list, clexulator,
+                          correlation_indices.data(),
+                          end_ptr(correlation_indices), n_threads);
+  std::vector<Configuration const *> batch_configurations(3, &configuration);
+  Eigen::MatrixXdRowMajor C_batch_config_corr;
+  restricted_correlations(C_batch_config_corr, batch_configurations,
+                          clexulator, correlation_indices.data(),
+                          end_ptr(correlation_indices), n_threads);
+  ASSERT_EQ(C_batch_config_corr.rows(), batch_configurations.size());
+  for (Index i = 0; i < C_batch_corr.rows(); ++i) {
+    Eigen::VectorXd row = C_batch_corr.row(i);
+    assert_equal(*neighborhood_info, clex_basis_function_info,
+                 C_corr_restricted, "C_corr_restricted", row,
+                 "C_batch_corr_restricted");
+  }
+  for (Index i = 0; i < C_batch_config_corr.rows(); ++i) {
+    Eigen::VectorXd row = C_batch_config_corr.row(i);
+    assert_equal(*neighborhood_info, clex_basis_function_info,
+                 C_corr_restricted, "C_corr_restricted", row,
+                 "C_batch_config_corr_restricted");
+  }
+
   Index volume = configuration.supercell().volume();
 
   Eigen::VectorXd sum;
@@ -0,0 +1,76 @@
+#include "gtest/gtest.h"
+
+/// What is being tested:
+#include "casm/clex/OccupationCanonicalForm.hh"
+
+/// What is being used to test it:
+#include "casm/clex/Configuration_impl.hh"
+#include "casm/crystallography/Structure.hh"
+#include "casm/external/MersenneTwister/MersenneTwister.h"
+#include "crystallography/TestStructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+/// Check the pruned search against brute force over all PermuteIterator, for
+/// random occupations
+void check_occupation_canonical_form(
+    std::shared_ptr<Structure const> const &shared_prim,
+    Eigen::Matrix3l const &T, Index n_trials) {
+  auto shared_supercell = std::make_shared<Supercell const>(shared_prim, T);
+  SupercellSymInfo const &sym_info = shared_supercell->sym_info();
+  Configuration config(shared_supercell);
+  ASSERT_TRUE(is_occupation_only(config.configdof(), sym_info));
+
+  MTRand mtrand(MTRand::uint32(0));
+  Index n_canonical = 0;
+  for (Index trial = 0; trial < n_trials; ++trial) {
+    // use few distinct values, so that there are many ties
+    for (Index l = 0; l < config.size(); ++l) {
+      Index n_occ = shared_supercell->max_allowed_occupation()[l] + 1;
+      config.set_occ(l, mtrand.randInt(n_occ - 1));
+    }
+    if (trial % 3 == 0) {
+      config = config.canonical_form();
+    }
+
+    auto expected = *std::max_element(sym_info.permute_begin(),
+                                      sym_info.permute_end(), config.less());
+    auto result = occupation_to_canonical(config.occupation(), sym_info);
+    EXPECT_EQ(result.factor_group_index(), expected.factor_group_index());
+    EXPECT_EQ(result.translation_index(), expected.translation_index());
+
+    bool expected_is_canonical = std::none_of(
+        sym_info.permute_begin(), sym_info.permute_end(), config.less());
+    EXPECT_EQ(occupation_is_canonical(config.occupation(), sym_info),
+              expected_is_canonical);
+    EXPECT_EQ(config.is_canonical(), expected_is_canonical);
+    if (expected_is_canonical) {
+      ++n_canonical;
+    }
+  }
+  EXPECT_GT(n_canonical, 0);
+}
+
+}  // namespace
+
+TEST(OccupationCanonicalFormTest, FCCTernary) {
+  auto shared_prim =
+      std::make_shared<Structure const>(test::FCC_ternary_prim());
+
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+  check_occupation_canonical_form(shared_prim, T, 30);
+
+  T << -1, 1, 1, 1, -1, 1, 3, 3, -3;
+  check_occupation_canonical_form(shared_prim, T, 30);
+}
+
+TEST(OccupationCanonicalFormTest, ZrO) {
+  auto shared_prim = std::make_shared<Structure const>(test::ZrO_prim());
+
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 1;
+  check_occupation_canonical_form(shared_prim, T, 30);
+}
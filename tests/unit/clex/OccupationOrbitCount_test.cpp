@@ -0,0 +1,81 @@
+#include "gtest/gtest.h"
+
+/// What is being tested:
+#include "casm/clex/OccupationOrbitCount.hh"
+
+/// What is being used to test it:
+#include "casm/clex/ConfigEnumAllOccupations.hh"
+#include "casm/clex/Supercell.hh"
+#include "casm/crystallography/Structure.hh"
+#include "casm/enumerator/ConfigEnumInput.hh"
+#include "crystallography/TestStructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+/// Check the Burnside counts against the number of canonical configurations,
+/// including and excluding non-primitive, found by enumeration
+void check_orbit_count(std::shared_ptr<Structure const> const &shared_prim,
+                       Eigen::Matrix3l const &T) {
+  Supercell supercell{shared_prim, T};
+  ConfigEnumInput initial_state{supercell};
+  ConfigEnumAllOccupations enumerator{initial_state, false, true};
+  Index n_canonical = std::distance(enumerator.begin(), enumerator.end());
+  ConfigEnumAllOccupations primitive_enumerator{initial_state, true, true};
+  Index n_primitive_canonical = std::distance(primitive_enumerator.begin(),
+                                              primitive_enumerator.end());
+
+  Eigen::VectorXi max_allowed = supercell.max_allowed_occupation();
+  EXPECT_EQ(count_occupation_orbits(supercell.sym_info(), max_allowed),
+            n_canonical);
+  EXPECT_EQ(
+      count_primitive_occupation_orbits(supercell.sym_info(), max_allowed),
+      n_primitive_canonical);
+}
+
+}  // namespace
+
+TEST(OccupationOrbitCountTest, CountOccupations) {
+  Eigen::VectorXi max_allowed(3);
+  max_allowed << 0, 1, 2;
+  EXPECT_EQ(count_occupations(max_allowed), 6);
+
+  // exceeds 64-bit integers
+  max_allowed = Eigen::VectorXi::Constant(128, 2);
+  EXPECT_EQ(count_occupations(max_allowed),
+            boost::multiprecision::pow(
+                boost::multiprecision::cpp_int(3), 128));
+}
+
+TEST(OccupationOrbitCountTest, ZrO) {
+  auto shared_prim = std::make_shared<Structure const>(test::ZrO_prim());
+  Eigen::Matrix3l T;
+
+  T = Eigen::Matrix3l::Identity();
+  check_orbit_count(shared_prim, T);
+
+  T << 1, 0, 0, 0, 1, 0, 0, 0, 2;
+  check_orbit_count(shared_prim, T);
+
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+  check_orbit_count(shared_prim, T);
+}
+
+TEST(OccupationOrbitCountTest, FCCTernary) {
+  auto shared_prim =
+      std::make_shared<Structure const>(test::FCC_ternary_prim());
+  Eigen::Matrix3l T;
+
+  T << -1, 1, 1, 1, -1, 1, 1, 1, -1;
+  check_orbit_count(shared_prim, T);
+
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+  check_orbit_count(shared_prim, T);
+
+  T << 1, 0, 0, 0, 1, 0, 0, 0, 4;
+  check_orbit_count(shared_prim, T);
+
+  T << 1, 0, 0, 0, 1, 0, 0, 0, 6;
+  check_orbit_count(shared_prim, T);
+}
@@ -0,0 +1,76 @@
+#include "gtest/gtest.h"
+
+/// What is being tested:
+#include "casm/clex/HasCanonicalForm_impl.hh"
+
+/// What is being used to test it:
+#include "casm/clex/Configuration_impl.hh"
+#include "casm/crystallography/Structure.hh"
+#include "casm/external/MersenneTwister/MersenneTwister.h"
+#include "crystallography/TestStructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+bool same_permutation(PermuteIterator const &A, PermuteIterator const &B) {
+  return A.factor_group_index() == B.factor_group_index() &&
+         A.translation_index() == B.translation_index();
+}
+
+/// Check that parallel evaluation gives the same results as serial evaluation
+void check_parallel_canonical_form(
+    std::shared_ptr<Structure const> const &shared_prim,
+    Eigen::Matrix3l const &T, Index n_trials) {
+  auto shared_supercell = std::make_shared<Supercell const>(shared_prim, T);
+  SupercellSymInfo const &sym_info = shared_supercell->sym_info();
+  Configuration config(shared_supercell);
+
+  // a vector range, so that the pruned occupation-only search is not used
+  std::vector<PermuteIterator> group(sym_info.permute_begin(),
+                                     sym_info.permute_end());
+  ASSERT_GE(group.size(),
+            2 * ConfigCanonicalForm_impl::min_permutations_per_thread);
+
+  MTRand mtrand(MTRand::uint32(0));
+  for (Index trial = 0; trial < n_trials; ++trial) {
+    // use few distinct values and symmetric configurations, so that there are
+    // many ties
+    for (Index l = 0; l < config.size(); ++l) {
+      config.set_occ(l, trial == 0 ? 0 : mtrand.randInt(1));
+    }
+    if (trial % 2 == 0) {
+      config = config.canonical_form();
+    }
+
+    for (Index n_threads : {2, 3, 8}) {
+      EXPECT_TRUE(same_permutation(
+          config.to_canonical(group.begin(), group.end(), n_threads),
+          config.to_canonical(group.begin(), group.end(), 1)));
+      EXPECT_TRUE(same_permutation(
+          config.from_canonical(group.begin(), group.end(), n_threads),
+          config.from_canonical(group.begin(), group.end(), 1)));
+
+      auto parallel_subgroup = config.invariant_subgroup(
+          sym_info.permute_begin(), sym_info.permute_end(), n_threads);
+      auto serial_subgroup = config.invariant_subgroup(
+          sym_info.permute_begin(), sym_info.permute_end(), 1);
+      ASSERT_EQ(parallel_subgroup.size(), serial_subgroup.size());
+      for (Index i = 0; i < serial_subgroup.size(); ++i) {
+        EXPECT_TRUE(
+            same_permutation(parallel_subgroup[i], serial_subgroup[i]));
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST(ParallelCanonicalFormTest, FCCTernary) {
+  auto shared_prim =
+      std::make_shared<Structure const>(test::FCC_ternary_prim());
+
+  Eigen::Matrix3l T;
+  T << 3, 0, 0, 0, 3, 0, 0, 0, 3;
+  check_parallel_canonical_form(shared_prim, T, 6);
+}
@@ -3,6 +3,7 @@
 #include "casm/clex/Clexulator.hh"
 #include "casm/clex/ConfigCorrelations.hh"
 #include "casm/clex/Configuration.hh"
+#include "casm/clex/GlobalDoFCorrelationsPolynomial.hh"
 #include "casm/clex/PrimClex_impl.hh"
 #include "casm/clex/Supercell.hh"
 #include "casm/clex/io/stream/ClexBasis_stream_io.hh"
@@ -66,3 +67,52 @@ TEST_F(StrainClexulatorTest, UseClexulator) {
   Eigen::VectorXd corr = correlations(configuration, clexulator);
   EXPECT_EQ(corr.size(), 11);
 }
+
+TEST_F(StrainClexulatorTest, GlobalDoFCorrelationsPolynomial) {
+  CASM::Configuration configuration{shared_supercell};
+  ConfigDoF configdof = configuration.configdof();
+  SuperNeighborList const &supercell_neighbor_list =
+      configuration.supercell().nlist();
+
+  Clexulator clexulator = primclex_ptr->clexulator(basis_set_name);
+  std::vector<unsigned int> correlation_indices;
+  for (unsigned int i = 0; i < clexulator.corr_size(); ++i) {
+    correlation_indices.push_back(i);
+  }
+
+  Index max_poly_order = 3;
+  GlobalDoFCorrelationsPolynomial polynomial(
+      configdof, supercell_neighbor_list, clexulator, "GLstrain",
+      max_poly_order, correlation_indices.data(), end_ptr(correlation_indices));
+  EXPECT_EQ(polynomial.dim(), 6);
+  EXPECT_EQ(polynomial.exponents().size(), 84);
+
+  Eigen::VectorXd curr_value(6);
+  curr_value << 0.01, 0.02, -0.01, 0.0, 0.005, 0.0;
+  Eigen::VectorXd new_value(6);
+  new_value << 0.02, -0.01, 0.0, 0.01, 0.0, 0.003;
+
+  Eigen::VectorXd expected_curr;
+  configdof.global_dof("GLstrain").set_values(curr_value);
+  extensive_correlations(expected_curr, configdof, supercell_neighbor_list,
+                         clexulator);
+  Eigen::VectorXd curr;
+  polynomial.extensive_correlations(curr, curr_value);
+  EXPECT_TRUE(almost_equal(curr, expected_curr, 1e-8));
+
+  Eigen::VectorXd expected_dcorr;
+  restricted_delta_corr(expected_dcorr, new_value, expected_curr, configdof,
+                        supercell_neighbor_list,
+                        configdof.global_dof("GLstrain"), clexulator,
+                        correlation_indices.data(),
+                        end_ptr(correlation_indices));
+  Eigen::VectorXd dcorr;
+  restricted_delta_corr(dcorr, curr_value, new_value, polynomial);
+  EXPECT_TRUE(almost_equal(dcorr, expected_dcorr, 1e-8));
+
+  // order too low for the basis set
+  EXPECT_THROW(GlobalDoFCorrelationsPolynomial(
+                   configdof, supercell_neighbor_list, clexulator, "GLstrain",
+                   1, correlation_indices.data(), end_ptr(correlation_indices)),
+               std::runtime_error);
+}
@@ -0,0 +1,134 @@
+#include "gtest/gtest.h"
+
+/// What is being tested:
+#include "casm/clex/SupercellLRU.hh"
+
+/// What is being used to test it:
+#include "casm/clex/Supercell.hh"
+#include "casm/crystallography/Structure.hh"
+#include "casm/symmetry/PermuteIterator.hh"
+#include "crystallography/TestStructures.hh"
+
+using namespace CASM;
+
+TEST(SupercellLRUTest, LazySymInfo) {
+  auto shared_prim = std::make_shared<Structure const>(test::ZrO_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 1;
+
+  Supercell supercell(shared_prim, T);
+  EXPECT_EQ(supercell.has_sym_info(), false);
+
+  // accessing the lattice and name does not construct SupercellSymInfo
+  EXPECT_EQ(supercell.volume(), 4);
+  EXPECT_EQ(supercell.transf_mat(), T);
+  EXPECT_EQ(supercell.num_sites(), 16);
+  EXPECT_EQ(supercell.sublat(5), 1);
+  supercell.name();
+  EXPECT_EQ(supercell.has_sym_info(), false);
+
+  EXPECT_EQ(supercell.sym_info().transformation_matrix_to_super(), T);
+  EXPECT_EQ(supercell.has_sym_info(), true);
+  EXPECT_EQ(supercell.sym_info().unitcell_index_converter().total_sites(),
+            supercell.volume());
+
+  // copies construct their own SupercellSymInfo
+  Supercell copy(supercell);
+  EXPECT_EQ(copy.has_sym_info(), false);
+  EXPECT_EQ(copy.factor_group().size(), supercell.factor_group().size());
+}
+
+TEST(SupercellLRUTest, Capacity) {
+  auto shared_prim = std::make_shared<Structure const>(test::ZrO_prim());
+
+  // declared first, so that it outlives the registered Supercell
+  SupercellLRU lru(2);
+
+  std::vector<std::unique_ptr<Supercell>> supercells;
+  for (Index i = 1; i <= 3; ++i) {
+    Eigen::Matrix3l T;
+    T << i, 0, 0, 0, 1, 0, 0, 0, 1;
+    supercells.emplace_back(new Supercell(shared_prim, T));
+  }
+
+  for (auto const &scel : supercells) {
+    scel->set_lru(&lru);
+  }
+  EXPECT_EQ(lru.size(), 0);
+
+  supercells[0]->sym_info();
+  supercells[1]->sym_info();
+  EXPECT_EQ(lru.size(), 2);
+
+  // using supercells[0] makes supercells[1] least recently used
+  supercells[0]->sym_info();
+
+  // accessing a Supercell never releases another
+  supercells[2]->sym_info();
+  EXPECT_EQ(lru.size(), 3);
+  EXPECT_EQ(supercells[1]->has_sym_info(), true);
+
+  // released by shrink
+  EXPECT_EQ(lru.shrink(), 1);
+  EXPECT_EQ(lru.size(), 2);
+  EXPECT_EQ(supercells[0]->has_sym_info(), true);
+  EXPECT_EQ(supercells[1]->has_sym_info(), false);
+  EXPECT_EQ(supercells[2]->has_sym_info(), true);
+
+  // released supercells are re-constructed on use
+  EXPECT_EQ(supercells[1]->sym_info().transformation_matrix_to_super(),
+            supercells[1]->transf_mat());
+  EXPECT_EQ(lru.shrink(), 1);
+  EXPECT_EQ(supercells[0]->has_sym_info(), false);
+
+  lru.set_capacity(1);
+  EXPECT_EQ(lru.size(), 1);
+  EXPECT_EQ(supercells[1]->has_sym_info(), true);
+  EXPECT_EQ(supercells[2]->has_sym_info(), false);
+
+  // destroyed supercells are removed
+  supercells[1].reset();
+  EXPECT_EQ(lru.size(), 0);
+
+  // unlimited capacity does not release
+  lru.set_capacity(0);
+  supercells[0]->sym_info();
+  supercells[2]->sym_info();
+  EXPECT_EQ(lru.shrink(), 0);
+  EXPECT_EQ(lru.size(), 2);
+  EXPECT_EQ(supercells[0]->has_sym_info(), true);
+  EXPECT_EQ(supercells[2]->has_sym_info(), true);
+}
+
+TEST(SupercellLRUTest, Pinned) {
+  auto shared_prim = std::make_shared<Structure const>(test::ZrO_prim());
+  SupercellLRU lru(1);
+
+  std::vector<std::unique_ptr<Supercell>> supercells;
+  for (Index i = 1; i <= 3; ++i) {
+    Eigen::Matrix3l T;
+    T << i, 0, 0, 0, 1, 0, 0, 0, 1;
+    supercells.emplace_back(new Supercell(shared_prim, T));
+    supercells.back()->set_lru(&lru);
+  }
+
+  // a PermuteIterator does not pin its Supercell, so pin it for the loop
+  SupercellPin permute_pin(*supercells[0]);
+  auto permute_it = supercells[0]->sym_info().permute_begin();
+
+  {
+    // a SupercellPin pins its Supercell, so only supercells[2] is released
+    SupercellPin pin(*supercells[1]);
+    supercells[2]->sym_info();
+    EXPECT_EQ(lru.shrink(), 1);
+    EXPECT_EQ(lru.size(), 2);
+    EXPECT_EQ(supercells[1]->has_sym_info(), true);
+    EXPECT_EQ(supercells[2]->has_sym_info(), false);
+  }
+
+  EXPECT_EQ(lru.shrink(), 1);
+  EXPECT_EQ(supercells[0]->has_sym_info(), true);
+  EXPECT_EQ(supercells[1]->has_sym_info(), false);
+  EXPECT_EQ(supercells[2]->has_sym_info(), false);
+  EXPECT_EQ(permute_it.factor_group_index(), 0);
+}
@@ -0,0 +1,118 @@
+#include "gtest/gtest.h"
+
+/// What is being tested:
+#include "casm/clex/SupercellSymCache.hh"
+
+/// What is being used to test it:
+#include <boost/filesystem.hpp>
+
+#include "Common.hh"
+#include "casm/clex/NeighborList.hh"
+#include "casm/clex/Supercell.hh"
+#include "casm/crystallography/Structure.hh"
+#include "casm/symmetry/PermuteIterator.hh"
+#include "casm/symmetry/SupercellPermutationTable.hh"
+#include "casm/symmetry/SupercellSymInfo.hh"
+#include "crystallography/TestStructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+std::vector<std::vector<Index>> make_permutations(
+    SupercellSymInfo const &sym_info) {
+  std::vector<std::vector<Index>> result;
+  for (auto it = sym_info.permute_begin(); it != sym_info.permute_end();
+       ++it) {
+    std::vector<Index> row;
+    Index n_sites = sym_info.unitcellcoord_index_converter().total_sites();
+    for (Index i = 0; i < n_sites; ++i) {
+      row.push_back(it->permute_ind(i));
+    }
+    result.push_back(row);
+  }
+  return result;
+}
+
+PrimNeighborList make_prim_nlist(Structure const &prim) {
+  std::set<int> sublat_indices;
+  for (int i = 0; i < prim.basis().size(); i++) {
+    sublat_indices.insert(i);
+  }
+  return PrimNeighborList(PrimNeighborList::make_weight_matrix(
+                              prim.lattice().lat_column_mat(), 10, TOL),
+                          sublat_indices.begin(), sublat_indices.end(),
+                          prim.basis().size());
+}
+
+}  // namespace
+
+TEST(SupercellSymCacheTest, SitePermutations) {
+  test::TmpDir tmpdir;
+  auto shared_prim = std::make_shared<Structure const>(test::ZrO_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 1;
+
+  Supercell supercell(shared_prim, T);
+  auto expected = make_permutations(supercell.sym_info());
+
+  SupercellSymCache cache(tmpdir.path() / "supercell", 1234);
+  EXPECT_TRUE(cache.save(supercell.sym_info()));
+  EXPECT_TRUE(fs::exists(cache.sym_path(T)));
+
+  // site permutations are read from the cache
+  Supercell cached_supercell(shared_prim, T);
+  SupercellSymInfo const &sym_info = cached_supercell.sym_info();
+  EXPECT_TRUE(cache.load(sym_info));
+  EXPECT_TRUE(sym_info.permutation_table().layout() ==
+              SupercellPermutationTable::Layout::factored);
+  EXPECT_EQ(make_permutations(sym_info), expected);
+  for (Index f = 0; f < sym_info.factor_group().size(); ++f) {
+    EXPECT_EQ(sym_info.factor_group_permute(f).perm_array(),
+              supercell.sym_info().factor_group_permute(f).perm_array());
+  }
+
+  // other supercells are not in the cache
+  Eigen::Matrix3l T_other;
+  T_other << 1, 0, 0, 0, 1, 0, 0, 0, 2;
+  Supercell other_supercell(shared_prim, T_other);
+  EXPECT_FALSE(cache.load(other_supercell.sym_info()));
+
+  // a different prim hash does not use the files, and removes them
+  SupercellSymCache other_cache(tmpdir.path() / "supercell", 5678);
+  Supercell new_supercell(shared_prim, T);
+  EXPECT_FALSE(other_cache.load(new_supercell.sym_info()));
+  other_cache.remove_stale();
+  EXPECT_FALSE(fs::exists(cache.dir()));
+}
+
+TEST(SupercellSymCacheTest, NeighborList) {
+  test::TmpDir tmpdir;
+  Structure prim(test::FCC_ternary_prim());
+  PrimNeighborList prim_nlist = make_prim_nlist(prim);
+  Eigen::Matrix3l T;
+  T << -1, 1, 1, 1, -1, 1, 3, 3, -3;
+
+  SuperNeighborList super_nlist(T, prim_nlist);
+  SupercellSymCache cache(tmpdir.path() / "supercell", 1234);
+  EXPECT_EQ(cache.load_nlist(T, prim_nlist), nullptr);
+  EXPECT_TRUE(cache.save_nlist(T, prim_nlist, super_nlist));
+
+  auto cached_nlist = cache.load_nlist(T, prim_nlist);
+  ASSERT_NE(cached_nlist, nullptr);
+  ASSERT_EQ(cached_nlist->n_unitcells(), super_nlist.n_unitcells());
+  EXPECT_EQ(cached_nlist->overlaps(), super_nlist.overlaps());
+  for (Index i = 0; i < super_nlist.n_unitcells(); ++i) {
+    EXPECT_EQ(cached_nlist->sites(i), super_nlist.sites(i));
+    EXPECT_EQ(cached_nlist->unitcells(i), super_nlist.unitcells(i));
+  }
+  for (Index l = 0; l < super_nlist.n_unitcells() * prim.basis().size(); ++l) {
+    EXPECT_EQ(cached_nlist->neighbor_index(l), super_nlist.neighbor_index(l));
+  }
+
+  // expanding the prim neighbor list invalidates the cached neighbor list
+  std::set<xtal::UnitCellCoord> nbors;
+  nbors.emplace(0, xtal::UnitCell(3, 0, 0));
+  prim_nlist.expand(nbors.begin(), nbors.end());
+  EXPECT_EQ(cache.load_nlist(T, prim_nlist), nullptr);
+}
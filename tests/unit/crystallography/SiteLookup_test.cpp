@@ -0,0 +1,77 @@
+#include "gtest/gtest.h"
+
+/// What is being tested:
+#include "casm/crystallography/SiteLookup.hh"
+
+/// What is being used to test it:
+#include "casm/crystallography/BasicStructure.hh"
+#include "casm/crystallography/BasicStructureTools.hh"
+#include "casm/crystallography/Site.hh"
+#include "casm/external/MersenneTwister/MersenneTwister.h"
+#include "crystallography/TestStructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+/// Check SiteLookup::find_index against xtal::find_index for basis sites
+/// displaced by random vectors with length near `tol`
+void check_site_lookup(xtal::BasicStructure const &struc, double tol) {
+  std::vector<xtal::Site> const &basis = struc.basis();
+  xtal::SiteLookup lookup(basis, struc.lattice(), tol);
+
+  MTRand mtrand(MTRand::uint32(0));
+  Index n_found = 0;
+  for (Index trial = 0; trial < 20; ++trial) {
+    for (xtal::Site const &site : basis) {
+      Eigen::Vector3d displacement(mtrand.randNorm(), mtrand.randNorm(),
+                                   mtrand.randNorm());
+      displacement *= tol * (0.5 + mtrand.rand()) / displacement.norm();
+      xtal::Site test_site = site;
+      test_site.cart() += displacement;
+      // also test periodic images
+      test_site.frac() += Eigen::Vector3d(mtrand.randInt(2) - 1.,
+                                          mtrand.randInt(2) - 1., 0.);
+
+      Index expected = xtal::find_index(basis, test_site, tol);
+      EXPECT_EQ(lookup.find_index(test_site), expected);
+      if (expected < basis.size()) {
+        ++n_found;
+      }
+    }
+  }
+  // both found and not found cases are checked
+  EXPECT_GT(n_found, 0);
+  EXPECT_LT(n_found, 20 * basis.size());
+}
+
+}  // namespace
+
+TEST(SiteLookupTest, ZrOSuperstructure) {
+  Eigen::Matrix3l T;
+  T << 3, 0, 0, 0, 3, 0, 0, 0, 2;
+  xtal::BasicStructure struc =
+      xtal::make_superstructure(test::ZrO_prim(), T);
+  check_site_lookup(struc, 1e-1);
+  check_site_lookup(struc, 1e-5);
+}
+
+TEST(SiteLookupTest, FCCSkewedSuperstructure) {
+  Eigen::Matrix3l T;
+  T << -1, 1, 1, 1, -1, 1, 3, 3, -3;
+  xtal::BasicStructure struc =
+      xtal::make_superstructure(test::FCC_ternary_prim(), T);
+  check_site_lookup(struc, 1e-1);
+}
+
+TEST(SiteLookupTest, Insert) {
+  xtal::BasicStructure struc = test::ZrO_prim();
+  std::vector<xtal::Site> basis;
+  xtal::SiteLookup lookup(basis, struc.lattice(), TOL);
+  for (xtal::Site const &site : struc.basis()) {
+    EXPECT_EQ(lookup.find_index(site), basis.size());
+    basis.push_back(site);
+    lookup.insert(basis.size() - 1);
+    EXPECT_EQ(lookup.find_index(site), basis.size() - 1);
+  }
+}
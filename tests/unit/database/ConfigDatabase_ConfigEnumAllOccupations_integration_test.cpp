@@ -49,3 +49,66 @@ TEST(ConfigDatabase_ConfigEnumAllOccupations_IntegrationTest, Test1) {
   EXPECT_EQ(number_enumerated.size(), number_expected.size());
   EXPECT_EQ(number_enumerated, number_expected);
 }
+
+TEST(ConfigDatabase_ConfigEnumAllOccupations_IntegrationTest, Test2) {
+  // ConfigEnumAllOccupations: ZrO enumeration, w/ database, inserting
+  // batches of configurations using multiple threads
+
+  auto shared_prim = std::make_shared<Structure const>(test::ZrO_prim());
+  auto title = shared_prim->structure().title();
+  auto project_settings = make_default_project_settings(*shared_prim, title);
+  PrimClex primclex_serial{project_settings, shared_prim};
+  PrimClex primclex_batch{project_settings, shared_prim};
+
+  xtal::ScelEnumProps scel_enum_props{1, 4};
+  ScelEnumByProps supercell_enumerator{shared_prim, scel_enum_props};
+  for (auto const &supercell : supercell_enumerator) {
+    make_canonical_and_insert(supercell_enumerator, supercell,
+                              primclex_serial.db<Supercell>());
+    make_canonical_and_insert(supercell_enumerator, supercell,
+                              primclex_batch.db<Supercell>());
+  }
+
+  bool primitive_only = false;
+  Index n_threads = 2;
+  for (auto const &supercell : primclex_serial.db<Supercell>()) {
+    std::vector<Configuration> batch;
+    ConfigEnumAllOccupations enumerator{supercell};
+    for (auto const &configuration : enumerator) {
+      make_canonical_and_insert(configuration, primclex_serial.db<Supercell>(),
+                                primclex_serial.db<Configuration>(),
+                                primitive_only);
+      batch.push_back(configuration);
+    }
+
+    auto results = DB::make_canonical_and_insert(
+        batch, primclex_batch.db<Supercell>(),
+        primclex_batch.db<Configuration>(), primitive_only, n_threads);
+    EXPECT_EQ(results.size(), batch.size());
+
+    // inserting again finds the same configurations
+    auto repeat_results = DB::make_canonical_and_insert(
+        batch, primclex_batch.db<Supercell>(),
+        primclex_batch.db<Configuration>(), primitive_only, n_threads);
+    ASSERT_EQ(repeat_results.size(), results.size());
+    for (Index i = 0; i < results.size(); ++i) {
+      EXPECT_EQ(repeat_results[i].insert_primitive, false);
+      EXPECT_EQ(repeat_results[i].insert_canonical, false);
+      EXPECT_EQ(repeat_results[i].primitive_it.name(),
+                results[i].primitive_it.name());
+      EXPECT_EQ(repeat_results[i].canonical_it.name(),
+                results[i].canonical_it.name());
+    }
+  }
+
+  // same configurations, with the same names
+  std::vector<std::string> names_serial;
+  for (auto const &configuration : primclex_serial.db<Configuration>()) {
+    names_serial.push_back(configuration.name());
+  }
+  std::vector<std::string> names_batch;
+  for (auto const &configuration : primclex_batch.db<Configuration>()) {
+    names_batch.push_back(configuration.name());
+  }
+  EXPECT_EQ(names_batch, names_serial);
+}
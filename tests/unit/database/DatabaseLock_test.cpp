@@ -0,0 +1,62 @@
+#include "gtest/gtest.h"
+
+/// What is being tested:
+#include "casm/database/DatabaseLock.hh"
+
+/// What is being used to test it:
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+#include <boost/filesystem.hpp>
+
+#include "Common.hh"
+
+using namespace CASM;
+
+namespace {
+
+/// Try to lock the file through another open file description, which
+/// conflicts with the locks held by DatabaseLockFile
+bool can_lock(fs::path const &path, int operation) {
+  int fd = ::open(path.string().c_str(), O_RDWR);
+  bool result = ::flock(fd, operation | LOCK_NB) == 0;
+  ::close(fd);
+  return result;
+}
+
+}  // namespace
+
+TEST(DatabaseLockTest, NestedLocks) {
+  fs::path path = "tests/unit/database/test.lock";
+  {
+    DB::DatabaseLockFile file(path);
+    EXPECT_THROW(file.unlock(), std::runtime_error);
+
+    {
+      DB::DatabaseLock shared(&file, DB::DatabaseLock::Mode::shared);
+      EXPECT_TRUE(fs::exists(path));
+      EXPECT_TRUE(can_lock(path, LOCK_SH));
+      EXPECT_FALSE(can_lock(path, LOCK_EX));
+
+      {
+        // upgrade, until released
+        DB::DatabaseLock exclusive(&file, DB::DatabaseLock::Mode::exclusive);
+        EXPECT_FALSE(can_lock(path, LOCK_SH));
+
+        // nested shared lock does not downgrade
+        DB::DatabaseLock nested(&file, DB::DatabaseLock::Mode::shared);
+        EXPECT_FALSE(can_lock(path, LOCK_SH));
+      }
+      EXPECT_TRUE(can_lock(path, LOCK_SH));
+      EXPECT_FALSE(can_lock(path, LOCK_EX));
+    }
+    EXPECT_TRUE(can_lock(path, LOCK_EX));
+
+    // no lock file
+    DB::DatabaseLock none(nullptr, DB::DatabaseLock::Mode::exclusive);
+    EXPECT_TRUE(can_lock(path, LOCK_EX));
+  }
+  fs::remove(path);
+}
@@ -263,3 +263,50 @@ TEST_F(ImportTest, Test3) {
   // should import properties for original size configurations only
   EXPECT_EQ(primclex->db_props<Configuration>("default").size(), 1);
 }
+
+/// This test includes:
+/// - "n_threads": 4
+/// - each structure listed more than once, so that structures mapping to the
+///   same supercells are mapped by different threads
+TEST_F(ImportTest, Threads) {
+  // ## setup
+  title = "ImportTest_threads";
+  data_dir = test::data_dir("database") / "import_test1";
+  data_files = std::vector<fs::path>(
+      {"AB_Ordering_large_supercell.json", "import_list.txt", "import.json",
+       "prim.json", "pure_A_large_supercell.json"});
+  build();
+
+  fs::path import_list = tmp_dir.path() / "import_list_threads.txt";
+  {
+    std::ofstream file{import_list.string()};
+    for (Index i = 0; i < 4; ++i) {
+      file << "pure_A_large_supercell.json\n"
+           << "AB_Ordering_large_supercell.json\n";
+    }
+  }
+
+  // ## run import
+  std::string cli_str = "casm import --batch " + import_list.string();
+  jsonParser json_options{tmp_dir.path() / "import.json"};
+  json_options["n_threads"] = 4;
+  import(cli_str, json_options);
+
+  // ## post-condition tests
+
+  fs::path report_dir = tmp_dir.path() / "reports" / "import_report.0";
+  fs::path map_success_report = report_dir / "map_success.json";
+  EXPECT_TRUE(fs::exists(map_success_report));
+  EXPECT_FALSE(fs::exists(report_dir / "map_fail.json"));
+
+  // same configurations as importing each structure once
+  jsonParser map_success_json{map_success_report};
+  for (std::string name : {"SCEL54_6_3_3_0_3_3/0", "SCEL54_6_3_3_0_3_3/1",
+                           "SCEL1_1_1_1_0_0_0/0"}) {
+    EXPECT_TRUE(test::find_mapped(map_success_json, name) !=
+                map_success_json.end());
+  }
+
+  EXPECT_EQ(primclex->db<Supercell>().size(), 2);
+  EXPECT_EQ(primclex->db<Configuration>().size(), 3);
+}
@@ -0,0 +1,142 @@
+#include "gtest/gtest.h"
+
+/// What is being tested:
+#include "casm/database/SelectionBitset.hh"
+
+/// What is being used to test it:
+
+#include "Common.hh"
+#include "FCCTernaryProj.hh"
+#include "casm/app/QueryHandler.hh"
+#include "casm/clex/ConfigEnumAllOccupations.hh"
+#include "casm/clex/PrimClex.hh"
+#include "casm/crystallography/Structure.hh"
+#include "casm/database/ConfigDatabase.hh"
+#include "casm/database/ScelDatabase.hh"
+#include "casm/database/Selection.hh"
+#include "casm/enumerator/ConfigEnumInput.hh"
+
+using namespace CASM;
+
+namespace {
+
+/// Selection containing every `step`-th Configuration, starting at
+/// `offset`, all with value `selected`
+DB::Selection<Configuration> make_selection(DB::Database<Configuration> &db,
+                                            Index offset, Index step,
+                                            bool selected) {
+  DB::Selection<Configuration> selection(db, "EMPTY");
+  Index i = 0;
+  for (auto it = db.begin(); it != db.end(); ++it, ++i) {
+    if (i >= offset && (i - offset) % step == 0) {
+      selection.data()[it.name()] = selected;
+    }
+  }
+  return selection;
+}
+
+}  // namespace
+
+TEST(SelectionBitset_Test, SetOperations) {
+  test::FCCTernaryProj proj;
+  proj.check_init();
+
+  ScopedNullLogging logging;
+  PrimClex primclex(proj.dir);
+  const Structure &prim(primclex.prim());
+  auto &db = primclex.db<Configuration>();
+
+  Eigen::Vector3d a, b, c;
+  std::tie(a, b, c) = prim.lattice().vectors();
+  Supercell tscel(&primclex, Lattice(2. * a, 2. * b, c));
+  const Supercell &scel = *tscel.insert().first;
+  ConfigEnumAllOccupations enum_config(scel);
+  for (const auto &config : enum_config) {
+    if (!config.supercell().has_primclex()) {
+      config.supercell().set_primclex(&primclex);
+    }
+    db.insert(config);
+  }
+  ASSERT_EQ(db.size(), 12);
+
+  auto index = std::make_shared<DB::SelectionIndex<Configuration> const>(db);
+  EXPECT_EQ(index->size(), 12);
+  EXPECT_EQ(index->ordinal(index->name(5)), 5);
+  EXPECT_EQ(index->ordinal("none"), -1);
+
+  // A: even ordinals selected; B: every third ordinal selected, plus ordinal 1
+  // included but not selected
+  auto A = make_selection(db, 0, 2, true);
+  auto B = make_selection(db, 0, 3, true);
+  B.data()[index->name(1)] = false;
+
+  DB::SelectionBitset<Configuration> bits_A(index, A);
+  DB::SelectionBitset<Configuration> bits_B(index, B);
+  EXPECT_EQ(bits_A.included_size(), 6);
+  EXPECT_EQ(bits_A.selected_size(), 6);
+  EXPECT_EQ(bits_B.included_size(), 5);
+  EXPECT_EQ(bits_B.selected_size(), 4);
+
+  // and: selected in both, objects only in A keep their value
+  {
+    auto result = bits_A;
+    result &= bits_B;
+    DB::Selection<Configuration> selection(db, "EMPTY");
+    result.to_selection(selection);
+    for (Index i = 0; i < 12; ++i) {
+      bool in_A = (i % 2 == 0);
+      bool in_B = (i % 3 == 0 || i == 1);
+      EXPECT_EQ(result.is_included(i), in_A || in_B);
+      bool expected = in_B ? (in_A && i % 3 == 0) : in_A;
+      EXPECT_EQ(result.is_selected(i), expected);
+      EXPECT_EQ(selection.is_selected(index->name(i)), expected);
+    }
+    EXPECT_EQ(selection.size(), result.included_size());
+  }
+
+  // or
+  {
+    auto result = bits_A;
+    result |= bits_B;
+    for (Index i = 0; i < 12; ++i) {
+      EXPECT_EQ(result.is_selected(i), i % 2 == 0 || i % 3 == 0);
+    }
+    EXPECT_EQ(result.is_included(1), false);
+  }
+
+  // xor
+  {
+    auto result = bits_A;
+    result ^= bits_B;
+    for (Index i = 0; i < 12; ++i) {
+      EXPECT_EQ(result.is_selected(i), (i % 2 == 0) != (i % 3 == 0));
+    }
+  }
+
+  // not, subset
+  {
+    auto result = bits_B;
+    result.flip();
+    EXPECT_EQ(result.selected_size(), 1);
+    EXPECT_EQ(result.is_selected(1), true);
+    result.subset();
+    EXPECT_EQ(result.included_size(), 1);
+  }
+
+  // binary file round trip, through Selection
+  {
+    fs::path path = proj.dir / "test_selection.bin";
+    auto &dict = primclex.settings().query_handler<Configuration>().dict();
+    B.write(dict, path, false, false);
+    DB::Selection<Configuration> read_B(db, path);
+    EXPECT_EQ(read_B.size(), B.size());
+    EXPECT_EQ(read_B.selected_size(), B.selected_size());
+    for (auto const &value : B.data()) {
+      EXPECT_EQ(read_B.is_selected(value.first), value.second);
+    }
+
+    // binary selections are invalid after the database changes
+    db.erase(db.begin());
+    EXPECT_THROW(DB::Selection<Configuration>(db, path), std::runtime_error);
+  }
+}
@@ -0,0 +1,211 @@
+#include "gtest/gtest.h"
+
+/// What is being tested:
+#include "casm/database/journal/columnarPropertiesDatabase.hh"
+
+/// What is being used to test it:
+
+#include <boost/filesystem.hpp>
+
+#include "Common.hh"
+#include "ZrOProj.hh"
+#include "casm/database/json/jsonPropertiesDatabase.hh"
+
+using namespace CASM;
+
+TEST(columnarPropertiesDatabase_Test, Test1) {
+  test::ZrOProj proj;
+  proj.check_init();
+
+  ScopedNullLogging logging;
+  PrimClex primclex(proj.dir);
+  primclex.settings().set_crystallography_tol(1e-5);
+
+  std::string calc_type("test");
+  fs::path loc("tests/unit/database/config_props.bin");
+  DB::columnarPropertiesDatabase db_props(primclex, calc_type, loc);
+
+  db_props.open();
+  EXPECT_EQ(db_props.empty(), true);
+
+  // Insert and erase, as for jsonPropertiesDatabase
+  MappedProperties props;
+  props.origin = "from/0";
+  props.to = "to/0";
+  props.scalar("energy") = 0.1;
+  props.site["test"] = Eigen::MatrixXd::Ones(3, 3);
+
+  auto res = db_props.insert(props);
+  EXPECT_EQ(res.second, true);
+  EXPECT_EQ(db_props.insert(props).second, false);
+  EXPECT_EQ(db_props.size(), 1);
+  EXPECT_EQ(db_props.find_via_origin("from/0")->to, "to/0");
+  EXPECT_EQ(db_props.find_via_to("to/0")->origin, "from/0");
+  EXPECT_EQ(almost_equal(db_props.best_score("to/0"), 0.1), true);
+
+  // Bulk insert, with properties that differ between rows
+  std::vector<MappedProperties> values;
+  props.origin = "from/1";
+  props.to = "to/1";
+  props.scalar("energy") = 0.2;
+  props.site["test"] = Eigen::MatrixXd::Ones(3, 2);
+  values.push_back(props);
+  props.origin = "from/2";
+  props.to = "to/1";
+  props.scalar("energy") = 0.3;
+  props.site.clear();
+  props.global["latvec"] = Eigen::MatrixXd::Identity(3, 3);
+  values.push_back(props);
+  EXPECT_EQ(db_props.insert(values), 2);
+  EXPECT_EQ(db_props.size(), 3);
+  EXPECT_EQ(db_props.all_origins("to/1").size(), 2);
+  EXPECT_EQ(db_props.find_via_to("to/1")->origin, "from/1");
+  EXPECT_EQ(db_props.find_via_origin("from/2")->site.size(), 0);
+  EXPECT_EQ(db_props.find_via_origin("from/2")->global.count("latvec"), 1);
+
+  auto it = db_props.find_via_to("to/1");
+  db_props.erase(it);
+  EXPECT_EQ(db_props.size(), 2);
+  EXPECT_EQ(db_props.find_via_origin("from/1") == db_props.end(), true);
+  EXPECT_EQ(db_props.find_via_to("to/1")->origin, "from/2");
+
+  db_props.commit();
+  EXPECT_EQ(fs::exists(loc), true);
+  db_props.close();
+  EXPECT_EQ(db_props.size(), 0);
+
+  // Re-open, which reads rows without constructing MappedProperties
+  db_props.open();
+  EXPECT_EQ(db_props.size(), 2);
+  EXPECT_EQ(std::distance(db_props.begin(), db_props.end()), 2);
+  EXPECT_EQ(db_props.size_materialized(), 0);
+
+  // Read property values directly from columns
+  auto energy = db_props.global_column("energy");
+  ASSERT_TRUE(energy != nullptr);
+  Index ordinal_0 = db_props.ordinal(db_props.find_via_origin("from/0"));
+  Index ordinal_2 = db_props.ordinal(db_props.find_via_origin("from/2"));
+  EXPECT_EQ(almost_equal(energy->value(ordinal_0)(0, 0), 0.1), true);
+  EXPECT_EQ(almost_equal(energy->value(ordinal_2)(0, 0), 0.3), true);
+  auto site = db_props.site_column("test");
+  ASSERT_TRUE(site != nullptr);
+  EXPECT_EQ(site->has(ordinal_0), true);
+  EXPECT_EQ(site->has(ordinal_2), false);
+  EXPECT_EQ(db_props.global_column("test") == nullptr, true);
+  EXPECT_EQ(db_props.size_materialized(), 0);
+
+  // Dereferencing constructs MappedProperties
+  auto const &value = *db_props.find_via_origin("from/0");
+  EXPECT_EQ(db_props.size_materialized(), 1);
+  EXPECT_EQ(value.to, "to/0");
+  EXPECT_EQ(almost_equal(value.scalar("energy"), 0.1), true);
+  EXPECT_EQ(almost_equal(value.site.at("test"), Eigen::MatrixXd::Ones(3, 3)),
+            true);
+
+  // Insert after re-opening appends to the mapped columns
+  props.origin = "from/3";
+  props.to = "to/3";
+  props.global.clear();
+  props.scalar("energy") = 0.4;
+  db_props.insert(props);
+  EXPECT_EQ(almost_equal(db_props.score("from/3"), 0.4), true);
+  db_props.commit();
+  db_props.close();
+  db_props.open();
+  EXPECT_EQ(db_props.size(), 3);
+  EXPECT_EQ(almost_equal(db_props.best_score("to/3"), 0.4), true);
+  EXPECT_EQ(almost_equal(db_props.best_score("to/1"), 0.3), true);
+  db_props.close();
+
+  fs::remove(loc);
+}
+
+TEST(columnarPropertiesDatabase_Test, ReadJSON) {
+  test::ZrOProj proj;
+  proj.check_init();
+
+  ScopedNullLogging logging;
+  PrimClex primclex(proj.dir);
+
+  std::string calc_type("test");
+  fs::path json_loc("tests/unit/database/config_props_columnar.json");
+  fs::path loc("tests/unit/database/config_props_columnar.bin");
+
+  DB::jsonPropertiesDatabase json_props(primclex, calc_type, json_loc);
+  json_props.open();
+  MappedProperties props;
+  props.origin = "from/0";
+  props.to = "to/0";
+  props.scalar("energy") = 0.1;
+  json_props.insert(props);
+  json_props.commit();
+  json_props.close();
+
+  // Existing JSON properties are read if there is no columnar file yet
+  DB::columnarPropertiesDatabase db_props(primclex, calc_type, loc, json_loc);
+  db_props.open();
+  EXPECT_EQ(db_props.size(), 1);
+  EXPECT_EQ(almost_equal(db_props.best_score("to/0"), 0.1), true);
+  db_props.commit();
+  EXPECT_EQ(fs::exists(loc), true);
+  db_props.close();
+
+  fs::remove(json_loc);
+  db_props.open();
+  EXPECT_EQ(db_props.size(), 1);
+  db_props.close();
+
+  fs::remove(loc);
+}
+
+TEST(columnarPropertiesDatabase_Test, MergeOnCommit) {
+  test::ZrOProj proj;
+  proj.check_init();
+
+  ScopedNullLogging logging;
+  PrimClex primclex(proj.dir);
+
+  std::string calc_type("test");
+  fs::path loc("tests/unit/database/config_props_merge.bin");
+
+  MappedProperties props;
+  props.to = "to/0";
+  props.scalar("energy") = 0.1;
+  props.origin = "from/0";
+
+  // Two writers open the same database, as separate processes would
+  DB::columnarPropertiesDatabase db_A(primclex, calc_type, loc);
+  db_A.open();
+  db_A.insert(props);
+  db_A.commit();
+
+  DB::columnarPropertiesDatabase db_B(primclex, calc_type, loc);
+  db_A.close();
+  db_A.open();
+  db_B.open();
+
+  props.origin = "from/1";
+  db_A.insert(props);
+  db_A.erase_via_origin("from/0");
+  db_A.commit();
+
+  props.origin = "from/2";
+  props.to = "to/2";
+  db_B.insert(props);
+  db_B.commit();
+
+  // db_B was merged with the changes committed by db_A
+  EXPECT_EQ(db_B.size(), 2);
+  EXPECT_TRUE(db_B.find_via_origin("from/0") == db_B.end());
+  EXPECT_EQ(db_B.all_origins("to/0").size(), 1);
+
+  db_A.close();
+  db_A.open();
+  EXPECT_EQ(db_A.size(), 2);
+  EXPECT_EQ(db_A.find_via_to("to/0")->origin, "from/1");
+  EXPECT_EQ(db_A.find_via_to("to/2")->origin, "from/2");
+  db_A.close();
+  db_B.close();
+
+  fs::remove(loc);
+}
@@ -0,0 +1,238 @@
+#include "gtest/gtest.h"
+
+/// What is being tested:
+#include "casm/database/ConfigDatabase.hh"
+#include "casm/database/journal/journalDatabase.hh"
+
+/// What is being used to test it:
+
+#include <boost/filesystem/fstream.hpp>
+
+#include "Common.hh"
+#include "FCCTernaryProj.hh"
+#include "casm/clex/ConfigEnumAllOccupations.hh"
+#include "casm/clex/PrimClex.hh"
+#include "casm/crystallography/CanonicalForm.hh"
+#include "casm/crystallography/Structure.hh"
+#include "casm/database/DatabaseHandler_impl.hh"
+#include "casm/database/ScelDatabase.hh"
+#include "casm/database/Selection.hh"
+#include "casm/enumerator/ConfigEnumInput.hh"
+
+using namespace CASM;
+
+TEST(journalConfigDatabase_Test, Test1) {
+  // Create testing project
+  test::FCCTernaryProj proj;
+  proj.check_init();
+
+  ScopedNullLogging logging;
+  PrimClex primclex(proj.dir);
+  const Structure &prim(primclex.prim());
+  primclex.settings().set_crystallography_tol(1e-5);
+
+  // Make a Configuration database
+  DB::journalDatabase<Configuration> db_config(primclex);
+  db_config.open();
+  EXPECT_EQ(db_config.size(), 0);
+
+  // Supercell are read from the journalDB Supercell database
+  auto &db_scel =
+      primclex.db_handler().db<Supercell>(traits<DB::journalDB>::name);
+  Eigen::Vector3d a, b, c;
+  std::tie(a, b, c) = prim.lattice().vectors();
+  Lattice canonical_lattice = xtal::canonical::equivalent(
+      Lattice(2. * a, 2. * b, c), prim.point_group(), TOL);
+  const Supercell &scel = *db_scel.emplace(&primclex, canonical_lattice).first;
+
+  // Insert and erase a Configuration
+  Configuration config{scel};
+  auto res = db_config.insert(config);
+  EXPECT_EQ(db_config.size(), 1);
+  EXPECT_EQ(db_config.begin()->id(), "0");
+  db_config.erase(res.first);
+  EXPECT_EQ(db_config.size(), 0);
+
+  // Enumerate and insert Configs
+  ConfigEnumAllOccupations enum_config(scel);
+  for (const auto &config : enum_config) {
+    if (!config.supercell().has_primclex()) {
+      config.supercell().set_primclex(&primclex);
+    }
+    db_config.insert(config);
+  }
+  db_config.commit();
+  EXPECT_EQ(db_config.size(), 12);
+  EXPECT_EQ(db_config.begin()->id(), "1");
+
+  // Cache updates are recorded on commit
+  for (const auto &config : db_config) {
+    EXPECT_EQ(config.cache().contains("multiplicity"), false);
+    EXPECT_EQ(config.multiplicity() != 0, true);
+    EXPECT_EQ(config.cache_updated(), true);
+  }
+  db_config.commit();
+  for (const auto &config : db_config) {
+    EXPECT_EQ(config.cache_updated(), false);
+  }
+
+  // Re-open database, which only reads the index
+  db_config.close();
+  EXPECT_EQ(db_config.size(), 0);
+  db_config.open();
+  EXPECT_EQ(db_config.size(), 12);
+  EXPECT_EQ(db_config.size_materialized(), 0);
+
+  // Find by name and read selections without constructing Configuration
+  std::string name = scel.name() + "/5";
+  EXPECT_TRUE(db_config.find(name) != db_config.end());
+  EXPECT_EQ(db_config.find(name).name(), name);
+  EXPECT_TRUE(db_config.find(scel.name() + "/0") == db_config.end());
+  EXPECT_EQ(boost::distance(db_config.scel_range(scel.name())), 12);
+  DB::Selection<Configuration> selection(db_config);
+  EXPECT_EQ(selection.size(), 12);
+  EXPECT_EQ(db_config.size_materialized(), 0);
+
+  // Dereferencing constructs Configuration
+  EXPECT_EQ(db_config.find(name)->name(), name);
+  EXPECT_EQ(db_config.size_materialized(), 1);
+  EXPECT_EQ(db_config.begin()->id(), "1");
+  for (const auto &config : db_config) {
+    EXPECT_EQ(config.cache().contains("multiplicity"), true);
+  }
+  EXPECT_EQ(db_config.size_materialized(), 12);
+
+  // Search constructs Configuration in the same supercell
+  db_config.close();
+  db_config.open();
+  Configuration search_config = *db_config.find(name);
+  EXPECT_EQ(db_config.search(search_config).name(), name);
+  EXPECT_EQ(db_config.size_materialized(), 12);
+
+  // An incomplete record at the end of the journal is ignored
+  DB::journalDB::DirectoryStructure dir(primclex.dir().root_dir());
+  fs::path journal_path = dir.journal<Configuration>();
+  auto journal_size = fs::file_size(journal_path);
+  {
+    fs::ofstream file(journal_path, std::ios::binary | std::ios::app);
+    file << "incomplete";
+  }
+  db_config.close();
+  db_config.open();
+  EXPECT_EQ(db_config.size(), 12);
+
+  // ... and discarded on the next commit
+  Configuration erased_config = *db_config.begin();
+  std::string first_name = erased_config.name();
+  db_config.erase(db_config.begin());
+  db_config.commit();
+  EXPECT_GT(fs::file_size(journal_path), journal_size);
+  db_config.close();
+  db_config.open();
+  EXPECT_EQ(db_config.size(), 11);
+  EXPECT_TRUE(db_config.find(first_name) == db_config.end());
+
+  // Compaction writes a snapshot and resets the journal
+  db_config.compact();
+  EXPECT_TRUE(fs::exists(dir.snapshot<Configuration>()));
+  journal_size = fs::file_size(journal_path);
+  db_config.close();
+  db_config.open();
+  EXPECT_EQ(db_config.size(), 11);
+  for (const auto &config : db_config) {
+    EXPECT_EQ(config.cache().contains("multiplicity"), true);
+  }
+
+  // New ids continue after compaction
+  auto reinsert_res = db_config.insert(erased_config);
+  EXPECT_EQ(reinsert_res.second, true);
+  EXPECT_EQ(reinsert_res.first->id(), "13");
+  db_config.commit();
+  EXPECT_GT(fs::file_size(journal_path), journal_size);
+  db_config.close();
+  db_config.open();
+  EXPECT_EQ(db_config.size(), 12);
+
+  // Check that the database is sorted by id
+  {
+    auto next = db_config.begin();
+    auto it = next++;
+    auto end = db_config.end();
+    for (; next != end; ++it, ++next) {
+      EXPECT_LT(std::stol(it->id()), std::stol(next->id()));
+    }
+  }
+}
+
+TEST(journalConfigDatabase_Test, MergeOnCommit) {
+  test::FCCTernaryProj proj;
+  proj.check_init();
+
+  ScopedNullLogging logging;
+  PrimClex primclex(proj.dir);
+  const Structure &prim(primclex.prim());
+  primclex.settings().set_crystallography_tol(1e-5);
+
+  auto &db_scel =
+      primclex.db_handler().db<Supercell>(traits<DB::journalDB>::name);
+  Eigen::Vector3d a, b, c;
+  std::tie(a, b, c) = prim.lattice().vectors();
+  Lattice canonical_lattice = xtal::canonical::equivalent(
+      Lattice(2. * a, 2. * b, c), prim.point_group(), TOL);
+  const Supercell &scel = *db_scel.emplace(&primclex, canonical_lattice).first;
+  db_scel.commit();
+
+  std::vector<Configuration> configs;
+  ConfigEnumAllOccupations enum_config(scel);
+  for (const auto &config : enum_config) {
+    configs.push_back(config);
+  }
+  ASSERT_GE(configs.size(), 3);
+
+  // Two writers open the same database, as separate processes would
+  DB::journalDatabase<Configuration> db_A(primclex);
+  DB::journalDatabase<Configuration> db_B(primclex);
+  db_A.open();
+  db_B.open();
+
+  db_A.insert(configs[0]);
+  db_A.insert(configs[1]);
+
+  // db_B inserts a Configuration also inserted by db_A, and a new one; ids
+  // are reserved, so the new one keeps its name after merging
+  auto res_B1 = db_B.insert(configs[1]);
+  auto res_B2 = db_B.insert(configs[2]);
+  std::string name_B1 = res_B1.first.name();
+  std::string name_B2 = res_B2.first.name();
+  EXPECT_NE(name_B1, scel.name() + "/0");
+  EXPECT_NE(name_B1, scel.name() + "/1");
+
+  db_A.commit();
+  EXPECT_EQ(db_A.renamed_on_commit().size(), 0);
+  db_B.commit();
+
+  // db_B was merged with the changes committed by db_A
+  EXPECT_EQ(db_B.size(), 3);
+  EXPECT_EQ(db_B.search(configs[2]).name(), name_B2);
+  EXPECT_EQ(db_B.search(configs[1]).name(), scel.name() + "/1");
+  ASSERT_EQ(db_B.renamed_on_commit().size(), 1);
+  EXPECT_EQ(db_B.renamed_on_commit().at(name_B1), scel.name() + "/1");
+
+  db_A.close();
+  db_A.open();
+  EXPECT_EQ(db_A.size(), 3);
+  EXPECT_TRUE(db_A.search(configs[0]) != db_A.end());
+  EXPECT_TRUE(db_A.search(configs[1]) != db_A.end());
+  EXPECT_TRUE(db_A.search(configs[2]) != db_A.end());
+
+  // Erasures by either writer are kept
+  db_B.erase(db_B.search(configs[0]));
+  db_B.commit();
+  db_A.erase(db_A.search(configs[2]));
+  db_A.commit();
+  EXPECT_EQ(db_A.size(), 1);
+  db_B.close();
+  db_B.open();
+  EXPECT_EQ(db_B.size(), 1);
+  EXPECT_TRUE(db_B.search(configs[1]) != db_B.end());
+}
@@ -10,7 +10,10 @@
 #include "FCCTernaryProj.hh"
 #include "casm/casm_io/container/stream_io.hh"
 #include "casm/clex/ConfigEnumAllOccupations.hh"
+#include "casm/clex/PrimClex.hh"
+#include "casm/crystallography/CanonicalForm.hh"
 #include "casm/crystallography/Structure.hh"
+#include "casm/database/DatabaseHandler_impl.hh"
 #include "casm/database/ScelDatabase.hh"
 #include "casm/enumerator/ConfigEnumInput.hh"
 
@@ -123,3 +126,122 @@ TEST(jsonConfigDatabase_Test, Test1) {
     }
   }
 }
+
+TEST(jsonConfigDatabase_Test, Search) {
+  test::FCCTernaryProj proj;
+  proj.check_init();
+
+  ScopedNullLogging logging;
+  PrimClex primclex(proj.dir);
+  const Structure &prim(primclex.prim());
+
+  DB::jsonDatabase<Configuration> db_config(primclex);
+  db_config.open();
+
+  Eigen::Vector3d a, b, c;
+  std::tie(a, b, c) = prim.lattice().vectors();
+  Supercell tscel(&primclex, Lattice(2. * a, 2. * b, c));
+  const Supercell &scel = *tscel.insert().first;
+
+  std::vector<Configuration> configs;
+  ConfigEnumAllOccupations enum_config(scel);
+  for (const auto &config : enum_config) {
+    if (!config.supercell().has_primclex()) {
+      config.supercell().set_primclex(&primclex);
+    }
+    configs.push_back(config);
+    EXPECT_EQ(db_config.insert(config).second, true);
+  }
+  EXPECT_EQ(db_config.size(), 12);
+
+  // Each is found by search, and inserting again does not add a duplicate
+  for (const auto &config : configs) {
+    auto it = db_config.search(config);
+    ASSERT_TRUE(it != db_config.end());
+    EXPECT_EQ(it->occupation(), config.occupation());
+    auto res = db_config.insert(config);
+    EXPECT_EQ(res.second, false);
+    EXPECT_EQ(res.first.name(), it.name());
+  }
+  EXPECT_EQ(db_config.size(), 12);
+
+  // Erased Configuration are no longer found
+  auto it = db_config.search(configs[3]);
+  db_config.erase(it);
+  EXPECT_TRUE(db_config.search(configs[3]) == db_config.end());
+  EXPECT_EQ(db_config.insert(configs[3]).second, true);
+  EXPECT_TRUE(db_config.search(configs[3]) != db_config.end());
+}
+
+TEST(jsonConfigDatabase_Test, MergeOnCommit) {
+  test::FCCTernaryProj proj;
+  proj.check_init();
+
+  ScopedNullLogging logging;
+  PrimClex primclex(proj.dir);
+  const Structure &prim(primclex.prim());
+  primclex.settings().set_crystallography_tol(1e-5);
+
+  auto &db_scel =
+      primclex.db_handler().db<Supercell>(traits<DB::jsonDB>::name);
+  Eigen::Vector3d a, b, c;
+  std::tie(a, b, c) = prim.lattice().vectors();
+  Lattice canonical_lattice = xtal::canonical::equivalent(
+      Lattice(2. * a, 2. * b, c), prim.point_group(), TOL);
+  const Supercell &scel = *db_scel.emplace(&primclex, canonical_lattice).first;
+  db_scel.commit();
+
+  std::vector<Configuration> configs;
+  ConfigEnumAllOccupations enum_config(scel);
+  for (const auto &config : enum_config) {
+    configs.push_back(config);
+  }
+  ASSERT_GE(configs.size(), 3);
+
+  // Two writers open the same database, as separate processes would
+  DB::jsonDatabase<Configuration> db_A(primclex);
+  DB::jsonDatabase<Configuration> db_B(primclex);
+  db_A.open();
+  db_B.open();
+
+  db_A.insert(configs[0]);
+  db_A.insert(configs[1]);
+
+  // db_B inserts a Configuration also inserted by db_A, and a new one; ids
+  // are reserved, so the new one keeps its name after merging
+  auto res_B1 = db_B.insert(configs[1]);
+  auto res_B2 = db_B.insert(configs[2]);
+  std::string name_B1 = res_B1.first.name();
+  std::string name_B2 = res_B2.first.name();
+  EXPECT_NE(name_B1, scel.name() + "/0");
+  EXPECT_NE(name_B1, scel.name() + "/1");
+
+  db_A.commit();
+  EXPECT_EQ(db_A.renamed_on_commit().size(), 0);
+  db_B.commit();
+
+  // db_B was merged with the changes committed by db_A
+  EXPECT_EQ(db_B.size(), 3);
+  EXPECT_EQ(db_B.search(configs[2]).name(), name_B2);
+  EXPECT_EQ(db_B.search(configs[1]).name(), scel.name() + "/1");
+  ASSERT_EQ(db_B.renamed_on_commit().size(), 1);
+  EXPECT_EQ(db_B.renamed_on_commit().at(name_B1), scel.name() + "/1");
+
+  db_A.close();
+  db_A.open();
+  EXPECT_EQ(db_A.size(), 3);
+  EXPECT_TRUE(db_A.search(configs[0]) != db_A.end());
+  EXPECT_TRUE(db_A.search(configs[1]) != db_A.end());
+  EXPECT_TRUE(db_A.search(configs[2]) != db_A.end());
+
+  // Erasures by either writer are kept
+  db_B.erase(db_B.search(configs[0]));
+  db_B.commit();
+  db_A.erase(db_A.search(configs[2]));
+  db_A.commit();
+  EXPECT_EQ(db_A.size(), 1);
+  db_B.close();
+  db_B.open();
+  EXPECT_EQ(db_B.size(), 1);
+  EXPECT_TRUE(db_B.search(configs[1]) != db_B.end());
+}
@@ -108,3 +108,63 @@ TEST(jsonPropertiesDatabase_Test, Test1) {
 
   fs::remove(loc);
 }
+
+TEST(jsonPropertiesDatabase_Test, MergeOnCommit) {
+  test::ZrOProj proj;
+  proj.check_init();
+
+  ScopedNullLogging logging;
+  PrimClex primclex(proj.dir);
+
+  std::string calc_type("test");
+  fs::path loc("tests/unit/database/config_props_merge.json");
+
+  MappedProperties props;
+  props.to = "to/0";
+  props.scalar("energy") = 0.1;
+  props.origin = "from/0";
+
+  // Two writers open the same database, as separate processes would
+  DB::jsonPropertiesDatabase db_A(primclex, calc_type, loc);
+  db_A.open();
+  db_A.insert(props);
+  db_A.commit();
+
+  DB::jsonPropertiesDatabase db_B(primclex, calc_type, loc);
+  db_A.close();
+  db_A.open();
+  db_B.open();
+
+  props.origin = "from/1";
+  db_A.insert(props);
+  db_A.erase_via_origin("from/0");
+  db_A.commit();
+
+  props.origin = "from/2";
+  props.to = "to/2";
+  db_B.insert(props);
+  db_B.commit();
+
+  // db_B was merged with the changes committed by db_A
+  EXPECT_EQ(db_B.size(), 2);
+  EXPECT_TRUE(db_B.find_via_origin("from/0") == db_B.end());
+  EXPECT_EQ(db_B.all_origins("to/0").size(), 1);
+
+  db_A.close();
+  db_A.open();
+  EXPECT_EQ(db_A.size(), 2);
+  EXPECT_EQ(db_A.find_via_to("to/0")->origin, "from/1");
+  EXPECT_EQ(db_A.find_via_to("to/2")->origin, "from/2");
+
+  // Properties of a renamed Configuration are mapped to the new name
+  std::map<std::string, std::string> renamed;
+  renamed["to/2"] = "to/0";
+  EXPECT_EQ(db_A.rename_to(renamed), 1);
+  EXPECT_EQ(db_A.all_origins("to/0").size(), 2);
+  EXPECT_EQ(db_A.all_origins("to/2").size(), 0);
+  EXPECT_EQ(db_A.find_via_origin("from/2")->to, "to/0");
+  db_A.close();
+  db_B.close();
+
+  fs::remove(loc);
+}
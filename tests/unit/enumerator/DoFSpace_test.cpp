@@ -1,6 +1,7 @@
 #include "casm/enumerator/DoFSpace.hh"
 
 #include "casm/casm_io/Log.hh"
+#include "casm/clex/Configuration.hh"
 #include "casm/clex/FillSupercell.hh"
 #include "casm/clex/ScelEnum.hh"
 #include "casm/clex/Supercell.hh"
@@ -14,6 +15,7 @@
 #include "casm/symmetry/IrrepDecomposition.hh"
 #include "casm/symmetry/IrrepDecompositionImpl.hh"
 #include "casm/symmetry/IrrepWedge.hh"
+#include "casm/symmetry/SparseCollectiveDoFSymRep.hh"
 #include "casm/symmetry/SymGroup.hh"
 #include "casm/symmetry/SymInfo.hh"
 #include "casm/symmetry/io/json/SymGroup_json_io.hh"
@@ -77,6 +79,46 @@ void print_irreps(IrrepInfoVectorType const &irreps) {
   return;
 }
 
+// check that the blocked, sparse, irrep decomposition finds the same irreps,
+// spanning the same space, as the dense irrep decomposition
+void check_blocked_decomposition(DoFSpace const &dof_space,
+                                 SupercellSymInfo const &sym_info,
+                                 std::vector<PermuteIterator> const &group) {
+  bool calc_wedges = false;
+  SymRepTools_v2::VectorSpaceSymReport dense = vector_space_sym_report_v2(
+      dof_space, sym_info, group, calc_wedges, false);
+  SymRepTools_v2::VectorSpaceSymReport blocked = vector_space_sym_report_v2(
+      dof_space, sym_info, group, calc_wedges, true);
+
+  ASSERT_EQ(blocked.symgroup_rep.size(), dense.symgroup_rep.size());
+  for (Index i = 0; i < dense.symgroup_rep.size(); ++i) {
+    EXPECT_TRUE(almost_equal(blocked.symgroup_rep[i], dense.symgroup_rep[i]));
+  }
+
+  ASSERT_EQ(blocked.irreps.size(), dense.irreps.size());
+  for (Index i = 0; i < dense.irreps.size(); ++i) {
+    auto const &irrep = blocked.irreps[i];
+    EXPECT_EQ(irrep.irrep_dim(), dense.irreps[i].irrep_dim());
+    EXPECT_TRUE(almost_equal(irrep.characters, dense.irreps[i].characters));
+
+    // check irreducible
+    double characters_squared_norm = 0.;
+    for (auto const &matrix : blocked.symgroup_rep) {
+      std::complex<double> character =
+          (irrep.trans_mat * matrix * irrep.trans_mat.adjoint()).trace();
+      characters_squared_norm += std::norm(character);
+    }
+    EXPECT_TRUE(almost_equal(characters_squared_norm,
+                             double(blocked.symgroup_rep.size()), 1e-5));
+  }
+
+  Eigen::MatrixXd const &S_dense = dense.symmetry_adapted_subspace;
+  Eigen::MatrixXd const &S_blocked = blocked.symmetry_adapted_subspace;
+  ASSERT_EQ(S_blocked.cols(), S_dense.cols());
+  EXPECT_TRUE(almost_equal(S_blocked * S_blocked.transpose(),
+                           S_dense * S_dense.transpose(), 1e-5));
+}
+
 }  // namespace
 
 class DoFSpaceTest : public testing::Test {
@@ -660,6 +702,47 @@ TEST_F(DoFSpaceTest, ExcludeHomogeneousModeSpace) {
   // log() << json << std::endl;
 }
 
+TEST_F(DoFSpaceTest, BlockedIrrepDecomposition) {
+  DoFKey dof_key = "disp";
+  SupercellSymInfo const &sym_info = shared_supercell->sym_info();
+
+  // one site orbit, with translations
+  ConfigEnumInput config_input{*shared_supercell};
+  std::vector<PermuteIterator> invariant_group =
+      make_invariant_subgroup(config_input);
+  DoFSpace dof_space = make_dof_space(dof_key, config_input);
+  check_blocked_decomposition(dof_space, sym_info, invariant_group);
+  check_blocked_decomposition(exclude_homogeneous_mode_space(dof_space),
+                              sym_info, invariant_group);
+
+  // two site orbits, no translations
+  Configuration config{shared_supercell};
+  config.set_occ(0, 1);
+  ConfigEnumInput ordered_config_input{config};
+  std::vector<PermuteIterator> ordered_invariant_group =
+      make_invariant_subgroup(ordered_config_input);
+  DoFSpace ordered_dof_space = make_dof_space(dof_key, ordered_config_input);
+  check_blocked_decomposition(ordered_dof_space, sym_info,
+                              ordered_invariant_group);
+  check_blocked_decomposition(
+      exclude_homogeneous_mode_space(ordered_dof_space), sym_info,
+      ordered_invariant_group);
+
+  // the sparse representation is not mixed between the site orbits
+  auto group_and_rep = make_sparse_collective_dof_symrep(
+      ordered_dof_space.sites().value(), sym_info, dof_key,
+      ordered_invariant_group);
+  SymRepTools_v2::GroupIndices head_group;
+  for (Index i = 0; i < group_and_rep.second.size(); ++i) {
+    head_group.insert(i);
+  }
+  auto blocks = SymRepTools_v2::IrrepDecompositionImpl::make_invariant_blocks(
+      group_and_rep.second, head_group);
+  ASSERT_EQ(blocks.size(), 2);
+  EXPECT_EQ(blocks[0].size(), 3);
+  EXPECT_EQ(blocks[1].size(), 9);
+}
+
 /// Tests on a structure with a restricted local basis (2d displacements), but
 /// the basis is the same on all sites
 class RestrictedLocalDoFSpaceTest : public testing::Test {
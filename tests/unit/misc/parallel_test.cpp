@@ -0,0 +1,71 @@
+#include "gtest/gtest.h"
+
+/// What is being tested:
+#include "casm/misc/parallel.hh"
+
+/// What is being used to test it:
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using namespace CASM;
+
+TEST(parallel_pipeline_Test, ConsumeInOrder) {
+  Index size = 100;
+  for (Index n_threads : {1, 2, 4}) {
+    std::vector<Index> consumed;
+    std::vector<Index> thread_index(size, -1);
+    parallel_pipeline(
+        size, n_threads, 3,
+        [&](Index t, Index i) {
+          // some items take longer, so are mapped out of order
+          if (i % 7 == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+          }
+          thread_index[i] = t;
+          return i * i;
+        },
+        [&](Index i, Index &&value) {
+          EXPECT_EQ(value, i * i);
+          consumed.push_back(i);
+        });
+    ASSERT_EQ(Index(consumed.size()), size);
+    for (Index i = 0; i < size; ++i) {
+      EXPECT_EQ(consumed[i], i);
+      EXPECT_TRUE(thread_index[i] >= 0 && thread_index[i] < n_threads);
+    }
+  }
+}
+
+TEST(parallel_pipeline_Test, MapException) {
+  for (Index n_threads : {1, 4}) {
+    Index n_consumed = 0;
+    EXPECT_THROW(parallel_pipeline(
+                     50, n_threads, -1,
+                     [&](Index t, Index i) {
+                       if (i == 20) {
+                         throw std::runtime_error("map");
+                       }
+                       return i;
+                     },
+                     [&](Index i, Index &&value) { ++n_consumed; }),
+                 std::runtime_error);
+
+    // items before the exception are consumed
+    EXPECT_EQ(n_consumed, 20);
+  }
+}
+
+TEST(parallel_pipeline_Test, ConsumeException) {
+  Index n_consumed = 0;
+  EXPECT_THROW(parallel_pipeline(
+                   1000, 4, -1, [&](Index t, Index i) { return i; },
+                   [&](Index i, Index &&value) {
+                     if (i == 10) {
+                       throw std::runtime_error("consume");
+                     }
+                     ++n_consumed;
+                   }),
+               std::runtime_error);
+  EXPECT_EQ(n_consumed, 10);
+}
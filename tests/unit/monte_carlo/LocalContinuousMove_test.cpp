@@ -0,0 +1,277 @@
+#include "casm/monte_carlo/LocalContinuousMove.hh"
+
+#include "ProjectBaseTest.hh"
+#include "casm/clex/ClexulatorContext.hh"
+#include "casm/clex/ConfigCorrelations.hh"
+#include "casm/clex/ConfigDoF.hh"
+#include "casm/clex/ConfigDoFTools.hh"
+#include "casm/clex/ECIContainer.hh"
+#include "casm/clex/PrimClex.hh"
+#include "casm/clex/Supercell.hh"
+#include "casm/crystallography/Structure.hh"
+#include "casm/external/MersenneTwister/MersenneTwister.h"
+#include "casm/misc/CASM_Eigen_math.hh"
+#include "casm/monte_carlo/MonteCorrelations.hh"
+#include "crystallography/TestStructures.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+namespace {
+
+ConfigDoF make_disp_configdof() {
+  auto shared_prim =
+      std::make_shared<Structure const>(test::SimpleCubic_disp_prim());
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 2;
+  Supercell supercell(shared_prim, T);
+  return make_configdof(supercell);
+}
+
+}  // namespace
+
+TEST(LocalContinuousMoveTest, RandomStep) {
+  ConfigDoF configdof = make_disp_configdof();
+  Monte::LocalContinuousMoveSettings settings;
+  settings.dof = "disp";
+  settings.max_step = 0.2;
+
+  Monte::LocalContinuousMoveProposer proposer(configdof, settings);
+  EXPECT_EQ(proposer.size(), 8);
+
+  MTRand mtrand(MTRand::uint32(0));
+  Monte::LocalContinuousMod mod;
+  for (Index i = 0; i < 100; ++i) {
+    proposer.propose(mod, configdof, mtrand);
+    ASSERT_TRUE(mod.site_index() >= 0 && mod.site_index() < 8);
+    Eigen::VectorXd curr = configdof.local_dof("disp").site_value(
+        mod.site_index());
+    EXPECT_EQ(mod.to_value().size(), 3);
+    EXPECT_LE((mod.to_value() - curr).norm(), settings.max_step + 1e-12);
+  }
+}
+
+TEST(LocalContinuousMoveTest, NormalizedStep) {
+  ConfigDoF configdof = make_disp_configdof();
+  Monte::LocalContinuousMoveSettings settings;
+  settings.dof = "disp";
+  settings.max_step = 0.5;
+  settings.normalize = true;
+
+  Monte::LocalContinuousMoveProposer proposer(configdof, settings);
+  MTRand mtrand(MTRand::uint32(0));
+  Monte::LocalContinuousMod mod;
+  for (Index i = 0; i < 100; ++i) {
+    proposer.propose(mod, configdof, mtrand);
+    configdof.local_dof("disp").site_value(mod.site_index()) = mod.to_value();
+    EXPECT_NEAR(mod.to_value().norm(), 1.0, 1e-12);
+  }
+}
+
+TEST(LocalContinuousMoveTest, OverRelaxation) {
+  ConfigDoF configdof = make_disp_configdof();
+  Monte::LocalContinuousMoveSettings settings;
+  settings.dof = "disp";
+
+  Monte::LocalContinuousMoveProposer proposer(configdof, settings);
+  Eigen::Vector3d value(0.3, -0.1, 0.2);
+  configdof.local_dof("disp").site_value(5) = value;
+  Eigen::Vector3d field(1.0, 2.0, -0.5);
+
+  // reflection preserves field.dot(value) and length, and is an involution
+  Monte::LocalContinuousMod mod;
+  proposer.propose_over_relaxation(mod, 5, field, configdof);
+  EXPECT_EQ(mod.site_index(), 5);
+  EXPECT_NEAR(field.dot(mod.to_value()), field.dot(value), 1e-12);
+  EXPECT_NEAR(mod.to_value().norm(), value.norm(), 1e-12);
+  EXPECT_GT((mod.to_value() - value).norm(), 1e-6);
+
+  configdof.local_dof("disp").site_value(5) = mod.to_value();
+  proposer.propose_over_relaxation(mod, 5, field, configdof);
+  EXPECT_TRUE(mod.to_value().isApprox(value, 1e-12));
+}
+
+TEST(LocalContinuousMoveTest, MissingDoF) {
+  ConfigDoF configdof = make_disp_configdof();
+  Monte::LocalContinuousMoveSettings settings;
+  settings.dof = "magspin";
+  EXPECT_ANY_THROW(Monte::LocalContinuousMoveProposer(configdof, settings));
+}
+
+class LocalContinuousMoveClexTest : public test::ProjectBaseTest {
+ protected:
+  static std::string clex_basis_specs_str();
+
+  LocalContinuousMoveClexTest()
+      : test::ProjectBaseTest(test::SimpleCubic_disp_prim(),
+                              "LocalContinuousMoveClexTest",
+                              jsonParser::parse(clex_basis_specs_str())),
+        shared_supercell(std::make_shared<CASM::Supercell>(
+            shared_prim, Eigen::Matrix3l::Identity() * 4)),
+        configdof(make_configdof(*shared_supercell)) {
+    this->write_basis_set_data();
+    this->make_clexulator();
+    shared_supercell->set_primclex(primclex_ptr.get());
+
+    clexulator = primclex_ptr->clexulator(basis_set_name);
+
+    // all correlations, with arbitrary non-zero values
+    std::vector<double> eci_values;
+    std::vector<unsigned int> eci_index;
+    for (unsigned int i = 0; i < clexulator.corr_size(); ++i) {
+      eci_values.push_back((i % 2 ? -0.1 : 0.2) * (i + 1));
+      eci_index.push_back(i);
+    }
+    eci = ECIContainer(eci_values.begin(), eci_values.end(), eci_index.begin());
+
+    // random displacements
+    MTRand mtrand(MTRand::uint32(0));
+    auto &disp = configdof.local_dof("disp");
+    for (Index l = 0; l < configdof.size(); ++l) {
+      for (Index k = 0; k < 3; ++k) {
+        disp.site_value(l)(k) = 0.4 * (mtrand.rand53() - 0.5);
+      }
+    }
+  }
+
+  /// Formation energy (extensive), from the full correlations
+  double energy(ConfigDoF const &_configdof) const {
+    Eigen::VectorXd corr;
+    extensive_correlations(corr, _configdof, shared_supercell->nlist(),
+                           clexulator);
+    return eci * corr;
+  }
+
+  // 4x4x4 supercell, so that a site does not share a cluster with its own
+  // periodic image
+  std::shared_ptr<CASM::Supercell> shared_supercell;
+  Clexulator clexulator;
+  ECIContainer eci;
+  ConfigDoF configdof;
+};
+
+std::string LocalContinuousMoveClexTest::clex_basis_specs_str() {
+  return R"({
+"basis_function_specs" : {
+"global_max_poly_order": 4
+},
+"cluster_specs": {
+"method": "periodic_max_length",
+"params": {
+  "orbit_branch_specs": {
+    "2" : {"max_length" : 1.01}
+  }
+}
+}
+})";
+}
+
+TEST_F(LocalContinuousMoveClexTest, RestrictedDeltaCorr) {
+  SuperNeighborList const &supercell_neighbor_list = shared_supercell->nlist();
+  ClexulatorContext context(clexulator);
+  std::vector<unsigned int> const &all_indices =
+      context.all_correlation_indices();
+
+  Eigen::VectorXd corr_before;
+  extensive_correlations(corr_before, configdof, supercell_neighbor_list,
+                         clexulator);
+
+  Monte::LocalContinuousMoveSettings settings;
+  settings.dof = "disp";
+  settings.max_step = 0.2;
+  Monte::LocalContinuousMoveProposer proposer(configdof, settings);
+  MTRand mtrand(MTRand::uint32(1));
+  Monte::LocalContinuousMod mod;
+  for (Index i = 0; i < 10; ++i) {
+    proposer.propose(mod, configdof, mtrand);
+
+    Eigen::VectorXd dcorr;
+    Monte::restricted_delta_corr(dcorr, mod, "disp", configdof,
+                                 supercell_neighbor_list, context,
+                                 all_indices.data(), end_ptr(all_indices));
+
+    ConfigDoF after = configdof;
+    after.local_dof("disp").site_value(mod.site_index()) = mod.to_value();
+    Eigen::VectorXd corr_after;
+    extensive_correlations(corr_after, after, supercell_neighbor_list,
+                           clexulator);
+    EXPECT_TRUE(almost_equal(dcorr, corr_after - corr_before, 1e-8));
+  }
+}
+
+TEST_F(LocalContinuousMoveClexTest, LocalField) {
+  SuperNeighborList const &supercell_neighbor_list = shared_supercell->nlist();
+  ClexulatorContext context(clexulator);
+
+  for (Index l : {0, 21, 63}) {
+    Eigen::VectorXd field;
+    Monte::local_field(field, l, "disp", configdof, supercell_neighbor_list,
+                       context, eci);
+    ASSERT_EQ(field.size(), 3);
+
+    Eigen::VectorXd expected(3);
+    ConfigDoF trial = configdof;
+    for (Index k = 0; k < 3; ++k) {
+      Eigen::VectorXd value = Eigen::VectorXd::Zero(3);
+      value(k) = 1.0;
+      trial.local_dof("disp").site_value(l) = value;
+      double E_plus = energy(trial);
+      value(k) = -1.0;
+      trial.local_dof("disp").site_value(l) = value;
+      double E_minus = energy(trial);
+      expected(k) = 0.5 * (E_plus - E_minus);
+    }
+    EXPECT_TRUE(almost_equal(field, expected, 1e-8));
+  }
+}
+
+TEST_F(LocalContinuousMoveClexTest, ProposeAcceptEnergyConsistency) {
+  // Follows Canonical::propose / check / accept: the energy accumulated from
+  // accepted delta energies must match the energy of the final state
+  SuperNeighborList const &supercell_neighbor_list = shared_supercell->nlist();
+  ClexulatorContext context(clexulator);
+
+  Monte::LocalContinuousMoveSettings settings;
+  settings.dof = "disp";
+  settings.max_step = 0.1;
+  settings.over_relaxation = 0.3;
+  Monte::LocalContinuousMoveProposer proposer(configdof, settings);
+
+  double beta = 10.0;
+  double E = energy(configdof);
+  MTRand mtrand(MTRand::uint32(2));
+  Monte::LocalContinuousMod mod;
+  Eigen::VectorXd dcorr;
+  Index n_accept = 0;
+  Index n_reject = 0;
+  for (Index i = 0; i < 500; ++i) {
+    // propose
+    if (proposer.choose_over_relaxation(mtrand)) {
+      Index l = proposer.propose_site(mtrand);
+      Eigen::VectorXd field;
+      Monte::local_field(field, l, settings.dof, configdof,
+                         supercell_neighbor_list, context, eci);
+      proposer.propose_over_relaxation(mod, l, field, configdof);
+    } else {
+      proposer.propose(mod, configdof, mtrand);
+    }
+    Monte::restricted_delta_corr(dcorr, mod, settings.dof, configdof,
+                                 supercell_neighbor_list, context,
+                                 eci.index().data(), end_ptr(eci.index()));
+    double dE = eci * dcorr;
+
+    // check
+    if (dE > 0.0 && mtrand.rand53() >= std::exp(-beta * dE)) {
+      ++n_reject;
+      continue;
+    }
+
+    // accept
+    configdof.local_dof(settings.dof).site_value(mod.site_index()) =
+        mod.to_value();
+    E += dE;
+    ++n_accept;
+  }
+  EXPECT_GT(n_accept, 0);
+  EXPECT_GT(n_reject, 0);
+  EXPECT_NEAR(E, energy(configdof), 1e-8);
+}
@@ -0,0 +1,120 @@
+#include "gtest/gtest.h"
+
+/// What is being tested:
+#include "casm/symmetry/SupercellPermutationTable.hh"
+
+/// What is being used to test it:
+#include "casm/clex/Supercell.hh"
+#include "casm/crystallography/Structure.hh"
+#include "casm/symmetry/PermuteIterator.hh"
+#include "casm/symmetry/SupercellSymInfo.hh"
+#include "crystallography/TestStructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+/// Check table.permute_ind against the PermuteIterator composition of factor
+/// group and translation permutations
+void check_table(SupercellSymInfo const &sym_info,
+                 SupercellPermutationTable const &table) {
+  ASSERT_EQ(table.n_factor_group(), sym_info.factor_group().size());
+  ASSERT_EQ(table.n_translations(), sym_info.superlattice().size());
+  for (auto it = sym_info.permute_begin(); it != sym_info.permute_end();
+       ++it) {
+    for (Index i = 0; i < table.n_sites(); ++i) {
+      Index expected = it->factor_group_permute()[it->translation_permute()[i]];
+      ASSERT_EQ(table.permute_ind(it->factor_group_index(),
+                                  it->translation_index(), i),
+                expected);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(SupercellPermutationTableTest, Layouts) {
+  auto shared_prim = std::make_shared<Structure const>(test::ZrO_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 1;
+  Supercell supercell(shared_prim, T);
+  SupercellSymInfo const &sym_info = supercell.sym_info();
+
+  Index n_fg = sym_info.factor_group().size();
+  Index n_trans = sym_info.superlattice().size();
+  Index n_sites = supercell.num_sites();
+  typedef SupercellPermutationTable::Layout Layout;
+
+  SupercellPermutationTable combined(sym_info, Layout::combined);
+  EXPECT_EQ(combined.memory_size(), SupercellPermutationTable::required_bytes(
+                                        Layout::combined, n_fg, n_trans,
+                                        n_sites));
+  check_table(sym_info, combined);
+
+  SupercellPermutationTable factored(sym_info, Layout::factored);
+  EXPECT_EQ(factored.memory_size(), SupercellPermutationTable::required_bytes(
+                                        Layout::factored, n_fg, n_trans,
+                                        n_sites));
+  check_table(sym_info, factored);
+
+  // the memory budget chooses the layout
+  EXPECT_TRUE(SupercellPermutationTable(sym_info, combined.memory_size())
+                  .layout() == Layout::combined);
+  EXPECT_TRUE(SupercellPermutationTable(sym_info, factored.memory_size())
+                  .layout() == Layout::factored);
+  EXPECT_TRUE(SupercellPermutationTable(sym_info, 0).layout() == Layout::none);
+}
+
+TEST(SupercellPermutationTableTest, PermuteIterator) {
+  auto shared_prim =
+      std::make_shared<Structure const>(test::FCC_ternary_prim());
+  Eigen::Matrix3l T;
+  T << -1, 1, 1, 1, -1, 1, 3, 3, -3;
+  Supercell supercell(shared_prim, T);
+  SupercellSymInfo const &sym_info = supercell.sym_info();
+
+  std::vector<std::vector<Index>> expected;
+  for (auto it = sym_info.permute_begin(); it != sym_info.permute_end();
+       ++it) {
+    std::vector<Index> row;
+    for (Index i = 0; i < supercell.num_sites(); ++i) {
+      row.push_back(it->permute_ind(i));
+    }
+    expected.push_back(row);
+  }
+
+  for (std::size_t max_bytes :
+       {std::size_t(1) << 30, std::size_t(5000), std::size_t(0)}) {
+    auto layout = sym_info.materialize_permutations(max_bytes);
+    EXPECT_EQ(layout != SupercellPermutationTable::Layout::none,
+              max_bytes != 0);
+    Index r = 0;
+    for (auto it = sym_info.permute_begin(); it != sym_info.permute_end();
+         ++it, ++r) {
+      PermuteIndices permute_ind(*it);
+      for (Index i = 0; i < supercell.num_sites(); ++i) {
+        ASSERT_EQ(it->permute_ind(i), expected[r][i]);
+        ASSERT_EQ(permute_ind[i], expected[r][i]);
+      }
+    }
+  }
+  sym_info.materialize_permutations(0);
+  EXPECT_TRUE(sym_info.permutation_table().layout() ==
+              SupercellPermutationTable::Layout::none);
+}
+
+TEST(SupercellPermutationTableTest, LargeSupercell) {
+  // more than 100 unit cells, so translation permutations are not stored and
+  // table rows are filled from the unit cell index converters
+  auto shared_prim =
+      std::make_shared<Structure const>(test::FCC_ternary_prim());
+  Eigen::Matrix3l T;
+  T << 5, 0, 0, 0, 5, 0, 0, 0, 5;
+  Supercell supercell(shared_prim, T);
+  SupercellSymInfo const &sym_info = supercell.sym_info();
+  EXPECT_EQ(sym_info.translation_permutations().size(), 0);
+
+  typedef SupercellPermutationTable::Layout Layout;
+  check_table(sym_info, SupercellPermutationTable(sym_info, Layout::combined));
+  check_table(sym_info, SupercellPermutationTable(sym_info, Layout::factored));
+}
@@ -0,0 +1,103 @@
+#include "gtest/gtest.h"
+
+/// What is being tested:
+#include "casm/symmetry/SymGroup.hh"
+
+/// What is being used to test it:
+#include "casm/crystallography/Structure.hh"
+#include "casm/misc/parallel.hh"
+#include "casm/symmetry/SymGroupRep.hh"
+#include "casm/symmetry/SymPermutation.hh"
+#include "crystallography/TestStructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+/// Check multiplication table against direct products, and that conjugacy
+/// classes partition the group
+void check_group_tables(SymGroup const &group) {
+  auto const &multi_table = group.get_multi_table();
+  ASSERT_EQ(multi_table.size(), group.size());
+  for (Index i = 0; i < group.size(); ++i) {
+    std::vector<bool> in_row(group.size(), false);
+    for (Index j = 0; j < group.size(); ++j) {
+      Index k = multi_table[i][j];
+      ASSERT_LT(k, group.size());
+      EXPECT_FALSE(in_row[k]);
+      in_row[k] = true;
+      EXPECT_EQ(k, group.find_periodic(group[i] * group[j]));
+    }
+  }
+
+  Index n_ops = 0;
+  std::vector<bool> in_class(group.size(), false);
+  // copy, class_of_op may regenerate the conjugacy classes
+  std::vector<std::vector<Index>> conjugacy_classes =
+      group.get_conjugacy_classes();
+  for (auto const &conjugacy_class : conjugacy_classes) {
+    for (Index op : conjugacy_class) {
+      EXPECT_FALSE(in_class[op]);
+      in_class[op] = true;
+      EXPECT_EQ(group.class_of_op(op),
+                group.class_of_op(conjugacy_class.front()));
+      ++n_ops;
+    }
+  }
+  EXPECT_EQ(n_ops, group.size());
+}
+
+}  // namespace
+
+TEST(SymGroupTest, FCCTables) {
+  Structure prim(test::FCC_ternary_prim());
+  SymGroup const &factor_group = prim.factor_group();
+  ASSERT_EQ(factor_group.size(), 48);
+  check_group_tables(factor_group);
+  EXPECT_EQ(factor_group.get_conjugacy_classes().size(), 10);
+
+  // m-3m has 98 subgroups, in 33 conjugacy classes
+  auto const &subgroups = factor_group.subgroups();
+  EXPECT_EQ(subgroups.size(), 33);
+  Index n_subgroups = 0;
+  for (auto const &orbit : subgroups) {
+    n_subgroups += orbit.size();
+  }
+  EXPECT_EQ(n_subgroups, 98);
+}
+
+TEST(SymGroupTest, ZrOTables) {
+  Structure prim(test::ZrO_prim());
+  check_group_tables(prim.factor_group());
+}
+
+TEST(SymGroupTest, ConcurrentRepresentations) {
+  // Supercell constructed by multiple threads add representations to the
+  // shared prim factor group
+  Structure prim(test::ZrO_prim());
+  MasterSymGroup const &factor_group = prim.factor_group();
+  Index n_ops = factor_group.size();
+
+  Index n_reps = 200;
+  std::vector<SymGroupRepID> rep_IDs(n_reps);
+  parallel_for(0, n_reps, 4, [&](Index thread_index, Index i) {
+    SymGroupRepID id = factor_group.allocate_representation();
+    for (Index op = 0; op < n_ops; ++op) {
+      factor_group[op].set_rep(id, SymPermutation(std::vector<Index>(1, i)));
+    }
+    factor_group.coord_rep_ID();
+    factor_group.identity_rep_ID(i % 3);
+    rep_IDs[i] = id;
+  });
+
+  std::set<Index> rep_indices;
+  for (Index i = 0; i < n_reps; ++i) {
+    rep_indices.insert(rep_IDs[i].rep_index());
+    SymGroupRep const &rep = factor_group.representation(rep_IDs[i]);
+    for (Index op = 0; op < n_ops; ++op) {
+      ASSERT_TRUE(rep[op] != nullptr);
+      EXPECT_EQ((*rep[op]->permutation())[0], i);
+    }
+  }
+  EXPECT_EQ(rep_indices.size(), n_reps);
+}
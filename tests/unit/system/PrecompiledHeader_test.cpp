@@ -0,0 +1,76 @@
+#include "casm/system/PrecompiledHeader.hh"
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+#include "Common.hh"
+#include "casm/system/RuntimeLibrary.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+TEST(PrecompiledHeaderTest, UpdateTest) {
+  test::TmpDir tmpdir;
+
+  // a local header, so that the dependency check can be tested
+  fs::path local_header = tmpdir.path() / "local.hh";
+  {
+    std::ofstream file(local_header.string());
+    file << "#ifndef LOCAL_HH\n"
+            "#define LOCAL_HH\n"
+            "#include <vector>\n"
+            "inline int forty_two() { return 42; }\n"
+            "#endif\n";
+  }
+
+  std::string compile_opt = RuntimeLibrary::default_cxx().first +
+                            " -O3 -Wall -fPIC --std=c++17 -I" +
+                            tmpdir.path().string();
+
+  PrecompiledHeader pch(tmpdir.path() / "pch", "test_pch",
+                        {"<vector>", "\"local.hh\""}, compile_opt);
+  EXPECT_FALSE(pch.is_current());
+
+  pch.update();
+  EXPECT_TRUE(fs::exists(pch.header()));
+  EXPECT_TRUE(fs::exists(pch.precompiled_header()));
+  EXPECT_TRUE(pch.is_current());
+
+  // compile using the precompiled header
+  fs::path cc_filename = tmpdir.path() / "use_pch.cc";
+  {
+    std::ofstream file(cc_filename.string());
+    file << "#include \"local.hh\"\n"
+            "int f() { return forty_two(); }\n";
+  }
+  int result = std::system((compile_opt + " " + pch.include_option() +
+                            " -c " + cc_filename.string() + " -o " +
+                            (tmpdir.path() / "use_pch.o").string())
+                               .c_str());
+  EXPECT_EQ(result, 0);
+
+  // different compile options: not current
+  PrecompiledHeader pch_O0(tmpdir.path() / "pch", "test_pch",
+                           {"<vector>", "\"local.hh\""},
+                           compile_opt + " -O0");
+  EXPECT_FALSE(pch_O0.is_current());
+
+  // dependency changed: not current
+  std::time_t t = fs::last_write_time(pch.precompiled_header());
+  fs::last_write_time(local_header, t + 10);
+  EXPECT_FALSE(pch.is_current());
+  pch.update();
+  fs::last_write_time(pch.precompiled_header(), t + 20);
+  EXPECT_TRUE(pch.is_current());
+}
+
+TEST(PrecompiledHeaderTest, FailTest) {
+  test::TmpDir tmpdir;
+  std::string compile_opt = RuntimeLibrary::default_cxx().first +
+                            " -O3 -Wall -fPIC --std=c++17";
+  PrecompiledHeader pch(tmpdir.path() / "pch", "test_pch",
+                        {"\"does_not_exist.hh\""}, compile_opt);
+  EXPECT_THROW(pch.update(), std::runtime_error);
+  EXPECT_FALSE(fs::exists(pch.precompiled_header()));
+  EXPECT_FALSE(pch.is_current());
+}